@@ -119,6 +119,34 @@ ScratchStatus concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(size_t *stack_si
                                                                 size_t polynomial_size,
                                                                 const struct Fft *fft);
 
+void concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64(c64 *fourier_ggsw_out,
+                                                               const uint64_t *ct_in,
+                                                               const c64 *fourier_bsk,
+                                                               const uint64_t *fpksk,
+                                                               size_t ct_in_dimension,
+                                                               size_t bsk_decomposition_level_count,
+                                                               size_t bsk_decomposition_base_log,
+                                                               size_t bsk_glwe_dimension,
+                                                               size_t bsk_polynomial_size,
+                                                               size_t bsk_input_lwe_dimension,
+                                                               size_t fpksk_decomposition_level_count,
+                                                               size_t fpksk_decomposition_base_log,
+                                                               size_t fpksk_input_dimension,
+                                                               size_t fpksk_output_glwe_dimension,
+                                                               size_t fpksk_output_polynomial_size,
+                                                               size_t cbs_decomposition_level_count,
+                                                               size_t cbs_decomposition_base_log,
+                                                               const struct Fft *fft,
+                                                               uint8_t *stack,
+                                                               size_t stack_size);
+
+ScratchStatus concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64_scratch(size_t *stack_size,
+                                                                                size_t *stack_align,
+                                                                                size_t ct_in_dimension,
+                                                                                size_t bsk_glwe_dimension,
+                                                                                size_t bsk_polynomial_size,
+                                                                                const struct Fft *fft);
+
 void concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64(uint64_t *ct_out_vec,
                                                                                 const uint64_t *ct_in_vec,
                                                                                 const uint64_t *lut,
@@ -277,6 +305,10 @@ size_t concrete_cpu_fourier_bootstrap_key_size_u64(size_t decomposition_level_co
                                                    size_t polynomial_size,
                                                    size_t input_lwe_dimension);
 
+size_t concrete_cpu_fourier_ggsw_ciphertext_size_u64(size_t glwe_dimension,
+                                                     size_t polynomial_size,
+                                                     size_t decomposition_level_count);
+
 size_t concrete_cpu_ggsw_ciphertext_size_u64(size_t glwe_dimension,
                                              size_t polynomial_size,
                                              size_t decomposition_level_count);
@@ -364,6 +396,27 @@ size_t concrete_cpu_lwe_packing_keyswitch_key_size(size_t output_glwe_dimension,
 
 size_t concrete_cpu_lwe_secret_key_size_u64(size_t lwe_dimension);
 
+void concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64(uint64_t *ct_out_vec,
+                                                        const uint64_t *ct_in,
+                                                        uint64_t *accumulator,
+                                                        const c64 *fourier_bsk,
+                                                        size_t lut_count,
+                                                        size_t sample_stride,
+                                                        size_t decomposition_level_count,
+                                                        size_t decomposition_base_log,
+                                                        size_t glwe_dimension,
+                                                        size_t polynomial_size,
+                                                        size_t input_lwe_dimension,
+                                                        const struct Fft *fft,
+                                                        uint8_t *stack,
+                                                        size_t stack_size);
+
+ScratchStatus concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64_scratch(size_t *stack_size,
+                                                                         size_t *stack_align,
+                                                                         size_t glwe_dimension,
+                                                                         size_t polynomial_size,
+                                                                         const struct Fft *fft);
+
 void concrete_cpu_mul_cleartext_lwe_ciphertext_u64(uint64_t *ct_out,
                                                    const uint64_t *ct_in,
                                                    uint64_t cleartext,
@@ -381,6 +434,27 @@ size_t concrete_cpu_seeded_bootstrap_key_size_u64(size_t decomposition_level_cou
 size_t concrete_cpu_seeded_keyswitch_key_size_u64(size_t decomposition_level_count,
                                                   size_t input_dimension);
 
+void concrete_cpu_vertical_packing_lwe_ciphertext_u64(uint64_t *ct_out,
+                                                      const c64 *fourier_ggsw_list,
+                                                      const uint64_t *lut,
+                                                      size_t ggsw_count,
+                                                      size_t lut_size,
+                                                      size_t glwe_dimension,
+                                                      size_t polynomial_size,
+                                                      size_t decomposition_level_count,
+                                                      size_t decomposition_base_log,
+                                                      const struct Fft *fft,
+                                                      uint8_t *stack,
+                                                      size_t stack_size);
+
+ScratchStatus concrete_cpu_vertical_packing_lwe_ciphertext_u64_scratch(size_t *stack_size,
+                                                                       size_t *stack_align,
+                                                                       size_t ggsw_count,
+                                                                       size_t lut_size,
+                                                                       size_t glwe_dimension,
+                                                                       size_t polynomial_size,
+                                                                       const struct Fft *fft);
+
 void simulation_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64(const uint64_t *lwe_list_in,
                                                                               uint64_t *lwe_list_out,
                                                                               size_t ct_in_count,
@@ -413,6 +413,116 @@ pub unsafe extern "C" fn concrete_cpu_bootstrap_lwe_ciphertext_u64(
     })
 }
 
+#[no_mangle]
+#[must_use]
+pub unsafe extern "C" fn concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64_scratch(
+    stack_size: *mut usize,
+    stack_align: *mut usize,
+    // bootstrap parameters
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    // side resources
+    fft: *const Fft,
+) -> ScratchStatus {
+    nounwind(|| {
+        if let Ok(scratch) = blind_rotate_assign_mem_optimized_requirement::<u64>(
+            GlweDimension(glwe_dimension).to_glwe_size(),
+            PolynomialSize(polynomial_size),
+            (*fft).as_view(),
+        ) {
+            *stack_size = scratch.size_bytes();
+            *stack_align = scratch.align_bytes();
+            ScratchStatus::Valid
+        } else {
+            ScratchStatus::SizeOverflow
+        }
+    })
+}
+
+// Bootstraps `ct_in` with an accumulator packing several lookup tables, and extracts
+// `lut_count` ciphertexts from a single blind rotation. The i-th output ciphertext is the
+// sample extracted at the coefficient `i * sample_stride` of the rotated accumulator, which
+// is rotated in place.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64(
+    // ciphertexts
+    ct_out_vec: *mut u64,
+    ct_in: *const u64,
+    // accumulator
+    accumulator: *mut u64,
+    // bootstrap key
+    fourier_bsk: *const c64,
+    // many lut parameters
+    lut_count: usize,
+    sample_stride: usize,
+    // bootstrap parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    input_lwe_dimension: usize,
+    // side resources
+    fft: *const Fft,
+    stack: *mut u8,
+    stack_size: usize,
+) {
+    nounwind(|| {
+        assert!(lut_count == 0 || (lut_count - 1) * sample_stride < polynomial_size);
+
+        let output_lwe_size = glwe_dimension * polynomial_size + 1;
+
+        let fourier = FourierLweBootstrapKey::from_container(
+            slice::from_raw_parts(
+                fourier_bsk,
+                concrete_cpu_fourier_bootstrap_key_size_u64(
+                    decomposition_level_count,
+                    glwe_dimension,
+                    polynomial_size,
+                    input_lwe_dimension,
+                ),
+            ),
+            LweDimension(input_lwe_dimension),
+            GlweDimension(glwe_dimension).to_glwe_size(),
+            PolynomialSize(polynomial_size),
+            DecompositionBaseLog(decomposition_base_log),
+            DecompositionLevelCount(decomposition_level_count),
+        );
+
+        let lwe_in = LweCiphertext::from_container(
+            slice::from_raw_parts(ct_in, input_lwe_dimension + 1),
+            CiphertextModulus::new_native(),
+        );
+
+        let mut accumulator = GlweCiphertext::from_container(
+            slice::from_raw_parts_mut(
+                accumulator,
+                concrete_cpu_glwe_ciphertext_size_u64(glwe_dimension, polynomial_size),
+            ),
+            PolynomialSize(polynomial_size),
+            CiphertextModulus::new_native(),
+        );
+
+        blind_rotate_assign_mem_optimized(
+            &lwe_in,
+            &mut accumulator,
+            &fourier,
+            (*fft).as_view(),
+            PodStack::new(slice::from_raw_parts_mut(stack as _, stack_size)),
+        );
+
+        let ct_out_vec = slice::from_raw_parts_mut(ct_out_vec, lut_count * output_lwe_size);
+        for (i, ct_out) in ct_out_vec.chunks_exact_mut(output_lwe_size).enumerate() {
+            let mut lwe_out =
+                LweCiphertext::from_container(ct_out, CiphertextModulus::new_native());
+            extract_lwe_sample_from_glwe_ciphertext(
+                &accumulator,
+                &mut lwe_out,
+                MonomialDegree(i * sample_stride),
+            );
+        }
+    })
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_bootstrap_key_size_u64(
     decomposition_level_count: usize,
@@ -7,7 +7,12 @@ use crate::c_api::keyswitch::concrete_cpu_keyswitch_key_size_u64;
 use crate::c_api::types::*;
 use crate::c_api::utils::nounwind;
 use core::slice;
-use dyn_stack::PodStack;
+use dyn_stack::{PodStack, StackReq};
+use tfhe::core_crypto::fft_impl::fft64::crypto::ggsw::FourierGgswCiphertextList;
+use tfhe::core_crypto::fft_impl::fft64::crypto::wop_pbs::{
+    circuit_bootstrap_boolean, circuit_bootstrap_boolean_scratch, vertical_packing,
+    vertical_packing_scratch,
+};
 
 use super::secret_key::{
     concrete_cpu_glwe_secret_key_size_u64, concrete_cpu_lwe_secret_key_size_u64,
@@ -396,6 +401,293 @@ pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_vertical_packing
     })
 }
 
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_fourier_ggsw_ciphertext_size_u64(
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    decomposition_level_count: usize,
+) -> usize {
+    fourier_ggsw_ciphertext_size(
+        GlweDimension(glwe_dimension).to_glwe_size(),
+        PolynomialSize(polynomial_size).to_fourier_polynomial_size(),
+        DecompositionLevelCount(decomposition_level_count),
+    )
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64_scratch(
+    stack_size: *mut usize,
+    stack_align: *mut usize,
+    // ciphertext dimensions
+    ct_in_dimension: usize,
+    // bootstrap parameters
+    bsk_glwe_dimension: usize,
+    bsk_polynomial_size: usize,
+    // side resources
+    fft: *const Fft,
+) -> ScratchStatus {
+    nounwind(|| {
+        let bsk_output_lwe_dimension = bsk_glwe_dimension * bsk_polynomial_size;
+
+        let scratch = circuit_bootstrap_boolean_scratch::<u64>(
+            LweDimension(ct_in_dimension).to_lwe_size(),
+            LweDimension(bsk_output_lwe_dimension).to_lwe_size(),
+            GlweDimension(bsk_glwe_dimension).to_glwe_size(),
+            PolynomialSize(bsk_polynomial_size),
+            (*fft).as_view(),
+        )
+        .and_then(|cbs| {
+            StackReq::try_any_of([
+                cbs,
+                convert_standard_ggsw_ciphertext_to_fourier_mem_optimized_requirement(
+                    (*fft).as_view(),
+                )?,
+            ])
+        });
+
+        if let Ok(scratch) = scratch {
+            *stack_size = scratch.size_bytes();
+            *stack_align = scratch.align_bytes();
+            ScratchStatus::Valid
+        } else {
+            ScratchStatus::SizeOverflow
+        }
+    })
+}
+
+// Circuit bootstrap of a single boolean ciphertext into a fourier ggsw
+// ciphertext, to be given to the vertical packing of each lookup table.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64(
+    // ciphertexts
+    fourier_ggsw_out: *mut c64,
+    ct_in: *const u64,
+    // bootstrap key
+    fourier_bsk: *const c64,
+    // packing keyswitch key
+    fpksk: *const u64,
+    // ciphertext dimensions
+    ct_in_dimension: usize,
+    // bootstrap parameters
+    bsk_decomposition_level_count: usize,
+    bsk_decomposition_base_log: usize,
+    bsk_glwe_dimension: usize,
+    bsk_polynomial_size: usize,
+    bsk_input_lwe_dimension: usize,
+    // keyswitch_parameters
+    fpksk_decomposition_level_count: usize,
+    fpksk_decomposition_base_log: usize,
+    fpksk_input_dimension: usize,
+    fpksk_output_glwe_dimension: usize,
+    fpksk_output_polynomial_size: usize,
+    // circuit bootstrap parameters
+    cbs_decomposition_level_count: usize,
+    cbs_decomposition_base_log: usize,
+    // side resources
+    fft: *const Fft,
+    stack: *mut u8,
+    stack_size: usize,
+) {
+    nounwind(|| {
+        let bsk_output_lwe_dimension = bsk_glwe_dimension * bsk_polynomial_size;
+        assert_eq!(bsk_output_lwe_dimension, fpksk_input_dimension);
+        assert_eq!(ct_in_dimension, bsk_input_lwe_dimension);
+
+        assert_ne!(cbs_decomposition_base_log, 0);
+        assert_ne!(cbs_decomposition_level_count, 0);
+        assert!(cbs_decomposition_level_count * cbs_decomposition_base_log <= 64);
+
+        let fourier_bsk = FourierLweBootstrapKey::from_container(
+            slice::from_raw_parts(
+                fourier_bsk,
+                concrete_cpu_fourier_bootstrap_key_size_u64(
+                    bsk_decomposition_level_count,
+                    bsk_glwe_dimension,
+                    bsk_polynomial_size,
+                    bsk_input_lwe_dimension,
+                ),
+            ),
+            LweDimension(bsk_input_lwe_dimension),
+            GlweDimension(bsk_glwe_dimension).to_glwe_size(),
+            PolynomialSize(bsk_polynomial_size),
+            DecompositionBaseLog(bsk_decomposition_base_log),
+            DecompositionLevelCount(bsk_decomposition_level_count),
+        );
+
+        let lwe_in = LweCiphertext::from_container(
+            slice::from_raw_parts(ct_in, ct_in_dimension + 1),
+            CiphertextModulus::new_native(),
+        );
+
+        let fpksk_list = LwePrivateFunctionalPackingKeyswitchKeyList::from_container(
+            slice::from_raw_parts(
+                fpksk,
+                concrete_cpu_lwe_packing_keyswitch_key_size(
+                    fpksk_output_glwe_dimension,
+                    fpksk_output_polynomial_size,
+                    fpksk_decomposition_level_count,
+                    fpksk_input_dimension,
+                ) * (fpksk_output_glwe_dimension + 1),
+            ),
+            DecompositionBaseLog(fpksk_decomposition_base_log),
+            DecompositionLevelCount(fpksk_decomposition_level_count),
+            LweDimension(fpksk_input_dimension).to_lwe_size(),
+            GlweDimension(fpksk_output_glwe_dimension).to_glwe_size(),
+            PolynomialSize(fpksk_output_polynomial_size),
+            CiphertextModulus::new_native(),
+        );
+
+        let glwe_size = GlweDimension(fpksk_output_glwe_dimension).to_glwe_size();
+        let polynomial_size = PolynomialSize(fpksk_output_polynomial_size);
+        let base_log = DecompositionBaseLog(cbs_decomposition_base_log);
+        let level_count = DecompositionLevelCount(cbs_decomposition_level_count);
+
+        let mut ggsw = GgswCiphertext::new(
+            0_u64,
+            glwe_size,
+            polynomial_size,
+            base_log,
+            level_count,
+            CiphertextModulus::new_native(),
+        );
+
+        let mut fourier_ggsw = FourierGgswCiphertext::from_container(
+            slice::from_raw_parts_mut(
+                fourier_ggsw_out,
+                concrete_cpu_fourier_ggsw_ciphertext_size_u64(
+                    fpksk_output_glwe_dimension,
+                    fpksk_output_polynomial_size,
+                    cbs_decomposition_level_count,
+                ),
+            ),
+            glwe_size,
+            polynomial_size,
+            base_log,
+            level_count,
+        );
+
+        let mut stack = PodStack::new(slice::from_raw_parts_mut(stack as _, stack_size));
+
+        circuit_bootstrap_boolean(
+            fourier_bsk.as_view(),
+            lwe_in.as_view(),
+            ggsw.as_mut_view(),
+            DeltaLog(u64::BITS as usize - 1),
+            fpksk_list.as_view(),
+            (*fft).as_view(),
+            stack.rb_mut(),
+        );
+
+        convert_standard_ggsw_ciphertext_to_fourier_mem_optimized(
+            &ggsw,
+            &mut fourier_ggsw,
+            (*fft).as_view(),
+            stack,
+        );
+    })
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_vertical_packing_lwe_ciphertext_u64_scratch(
+    stack_size: *mut usize,
+    stack_align: *mut usize,
+    // ciphertext dimensions
+    ggsw_count: usize,
+    lut_size: usize,
+    // ggsw parameters
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    // side resources
+    fft: *const Fft,
+) -> ScratchStatus {
+    nounwind(|| {
+        assert_eq!(lut_size, 1 << ggsw_count);
+
+        let lut_polynomial_count = lut_size.max(polynomial_size) / polynomial_size;
+
+        if let Ok(scratch) = vertical_packing_scratch::<u64>(
+            GlweDimension(glwe_dimension).to_glwe_size(),
+            PolynomialSize(polynomial_size),
+            PolynomialCount(lut_polynomial_count),
+            ggsw_count,
+            (*fft).as_view(),
+        ) {
+            *stack_size = scratch.size_bytes();
+            *stack_align = scratch.align_bytes();
+            ScratchStatus::Valid
+        } else {
+            ScratchStatus::SizeOverflow
+        }
+    })
+}
+
+// Vertical packing of a single lookup table, indexed by the fourier ggsw
+// ciphertexts of the circuit bootstrapped bits, most significant bit first.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_vertical_packing_lwe_ciphertext_u64(
+    // ciphertexts
+    ct_out: *mut u64,
+    fourier_ggsw_list: *const c64,
+    // lookup table
+    lut: *const u64,
+    // ciphertext dimensions
+    ggsw_count: usize,
+    lut_size: usize,
+    // ggsw parameters
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    // side resources
+    fft: *const Fft,
+    stack: *mut u8,
+    stack_size: usize,
+) {
+    nounwind(|| {
+        assert_eq!(lut_size, 1 << ggsw_count);
+
+        let mut lut_container = slice::from_raw_parts(lut, lut_size);
+        let mut expanded_lut: Vec<u64> = vec![0_u64; polynomial_size];
+
+        if lut_size < polynomial_size {
+            expanded_lut[..lut_size].copy_from_slice(lut_container);
+            lut_container = expanded_lut.as_slice();
+        }
+
+        let lut = PolynomialList::from_container(lut_container, PolynomialSize(polynomial_size));
+
+        let ggsw_list = FourierGgswCiphertextList::new(
+            slice::from_raw_parts(
+                fourier_ggsw_list,
+                ggsw_count
+                    * concrete_cpu_fourier_ggsw_ciphertext_size_u64(
+                        glwe_dimension,
+                        polynomial_size,
+                        decomposition_level_count,
+                    ),
+            ),
+            ggsw_count,
+            GlweDimension(glwe_dimension).to_glwe_size(),
+            PolynomialSize(polynomial_size),
+            DecompositionBaseLog(decomposition_base_log),
+            DecompositionLevelCount(decomposition_level_count),
+        );
+
+        let mut lwe_out = LweCiphertext::from_container(
+            slice::from_raw_parts_mut(ct_out, glwe_dimension * polynomial_size + 1),
+            CiphertextModulus::new_native(),
+        );
+
+        vertical_packing(
+            lut.as_view(),
+            lwe_out.as_mut_view(),
+            ggsw_list.as_view(),
+            (*fft).as_view(),
+            PodStack::new(slice::from_raw_parts_mut(stack as _, stack_size)),
+        );
+    })
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_lwe_packing_keyswitch_key_size(
     output_glwe_dimension: usize,
@@ -711,15 +711,129 @@ template <int operandIdx, int resultIdx>
 using SameOperandAndResultElementTypeConstraint = SameElementTypeConstraint<
     OperandAndResultValueYield<operandIdx, resultIdx>>;
 
+// Constraint that ensures that all values of an equivalence class
+// have the same type. The classes are built with `unite()` on a
+// union-find structure, such that an arbitrary number of values can
+// be constrained by a single constraint applied in a single pass over
+// the values. This is preferable to one `DynamicSameTypeConstraint`
+// per pair of values for operations related to many values (e.g.,
+// `tensor.from_elements` with thousands of operands).
+//
+// Within a class, precedence is given to fixed types, then to the
+// type inferred for the value that was added first to the
+// constraint. If two values of a class have different, fixed types,
+// an assertion is triggered.
+class SameTypeClassesConstraint : public TypeConstraint {
+public:
+  // Puts `a` and `b` in the same equivalence class
+  void unite(mlir::Value a, mlir::Value b) {
+    unsigned rootA = findRoot(getOrCreateIndex(a));
+    unsigned rootB = findRoot(getOrCreateIndex(b));
+
+    if (rootA == rootB)
+      return;
+
+    // Union by size, the root of a class has no influence on the
+    // precedence of its types
+    if (sizes[rootA] < sizes[rootB])
+      std::swap(rootA, rootB);
+
+    parents[rootB] = rootA;
+    sizes[rootA] += sizes[rootB];
+  }
+
+  // Puts all values of `values` in the same equivalence class
+  void uniteAll(mlir::ValueRange values) {
+    if (values.empty())
+      return;
+
+    getOrCreateIndex(values.front());
+
+    for (mlir::Value v : values.drop_front())
+      unite(values.front(), v);
+  }
+
+  void apply(mlir::Operation *op, TypeResolver &resolver,
+             LocalInferenceState &currState,
+             const LocalInferenceState &prevState) override {
+    // Type of each class, indexed by the index of its root
+    llvm::SmallVector<InferredType> classTypes(values.size());
+    llvm::SmallVector<bool> classTypeIsFixed(values.size(), false);
+
+    for (auto [idx, v] : llvm::enumerate(values)) {
+      unsigned root = findRoot(idx);
+
+      if (!resolver.isUnresolvedType(v.getType())) {
+        assert((!classTypeIsFixed[root] ||
+                classTypes[root].getType() == v.getType()) &&
+               "Constraint cannot be matched, as values have different, "
+               "fixed types");
+
+        classTypes[root] = v.getType();
+        classTypeIsFixed[root] = true;
+      } else if (!classTypes[root].hasType()) {
+        classTypes[root] =
+            getFirstTypeInOrder(resolver, currState, prevState, v);
+      }
+    }
+
+    for (auto [idx, v] : llvm::enumerate(values)) {
+      InferredType t = classTypes[findRoot(idx)];
+
+      if (t.hasType())
+        currState.set(v, t);
+    }
+  }
+
+protected:
+  unsigned getOrCreateIndex(mlir::Value v) {
+    auto [it, inserted] = indexes.try_emplace(v, values.size());
+
+    if (inserted) {
+      values.push_back(v);
+      parents.push_back(it->second);
+      sizes.push_back(1);
+    }
+
+    return it->second;
+  }
+
+  // Returns the root of the class of the value with the index `idx`
+  // and compresses the path from the value to the root
+  unsigned findRoot(unsigned idx) {
+    unsigned root = idx;
+
+    while (parents[root] != root)
+      root = parents[root];
+
+    while (parents[idx] != root) {
+      unsigned next = parents[idx];
+      parents[idx] = root;
+      idx = next;
+    }
+
+    return root;
+  }
+
+  // Values in order of their addition to the constraint
+  llvm::SmallVector<mlir::Value> values;
+  llvm::DenseMap<mlir::Value, unsigned> indexes;
+  llvm::SmallVector<unsigned> parents;
+  llvm::SmallVector<unsigned> sizes;
+};
+
 namespace {
 namespace impl {
 // Specialization needs to happen at namespace scope
 template <typename ConstraintT, typename... ArgTs>
-void addConstraint(std::vector<std::unique_ptr<TypeConstraint>> &constraints,
-                   ArgTs &&...args) {
-  std::unique_ptr<TypeConstraint> constraint =
+ConstraintT &
+addConstraint(std::vector<std::unique_ptr<TypeConstraint>> &constraints,
+              ArgTs &&...args) {
+  std::unique_ptr<ConstraintT> constraint =
       std::make_unique<ConstraintT>(std::forward<ArgTs>(args)...);
+  ConstraintT &ref = *constraint;
   constraints.push_back(std::move(constraint));
+  return ref;
 }
 
 template <typename ConstraintT, typename... ArgTs>
@@ -749,11 +863,12 @@ public:
   TypeConstraintSet() {}
 
   // Instantiates a constraint of the type `ConstraintT` with the
-  // arguments `args` and adds the constraint to the set
+  // arguments `args`, adds the constraint to the set and returns a
+  // reference to the new constraint
   template <typename ConstraintT, typename... ArgTs>
-  void addConstraint(ArgTs &&...args) {
-    impl::addConstraint<ConstraintT, ArgTs...>(constraints,
-                                               std::forward<ArgTs>(args)...);
+  ConstraintT &addConstraint(ArgTs &&...args) {
+    return impl::addConstraint<ConstraintT, ArgTs...>(
+        constraints, std::forward<ArgTs>(args)...);
   }
 
   // Instantiates the constraints of types specified by `ConstraintTs` with the
@@ -0,0 +1,91 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_COMMON_HUGEPAGES_H
+#define CONCRETELANG_COMMON_HUGEPAGES_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace concretelang {
+namespace hugepages {
+
+/// The pages backing the buffers allocated above the threshold.
+enum class Mode {
+  /// The pages of the default allocator.
+  NONE,
+  /// Anonymous mappings advised to be backed by transparent huge pages.
+  TRANSPARENT,
+  /// Explicit huge pages of the hugetlb pool, or transparent huge pages when
+  /// the pool cannot satisfy the allocation.
+  EXPLICIT,
+};
+
+/// Returns the mode, read on first use from the `CONCRETE_HUGE_PAGES`
+/// environment variable (`none`, `transparent` or `explicit`),
+/// `transparent` by default.
+Mode getMode();
+
+/// Sets the mode of the next allocations.
+void setMode(Mode mode);
+
+/// Returns the size in bytes from which the buffers are allocated on huge
+/// pages, read on first use from the `CONCRETE_HUGE_PAGES_THRESHOLD`
+/// environment variable, 2MiB by default.
+size_t getThreshold();
+
+/// Sets the threshold of the next allocations.
+void setThreshold(size_t threshold);
+
+/// Allocates `size` bytes aligned on 64 bytes, backed by huge pages
+/// according to the mode if `size` reaches the threshold. Returns nullptr if
+/// the memory is exhausted.
+void *allocate(size_t size);
+
+/// Frees a buffer returned by `allocate`, whatever the mode it has been
+/// allocated with.
+void deallocate(void *ptr);
+
+/// A standard allocator on `allocate`, for the containers of the evaluation
+/// keys which are streamed by every keyswitch or bootstrap.
+template <typename T> struct Allocator {
+  typedef T value_type;
+
+  Allocator() = default;
+  template <typename U> Allocator(const Allocator<U> &) {}
+
+  T *allocate(size_t n) {
+    auto ptr = (T *)hugepages::allocate(n * sizeof(T));
+    if (ptr == nullptr) {
+#if __cpp_exceptions
+      throw std::bad_alloc();
+#else
+      abort();
+#endif
+    }
+    return ptr;
+  }
+
+  void deallocate(T *ptr, size_t) { hugepages::deallocate(ptr); }
+};
+
+template <typename T, typename U>
+bool operator==(const Allocator<T> &, const Allocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const Allocator<T> &, const Allocator<U> &) {
+  return false;
+}
+
+template <typename T> using Vector = std::vector<T, Allocator<T>>;
+
+} // namespace hugepages
+} // namespace concretelang
+
+#endif
@@ -6,9 +6,13 @@
 #ifndef CONCRETELANG_COMMON_KEYS_H
 #define CONCRETELANG_COMMON_KEYS_H
 
+#include "concrete-cpu.h"
 #include "concrete-protocol.capnp.h"
 #include "concretelang/Common/Csprng.h"
+#include "concretelang/Common/HugePages.h"
 #include "concretelang/Common/Protocol.h"
+#include <atomic>
+#include <complex>
 #include <memory>
 #include <mutex>
 #include <stdlib.h>
@@ -75,6 +79,10 @@ private:
 class LweBootstrapKey {
 public:
   typedef Message<concreteprotocol::LweBootstrapKeyInfo> InfoType;
+  typedef std::vector<uint64_t> BufferType;
+  /// The key in the fourier domain, streamed by every bootstrap, is stored on
+  /// huge pages.
+  typedef hugepages::Vector<std::complex<double>> FourierBufferType;
 
   /// @brief Constructor of a bootstrap key that initialize according with the
   /// given specification.
@@ -88,8 +96,9 @@ public:
   LweBootstrapKey(std::shared_ptr<std::vector<uint64_t>> buffer,
                   Message<concreteprotocol::LweBootstrapKeyInfo> info)
       : seededBuffer(std::make_shared<std::vector<uint64_t>>()), buffer(buffer),
-        info(info), decompress_mutext(std::make_shared<std::mutex>()),
-        decompressed(false){};
+        fourierBuffer(std::make_shared<FourierBufferType>()),
+        info(info), decompress_mutext(std::make_shared<std::recursive_mutex>()),
+        decompressed(std::make_shared<std::atomic<bool>>(false)){};
 
   /// @brief Initialize the key from the protocol message.
   static LweBootstrapKey
@@ -104,14 +113,25 @@ public:
 
   const std::vector<uint64_t> &getTransportBuffer() const;
 
-  void decompress();
+  void decompress(Parallelism parallelism = Parallelism::Rayon);
+
+  /// @brief Converts the key to the fourier domain with `parallelism`
+  /// threads, each converting a range of the GGSW ciphertexts of the key. The
+  /// decompressed buffer of a seeded key is released once converted, and
+  /// decompressed again if it is needed later on.
+  void convertToFourier(size_t parallelism);
+
+  /// @brief Returns the key converted by `convertToFourier`, or nullptr if it
+  /// has not been converted.
+  std::shared_ptr<FourierBufferType> getFourierBuffer() const;
 
 private:
   LweBootstrapKey(Message<concreteprotocol::LweBootstrapKeyInfo> info)
       : seededBuffer(std::make_shared<std::vector<uint64_t>>()),
-        buffer(std::make_shared<std::vector<uint64_t>>()), info(info),
-        decompress_mutext(std::make_shared<std::mutex>()),
-        decompressed(false){};
+        buffer(std::make_shared<std::vector<uint64_t>>()),
+        fourierBuffer(std::make_shared<FourierBufferType>()),
+        info(info), decompress_mutext(std::make_shared<std::recursive_mutex>()),
+        decompressed(std::make_shared<std::atomic<bool>>(false)){};
   LweBootstrapKey() = delete;
 
   /// @brief  The buffer of the seeded key if needed.
@@ -120,28 +140,35 @@ private:
   /// @brief The buffer of the actual bootstrap key.
   std::shared_ptr<std::vector<uint64_t>> buffer;
 
+  /// @brief The buffer of the key in the fourier domain, empty if not
+  /// converted.
+  std::shared_ptr<FourierBufferType> fourierBuffer;
+
   /// @brief The metadata of the bootrap key.
   Message<concreteprotocol::LweBootstrapKeyInfo> info;
 
-  /// @brief Mutex to guard the decompression
-  std::shared_ptr<std::mutex> decompress_mutext;
+  /// @brief Mutex to guard the decompression and the conversion
+  std::shared_ptr<std::recursive_mutex> decompress_mutext;
 
-  /// @brief A boolean that indicates if the decompression is done or not
-  bool decompressed;
+  /// @brief A boolean that indicates if the decompression is done or not,
+  /// shared by the copies of the key as they share the buffers
+  std::shared_ptr<std::atomic<bool>> decompressed;
 };
 
 class LweKeyswitchKey {
 public:
   typedef Message<concreteprotocol::LweKeyswitchKeyInfo> InfoType;
+  /// The key, streamed by every keyswitch, is stored on huge pages.
+  typedef hugepages::Vector<uint64_t> BufferType;
 
   LweKeyswitchKey(Message<concreteprotocol::LweKeyswitchKeyInfo> info,
                   const LweSecretKey &inputKey, const LweSecretKey &outputKey,
                   concretelang::csprng::EncryptionCSPRNG &csprng);
-  LweKeyswitchKey(std::shared_ptr<std::vector<uint64_t>> buffer,
+  LweKeyswitchKey(std::shared_ptr<BufferType> buffer,
                   Message<concreteprotocol::LweKeyswitchKeyInfo> info)
-      : seededBuffer(std::make_shared<std::vector<uint64_t>>()), buffer(buffer),
+      : seededBuffer(std::make_shared<BufferType>()), buffer(buffer),
         info(info), decompress_mutext(std::make_shared<std::mutex>()),
-        decompressed(false){};
+        decompressed(std::make_shared<std::atomic<bool>>(false)){};
 
   /// @brief Initialize the key from the protocol message.
   static LweKeyswitchKey
@@ -152,24 +179,24 @@ public:
 
   const Message<concreteprotocol::LweKeyswitchKeyInfo> &getInfo() const;
 
-  const std::vector<uint64_t> &getBuffer();
+  const BufferType &getBuffer();
 
-  const std::vector<uint64_t> &getTransportBuffer() const;
+  const BufferType &getTransportBuffer() const;
 
-  void decompress();
+  void decompress(Parallelism parallelism = Parallelism::Rayon);
 
 private:
   LweKeyswitchKey(Message<concreteprotocol::LweKeyswitchKeyInfo> info)
-      : seededBuffer(std::make_shared<std::vector<uint64_t>>()),
-        buffer(std::make_shared<std::vector<uint64_t>>()), info(info),
+      : seededBuffer(std::make_shared<BufferType>()),
+        buffer(std::make_shared<BufferType>()), info(info),
         decompress_mutext(std::make_shared<std::mutex>()),
-        decompressed(false){};
+        decompressed(std::make_shared<std::atomic<bool>>(false)){};
 
   /// @brief  The buffer of the seeded key if needed.
-  std::shared_ptr<std::vector<uint64_t>> seededBuffer;
+  std::shared_ptr<BufferType> seededBuffer;
 
   /// @brief The buffer of the actual bootstrap key.
-  std::shared_ptr<std::vector<uint64_t>> buffer;
+  std::shared_ptr<BufferType> buffer;
 
   /// @brief The metadata of the bootrap key.
   Message<concreteprotocol::LweKeyswitchKeyInfo> info;
@@ -177,8 +204,9 @@ private:
   /// @brief Mutex to guard the decompression
   std::shared_ptr<std::mutex> decompress_mutext;
 
-  /// @brief A boolean that indicates if the decompression is done or not
-  bool decompressed;
+  /// @brief A boolean that indicates if the decompression is done or not,
+  /// shared by the copies of the key as they share the buffers
+  std::shared_ptr<std::atomic<bool>> decompressed;
 };
 
 class PackingKeyswitchKey {
@@ -186,6 +214,7 @@ class PackingKeyswitchKey {
 
 public:
   typedef Message<concreteprotocol::PackingKeyswitchKeyInfo> InfoType;
+  typedef std::vector<uint64_t> BufferType;
 
   PackingKeyswitchKey(Message<concreteprotocol::PackingKeyswitchKeyInfo> info,
                       const LweSecretKey &inputKey,
@@ -43,6 +43,15 @@ struct ServerKeyset {
   fromProto(const Message<concreteprotocol::ServerKeyset> &proto);
 
   Message<concreteprotocol::ServerKeyset> toProto() const;
+
+  /// Decompresses the seeded keys and converts the bootstrap keys to the
+  /// fourier domain ahead of the first circuit call, using `parallelism`
+  /// threads (0 uses all hardware threads). The keyswitch keys are
+  /// decompressed concurrently. The bootstrap keys are decompressed and
+  /// converted one at a time, such that at most one decompressed bootstrap
+  /// key is in memory at once. The copies of the keyset share the prepared
+  /// keys. Must not be called concurrently with a circuit call.
+  void prepare(size_t parallelism = 0);
 };
 
 struct Keyset {
@@ -0,0 +1,46 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_COMMON_LOOKUPTABLE_H_
+#define CONCRETELANG_COMMON_LOOKUPTABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace concretelang {
+namespace lut {
+
+/// Encode and expand a lookup table so that it can be used as the
+/// accumulator of a bootstrap.
+///
+/// \param output The expanded lookup table, of `outputSize` (the polynomial
+/// size) elements
+/// \param input The lookup table to encode, of `inputSize` elements
+/// \param outputBits The number of bits of the message in the output
+/// \param isSigned Whether the bootstrap is applied on signed integers
+void encodeExpandLutForBootstrap(uint64_t *output, size_t outputSize,
+                                 const uint64_t *input, size_t inputSize,
+                                 uint32_t outputBits, bool isSigned);
+
+/// Encode a lookup table so that it can be used by a wop pbs on a crt
+/// encoded integer.
+///
+/// \param output The encoded lookup table, a row-major matrix of `crtSize`
+/// rows of `outputSize1` elements
+/// \param input The lookup table to encode, of `inputSize` elements
+/// \param crtDecomposition The `crtSize` moduli of the crt decomposition
+/// \param crtBits The number of bits of each modulus of the decomposition
+/// \param modulusProduct The product of the moduli
+/// \param isSigned Whether the wop pbs is applied on signed integers
+void encodeLutForCrtWopPBS(uint64_t *output, size_t outputSize1,
+                           const uint64_t *input, size_t inputSize,
+                           const uint64_t *crtDecomposition,
+                           const uint64_t *crtBits, size_t crtSize,
+                           uint64_t modulusProduct, bool isSigned);
+
+} // namespace lut
+} // namespace concretelang
+
+#endif
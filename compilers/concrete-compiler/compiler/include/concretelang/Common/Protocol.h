@@ -258,9 +258,9 @@ template struct Message<concreteprotocol::Value>;
 template struct Message<concreteprotocol::GateInfo>;
 
 /// Helper function turning a vector of integers to a payload.
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 Message<concreteprotocol::Payload>
-vectorToProtoPayload(const std::vector<T> &input) {
+vectorToProtoPayload(const std::vector<T, Allocator> &input) {
   auto output = Message<concreteprotocol::Payload>();
   auto elmsPerBlob = capnp::MAX_TEXT_SIZE / sizeof(T);
   auto remainingElms = input.size() % elmsPerBlob;
@@ -315,9 +315,9 @@ protoPayloadToVector(const Message<concreteprotocol::Payload> &input) {
 }
 
 /// Helper function turning a payload to a shared vector of integers on the
-/// heap.
-template <typename T>
-std::shared_ptr<std::vector<T>>
+/// heap, allocated with `Allocator`.
+template <typename T, typename Allocator = std::allocator<T>>
+std::shared_ptr<std::vector<T, Allocator>>
 protoPayloadToSharedVector(const Message<concreteprotocol::Payload> &input) {
   auto payloadData = input.asReader().getData();
   size_t elmsPerBlob = capnp::MAX_TEXT_SIZE / sizeof(T);
@@ -327,7 +327,7 @@ protoPayloadToSharedVector(const Message<concreteprotocol::Payload> &input) {
   }
   assert(totalPayloadSize % sizeof(T) == 0);
   size_t dataSize = totalPayloadSize / sizeof(T);
-  auto output = std::make_shared<std::vector<T>>();
+  auto output = std::make_shared<std::vector<T, Allocator>>();
   output->resize(dataSize);
   for (size_t blobIndex = 0; blobIndex < payloadData.size(); blobIndex++) {
     auto blobData = payloadData[blobIndex];
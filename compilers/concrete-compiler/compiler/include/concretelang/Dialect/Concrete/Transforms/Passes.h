@@ -6,14 +6,25 @@
 #ifndef CONCRETELANG_DIALECT_CONCRETE_TRANSFORMS_PASSES_H_
 #define CONCRETELANG_DIALECT_CONCRETE_TRANSFORMS_PASSES_H_
 
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/OpenMP/OpenMPDialect.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Pass/Pass.h"
 
+#include "concretelang/Dialect/RT/IR/RTDialect.h"
+
 #define GEN_PASS_CLASSES
 #include "concretelang/Dialect/Concrete/Transforms/Passes.h.inc"
 
 namespace mlir {
 namespace concretelang {
 std::unique_ptr<OperationPass<ModuleOp>> createAddRuntimeContext();
+std::unique_ptr<OperationPass<mlir::func::FuncOp>>
+createConcreteKeyswitchBootstrapFusionPass();
+std::unique_ptr<OperationPass<ModuleOp>> createAsyncOffloadPass();
+std::unique_ptr<OperationPass<ModuleOp>> createConcreteSCFToOpenMPPass();
 } // namespace concretelang
 } // namespace mlir
 
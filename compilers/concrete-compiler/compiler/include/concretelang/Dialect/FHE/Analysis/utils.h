@@ -8,6 +8,7 @@
 
 #include <mlir/Dialect/Linalg/IR/Linalg.h>
 #include <mlir/IR/BuiltinOps.h>
+#include <optional>
 
 namespace mlir {
 namespace concretelang {
@@ -17,6 +18,24 @@ namespace utils {
 bool isEncryptedValue(mlir::Value value);
 unsigned int getEintPrecision(mlir::Value value);
 
+/// \brief Returns the power of two by which a ciphertext must be multiplied to
+/// move a value encoded with `fromWidth` bits to the encoding with `toWidth`
+/// bits, or std::nullopt if this needs a bootstrap.
+///
+/// The value being encoded right after the padding bit, it can only be moved
+/// to a more significant position, i.e. to a smaller width, with leveled
+/// operations. The value is assumed to fit in both widths.
+///
+/// \param fromWidth
+/// \param toWidth
+/// \return std::optional<unsigned>
+inline std::optional<unsigned> getLeveledCastShift(unsigned fromWidth,
+                                                   unsigned toWidth) {
+  if (toWidth > fromWidth)
+    return std::nullopt;
+  return fromWidth - toWidth;
+}
+
 /// \brief Returns the loop range on a linalg.genric operation.
 ///
 /// \param op
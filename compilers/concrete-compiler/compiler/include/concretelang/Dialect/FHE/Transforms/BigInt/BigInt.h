@@ -16,7 +16,8 @@ namespace mlir {
 namespace concretelang {
 
 std::unique_ptr<mlir::OperationPass<>>
-createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth);
+createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth,
+                             bool carryLookahead = false);
 
 } // namespace concretelang
 } // namespace mlir
@@ -7,7 +7,11 @@
 #define CONCRETELANG_FHE_ENCRYPTED_MUL_TO_DOUBLE_TLU_PASS_H
 
 #include <concretelang/Dialect/FHE/IR/FHEDialect.h>
+#include <concretelang/Dialect/FHELinalg/IR/FHELinalgDialect.h>
+#include <concretelang/Support/V0Parameters.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Tensor/IR/Tensor.h>
 #include <mlir/Pass/Pass.h>
 
 #define GEN_PASS_CLASSES
@@ -18,6 +22,11 @@ namespace mlir {
 namespace concretelang {
 std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
 createEncryptedMulToDoubleTLUPass();
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createEncryptedMulToPackedTLUPass(
+    optimizer::Config config = optimizer::DEFAULT_CONFIG,
+    bool alwaysPack = false);
 } // namespace concretelang
 } // namespace mlir
 
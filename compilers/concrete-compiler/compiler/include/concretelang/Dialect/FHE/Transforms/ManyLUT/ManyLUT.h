@@ -0,0 +1,31 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_FHE_MANY_LUT_PASS_H
+#define CONCRETELANG_FHE_MANY_LUT_PASS_H
+
+#include <concretelang/Dialect/FHE/IR/FHEDialect.h>
+#include <concretelang/Dialect/FHELinalg/IR/FHELinalgDialect.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Linalg/IR/Linalg.h>
+#include <mlir/Pass/Pass.h>
+
+#define GEN_PASS_CLASSES
+#include <concretelang/Dialect/FHE/Transforms/ManyLUT/ManyLUT.h.inc>
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createFHEManyLUTGroupingPass(unsigned int maxLUTCount = 4);
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createFHEManyLUTFusionPass();
+
+} // namespace concretelang
+} // namespace mlir
+
+#endif
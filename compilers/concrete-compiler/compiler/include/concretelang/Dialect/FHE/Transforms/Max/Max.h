@@ -16,6 +16,7 @@ namespace mlir {
 namespace concretelang {
 
 std::unique_ptr<mlir::OperationPass<>> createFHEMaxTransformPass();
+std::unique_ptr<mlir::OperationPass<>> createFHEBalanceMaxPass();
 
 } // namespace concretelang
 } // namespace mlir
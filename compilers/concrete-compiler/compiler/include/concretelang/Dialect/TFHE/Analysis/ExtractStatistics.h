@@ -16,6 +16,9 @@ namespace concretelang {
 
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
 createStatisticExtractionPass(ProgramCompilationFeedback &feedback);
+
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createParallelBandExtractionPass(ProgramCompilationFeedback &feedback);
 } // namespace concretelang
 } // namespace mlir
 
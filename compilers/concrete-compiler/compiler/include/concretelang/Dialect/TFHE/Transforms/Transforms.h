@@ -8,7 +8,11 @@
 
 #include "concrete-optimizer.hpp"
 #include "concretelang/Dialect/TFHE/IR/TFHEDialect.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/Pass/Pass.h"
+#include <limits>
 
 #define GEN_PASS_CLASSES
 #include "concretelang/Dialect/TFHE/Transforms/Transforms.h.inc"
@@ -19,6 +23,17 @@ std::unique_ptr<mlir::OperationPass<>> createTFHEOptimizationPass();
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
     createTFHECircuitSolutionParametrizationPass(
         std::optional<concrete_optimizer::dag::CircuitSolution>);
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createTFHELUTEncodingFoldingPass();
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createTFHEManyLUTPackingPass();
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createTFHEPBSDeduplicationPass();
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createTFHEKeyswitchSharingPass();
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createTFHEWavefrontBatchingPass(
+    int64_t maxBatchSize = std::numeric_limits<int64_t>::max());
 } // namespace concretelang
 } // namespace mlir
 
@@ -73,10 +73,10 @@ typedef struct RuntimeContext {
 
 protected:
   ServerKeyset serverKeyset;
-  std::vector<std::shared_ptr<std::vector<std::complex<double>>>>
+  std::vector<std::shared_ptr<LweBootstrapKey::FourierBufferType>>
       fourier_bootstrap_keys;
   std::vector<FFT> ffts;
-  std::pair<FFT, std::shared_ptr<std::vector<std::complex<double>>>>
+  std::pair<FFT, std::shared_ptr<LweBootstrapKey::FourierBufferType>>
   convert_to_fourier_domain(LweBootstrapKey &bsk);
 
 #ifdef CONCRETELANG_CUDA_SUPPORT
@@ -161,7 +161,7 @@ private:
   void getBSKonNode(size_t keyId);
   std::mutex cm_guard;
   std::map<size_t, LweKeyswitchKey> ksks;
-  std::map<size_t, std::shared_ptr<std::vector<std::complex<double>>>> fbks;
+  std::map<size_t, std::shared_ptr<LweBootstrapKey::FourierBufferType>> fbks;
   std::map<size_t, FFT> dffts;
   std::map<size_t, PackingKeyswitchKey> pksks;
 };
@@ -77,7 +77,7 @@ template <typename LweKeyType> struct KeyWrapper {
       assert(info.readBinaryFromString(info_string).has_value());
       size_t key_size;
       ar >> key_size;
-      auto buffer = std::make_shared<std::vector<uint64_t>>();
+      auto buffer = std::make_shared<typename LweKeyType::BufferType>();
       buffer->resize(key_size);
       ar >> hpx::serialization::make_array(buffer->data(), key_size);
       keys.push_back(LweKeyType(buffer, info));
@@ -146,7 +146,9 @@ void *memref_keyswitch_async_lwe_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
     uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
-    uint64_t ct0_stride, mlir::concretelang::RuntimeContext *context);
+    uint64_t ct0_stride, uint32_t level, uint32_t base_log,
+    uint32_t input_lwe_dim, uint32_t output_lwe_dim, uint32_t ksk_index,
+    mlir::concretelang::RuntimeContext *context);
 
 void memref_bootstrap_lwe_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
@@ -181,6 +183,41 @@ void memref_batched_mapped_bootstrap_lwe_u64(
     uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context);
 
+void memref_many_lut_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size, uint64_t ct0_stride,
+    uint64_t *tlu_allocated, uint64_t *tlu_aligned, uint64_t tlu_offset,
+    uint64_t tlu_size, uint64_t tlu_stride, uint32_t input_lwe_dim,
+    uint32_t poly_size, uint32_t level, uint32_t base_log, uint32_t glwe_dim,
+    uint32_t bsk_index, uint32_t sample_stride,
+    mlir::concretelang::RuntimeContext *context);
+
+void memref_keyswitch_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t *tlu_allocated, uint64_t *tlu_aligned,
+    uint64_t tlu_offset, uint64_t tlu_size, uint64_t tlu_stride,
+    uint32_t ksk_level, uint32_t ksk_base_log, uint32_t ksk_input_lwe_dim,
+    uint32_t input_lwe_dim, uint32_t poly_size, uint32_t bsk_level,
+    uint32_t bsk_base_log, uint32_t glwe_dim, uint32_t ksk_index,
+    uint32_t bsk_index, mlir::concretelang::RuntimeContext *context);
+
+void memref_batched_keyswitch_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *tlu_allocated,
+    uint64_t *tlu_aligned, uint64_t tlu_offset, uint64_t tlu_size,
+    uint64_t tlu_stride, uint32_t ksk_level, uint32_t ksk_base_log,
+    uint32_t ksk_input_lwe_dim, uint32_t input_lwe_dim, uint32_t poly_size,
+    uint32_t bsk_level, uint32_t bsk_base_log, uint32_t glwe_dim,
+    uint32_t ksk_index, uint32_t bsk_index,
+    mlir::concretelang::RuntimeContext *context);
+
 void *memref_bootstrap_async_lwe_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
@@ -67,6 +67,19 @@ struct CircuitCompilationFeedback {
   /// @brief memory usage per location
   std::map<std::string, std::optional<int64_t>> memoryUsagePerLoc;
 
+  /// @brief the number of PBS executions eliminated by the deduplication of
+  /// the TFHE operations
+  int64_t eliminatedPBSCount = 0;
+
+  /// @brief the number of low bits cleared by the automatic rounding from the
+  /// input of the lookup tables, per location
+  std::map<std::string, int64_t> autoRoundedBitsPerLoc;
+
+  /// @brief the number of iterations of the outermost parallel band of the
+  /// loop nests, after interchange and collapsing, per location (nullopt if
+  /// not static)
+  std::map<std::string, std::optional<int64_t>> parallelBandSizePerLoc;
+
   /// Fill the sizes from the program info.
   void fillFromCircuitInfo(concreteprotocol::CircuitInfo::Reader params);
 };
@@ -74,6 +87,14 @@ struct CircuitCompilationFeedback {
 struct ProgramCompilationFeedback {
   double complexity;
 
+  /// @brief the objective minimized by the optimizer, "complexity" or
+  /// "critical-path"
+  std::string optimizerObjective = "complexity";
+
+  /// @brief the complexity of the longest chain of dependent bootstraps, when
+  /// independent operations run in parallel, 0 if not estimated
+  double criticalPathComplexity = 0;
+
   /// @brief Probability of error for every PBS.
   double pError;
 
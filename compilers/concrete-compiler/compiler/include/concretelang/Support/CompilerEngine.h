@@ -18,6 +18,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/ThreadPool.h"
 #include <memory>
 #include <optional>
 
@@ -39,11 +40,16 @@ public:
   mlir::MLIRContext *getMLIRContext();
   llvm::LLVMContext *getLLVMContext();
 
+  /// Sets the number of threads used to run the passes of the MLIR context
+  /// (0 means all hardware threads, 1 disables multi-threading).
+  void setCompileThreads(unsigned int numThreads);
+
   static std::shared_ptr<CompilationContext> createShared();
 
 protected:
   mlir::MLIRContext *mlirContext;
   llvm::LLVMContext *llvmContext;
+  std::unique_ptr<llvm::ThreadPool> threadPool;
 };
 
 enum Backend {
@@ -72,6 +78,12 @@ struct CompilationOptions {
   bool loopParallelize;
   bool dataflowParallelize;
 
+  /// Number of threads used to compile the program: function-level passes
+  /// run concurrently on the circuits and the LLVM module is split into
+  /// parts that are code generated in parallel. 0 means all hardware
+  /// threads, 1 (the default) compiles sequentially.
+  unsigned int compileThreads;
+
   /// Compression options
   bool compressEvaluationKeys;
   bool compressInputCiphertexts;
@@ -89,6 +101,28 @@ struct CompilationOptions {
   bool unrollLoopsWithSDFGConvertibleOps;
   bool optimizeTFHE;
 
+  /// Maximal number of lookup tables applied to the same input that are
+  /// evaluated with a single many-lut bootstrap. 1 (the default) disables
+  /// many-lut bootstrapping.
+  unsigned int maxManyLUTCount;
+
+  /// Clear the low bits of the inputs of the lookup tables that do not
+  /// depend on them, to lower the precision of the lookup tables.
+  bool autoRounding;
+
+  /// Lower the encrypted inner products with a single table lookup per
+  /// product on packed operands, when the optimizer finds it cheaper than the
+  /// double table lookup. Only done with the dag-multi strategy.
+  /// alwaysPackEncryptedMul skips the comparison of the costs, with any
+  /// strategy but v0.
+  bool packEncryptedMul;
+  bool alwaysPackEncryptedMul;
+
+  /// Run the keyswitches and bootstraps of the CPU backend asynchronously on
+  /// a pool of workers, issued as early and awaited as late as possible.
+  /// Disables the fusion of keyswitches and bootstraps.
+  bool asyncOffload;
+
   std::optional<std::vector<int64_t>> fhelinalgTileSizes;
 
   /// When decomposing big integers into chunks, chunkSize is the total number
@@ -98,6 +132,11 @@ struct CompilationOptions {
   unsigned int chunkSize;
   unsigned int chunkWidth;
 
+  /// Propagate the carries between chunks with a carry-lookahead adder of
+  /// logarithmic depth instead of a ripple carry adder of linear depth, at
+  /// the cost of more table lookups. Requires a chunkSize of at least 3.
+  bool chunkCarryLookahead;
+
   /// When compiling from a dialect lower than FHE, one needs to provide
   /// encodings info manually to allow the client lib to be generated.
   std::optional<Message<concreteprotocol::ProgramEncodingInfo>> encodings;
@@ -113,7 +152,7 @@ struct CompilationOptions {
         simulate(false),
         // Parallelization options
         autoParallelize(false), loopParallelize(true),
-        dataflowParallelize(false),
+        dataflowParallelize(false), compileThreads(1),
         /// Compression options
         compressEvaluationKeys(false), compressInputCiphertexts(false),
         /// Optimizer options
@@ -123,7 +162,10 @@ struct CompilationOptions {
         /// Other options
         batchTFHEOps(false), maxBatchSize(std::numeric_limits<int64_t>::max()),
         emitSDFGOps(false), unrollLoopsWithSDFGConvertibleOps(false),
-        optimizeTFHE(true), chunkIntegers(false), chunkSize(4), chunkWidth(2),
+        optimizeTFHE(true), maxManyLUTCount(1), autoRounding(false),
+        packEncryptedMul(true), alwaysPackEncryptedMul(false),
+        asyncOffload(false), chunkIntegers(false),
+        chunkSize(4), chunkWidth(2), chunkCarryLookahead(false),
         encodings(std::nullopt), enableTluFusing(true), printTluFusing(false){};
 
   /// @brief Constructor for CompilationOptions with default parameters for a
@@ -191,9 +233,11 @@ public:
             bool cleanUp = true)
         : outputDirPath(outputDirPath), runtimeLibraryPath(runtimeLibraryPath),
           cleanUp(cleanUp), programInfo() {}
-    /// Sets the compilation result used by the library
+    /// Sets the compilation result used by the library, the object code is
+    /// generated using `compileThreads` threads (see `CompilationOptions`)
     llvm::Expected<std::string>
-    setCompilationResult(CompilationResult &compilation);
+    setCompilationResult(CompilationResult &compilation,
+                         unsigned int compileThreads = 1);
     /// Emit the library artifacts with the previously added compilation result
     llvm::Error emitArtifacts(bool sharedLib, bool staticLib,
                               bool clientParameters, bool compilationFeedback);
@@ -13,6 +13,14 @@ namespace concretelang {
 
 llvm::Error emitObject(llvm::Module &module, std::string objectPath);
 
+/// Emits the object code of `module` using `numThreads` threads (all the
+/// hardware threads if 0). The module is split into at most one part per
+/// thread and per circuit, each part being code generated concurrently in
+/// its own object file. Returns the paths of the emitted object files.
+llvm::Expected<std::vector<std::string>>
+emitObjects(llvm::Module &module, std::string objectPath,
+            unsigned int numThreads);
+
 llvm::Error callCmd(std::string cmd);
 
 llvm::Error emitLibrary(std::vector<std::string> objectsPath,
@@ -139,7 +139,8 @@ emitScalarImplementation(OpBuilder &b, Location loc, ArrayRef<Value> allIvs,
       indexing.push_back(makeCanonicalAffineApplies(
           b, loc, linalgOp.getMatchingIndexingMap(outputOperand),
           allIvsPlusDims));
-      outputBuffers.push_back(operandValuesToUse.back());
+      outputBuffers.push_back(
+          operandValuesToUse[outputOperand->getOperandNumber()]);
     }
   }
   return inlineRegionAndEmitStore<LoadOpTy, StoreOpTy>(
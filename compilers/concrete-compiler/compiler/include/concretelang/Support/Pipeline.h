@@ -55,10 +55,29 @@ mlir::LogicalResult
 transformFHEBoolean(mlir::MLIRContext &context, mlir::ModuleOp &module,
                     std::function<bool(mlir::Pass *)> enablePass);
 
+mlir::LogicalResult
+groupManyLUTs(mlir::MLIRContext &context, mlir::ModuleOp &module,
+              std::function<bool(mlir::Pass *)> enablePass,
+              unsigned int maxLUTCount);
+
+mlir::LogicalResult
+insertAutoRounding(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                   std::function<bool(mlir::Pass *)> enablePass);
+
+mlir::LogicalResult
+packEncryptedMul(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                 optimizer::Config config, bool alwaysPack,
+                 std::function<bool(mlir::Pass *)> enablePass);
+
+mlir::LogicalResult
+balanceMaxChains(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                 std::function<bool(mlir::Pass *)> enablePass);
+
 mlir::LogicalResult
 transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
                    std::function<bool(mlir::Pass *)> enablePass,
-                   unsigned int chunkSize, unsigned int chunkWidth);
+                   unsigned int chunkSize, unsigned int chunkWidth,
+                   bool carryLookahead);
 
 mlir::LogicalResult
 lowerFHEToTFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
@@ -75,6 +94,22 @@ mlir::LogicalResult batchTFHE(mlir::MLIRContext &context,
                               std::function<bool(mlir::Pass *)> enablePass,
                               int64_t maxBatchSize);
 
+mlir::LogicalResult
+deduplicateTFHEOps(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                   std::function<bool(mlir::Pass *)> enablePass);
+
+mlir::LogicalResult
+shareTFHEKeyswitches(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                     std::function<bool(mlir::Pass *)> enablePass);
+
+mlir::LogicalResult
+packManyLUTBootstraps(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                      std::function<bool(mlir::Pass *)> enablePass);
+
+mlir::LogicalResult
+foldTFHELUTEncodings(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                     std::function<bool(mlir::Pass *)> enablePass);
+
 mlir::LogicalResult
 normalizeTFHEKeys(mlir::MLIRContext &context, mlir::ModuleOp &module,
                   std::function<bool(mlir::Pass *)> enablePass);
@@ -88,6 +123,16 @@ mlir::LogicalResult
 lowerTFHEToConcrete(mlir::MLIRContext &context, mlir::ModuleOp &module,
                     std::function<bool(mlir::Pass *)> enablePass);
 
+mlir::LogicalResult
+fuseConcreteKeyswitchBootstrap(mlir::MLIRContext &context,
+                               mlir::ModuleOp &module,
+                               std::function<bool(mlir::Pass *)> enablePass);
+
+mlir::LogicalResult
+extractParallelBands(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                     std::function<bool(mlir::Pass *)> enablePass,
+                     ProgramCompilationFeedback &feedback);
+
 mlir::LogicalResult
 computeMemoryUsage(mlir::MLIRContext &context, mlir::ModuleOp &module,
                    std::function<bool(mlir::Pass *)> enablePass,
@@ -133,6 +178,10 @@ mlir::LogicalResult lowerToCAPI(mlir::MLIRContext &context,
                                 std::function<bool(mlir::Pass *)> enablePass,
                                 bool gpu);
 
+mlir::LogicalResult asyncOffload(mlir::MLIRContext &context,
+                                 mlir::ModuleOp &module,
+                                 std::function<bool(mlir::Pass *)> enablePass);
+
 mlir::LogicalResult optimizeLLVMModule(llvm::LLVMContext &llvmContext,
                                        llvm::Module &module);
 
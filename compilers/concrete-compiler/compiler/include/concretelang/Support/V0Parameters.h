@@ -6,6 +6,7 @@
 #ifndef CONCRETELANG_SUPPORT_V0Parameter_H_
 #define CONCRETELANG_SUPPORT_V0Parameter_H_
 
+#include <string>
 #include <variant>
 
 #include "llvm/ADT/Optional.h"
@@ -81,6 +82,9 @@ constexpr bool DEFAULT_CACHE_ON_DISK = true;
 constexpr uint32_t DEFAULT_CIPHERTEXT_MODULUS_LOG = 64;
 constexpr uint32_t DEFAULT_FFT_PRECISION = 53;
 constexpr bool DEFAULT_COMPOSABLE = false;
+constexpr const char *DEFAULT_CPU_CALIBRATION_PATH = "";
+constexpr concrete_optimizer::Objective DEFAULT_OBJECTIVE =
+    concrete_optimizer::Objective::Complexity;
 
 /// The strategy of the crypto optimization
 enum Strategy {
@@ -96,6 +100,8 @@ enum Strategy {
 
 std::string const StrategyLabel[] = {"V0", "dag-mono", "dag-multi"};
 
+std::string const ObjectiveLabel[] = {"complexity", "critical-path"};
+
 constexpr Strategy DEFAULT_STRATEGY = Strategy::DAG_MULTI;
 constexpr concrete_optimizer::MultiParamStrategy DEFAULT_MULTI_PARAM_STRATEGY =
     concrete_optimizer::MultiParamStrategy::ByPrecision;
@@ -116,9 +122,19 @@ struct Config {
   uint32_t ciphertext_modulus_log;
   uint32_t fft_precision;
   bool composable;
+  /// Calibration file written by the `cpu-calibration` tool of the
+  /// concrete-optimizer. When set, the optimizer minimizes the execution time
+  /// measured on the calibrated host instead of the analytic complexity.
+  std::string cpu_calibration_path;
+  /// Costs loaded from `cpu_calibration_path` by `getSolution`
+  concrete_optimizer::CpuCalibration cpu_calibration;
+  /// What the dag-multi strategy minimizes: the complexity of the whole
+  /// program (throughput) or of its critical path (latency when independent
+  /// operations run in parallel)
+  concrete_optimizer::Objective objective;
 };
 
-constexpr Config DEFAULT_CONFIG = {
+const Config DEFAULT_CONFIG = {
     UNSPECIFIED_P_ERROR,
     UNSPECIFIED_GLOBAL_P_ERROR,
     DEFAULT_DISPLAY,
@@ -133,6 +149,9 @@ constexpr Config DEFAULT_CONFIG = {
     DEFAULT_CIPHERTEXT_MODULUS_LOG,
     DEFAULT_FFT_PRECISION,
     DEFAULT_COMPOSABLE,
+    DEFAULT_CPU_CALIBRATION_PATH,
+    concrete_optimizer::CpuCalibration{},
+    DEFAULT_OBJECTIVE,
 };
 
 using Dag = rust::Box<concrete_optimizer::OperationDag>;
@@ -157,6 +176,26 @@ llvm::Expected<optimizer::Solution>
 getSolution(optimizer::Description &descr, ProgramCompilationFeedback &feedback,
             optimizer::Config optimizerConfig);
 
+/// The options of the concrete-optimizer corresponding to `config`
+inline concrete_optimizer::Options
+options_from_config(optimizer::Config config) {
+  concrete_optimizer::Options options = {
+      /* .security_level = */ config.security,
+      /* .maximum_acceptable_error_probability = */ config.p_error,
+      /* .key_sharing = */ config.key_sharing,
+      /* .multi_param_strategy = */ config.multi_param_strategy,
+      /* .default_log_norm2_woppbs = */ config.fallback_log_norm_woppbs,
+      /* .use_gpu_constraints = */ config.use_gpu_constraints,
+      /* .encoding = */ config.encoding,
+      /* .cache_on_disk = */ config.cache_on_disk,
+      /* .ciphertext_modulus_log = */ config.ciphertext_modulus_log,
+      /* .fft_precision = */ config.fft_precision,
+      /* .composable = */ config.composable,
+      /* .cpu_calibration = */ config.cpu_calibration,
+      /* .objective = */ config.objective};
+  return options;
+}
+
 // As for now the solution which contains a crt encoding is mono parameter only
 // we have some parts of the pipeline that rely on that.
 // TODO: Remove this function
@@ -691,6 +691,11 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
              concrete_optimizer::MultiParamStrategy::ByPrecisionAndNorm2)
       .export_values();
 
+  pybind11::enum_<concrete_optimizer::Objective>(m, "OptimizerObjective")
+      .value("COMPLEXITY", concrete_optimizer::Objective::Complexity)
+      .value("CRITICAL_PATH", concrete_optimizer::Objective::CriticalPath)
+      .export_values();
+
   pybind11::enum_<concrete_optimizer::Encoding>(m, "Encoding")
       .value("AUTO", concrete_optimizer::Encoding::Auto)
       .value("CRT", concrete_optimizer::Encoding::Crt)
@@ -748,6 +753,15 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
            [](CompilationOptions &options, bool composable) {
              options.optimizerConfig.composable = composable;
            })
+      .def("set_optimizer_objective",
+           [](CompilationOptions &options,
+              concrete_optimizer::Objective objective) {
+             options.optimizerConfig.objective = objective;
+           })
+      .def("set_optimizer_cpu_calibration",
+           [](CompilationOptions &options, std::string path) {
+             options.optimizerConfig.cpu_calibration_path = path;
+           })
       .def("set_security_level",
            [](CompilationOptions &options, int security_level) {
              options.optimizerConfig.security = security_level;
@@ -796,6 +810,22 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
            [](CompilationOptions &options, bool batch_tfhe_ops) {
              options.batchTFHEOps = batch_tfhe_ops;
            })
+      .def("set_max_many_lut_count",
+           [](CompilationOptions &options, unsigned int max_many_lut_count) {
+             options.maxManyLUTCount = max_many_lut_count;
+           })
+      .def("set_auto_rounding",
+           [](CompilationOptions &options, bool auto_rounding) {
+             options.autoRounding = auto_rounding;
+           })
+      .def("set_async_offload",
+           [](CompilationOptions &options, bool async_offload) {
+             options.asyncOffload = async_offload;
+           })
+      .def("set_pack_encrypted_mul",
+           [](CompilationOptions &options, bool pack_encrypted_mul) {
+             options.packEncryptedMul = pack_encrypted_mul;
+           })
       .def("set_enable_tlu_fusing",
            [](CompilationOptions &options, bool enableTluFusing) {
              options.enableTluFusing = enableTluFusing;
@@ -838,6 +868,12 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
       m, "ProgramCompilationFeedback")
       .def_readonly("complexity",
                     &mlir::concretelang::ProgramCompilationFeedback::complexity)
+      .def_readonly(
+          "optimizer_objective",
+          &mlir::concretelang::ProgramCompilationFeedback::optimizerObjective)
+      .def_readonly("critical_path_complexity",
+                    &mlir::concretelang::ProgramCompilationFeedback::
+                        criticalPathComplexity)
       .def_readonly("p_error",
                     &mlir::concretelang::ProgramCompilationFeedback::pError)
       .def_readonly(
@@ -873,7 +909,16 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
                     &mlir::concretelang::CircuitCompilationFeedback::statistics)
       .def_readonly(
           "memory_usage_per_location",
-          &mlir::concretelang::CircuitCompilationFeedback::memoryUsagePerLoc);
+          &mlir::concretelang::CircuitCompilationFeedback::memoryUsagePerLoc)
+      .def_readonly(
+          "eliminated_pbs_count",
+          &mlir::concretelang::CircuitCompilationFeedback::eliminatedPBSCount)
+      .def_readonly("auto_rounded_bits_per_location",
+                    &mlir::concretelang::CircuitCompilationFeedback::
+                        autoRoundedBitsPerLoc)
+      .def_readonly("parallel_band_size_per_location",
+                    &mlir::concretelang::CircuitCompilationFeedback::
+                        parallelBandSizePerLoc);
 
   pybind11::class_<mlir::concretelang::CompilationContext,
                    std::shared_ptr<mlir::concretelang::CompilationContext>>(
@@ -1447,7 +1492,15 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
       .def("serialize",
            [](::concretelang::clientlib::EvaluationKeys &evaluationKeys) {
              return pybind11::bytes(evaluationKeysSerialize(evaluationKeys));
-           });
+           })
+      .def(
+          "prepare",
+          [](::concretelang::clientlib::EvaluationKeys &evaluationKeys,
+             size_t parallelism) {
+            pybind11::gil_scoped_release release;
+            evaluationKeys.keyset.prepare(parallelism);
+          },
+          pybind11::arg("parallelism") = 0);
 
   pybind11::class_<lambdaArgument>(m, "LambdaArgument")
       .def_static("from_tensor_u8",
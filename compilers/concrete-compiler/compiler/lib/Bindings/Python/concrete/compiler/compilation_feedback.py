@@ -68,6 +68,13 @@ class CircuitCompilationFeedback(WrapperCpp):
         self.memory_usage_per_location = (
             circuit_compilation_feedback.memory_usage_per_location
         )
+        self.eliminated_pbs_count = circuit_compilation_feedback.eliminated_pbs_count
+        self.auto_rounded_bits_per_location = (
+            circuit_compilation_feedback.auto_rounded_bits_per_location
+        )
+        self.parallel_band_size_per_location = (
+            circuit_compilation_feedback.parallel_band_size_per_location
+        )
 
         super().__init__(circuit_compilation_feedback)
 
@@ -236,6 +243,10 @@ class ProgramCompilationFeedback(WrapperCpp):
             )
 
         self.complexity = program_compilation_feedback.complexity
+        self.optimizer_objective = program_compilation_feedback.optimizer_objective
+        self.critical_path_complexity = (
+            program_compilation_feedback.critical_path_complexity
+        )
         self.p_error = program_compilation_feedback.p_error
         self.global_p_error = program_compilation_feedback.global_p_error
         self.total_secret_keys_size = (
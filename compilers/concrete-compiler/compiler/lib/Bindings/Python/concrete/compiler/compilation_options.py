@@ -10,6 +10,7 @@ from mlir._mlir_libs._concretelang._compiler import (
     CompilationOptions as _CompilationOptions,
     OptimizerStrategy as _OptimizerStrategy,
     OptimizerMultiParameterStrategy as _OptimizerMultiParameterStrategy,
+    OptimizerObjective as _OptimizerObjective,
     Encoding,
     Backend as _Backend,
 )
@@ -255,6 +256,35 @@ class CompilationOptions(WrapperCpp):
             raise ValueError("global_p_error be a probability in ]0; 1]")
         self.cpp().set_global_p_error(global_p_error)
 
+    def set_optimizer_objective(self, objective: _OptimizerObjective):
+        """Set what the optimizer minimizes with the dag-multi strategy.
+
+        Args:
+            objective (OptimizerObjective): the complexity of the whole program, or of its critical path
+
+        Raises:
+            TypeError: if the value is not an OptimizerObjective
+        """
+        if not isinstance(objective, _OptimizerObjective):
+            raise TypeError("objective should be an OptimizerObjective")
+        self.cpp().set_optimizer_objective(objective)
+
+    def set_optimizer_cpu_calibration(self, path: str):
+        """Set the cpu calibration file used by the optimizer.
+
+        The file is written by the cpu-calibration tool of the concrete-optimizer.
+        The optimizer then minimizes the execution time measured on this host.
+
+        Args:
+            path (str): path of the calibration file
+
+        Raises:
+            TypeError: if the value to set is not str
+        """
+        if not isinstance(path, str):
+            raise TypeError("can't set the cpu calibration to a non-str value")
+        self.cpp().set_optimizer_cpu_calibration(path)
+
     def set_security_level(self, security_level: int):
         """Set security level.
 
@@ -456,6 +486,76 @@ class CompilationOptions(WrapperCpp):
             raise TypeError("batch_tfhe_ops must be boolean")
         self.cpp().set_batch_tfhe_ops(batch_tfhe_ops)
 
+    def set_max_many_lut_count(self, max_many_lut_count: int):
+        """Set the maximal number of lookup tables evaluated by a many-lut bootstrap.
+
+        Lookup tables applied to the same input are packed in the accumulator of
+        a single bootstrap when precision and polynomial size allow it.
+
+        Args:
+            max_many_lut_count (int): maximal number of packed lookup tables, 1 disables it
+
+        Raises:
+            TypeError: if the value to set is not int
+            ValueError: if the value to set is not positive
+        """
+        if not isinstance(max_many_lut_count, int):
+            raise TypeError("max_many_lut_count must be an int")
+        if max_many_lut_count < 1:
+            raise ValueError("max_many_lut_count must be positive")
+        self.cpp().set_max_many_lut_count(max_many_lut_count)
+
+    def set_auto_rounding(self, auto_rounding: bool):
+        """Enable or disable the automatic rounding of lookup table inputs.
+
+        The low bits of the input of a lookup table whose result does not depend
+        on them are cleared, and the lookup is applied on a smaller precision.
+
+        Args:
+            auto_rounding (bool): whether to round the lookup table inputs automatically
+
+        Raises:
+            TypeError: if the value to set is not bool
+        """
+        if not isinstance(auto_rounding, bool):
+            raise TypeError("auto_rounding must be boolean")
+        self.cpp().set_auto_rounding(auto_rounding)
+
+    def set_async_offload(self, async_offload: bool):
+        """Enable or disable the asynchronous keyswitches and bootstraps.
+
+        The keyswitches and bootstraps are run on a pool of workers, issued as
+        early as possible and awaited as late as possible.
+
+        Args:
+            async_offload (bool): whether to run keyswitches and bootstraps asynchronously
+
+        Raises:
+            TypeError: if the value to set is not bool
+        """
+        if not isinstance(async_offload, bool):
+            raise TypeError("async_offload must be boolean")
+        self.cpp().set_async_offload(async_offload)
+
+    def set_pack_encrypted_mul(self, pack_encrypted_mul: bool):
+        """Enable or disable the packed lowering of encrypted inner products.
+
+        The products of encrypted dot products and matrix multiplications are
+        computed with a single table lookup on the operands packed in an integer
+        of twice their width, when the optimizer finds it cheaper than the
+        default lowering with two table lookups per product. Only done with the
+        multi-parameter strategy.
+
+        Args:
+            pack_encrypted_mul (bool): whether to pack the encrypted multiplications
+
+        Raises:
+            TypeError: if the value to set is not bool
+        """
+        if not isinstance(pack_encrypted_mul, bool):
+            raise TypeError("pack_encrypted_mul must be boolean")
+        self.cpp().set_pack_encrypted_mul(pack_encrypted_mul)
+
     def set_enable_tlu_fusing(self, enable_tlu_fusing: bool):
         """Enable or disable tlu fusing.
 
@@ -32,6 +32,25 @@ class EvaluationKeys(WrapperCpp):
             )
         super().__init__(evaluation_keys)
 
+    def prepare(self, parallelism: int = 0):
+        """Decompress and convert the keys ahead of the first server call.
+
+        Seeded keys are decompressed concurrently, and the bootstrap keys are
+        converted to the fourier domain once, instead of on each call.
+
+        Args:
+            parallelism (int): number of threads to use, 0 uses all hardware threads
+
+        Raises:
+            TypeError: if parallelism is not an int
+            ValueError: if parallelism is negative
+        """
+        if not isinstance(parallelism, int):
+            raise TypeError(f"parallelism must be an int, not {type(parallelism)}")
+        if parallelism < 0:
+            raise ValueError("parallelism must be positive or zero")
+        self.cpp().prepare(parallelism)
+
     def serialize(self) -> bytes:
         """Serialize the EvaluationKeys.
 
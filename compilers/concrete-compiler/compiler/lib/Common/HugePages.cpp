@@ -0,0 +1,146 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "concretelang/Common/HugePages.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace concretelang {
+namespace hugepages {
+
+namespace {
+
+/// The size of the huge pages of the default pool, the one of the
+/// transparent huge pages on x86_64 and aarch64.
+constexpr size_t HUGE_PAGE_SIZE = 2 << 20;
+
+/// The header stored before each buffer, which keeps the data aligned on a
+/// cache line.
+constexpr size_t HEADER_SIZE = 64;
+
+enum class Backing : uint64_t { HEAP, MAPPING };
+
+struct Header {
+  void *base;
+  size_t length;
+  Backing backing;
+};
+
+static_assert(sizeof(Header) <= HEADER_SIZE,
+              "The header must fit before the buffer");
+
+Mode modeFromEnv() {
+  char *env = getenv("CONCRETE_HUGE_PAGES");
+  if (env == nullptr)
+    return Mode::TRANSPARENT;
+  if (!strcmp(env, "none") || !strcmp(env, "off") || !strcmp(env, "0"))
+    return Mode::NONE;
+  if (!strcmp(env, "explicit"))
+    return Mode::EXPLICIT;
+  return Mode::TRANSPARENT;
+}
+
+size_t thresholdFromEnv() {
+  char *env = getenv("CONCRETE_HUGE_PAGES_THRESHOLD");
+  if (env == nullptr)
+    return HUGE_PAGE_SIZE;
+  return strtoull(env, NULL, 10);
+}
+
+std::atomic<Mode> &currentMode() {
+  static std::atomic<Mode> mode(modeFromEnv());
+  return mode;
+}
+
+std::atomic<size_t> &currentThreshold() {
+  static std::atomic<size_t> threshold(thresholdFromEnv());
+  return threshold;
+}
+
+#ifdef __linux__
+/// Maps `length` bytes, a multiple of the huge page size, on huge pages.
+/// Returns nullptr if no mapping can be created.
+void *map(size_t length, Mode mode) {
+  if (mode == Mode::EXPLICIT) {
+    void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED)
+      return ptr;
+  }
+  // Over-map by a huge page to align the mapping, as the transparent huge
+  // pages only back the aligned ranges
+  size_t overLength = length + HUGE_PAGE_SIZE;
+  void *over = mmap(nullptr, overLength, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (over == MAP_FAILED)
+    return nullptr;
+  uintptr_t begin = (uintptr_t)over;
+  uintptr_t aligned = (begin + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+  if (aligned > begin)
+    munmap(over, aligned - begin);
+  if (aligned + length < begin + overLength)
+    munmap((void *)(aligned + length), begin + overLength - aligned - length);
+  madvise((void *)aligned, length, MADV_HUGEPAGE);
+  return (void *)aligned;
+}
+#endif
+
+} // namespace
+
+Mode getMode() { return currentMode(); }
+
+void setMode(Mode mode) { currentMode() = mode; }
+
+size_t getThreshold() { return currentThreshold(); }
+
+void setThreshold(size_t threshold) { currentThreshold() = threshold; }
+
+void *allocate(size_t size) {
+  Header header;
+#ifdef __linux__
+  Mode mode = getMode();
+  if (mode != Mode::NONE && size >= getThreshold()) {
+    size_t length = (size + HEADER_SIZE + HUGE_PAGE_SIZE - 1) &
+                    ~(HUGE_PAGE_SIZE - 1);
+    if (void *base = map(length, mode)) {
+      header = Header{base, length, Backing::MAPPING};
+      memcpy(base, &header, sizeof(header));
+      return (uint8_t *)base + HEADER_SIZE;
+    }
+  }
+#endif
+  size_t length = (size + 2 * HEADER_SIZE - 1) & ~(HEADER_SIZE - 1);
+  void *base = aligned_alloc(HEADER_SIZE, length);
+  if (base == nullptr)
+    return nullptr;
+  header = Header{base, length, Backing::HEAP};
+  memcpy(base, &header, sizeof(header));
+  return (uint8_t *)base + HEADER_SIZE;
+}
+
+void deallocate(void *ptr) {
+  if (ptr == nullptr)
+    return;
+  Header header;
+  memcpy(&header, (uint8_t *)ptr - HEADER_SIZE, sizeof(header));
+  switch (header.backing) {
+  case Backing::HEAP:
+    free(header.base);
+    return;
+  case Backing::MAPPING:
+#ifdef __linux__
+    munmap(header.base, header.length);
+#endif
+    return;
+  }
+}
+
+} // namespace hugepages
+} // namespace concretelang
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <memory>
 #include <stdlib.h>
+#include <thread>
 
 using concretelang::csprng::EncryptionCSPRNG;
 using concretelang::csprng::SecretCSPRNG;
@@ -33,11 +34,13 @@ Message<ProtoKey> keyToProto(const Key &key) {
   return std::move(output);
 }
 
-void writeSeed(struct Uint128 seed, std::vector<uint64_t> &buffer) {
+template <typename Buffer>
+void writeSeed(struct Uint128 seed, Buffer &buffer) {
   csprng::writeSeed(seed, buffer.data());
 }
 
-void readSeed(struct Uint128 &seed, std::vector<uint64_t> &buffer) {
+template <typename Buffer>
+void readSeed(struct Uint128 &seed, Buffer &buffer) {
   csprng::readSeed(seed, buffer.data());
 }
 
@@ -184,15 +187,15 @@ LweBootstrapKey::getInfo() const {
   return this->info;
 }
 
-void LweBootstrapKey::decompress() {
+void LweBootstrapKey::decompress(Parallelism parallelism) {
   switch (info.asReader().getCompression()) {
   case concreteprotocol::Compression::NONE:
     return;
   case concreteprotocol::Compression::SEED: {
-    if (decompressed)
+    if (*decompressed)
       return;
-    const std::lock_guard<std::mutex> guard(*decompress_mutext);
-    if (decompressed)
+    const std::lock_guard<std::recursive_mutex> guard(*decompress_mutext);
+    if (*decompressed)
       return;
     auto params = info.asReader().getParams();
     buffer->resize(concrete_cpu_bootstrap_key_size_u64(
@@ -203,8 +206,8 @@ void LweBootstrapKey::decompress() {
     concrete_cpu_decompress_seeded_lwe_bootstrap_key_u64(
         buffer->data(), seededBuffer->data() + 2, params.getInputLweDimension(),
         params.getPolynomialSize(), params.getGlweDimension(),
-        params.getLevelCount(), params.getBaseLog(), seed, Parallelism::Rayon);
-    decompressed = true;
+        params.getLevelCount(), params.getBaseLog(), seed, parallelism);
+    *decompressed = true;
     return;
   }
   default:
@@ -212,6 +215,73 @@ void LweBootstrapKey::decompress() {
   }
 }
 
+void LweBootstrapKey::convertToFourier(size_t parallelism) {
+  auto params = info.asReader().getParams();
+  size_t levelCount = params.getLevelCount();
+  size_t glweDimension = params.getGlweDimension();
+  size_t polynomialSize = params.getPolynomialSize();
+  size_t inputLweDimension = params.getInputLweDimension();
+
+  const std::lock_guard<std::recursive_mutex> guard(*decompress_mutext);
+  if (!fourierBuffer->empty())
+    return;
+
+  decompress(parallelism > 1 ? Parallelism::Rayon : Parallelism::No);
+
+  auto fft = (struct Fft *)aligned_alloc(CONCRETE_FFT_ALIGN, CONCRETE_FFT_SIZE);
+  concrete_cpu_construct_concrete_fft(fft, polynomialSize);
+  size_t scratchSize;
+  size_t scratchAlign;
+  concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(
+      &scratchSize, &scratchAlign, fft);
+
+  // The key is a list of GGSW ciphertexts, one per input lwe dimension, whose
+  // fourier transforms have half as many complex coefficients
+  size_t ggswSize = concrete_cpu_ggsw_ciphertext_size_u64(
+      glweDimension, polynomialSize, levelCount);
+  fourierBuffer->resize(buffer->size() / 2);
+
+  auto convertRange = [&](size_t begin, size_t end) {
+    if (begin >= end)
+      return;
+    auto scratch = (uint8_t *)aligned_alloc(scratchAlign, scratchSize);
+    concrete_cpu_bootstrap_key_convert_u64_to_fourier(
+        buffer->data() + begin * ggswSize,
+        fourierBuffer->data() + begin * ggswSize / 2, levelCount,
+        params.getBaseLog(), glweDimension, polynomialSize, end - begin, fft,
+        scratch, scratchSize);
+    free(scratch);
+  };
+
+  size_t threadCount =
+      std::max<size_t>(1, std::min(parallelism, inputLweDimension));
+  size_t rangeSize = (inputLweDimension + threadCount - 1) / threadCount;
+  std::vector<std::thread> threads;
+  for (size_t begin = rangeSize; begin < inputLweDimension; begin += rangeSize)
+    threads.emplace_back(convertRange, begin,
+                         std::min(begin + rangeSize, inputLweDimension));
+  convertRange(0, std::min(rangeSize, inputLweDimension));
+  for (auto &thread : threads)
+    thread.join();
+
+  concrete_cpu_destroy_concrete_fft(fft);
+  free(fft);
+
+  // The seeded buffer is enough to decompress the key again if needed
+  if (info.asReader().getCompression() == concreteprotocol::Compression::SEED) {
+    std::vector<uint64_t>().swap(*buffer);
+    *decompressed = false;
+  }
+}
+
+std::shared_ptr<LweBootstrapKey::FourierBufferType>
+LweBootstrapKey::getFourierBuffer() const {
+  const std::lock_guard<std::recursive_mutex> guard(*decompress_mutext);
+  if (fourierBuffer->empty())
+    return nullptr;
+  return fourierBuffer;
+}
+
 LweKeyswitchKey::LweKeyswitchKey(
     Message<concreteprotocol::LweKeyswitchKeyInfo> info,
     const LweSecretKey &inputKey, const LweSecretKey &outputKey,
@@ -261,7 +331,8 @@ LweKeyswitchKey LweKeyswitchKey::fromProto(
   auto info = Message<concreteprotocol::LweKeyswitchKeyInfo>(
       proto.asReader().getInfo());
   auto vector =
-      protoPayloadToSharedVector<uint64_t>(proto.asReader().getPayload());
+      protoPayloadToSharedVector<uint64_t, BufferType::allocator_type>(
+          proto.asReader().getPayload());
   LweKeyswitchKey key(info);
   switch (info.asReader().getCompression()) {
   case concreteprotocol::Compression::NONE:
@@ -287,12 +358,13 @@ LweKeyswitchKey::getInfo() const {
   return this->info;
 }
 
-const std::vector<uint64_t> &LweKeyswitchKey::getBuffer() {
+const LweKeyswitchKey::BufferType &LweKeyswitchKey::getBuffer() {
   decompress();
   return *buffer;
 }
 
-const std::vector<uint64_t> &LweKeyswitchKey::getTransportBuffer() const {
+const LweKeyswitchKey::BufferType &
+LweKeyswitchKey::getTransportBuffer() const {
   switch (info.asReader().getCompression()) {
   case concreteprotocol::Compression::NONE:
     return *buffer;
@@ -304,15 +376,15 @@ const std::vector<uint64_t> &LweKeyswitchKey::getTransportBuffer() const {
   }
 }
 
-void LweKeyswitchKey::decompress() {
+void LweKeyswitchKey::decompress(Parallelism parallelism) {
   switch (info.asReader().getCompression()) {
   case concreteprotocol::Compression::NONE:
     return;
   case concreteprotocol::Compression::SEED: {
-    if (decompressed)
+    if (*decompressed)
       return;
     const std::lock_guard<std::mutex> guard(*decompress_mutext);
-    if (decompressed)
+    if (*decompressed)
       return;
     auto params = info.asReader().getParams();
     buffer->resize(concrete_cpu_keyswitch_key_size_u64(
@@ -323,8 +395,8 @@ void LweKeyswitchKey::decompress() {
     concrete_cpu_decompress_seeded_lwe_keyswitch_key_u64(
         buffer->data(), seededBuffer->data() + 2, params.getInputLweDimension(),
         params.getOutputLweDimension(), params.getLevelCount(),
-        params.getBaseLog(), seed, Parallelism::Rayon);
-    decompressed = true;
+        params.getBaseLog(), seed, parallelism);
+    *decompressed = true;
     return;
   }
   default:
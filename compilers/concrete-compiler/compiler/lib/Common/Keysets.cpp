@@ -15,11 +15,13 @@
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include <atomic>
 #include <errno.h>
 #include <fcntl.h>
 #include <iostream>
 #include <stdlib.h>
 #include <string>
+#include <thread>
 #include <unistd.h>
 #include <utime.h>
 
@@ -102,6 +104,34 @@ Message<concreteprotocol::ServerKeyset> ServerKeyset::toProto() const {
   return output;
 }
 
+void ServerKeyset::prepare(size_t parallelism) {
+  if (parallelism == 0)
+    parallelism = std::max(1u, std::thread::hardware_concurrency());
+  Parallelism decompression =
+      parallelism > 1 ? Parallelism::Rayon : Parallelism::No;
+
+  // Keyswitch keys are decompressed concurrently, the calling thread being
+  // one of the workers
+  std::atomic<size_t> nextKeyswitchKey(0);
+  auto decompressKeyswitchKeys = [&]() {
+    for (size_t i = nextKeyswitchKey++; i < lweKeyswitchKeys.size();
+         i = nextKeyswitchKey++)
+      lweKeyswitchKeys[i].decompress(decompression);
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < std::min(parallelism, lweKeyswitchKeys.size()); i++)
+    workers.emplace_back(decompressKeyswitchKeys);
+  decompressKeyswitchKeys();
+  for (auto &worker : workers)
+    worker.join();
+
+  // Bootstrap keys are decompressed and converted one after the other, the
+  // decompressed buffer of a key being released before the next one is
+  // decompressed
+  for (auto &bootstrapKey : lweBootstrapKeys)
+    bootstrapKey.convertToFourier(parallelism);
+}
+
 Keyset::Keyset(const Message<concreteprotocol::KeysetInfo> &info,
                SecretCSPRNG &secretCsprng, EncryptionCSPRNG &encryptionCsprng) {
   for (auto keyInfo : info.asReader().getLweSecretKeys()) {
@@ -0,0 +1,145 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include <cassert>
+
+#include "concretelang/Common/CRT.h"
+#include "concretelang/Common/LookupTable.h"
+
+namespace concretelang {
+namespace lut {
+
+void encodeExpandLutForBootstrap(uint64_t *output, size_t outputSize,
+                                 const uint64_t *input, size_t inputSize,
+                                 uint32_t outputBits, bool isSigned) {
+  size_t megaCaseSize = outputSize / inputSize;
+
+  assert((megaCaseSize % 2) == 0);
+
+  // When the bootstrap is executed on encrypted signed integers, the lut must
+  // be half-rotated. The rotation properly indexes into the input lut
+  // depending on what bootstrap gets executed.
+  size_t halfInputSize = isSigned ? inputSize / 2 : 0;
+  auto encodedValue = [&](size_t idx) -> uint64_t {
+    size_t rotated =
+        (idx < halfInputSize) ? idx + halfInputSize : idx - halfInputSize;
+    return input[rotated] << (64 - outputBits - 1);
+  };
+
+  // The first lut value should be centered over zero. This means that half of
+  // it should appear at the beginning of the output lut, and half of it at the
+  // end (but negated).
+  uint64_t first = encodedValue(0);
+  for (size_t idx = 0; idx < megaCaseSize / 2; ++idx) {
+    output[idx] = first;
+  }
+  for (size_t idx = (inputSize - 1) * megaCaseSize + megaCaseSize / 2;
+       idx < outputSize; ++idx) {
+    output[idx] = -first;
+  }
+
+  // Treats the other lut values.
+  for (size_t lutIdx = 1; lutIdx < inputSize; ++lutIdx) {
+    uint64_t value = encodedValue(lutIdx);
+    size_t start = megaCaseSize * (lutIdx - 1) + megaCaseSize / 2;
+    for (size_t outputIdx = start; outputIdx < start + megaCaseSize;
+         ++outputIdx) {
+      output[outputIdx] = value;
+    }
+  }
+}
+
+void encodeLutForCrtWopPBS(uint64_t *output, size_t outputSize1,
+                           const uint64_t *input, size_t inputSize,
+                           const uint64_t *crtDecomposition,
+                           const uint64_t *crtBits, size_t crtSize,
+                           uint64_t modulusProduct, bool isSigned) {
+  assert(modulusProduct >= inputSize);
+
+  // Initialize lut cases not supposed to be reached
+  for (uint64_t i = 0; i < crtSize * outputSize1; i++) {
+    output[i] = 0;
+  }
+
+  // When the woppbs is executed on encrypted signed integers, the index of the
+  // lut elements must be adapted to fit the way signed are encrypted in CRT
+  // (to ensure the lookup falls into the proper case).
+  //
+  // When not signed, the integer values are encoded in increasing order. That
+  // is (example of 9 bits values, using crt decomposition [5,7,16]):
+  //
+  // |0     511|
+  // |---------|
+  // |0     511|
+  //
+  // is encoded as
+  //
+  // |0   511|  INVALID  |
+  // |-------|-----------|
+  // |0   511|512     559|
+  //
+  // Where on top are represented the semantic values, and below, the actual
+  // encoding of values, either on uint64_t or as increasing crt values.
+  //
+  // As a consequence, there is nothing particular to do to map the index of
+  // the input lut to an index of the output lut.
+  //
+  // When signed, the integer values are encoded in a way that resembles 2s
+  // complement. That is (example of 9 bits values, using crt decomposition
+  // [5,7,16]):
+  //
+  // |0     255|-256    -1|
+  // |---------|----------|
+  // |0     255|256    511|
+  //
+  // is encoded as
+  //
+  // |0     255|   INVALID   |-256    -1|
+  // |---------|-------------|----------|
+  // |0     255|256       303|304    559|
+  //
+  // As a consequence, to map the index of the input lut to an index of the
+  // output lut we must take care of crossing the invalid range in between
+  // positive values and negative values.
+  auto indexMap = [&](uint64_t plaintext) -> uint64_t {
+    if (isSigned && plaintext >= (inputSize / 2)) {
+      plaintext += modulusProduct - inputSize;
+    }
+    return plaintext;
+  };
+
+  uint64_t logLutCrtSize = 0;
+  for (size_t inBlock = 0; inBlock < crtSize; inBlock++) {
+    logLutCrtSize += crtBits[inBlock];
+  }
+
+  uint64_t lutCrtSize = 1 << logLutCrtSize;
+  assert(lutCrtSize == outputSize1);
+
+  for (uint64_t inIndex = 0; inIndex < inputSize; inIndex++) {
+    uint64_t outIndex = 0;
+    uint64_t plaintext = indexMap(inIndex);
+
+    {
+      uint64_t totalBitCount = 0;
+      for (size_t inBlock = 0; inBlock < crtSize; inBlock++) {
+        auto inBase = crtDecomposition[inBlock];
+        auto bitsCount = crtBits[inBlock];
+        outIndex += (((plaintext % inBase) << bitsCount) / inBase)
+                    << totalBitCount;
+        totalBitCount += bitsCount;
+      }
+    }
+
+    for (size_t outBlock = 0; outBlock < crtSize; outBlock++) {
+      auto outBase = crtDecomposition[outBlock];
+      output[outBlock * lutCrtSize + outIndex] =
+          crt::encode(input[inIndex], outBase, modulusProduct);
+    }
+  }
+}
+
+} // namespace lut
+} // namespace concretelang
@@ -44,6 +44,11 @@ char memref_batched_keyswitch_lwe_u64[] = "memref_batched_keyswitch_lwe_u64";
 char memref_batched_bootstrap_lwe_u64[] = "memref_batched_bootstrap_lwe_u64";
 char memref_batched_mapped_bootstrap_lwe_u64[] =
     "memref_batched_mapped_bootstrap_lwe_u64";
+char memref_many_lut_bootstrap_lwe_u64[] = "memref_many_lut_bootstrap_lwe_u64";
+char memref_keyswitch_bootstrap_lwe_u64[] =
+    "memref_keyswitch_bootstrap_lwe_u64";
+char memref_batched_keyswitch_bootstrap_lwe_u64[] =
+    "memref_batched_keyswitch_bootstrap_lwe_u64";
 
 char memref_keyswitch_async_lwe_u64[] = "memref_keyswitch_async_lwe_u64";
 char memref_bootstrap_async_lwe_u64[] = "memref_bootstrap_async_lwe_u64";
@@ -111,10 +116,11 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
                                         i32Type, i32Type, i32Type, contextType},
                                        {});
   } else if (funcName == memref_keyswitch_async_lwe_u64) {
-    // Todo Answer this question: Isn't it dead ?
-    funcType = mlir::FunctionType::get(
-        rewriter.getContext(), {memref1DType, memref1DType, contextType},
-        {futureType});
+    funcType =
+        mlir::FunctionType::get(rewriter.getContext(),
+                                {memref1DType, memref1DType, i32Type, i32Type,
+                                 i32Type, i32Type, i32Type, contextType},
+                                {futureType});
   } else if (funcName == memref_bootstrap_async_lwe_u64) {
     funcType = mlir::FunctionType::get(rewriter.getContext(),
                                        {memref1DType, memref1DType,
@@ -162,10 +168,29 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
                                         memref2DType, i32Type, i32Type, i32Type,
                                         i32Type, i32Type, i32Type, contextType},
                                        {});
-  } else if (funcName == memref_await_future) {
+  } else if (funcName == memref_many_lut_bootstrap_lwe_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref2DType, memref1DType, memref1DType, i32Type, i32Type, i32Type,
+         i32Type, i32Type, i32Type, i32Type, contextType},
+        {});
+  } else if (funcName == memref_keyswitch_bootstrap_lwe_u64) {
     funcType = mlir::FunctionType::get(
         rewriter.getContext(),
-        {memref1DType, futureType, memref1DType, memref1DType}, {});
+        {memref1DType, memref1DType, memref1DType, i32Type, i32Type, i32Type,
+         i32Type, i32Type, i32Type, i32Type, i32Type, i32Type, i32Type,
+         contextType},
+        {});
+  } else if (funcName == memref_batched_keyswitch_bootstrap_lwe_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref2DType, memref2DType, memref1DType, i32Type, i32Type, i32Type,
+         i32Type, i32Type, i32Type, i32Type, i32Type, i32Type, i32Type,
+         contextType},
+        {});
+  } else if (funcName == memref_await_future) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(), {memref1DType, futureType, memref1DType}, {});
   } else if (funcName == memref_expand_lut_in_trivial_glwe_ct_u64) {
     funcType = mlir::FunctionType::get(rewriter.getContext(),
                                        {
@@ -332,6 +357,72 @@ void bootstrapAddOperands(BootstrapOp op,
   operands.push_back(getContextArgument(op));
 }
 
+void manyLUTBootstrapAddOperands(Concrete::ManyLUTBootstrapLweBufferOp op,
+                                 mlir::SmallVector<mlir::Value> &operands,
+                                 mlir::RewriterBase &rewriter) {
+  // input_lwe_dim
+  operands.push_back(rewriter.create<mlir::arith::ConstantOp>(
+      op.getLoc(), op.getInputLweDimAttr()));
+  // poly_size
+  operands.push_back(rewriter.create<mlir::arith::ConstantOp>(
+      op.getLoc(), op.getPolySizeAttr()));
+  // level
+  operands.push_back(
+      rewriter.create<mlir::arith::ConstantOp>(op.getLoc(), op.getLevelAttr()));
+  // base_log
+  operands.push_back(rewriter.create<mlir::arith::ConstantOp>(
+      op.getLoc(), op.getBaseLogAttr()));
+  // glwe_dim
+  operands.push_back(rewriter.create<mlir::arith::ConstantOp>(
+      op.getLoc(), op.getGlweDimensionAttr()));
+  // bsk_index
+  operands.push_back(
+      rewriter.create<arith::ConstantOp>(op.getLoc(), op.getBskIndexAttr()));
+  // sample_stride
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getSampleStrideAttr()));
+  // context
+  operands.push_back(getContextArgument(op));
+}
+
+template <typename KeySwitchBootstrapOp>
+void keyswitchBootstrapAddOperands(KeySwitchBootstrapOp op,
+                                   mlir::SmallVector<mlir::Value> &operands,
+                                   mlir::RewriterBase &rewriter) {
+  // ksk_level
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getKeyswitchLevelAttr()));
+  // ksk_base_log
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getKeyswitchBaseLogAttr()));
+  // ksk_input_lwe_dim
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getKeyswitchInputLweDimAttr()));
+  // input_lwe_dim
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getInputLweDimAttr()));
+  // poly_size
+  operands.push_back(
+      rewriter.create<arith::ConstantOp>(op.getLoc(), op.getPolySizeAttr()));
+  // bsk_level
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getBootstrapLevelAttr()));
+  // bsk_base_log
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getBootstrapBaseLogAttr()));
+  // glwe_dim
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getGlweDimensionAttr()));
+  // ksk_index
+  operands.push_back(
+      rewriter.create<arith::ConstantOp>(op.getLoc(), op.getKskIndexAttr()));
+  // bsk_index
+  operands.push_back(
+      rewriter.create<arith::ConstantOp>(op.getLoc(), op.getBskIndexAttr()));
+  // context
+  operands.push_back(getContextArgument(op));
+}
+
 void wopPBSAddOperands(Concrete::WopPBSCRTLweBufferOp op,
                        mlir::SmallVector<mlir::Value> &operands,
                        mlir::RewriterBase &rewriter) {
@@ -602,6 +693,25 @@ struct ConcreteToCAPIPass : public ConcreteToCAPIBase<ConcreteToCAPIPass> {
                                     memref_batched_mapped_bootstrap_lwe_u64>>(
           &getContext(),
           bootstrapAddOperands<Concrete::BatchedMappedBootstrapLweBufferOp>);
+      // The many-LUT bootstrap is only implemented by the CPU backend, the
+      // compiler does not emit it when targeting GPUs.
+      patterns.add<
+          ConcreteToCAPICallPattern<Concrete::ManyLUTBootstrapLweBufferOp,
+                                    memref_many_lut_bootstrap_lwe_u64>>(
+          &getContext(), manyLUTBootstrapAddOperands);
+      // The fused keyswitch and bootstrap is only implemented by the CPU
+      // backend, the compiler does not emit it when targeting GPUs.
+      patterns.add<
+          ConcreteToCAPICallPattern<Concrete::KeySwitchBootstrapLweBufferOp,
+                                    memref_keyswitch_bootstrap_lwe_u64>>(
+          &getContext(), keyswitchBootstrapAddOperands<
+                             Concrete::KeySwitchBootstrapLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::BatchedKeySwitchBootstrapLweBufferOp,
+          memref_batched_keyswitch_bootstrap_lwe_u64>>(
+          &getContext(),
+          keyswitchBootstrapAddOperands<
+              Concrete::BatchedKeySwitchBootstrapLweBufferOp>);
     }
 
     patterns.add<ConcreteToCAPICallPattern<Concrete::WopPBSCRTLweBufferOp,
@@ -46,6 +46,13 @@ inline void forwardOptimizerID(mlir::Operation *source,
   destination->setAttr("TFHE.OId", optimizerIdAttr);
 }
 
+/// Forwards the many-lut group size of a lookup table, if any
+inline void forwardManyLUT(mlir::Operation *source,
+                           mlir::Operation *destination) {
+  if (auto manyLUTAttr = source->getAttr("TFHE.many_lut"))
+    destination->setAttr("TFHE.many_lut", manyLUTAttr);
+}
+
 template <typename DotOp, typename FHEMulOp>
 struct DotToLinalgGeneric : public ::mlir::OpRewritePattern<DotOp> {
   DotToLinalgGeneric(
@@ -424,6 +431,7 @@ struct FHELinalgApplyMappedLookupTableToLinalgGeneric
       auto lookup = nestedBuilder.create<FHE::ApplyLookupTableEintOp>(
           loc, elementTy, tElmt, lut);
       forwardOptimizerID(mappedLookup, lookup);
+      forwardManyLUT(mappedLookup, lookup);
       // linalg.yield %res1 : !FHE.eint<2>
       nestedBuilder.create<linalg::YieldOp>(loc, lookup.getResult());
     };
@@ -582,6 +590,7 @@ struct FHELinalgApplyMultiLookupTableToLinalgGeneric
       auto lutOp = nestedBuilder.create<FHE::ApplyLookupTableEintOp>(
           loc, resultTy.getElementType(), tElmt, lut);
       forwardOptimizerID(fheLinalgLutOp, lutOp);
+      forwardManyLUT(fheLinalgLutOp, lutOp);
 
       nestedBuilder.create<mlir::linalg::YieldOp>(loc, lutOp.getResult());
     };
@@ -689,6 +698,7 @@ struct FHELinalgApplyLookupTableToLinalgGeneric
               lutOp.getLoc(), resultTy.getElementType(), blockArgs[0],
               lutOp.getLut());
       forwardOptimizerID(lutOp, fheOp);
+      forwardManyLUT(lutOp, fheOp);
 
       nestedBuilder.create<mlir::linalg::YieldOp>(lutOp.getLoc(),
                                                   fheOp.getResult());
@@ -1752,12 +1762,33 @@ struct FHELinalgConv2dToLinalgConv2d
   };
 };
 
-/// This rewrite pattern transforms all instances
-/// of `FHELinalg.maxpool2d` to `linalg.pooling_ncw_max`.
-struct FHELinalgMaxpool2dToLinalgMaxpool2d
+/// This rewrite pattern transforms all instances of `FHELinalg.maxpool2d`
+/// into a balanced tree of maximums over the elements of each window. The
+/// `K` elements of the windows are gathered along a new leading dimension,
+/// and each level of the tree computes the maximum of pairs of elements with
+/// a single `linalg.generic` using `FHE.max_eint`, such that all the lookups
+/// of a level are independent. The depth of lookups is then `ceil(log2(K))`
+/// instead of `K - 1` for a sequential reduction over the window.
+///
+/// Example:
+///
+///   %res = "FHELinalg.maxpool2d"(%input) { kernel_shape = [2, 2] }
+///          : (tensor<1x1x4x4x!FHE.eint<6>>) -> tensor<1x1x3x3x!FHE.eint<6>>
+///
+/// becomes:
+///
+///   %w0 = tensor.extract_slice %input[0, 0, 0, 0] [1, 1, 3, 3] [1, 1, 1, 1]
+///   %e0 = tensor.insert_slice %w0 into %zero[0, 0, 0, 0, 0] [1, 1, 1, 3, 3]
+///   ... (windows 1 to 3)
+///   %l0 = tensor.extract_slice %e3[0, 0, 0, 0, 0] [2, 1, 1, 3, 3] [2, ...]
+///   %r0 = tensor.extract_slice %e3[1, 0, 0, 0, 0] [2, 1, 1, 3, 3] [2, ...]
+///   %m0 = linalg.generic ins(%l0, %r0) ... { FHE.max_eint }
+///   ... (next level on %m0)
+///   %res = tensor.extract_slice %m1[0, 0, 0, 0, 0] [1, 1, 1, 3, 3] [...]
+struct FHELinalgMaxpool2dToLinalgTreeReduction
     : public mlir::OpRewritePattern<FHELinalg::Maxpool2dOp> {
 
-  FHELinalgMaxpool2dToLinalgMaxpool2d(mlir::MLIRContext *context)
+  FHELinalgMaxpool2dToLinalgTreeReduction(mlir::MLIRContext *context)
       : mlir::OpRewritePattern<FHELinalg::Maxpool2dOp>(context) {}
 
   mlir::LogicalResult
@@ -1768,85 +1799,144 @@ struct FHELinalgMaxpool2dToLinalgMaxpool2d
 
     const mlir::Location loc = maxpool2dOp->getLoc();
 
-    std::vector<mlir::NamedAttribute> maxOpDict = {rewriter.getNamedAttr(
-        "op", rewriter.getStringAttr(
-                  mlir::concretelang::FHE::MaxEintOp::getOperationName()))};
-    std::vector<mlir::NamedAttribute> opAttrs;
-    if (optimizerIdAttr != nullptr) {
-      opAttrs.push_back(rewriter.getNamedAttr("TFHE.OId", optimizerIdAttr));
-    }
-    auto opNamedAttrs =
-        rewriter.getNamedAttr("op_attrs", rewriter.getDictionaryAttr(opAttrs));
-    maxOpDict.push_back(opNamedAttrs);
-    const mlir::NamedAttribute maxOpAttr = rewriter.getNamedAttr(
-        "max_signed", rewriter.getDictionaryAttr(maxOpDict));
-
     const auto outputTy =
         maxpool2dOp->getResult(0).getType().cast<mlir::RankedTensorType>();
-    const auto outputElementTy =
-        outputTy.getElementType().cast<FHE::FheIntegerInterface>();
-
-    auto output = rewriter.create<FHE::ZeroTensorOp>(loc, outputTy).getResult();
-
-    if (outputElementTy.isSigned()) {
-      const int64_t outputBitWidth = outputElementTy.getWidth();
-      const int64_t offsetValue = 1 << (outputBitWidth - 2);
-
-      const mlir::Type offsetType =
-          mlir::IntegerType::get(this->getContext(), outputBitWidth + 1);
-      const mlir::Type offsetTensorType =
-          mlir::RankedTensorType::get({1}, offsetType);
-
-      const llvm::SmallVector<mlir::Attribute> offsetTensorAttr = {
-          mlir::IntegerAttr::get(offsetType, offsetValue)};
-      const mlir::Attribute offsetAttr =
-          mlir::DenseElementsAttr::get(offsetTensorType, offsetTensorAttr);
-
-      const mlir::Value offset =
-          rewriter.create<mlir::arith::ConstantOp>(loc, offsetAttr);
-
-      auto subOp =
-          rewriter.create<FHELinalg::SubEintIntOp>(loc, output, offset);
-      if (optimizerIdAttr != nullptr) {
-        assert(optimizerIdAttr.size() == 3);
-        output.getDefiningOp()->setAttr(
-            "TFHE.OId", rewriter.getI32IntegerAttr(optimizerIdAttr[2]));
-        subOp->setAttr("TFHE.OId",
-                       rewriter.getI32IntegerAttr(optimizerIdAttr[2]));
-      }
-      output = subOp.getResult();
-    } else {
-      if (optimizerIdAttr != nullptr) {
-        output.getDefiningOp()->setAttr(
-            "TFHE.OId", rewriter.getI32IntegerAttr(optimizerIdAttr[0]));
-      }
-    }
+    const mlir::Type elementTy = outputTy.getElementType();
+    const llvm::ArrayRef<int64_t> outputShape = outputTy.getShape();
+
+    auto getPair = [](std::optional<mlir::DenseIntElementsAttr> attr) {
+      llvm::SmallVector<int64_t, 2> values{1, 1};
+      if (attr.has_value())
+        values.assign(attr->value_begin<int64_t>(), attr->value_end<int64_t>());
+      return values;
+    };
 
     const mlir::DenseElementsAttr kernelShapeAttr =
         maxpool2dOp.getKernelShape();
     const auto kernelShape =
         llvm::SmallVector<int64_t, 2>(kernelShapeAttr.value_begin<int64_t>(),
                                       kernelShapeAttr.value_end<int64_t>());
+    const llvm::SmallVector<int64_t, 2> strides =
+        getPair(maxpool2dOp.getStrides());
+    const llvm::SmallVector<int64_t, 2> dilations =
+        getPair(maxpool2dOp.getDilations());
+
+    auto indexAttrs = [&](llvm::ArrayRef<int64_t> values) {
+      return llvm::to_vector(
+          llvm::map_range(values, [&](int64_t v) -> mlir::OpFoldResult {
+            return rewriter.getIndexAttr(v);
+          }));
+    };
 
-    const mlir::Value kernel =
-        rewriter
-            .create<mlir::tensor::EmptyOp>(
-                loc, kernelShape,
-                mlir::IntegerType::get(this->getContext(), 64))
-            .getResult();
+    // Shape of `count` elements of the windows gathered along the leading
+    // dimension
+    auto gatheredShape = [&](int64_t count) {
+      llvm::SmallVector<int64_t> shape{count};
+      shape.append(outputShape.begin(), outputShape.end());
+      return shape;
+    };
+
+    auto createZeroTensor = [&](int64_t count) {
+      auto zero = rewriter.create<FHE::ZeroTensorOp>(
+          loc, mlir::RankedTensorType::get(gatheredShape(count), elementTy));
+      if (optimizerIdAttr != nullptr)
+        zero->setAttr("TFHE.OId",
+                      rewriter.getI32IntegerAttr(optimizerIdAttr[0]));
+      return zero.getResult();
+    };
+
+    // Extracts `count` elements starting at `offset` every `step` elements
+    auto extractElements = [&](mlir::Value elements, int64_t offset,
+                               int64_t count, int64_t step) {
+      llvm::SmallVector<int64_t> offsets(outputShape.size() + 1, 0);
+      llvm::SmallVector<int64_t> steps(outputShape.size() + 1, 1);
+      offsets[0] = offset;
+      steps[0] = step;
+      return rewriter
+          .create<tensor::ExtractSliceOp>(
+              loc, mlir::RankedTensorType::get(gatheredShape(count), elementTy),
+              elements, indexAttrs(offsets), indexAttrs(gatheredShape(count)),
+              indexAttrs(steps))
+          .getResult();
+    };
 
-    const mlir::DenseIntElementsAttr defaultAttr =
-        rewriter.getI64VectorAttr({1, 1});
+    // Inserts `inserted` in `elements` at `offset`, in the leading dimension
+    auto insertElements = [&](mlir::Value inserted, mlir::Value elements,
+                              int64_t offset, int64_t count) {
+      llvm::SmallVector<int64_t> offsets(outputShape.size() + 1, 0);
+      llvm::SmallVector<int64_t> steps(outputShape.size() + 1, 1);
+      offsets[0] = offset;
+      return rewriter
+          .create<tensor::InsertSliceOp>(loc, inserted, elements,
+                                         indexAttrs(offsets),
+                                         indexAttrs(gatheredShape(count)),
+                                         indexAttrs(steps))
+          .getResult();
+    };
+
+    // Gather the elements of all windows
+    const int64_t windowSize = kernelShape[0] * kernelShape[1];
+    mlir::Value elements = createZeroTensor(windowSize);
+
+    for (int64_t kh = 0; kh < kernelShape[0]; kh++) {
+      for (int64_t kw = 0; kw < kernelShape[1]; kw++) {
+        mlir::Value window = rewriter.create<tensor::ExtractSliceOp>(
+            loc, outputTy, maxpool2dOp.getInput(),
+            indexAttrs({0, 0, kh * dilations[0], kw * dilations[1]}),
+            indexAttrs(outputShape),
+            indexAttrs({1, 1, strides[0], strides[1]}));
+        elements =
+            insertElements(window, elements, kh * kernelShape[1] + kw, 1);
+      }
+    }
+
+    // Reduce the elements level by level
+    const int64_t rank = outputShape.size() + 1;
+    llvm::SmallVector<mlir::AffineMap, 3> maps(
+        3, rewriter.getMultiDimIdentityMap(rank));
+    llvm::SmallVector<mlir::utils::IteratorType> iteratorTypes(
+        rank, mlir::utils::IteratorType::parallel);
 
-    const mlir::DenseIntElementsAttr stridesAttr =
-        maxpool2dOp.getDilations().value_or(defaultAttr);
-    const mlir::DenseIntElementsAttr dilationsAttr =
-        maxpool2dOp.getDilations().value_or(defaultAttr);
+    for (int64_t count = windowSize; count > 1; count = (count + 1) / 2) {
+      const int64_t pairs = count / 2;
+      mlir::Value lhs = extractElements(elements, 0, pairs, 2);
+      mlir::Value rhs = extractElements(elements, 1, pairs, 2);
+      mlir::Value init = createZeroTensor(pairs);
+
+      auto bodyBuilder = [&](mlir::OpBuilder &nestedBuilder,
+                             mlir::Location nestedLoc,
+                             mlir::ValueRange blockArgs) {
+        auto maxOp = nestedBuilder.create<FHE::MaxEintOp>(
+            nestedLoc, elementTy, blockArgs[0], blockArgs[1]);
+        if (optimizerIdAttr != nullptr)
+          maxOp->setAttr("TFHE.OId", optimizerIdAttr);
+        nestedBuilder.create<linalg::YieldOp>(nestedLoc, maxOp.getResult());
+      };
+
+      mlir::Value maxima =
+          rewriter
+              .create<linalg::GenericOp>(
+                  loc, mlir::TypeRange{init.getType()},
+                  mlir::ValueRange{lhs, rhs},
+                  mlir::ValueRange{init}, maps, iteratorTypes, bodyBuilder)
+              .getResult(0);
+
+      // The last element of an odd level is forwarded to the next level
+      if (count % 2 == 1) {
+        mlir::Value last = extractElements(elements, count - 1, 1, 1);
+        mlir::Value next = createZeroTensor(pairs + 1);
+        next = insertElements(maxima, next, 0, pairs);
+        maxima = insertElements(last, next, pairs, 1);
+      }
+
+      elements = maxima;
+    }
 
-    rewriter.replaceOpWithNewOp<mlir::linalg::PoolingNchwMaxOp>(
-        maxpool2dOp, outputTy, mlir::ValueRange{maxpool2dOp.getInput(), kernel},
-        output, stridesAttr, dilationsAttr,
-        llvm::ArrayRef<mlir::NamedAttribute>({maxOpAttr}));
+    llvm::SmallVector<int64_t> offsets(rank, 0);
+    llvm::SmallVector<int64_t> steps(rank, 1);
+    rewriter.replaceOpWithNewOp<tensor::ExtractSliceOp>(
+        maxpool2dOp, outputTy, elements, indexAttrs(offsets),
+        indexAttrs(gatheredShape(1)), indexAttrs(steps));
 
     return mlir::success();
   };
@@ -2207,7 +2297,7 @@ void FHETensorOpsToLinalg::runOnOperation() {
   patterns.insert<SumToLinalgGeneric>(&getContext());
   patterns.insert<ConcatRewritePattern>(&getContext());
   patterns.insert<FHELinalgConv2dToLinalgConv2d>(&getContext());
-  patterns.insert<FHELinalgMaxpool2dToLinalgMaxpool2d>(&getContext());
+  patterns.insert<FHELinalgMaxpool2dToLinalgTreeReduction>(&getContext());
   patterns.insert<TransposeToLinalgGeneric>(&getContext());
   patterns.insert<FromElementToTensorFromElements>(&getContext());
   patterns.insert<TensorPartitionFrontierOpToLinalgGeneric>(&getContext());
@@ -21,6 +21,7 @@
 #include "concretelang/Conversion/Utils/FuncConstOpConversion.h"
 #include "concretelang/Conversion/Utils/RTOpConverter.h"
 #include "concretelang/Conversion/Utils/TensorOpTypeConversion.h"
+#include "concretelang/Dialect/FHE/Analysis/utils.h"
 #include "concretelang/Dialect/FHE/IR/FHEDialect.h"
 #include "concretelang/Dialect/FHE/IR/FHEOps.h"
 #include "concretelang/Dialect/FHE/IR/FHETypes.h"
@@ -404,6 +405,9 @@ struct ApplyLookupTableEintOpPattern
                     rewriter.getI32IntegerAttr(
                         operatorIndexes[operatorIndexes.size() - 1]));
     }
+    if (auto manyLUTAttr = op->getAttr("TFHE.many_lut")) {
+      bsOp->setAttr("TFHE.many_lut", manyLUTAttr);
+    }
     return mlir::success();
   };
 
@@ -702,51 +706,111 @@ struct NoopScalarOpPattern : public ScalarOpPattern<T> {
   }
 };
 
+/// Writes the cast of an encrypted boolean from or to an encrypted integer,
+/// i.e. moves the value encoded with `fromWidth` bits to the encoding with
+/// `toWidth` bits. Moving the value to a more significant position is a
+/// multiplication by a power of two, moving it to a less significant one is a
+/// bootstrap of the identity.
+mlir::Value writeBooleanCast(mlir::Operation *op, mlir::Value input,
+                             unsigned fromWidth, unsigned toWidth,
+                             uint64_t polynomialSize,
+                             mlir::ConversionPatternRewriter &rewriter) {
+  auto glweType = TFHE::GLWECipherTextType::get(rewriter.getContext(),
+                                                TFHE::GLWESecretKey());
+
+  if (auto shift = mlir::concretelang::fhe::utils::getLeveledCastShift(
+          fromWidth, toWidth)) {
+    if (shift.value() == 0) {
+      return input;
+    }
+    mlir::Value factor = rewriter.create<mlir::arith::ConstantOp>(
+        op->getLoc(), rewriter.getI64IntegerAttr((int64_t)1 << shift.value()));
+    auto mulOp = rewriter.create<TFHE::MulGLWEIntOp>(op->getLoc(), glweType,
+                                                     input, factor);
+    forwardOptimizerID(op, mulOp);
+    return mulOp;
+  }
+
+  llvm::SmallVector<int64_t> identity;
+  for (int64_t i = 0; i < ((int64_t)1 << fromWidth); i++) {
+    identity.push_back(i);
+  }
+  mlir::Value lut = rewriter.create<mlir::arith::ConstantOp>(
+      op->getLoc(), rewriter.getI64TensorAttr(identity));
+  mlir::Value newLut =
+      rewriter
+          .create<TFHE::EncodeExpandLutForBootstrapOp>(
+              op->getLoc(),
+              mlir::RankedTensorType::get({(int64_t)polynomialSize},
+                                          rewriter.getI64Type()),
+              lut, rewriter.getI32IntegerAttr(polynomialSize),
+              rewriter.getI32IntegerAttr(toWidth), rewriter.getBoolAttr(false))
+          .getResult();
+
+  auto ksOp = rewriter.create<TFHE::KeySwitchGLWEOp>(
+      op->getLoc(), glweType, input,
+      TFHE::GLWEKeyswitchKeyAttr::get(op->getContext(), TFHE::GLWESecretKey(),
+                                      TFHE::GLWESecretKey(), -1, -1, -1));
+  auto bsOp = rewriter.create<TFHE::BootstrapGLWEOp>(
+      op->getLoc(), glweType, ksOp, newLut,
+      TFHE::GLWEBootstrapKeyAttr::get(op->getContext(), TFHE::GLWESecretKey(),
+                                      TFHE::GLWESecretKey(), -1, -1, -1, -1,
+                                      -1));
+  // see `addBooleanCastLut` in lib/Dialect/FHE/Analysis/ConcreteOptimizer.cpp
+  if (auto operatorIndexes =
+          op->getAttrOfType<mlir::DenseI32ArrayAttr>("TFHE.OId")) {
+    assert(operatorIndexes.size() == 1);
+    auto lutIndex = rewriter.getI32IntegerAttr(operatorIndexes[0]);
+    ksOp->setAttr("TFHE.OId", lutIndex);
+    bsOp->setAttr("TFHE.OId", lutIndex);
+  }
+  return bsOp;
+}
+
 /// Rewriter for the `FHE::to_bool` operation.
-struct ToBoolOpPattern : public mlir::OpRewritePattern<FHE::ToBoolOp> {
-  ToBoolOpPattern(mlir::MLIRContext *context, mlir::PatternBenefit benefit = 1)
-      : mlir::OpRewritePattern<FHE::ToBoolOp>(context, benefit) {}
+struct ToBoolOpPattern : public ScalarOpPattern<FHE::ToBoolOp> {
+  ToBoolOpPattern(mlir::TypeConverter &converter, mlir::MLIRContext *context,
+                  mlir::concretelang::ScalarLoweringParameters loweringParams,
+                  mlir::PatternBenefit benefit = 1)
+      : ScalarOpPattern<FHE::ToBoolOp>(converter, context, benefit),
+        loweringParameters(loweringParams) {}
 
   mlir::LogicalResult
-  matchAndRewrite(FHE::ToBoolOp op,
-                  mlir::PatternRewriter &rewriter) const override {
-    auto width =
-        op.getInput()
-            .getType()
-            .dyn_cast<mlir::concretelang::FHE::EncryptedUnsignedIntegerType>()
-            .getWidth();
-    if (width == mlir::concretelang::FHE::EncryptedBooleanType::getWidth()) {
-      rewriter.replaceOp(op, op.getInput());
-      return mlir::success();
-    }
-    // TODO
-    op->emitError("only support conversion with width 2 for the moment");
-    return mlir::failure();
+  matchAndRewrite(FHE::ToBoolOp op, FHE::ToBoolOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+    mlir::Value result = writeBooleanCast(
+        op, adaptor.getInput(), op.getInput().getType().getWidth(),
+        FHE::EncryptedBooleanType::getWidth(),
+        loweringParameters.polynomialSize, rewriter);
+    rewriter.replaceOp(op, result);
+    return mlir::success();
   }
+
+private:
+  mlir::concretelang::ScalarLoweringParameters loweringParameters;
 };
 
 /// Rewriter for the `FHE::from_bool` operation.
-struct FromBoolOpPattern : public mlir::OpRewritePattern<FHE::FromBoolOp> {
-  FromBoolOpPattern(mlir::MLIRContext *context,
+struct FromBoolOpPattern : public ScalarOpPattern<FHE::FromBoolOp> {
+  FromBoolOpPattern(mlir::TypeConverter &converter, mlir::MLIRContext *context,
+                    mlir::concretelang::ScalarLoweringParameters loweringParams,
                     mlir::PatternBenefit benefit = 1)
-      : mlir::OpRewritePattern<FHE::FromBoolOp>(context, benefit) {}
+      : ScalarOpPattern<FHE::FromBoolOp>(converter, context, benefit),
+        loweringParameters(loweringParams) {}
 
   mlir::LogicalResult
-  matchAndRewrite(FHE::FromBoolOp op,
-                  mlir::PatternRewriter &rewriter) const override {
-    auto width =
-        op.getResult()
-            .getType()
-            .dyn_cast<mlir::concretelang::FHE::EncryptedUnsignedIntegerType>()
-            .getWidth();
-    if (width == mlir::concretelang::FHE::EncryptedBooleanType::getWidth()) {
-      rewriter.replaceOp(op, op.getInput());
-      return mlir::success();
-    }
-    // TODO
-    op->emitError("only support conversion with width 2 for the moment");
-    return mlir::failure();
+  matchAndRewrite(FHE::FromBoolOp op, FHE::FromBoolOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+    mlir::Value result = writeBooleanCast(
+        op, adaptor.getInput(), FHE::EncryptedBooleanType::getWidth(),
+        op.getResult().getType().getWidth(), loweringParameters.polynomialSize,
+        rewriter);
+    rewriter.replaceOp(op, result);
+    return mlir::success();
   }
+
+private:
+  mlir::concretelang::ScalarLoweringParameters loweringParameters;
 };
 
 } // namespace lowering
@@ -839,7 +903,7 @@ struct FHEToTFHEScalarPass : public FHEToTFHEScalarBase<FHEToTFHEScalarPass> {
 
     // Patterns for boolean conversion ops
     patterns.add<lowering::FromBoolOpPattern, lowering::ToBoolOpPattern>(
-        &getContext());
+        converter, &getContext(), loweringParameters);
 
     // Patterns for the relics of the `FHELinalg` dialect operations.
     //    |_ `linalg::generic` turned to nested `scf::for`
@@ -465,6 +465,96 @@ struct BootstrapGLWEOpPattern
   }
 };
 
+/// Simulates the many-lut bootstrap as one simulated bootstrap per lookup
+/// table. Extracting the sample at coefficient `j * sampleStride` of the
+/// rotated accumulator is the same as bootstrapping the input shifted by
+/// `j * sampleStride` steps of the modulus switched torus.
+struct ManyLUTBootstrapGLWEOpPattern
+    : public mlir::OpConversionPattern<TFHE::ManyLUTBootstrapGLWEOp> {
+
+  ManyLUTBootstrapGLWEOpPattern(mlir::MLIRContext *context,
+                                mlir::TypeConverter &typeConverter)
+      : mlir::OpConversionPattern<TFHE::ManyLUTBootstrapGLWEOp>(
+            typeConverter, context,
+            mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  ::mlir::LogicalResult
+  matchAndRewrite(TFHE::ManyLUTBootstrapGLWEOp bsOp,
+                  TFHE::ManyLUTBootstrapGLWEOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+
+    const std::string funcName = "sim_bootstrap_lwe_u64";
+
+    auto loc = bsOp.getLoc();
+    TFHE::GLWECipherTextType inputType =
+        bsOp.getCiphertext().getType().cast<TFHE::GLWECipherTextType>();
+    auto resultType = this->getTypeConverter()
+                          ->convertType(bsOp.getType())
+                          .cast<mlir::RankedTensorType>();
+
+    auto polySize = adaptor.getKey().getPolySize();
+    auto glweDimension = adaptor.getKey().getGlweDim();
+    auto levels = adaptor.getKey().getLevels();
+    auto baseLog = adaptor.getKey().getBaseLog();
+    auto inputLweDimension =
+        inputType.getKey().getNormalized().value().dimension;
+
+    auto polySizeCst =
+        rewriter.create<mlir::arith::ConstantIntOp>(loc, polySize, 32);
+    auto glweDimensionCst =
+        rewriter.create<mlir::arith::ConstantIntOp>(loc, glweDimension, 32);
+    auto levelsCst =
+        rewriter.create<mlir::arith::ConstantIntOp>(loc, levels, 32);
+    auto baseLogCst =
+        rewriter.create<mlir::arith::ConstantIntOp>(loc, baseLog, 32);
+    auto inputLweDimensionCst =
+        rewriter.create<mlir::arith::ConstantIntOp>(loc, inputLweDimension, 32);
+
+    auto dynamicLutType = toDynamicTensorType(bsOp.getLookupTable().getType());
+
+    mlir::Value castedLUT = rewriter.create<mlir::tensor::CastOp>(
+        loc, dynamicLutType, adaptor.getLookupTable());
+
+    if (insertForwardDeclaration(
+            bsOp, rewriter, funcName,
+            rewriter.getFunctionType(
+                {rewriter.getIntegerType(64), dynamicLutType,
+                 rewriter.getIntegerType(32), rewriter.getIntegerType(32),
+                 rewriter.getIntegerType(32), rewriter.getIntegerType(32),
+                 rewriter.getIntegerType(32)},
+                {rewriter.getIntegerType(64)}))
+            .failed()) {
+      return mlir::failure();
+    }
+
+    // One step of the modulus switched torus of size `2 * polySize`
+    uint64_t step = (uint64_t)1 << (64 - llvm::Log2_64(2 * polySize));
+
+    llvm::SmallVector<mlir::Value> results;
+    for (int64_t j = 0; j < resultType.getShape()[0]; j++) {
+      mlir::Value input = adaptor.getCiphertext();
+      if (j != 0) {
+        mlir::Value offset = rewriter.create<mlir::arith::ConstantIntOp>(
+            loc, j * bsOp.getSampleStride() * step, 64);
+        input = rewriter.create<mlir::arith::AddIOp>(loc, input, offset);
+      }
+      results.push_back(
+          rewriter
+              .create<mlir::func::CallOp>(
+                  loc, funcName, rewriter.getIntegerType(64),
+                  mlir::ValueRange({input, castedLUT, inputLweDimensionCst,
+                                    polySizeCst, levelsCst, baseLogCst,
+                                    glweDimensionCst}))
+              .getResult(0));
+    }
+
+    rewriter.replaceOpWithNewOp<mlir::tensor::FromElementsOp>(bsOp, resultType,
+                                                              results);
+
+    return mlir::success();
+  }
+};
+
 struct KeySwitchGLWEOpPattern
     : public mlir::OpConversionPattern<TFHE::KeySwitchGLWEOp> {
 
@@ -640,8 +730,8 @@ void SimulateTFHEPass::runOnOperation() {
   });
 
   patterns.insert<ZeroOpPattern, ZeroTensorOpPattern, KeySwitchGLWEOpPattern,
-                  BootstrapGLWEOpPattern, WopPBSGLWEOpPattern,
-                  EncodeExpandLutForBootstrapOpPattern,
+                  BootstrapGLWEOpPattern, ManyLUTBootstrapGLWEOpPattern,
+                  WopPBSGLWEOpPattern, EncodeExpandLutForBootstrapOpPattern,
                   EncodeLutForCrtWopPBSOpPattern,
                   EncodePlaintextWithCrtOpPattern, NegOpPattern>(&getContext(),
                                                                  converter);
@@ -157,11 +157,15 @@ struct BootstrapGLWEOpPattern
         bsOp->getContext(), newInputKey, newOutputKey,
         cryptoParameters.getPolynomialSize(), cryptoParameters.glweDimension,
         cryptoParameters.brLevel, cryptoParameters.brLogBase, -1);
+    auto manyLUT = bsOp->getAttr("TFHE.many_lut");
     auto newOp = rewriter.replaceOpWithNewOp<TFHE::BootstrapGLWEOp>(
         bsOp, newOutputTy, bsOp.getCiphertext(), bsOp.getLookupTable(),
         bootstrapKey);
     rewriter.startRootUpdate(newOp);
     newOp.getCiphertext().setType(newInputTy);
+    // Keep the many-lut marker for the packing of the bootstraps
+    if (manyLUT != nullptr)
+      newOp->setAttr("TFHE.many_lut", manyLUT);
     rewriter.finalizeRootUpdate(newOp);
     return mlir::success();
   };
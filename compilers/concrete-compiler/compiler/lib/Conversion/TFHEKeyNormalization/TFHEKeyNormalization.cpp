@@ -204,6 +204,37 @@ private:
   conversion::TypeConverter &typeConverter;
 };
 
+struct ManyLUTBootstrapGLWEOpPattern
+    : public mlir::OpRewritePattern<TFHE::ManyLUTBootstrapGLWEOp> {
+  ManyLUTBootstrapGLWEOpPattern(mlir::MLIRContext *context,
+                                conversion::TypeConverter &typeConverter,
+                                conversion::KeyConverter &keyConverter,
+                                mlir::PatternBenefit benefit =
+                                    mlir::concretelang::DEFAULT_PATTERN_BENEFIT)
+      : mlir::OpRewritePattern<TFHE::ManyLUTBootstrapGLWEOp>(context, benefit),
+        keyConverter(keyConverter), typeConverter(typeConverter) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(TFHE::ManyLUTBootstrapGLWEOp bsOp,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto newInputTy = typeConverter.convertType(bsOp.getCiphertext().getType())
+                          .cast<GLWECipherTextType>();
+    auto newOutputTy = typeConverter.convertType(bsOp.getResult().getType());
+    auto newBootstrapKey = keyConverter.convertBootstrapKey(bsOp.getKeyAttr());
+    auto newOp = rewriter.replaceOpWithNewOp<TFHE::ManyLUTBootstrapGLWEOp>(
+        bsOp, newOutputTy, bsOp.getCiphertext(), bsOp.getLookupTable(),
+        newBootstrapKey, bsOp.getSampleStrideAttr());
+    rewriter.startRootUpdate(newOp);
+    newOp.getCiphertext().setType(newInputTy);
+    rewriter.finalizeRootUpdate(newOp);
+    return mlir::success();
+  };
+
+private:
+  conversion::KeyConverter &keyConverter;
+  conversion::TypeConverter &typeConverter;
+};
+
 struct WopPBSGLWEOpPattern : public mlir::OpRewritePattern<TFHE::WopPBSGLWEOp> {
   WopPBSGLWEOpPattern(mlir::MLIRContext *context,
                       conversion::TypeConverter &typeConverter,
@@ -341,6 +372,16 @@ void TFHEKeyNormalizationPass::runOnOperation() {
                  op.getKeyAttr().getIndex() != -1;
         });
 
+    // Parametrize many-lut bootstrap
+    patterns.add<patterns::ManyLUTBootstrapGLWEOpPattern>(
+        &getContext(), typeConverter, keyConverter);
+    target.addDynamicallyLegalOp<TFHE::ManyLUTBootstrapGLWEOp>(
+        [&](TFHE::ManyLUTBootstrapGLWEOp op) {
+          return op.getKeyAttr().getInputKey().isNormalized() &&
+                 op.getKeyAttr().getOutputKey().isNormalized() &&
+                 op.getKeyAttr().getIndex() != -1;
+        });
+
     // Parametrize wop pbs
     patterns.add<patterns::WopPBSGLWEOpPattern>(&getContext(), typeConverter,
                                                 keyConverter);
@@ -259,6 +259,40 @@ struct BatchedMappedBootstrapGLWEOpPattern
   }
 };
 
+struct ManyLUTBootstrapGLWEOpPattern
+    : public mlir::OpConversionPattern<TFHE::ManyLUTBootstrapGLWEOp> {
+
+  ManyLUTBootstrapGLWEOpPattern(mlir::MLIRContext *context,
+                                mlir::TypeConverter &typeConverter)
+      : mlir::OpConversionPattern<TFHE::ManyLUTBootstrapGLWEOp>(
+            typeConverter, context,
+            mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  ::mlir::LogicalResult
+  matchAndRewrite(TFHE::ManyLUTBootstrapGLWEOp mbsOp,
+                  TFHE::ManyLUTBootstrapGLWEOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+    TFHE::GLWECipherTextType inputType =
+        mbsOp.getCiphertext().getType().cast<TFHE::GLWECipherTextType>();
+
+    auto polySize = adaptor.getKey().getPolySize();
+    auto glweDimension = adaptor.getKey().getGlweDim();
+    auto levels = adaptor.getKey().getLevels();
+    auto baseLog = adaptor.getKey().getBaseLog();
+    auto inputLweDimension =
+        inputType.getKey().getNormalized().value().dimension;
+    auto bskIndex = mbsOp.getKeyAttr().getIndex();
+
+    rewriter.replaceOpWithNewOp<Concrete::ManyLUTBootstrapLweTensorOp>(
+        mbsOp, this->getTypeConverter()->convertType(mbsOp.getType()),
+        adaptor.getCiphertext(), adaptor.getLookupTable(), inputLweDimension,
+        polySize, levels, baseLog, glweDimension, bskIndex,
+        adaptor.getSampleStride());
+
+    return mlir::success();
+  }
+};
+
 struct KeySwitchGLWEOpPattern
     : public mlir::OpConversionPattern<TFHE::KeySwitchGLWEOp> {
 
@@ -899,7 +933,8 @@ void TFHEToConcretePass::runOnOperation() {
                   ZeroOpPattern<mlir::concretelang::TFHE::ZeroTensorGLWEOp>,
                   SubIntGLWEOpPattern, BootstrapGLWEOpPattern,
                   BatchedBootstrapGLWEOpPattern,
-                  BatchedMappedBootstrapGLWEOpPattern, KeySwitchGLWEOpPattern,
+                  BatchedMappedBootstrapGLWEOpPattern,
+                  ManyLUTBootstrapGLWEOpPattern, KeySwitchGLWEOpPattern,
                   BatchedKeySwitchGLWEOpPattern, WopPBSGLWEOpPattern>(
       &getContext(), converter);
 
@@ -0,0 +1,271 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+
+#include "concretelang/Conversion/Tools.h"
+#include "concretelang/Dialect/Concrete/Transforms/Passes.h"
+#include "concretelang/Dialect/RT/IR/RTTypes.h"
+
+namespace RT = mlir::concretelang::RT;
+
+namespace {
+
+char memref_keyswitch_lwe_u64[] = "memref_keyswitch_lwe_u64";
+char memref_bootstrap_lwe_u64[] = "memref_bootstrap_lwe_u64";
+char memref_keyswitch_async_lwe_u64[] = "memref_keyswitch_async_lwe_u64";
+char memref_bootstrap_async_lwe_u64[] = "memref_bootstrap_async_lwe_u64";
+char memref_await_future[] = "memref_await_future";
+
+/// Returns the buffer of which `value` is a view
+mlir::Value getAliasRoot(mlir::Value value) {
+  while (mlir::Operation *op = value.getDefiningOp()) {
+    if (auto castOp = llvm::dyn_cast<mlir::memref::CastOp>(op))
+      value = castOp.getSource();
+    else if (auto viewOp = llvm::dyn_cast<mlir::ViewLikeOpInterface>(op))
+      value = viewOp.getViewSource();
+    else
+      break;
+  }
+  return value;
+}
+
+/// Returns true if the buffer `root` is allocated in the function, and thus
+/// cannot alias a buffer allocated elsewhere
+bool isLocalAllocation(mlir::Value root) {
+  return root.getDefiningOp<mlir::memref::AllocOp>() ||
+         root.getDefiningOp<mlir::memref::AllocaOp>();
+}
+
+/// Returns true if the buffer `root` is an argument of its function, i.e. is
+/// allocated by the caller
+bool isFunctionArgument(mlir::Value root) {
+  auto arg = root.dyn_cast<mlir::BlockArgument>();
+  return arg && arg.getOwner()->isEntryBlock() &&
+         llvm::isa<mlir::func::FuncOp>(arg.getOwner()->getParentOp());
+}
+
+/// Returns true if the buffers `root` and `other` may be the same. Only the
+/// local allocations, the function arguments and the globals are known to be
+/// distinct buffers: any other root, e.g. a loop-carried block argument or
+/// the result of a region operation, may be any of them.
+bool mayAlias(mlir::Value root, mlir::Value other) {
+  if (root == other)
+    return true;
+  auto rootGlobal = root.getDefiningOp<mlir::memref::GetGlobalOp>();
+  auto otherGlobal = other.getDefiningOp<mlir::memref::GetGlobalOp>();
+  if (rootGlobal && otherGlobal)
+    return rootGlobal.getName() == otherGlobal.getName();
+  if (isLocalAllocation(root))
+    return !isLocalAllocation(other) && !isFunctionArgument(other) &&
+           !otherGlobal;
+  if (isLocalAllocation(other))
+    return !isFunctionArgument(root) && !rootGlobal;
+  return true;
+}
+
+/// Calls `access(buffer, isWrite)` for each buffer read or written by `op`,
+/// with a null buffer for accesses to unknown buffers
+void forEachAccess(mlir::Operation *op,
+                   llvm::function_ref<void(mlir::Value, bool)> access) {
+  // The functions of the runtime handled by the pass write their first
+  // operand and read the others
+  if (auto callOp = llvm::dyn_cast<mlir::func::CallOp>(op)) {
+    llvm::StringRef callee = callOp.getCallee();
+    if (callee == memref_keyswitch_lwe_u64 ||
+        callee == memref_bootstrap_lwe_u64 ||
+        callee == memref_keyswitch_async_lwe_u64 ||
+        callee == memref_bootstrap_async_lwe_u64 ||
+        callee == memref_await_future) {
+      for (auto &operand : op->getOpOperands())
+        if (operand.get().getType().isa<mlir::MemRefType>())
+          access(operand.get(), operand.getOperandNumber() == 0);
+      return;
+    }
+  }
+  auto effectOp = llvm::dyn_cast<mlir::MemoryEffectOpInterface>(op);
+  if (!effectOp) {
+    for (mlir::Value operand : op->getOperands())
+      if (operand.getType().isa<mlir::MemRefType>())
+        access(operand, true);
+    return;
+  }
+  llvm::SmallVector<mlir::MemoryEffects::EffectInstance> effects;
+  effectOp.getEffects(effects);
+  for (auto &effect : effects)
+    access(effect.getValue(),
+           !llvm::isa<mlir::MemoryEffects::Read>(effect.getEffect()));
+}
+
+/// Returns true if `op` or one of its nested operations accesses the buffer
+/// `outRoot` written by an asynchronous call, or writes one of the buffers
+/// `inRoots` it reads
+bool conflicts(mlir::Operation *op, mlir::Value outRoot,
+               llvm::ArrayRef<mlir::Value> inRoots) {
+  return op
+      ->walk([&](mlir::Operation *nested) {
+        if (mlir::isMemoryEffectFree(nested))
+          return mlir::WalkResult::advance();
+        bool conflict = false;
+        forEachAccess(nested, [&](mlir::Value buffer, bool isWrite) {
+          if (!buffer) {
+            conflict = true;
+            return;
+          }
+          mlir::Value root = getAliasRoot(buffer);
+          conflict |= mayAlias(root, outRoot) ||
+                      (isWrite && llvm::any_of(inRoots, [&](mlir::Value in) {
+                         return mayAlias(root, in);
+                       }));
+        });
+        return conflict ? mlir::WalkResult::interrupt()
+                        : mlir::WalkResult::advance();
+      })
+      .wasInterrupted();
+}
+
+/// Returns the last operation of the block of `op` defining one of its
+/// operands, or nullptr if all operands are defined outside of the block
+mlir::Operation *lastOperandDefinition(mlir::Operation *op) {
+  mlir::Operation *last = nullptr;
+  for (mlir::Value operand : op->getOperands()) {
+    mlir::Operation *def = operand.getDefiningOp();
+    if (def && def->getBlock() == op->getBlock() &&
+        (!last || last->isBeforeInBlock(def)))
+      last = def;
+  }
+  return last;
+}
+
+/// Moves `op` right after `after`, or at the start of its block if `after`
+/// is nullptr
+void moveAfterOrToFront(mlir::Operation *op, mlir::Operation *after) {
+  if (after)
+    op->moveAfter(after);
+  else if (op != &op->getBlock()->front())
+    op->moveBefore(&op->getBlock()->front());
+}
+
+/// Moves the side effect free operation `op`, and the side effect free
+/// operations of its block defining its operands, as early as possible
+void hoistPure(mlir::Operation *op) {
+  for (mlir::Value operand : op->getOperands()) {
+    mlir::Operation *def = operand.getDefiningOp();
+    if (def && def->getBlock() == op->getBlock() && def->getNumRegions() == 0 &&
+        mlir::isMemoryEffectFree(def))
+      hoistPure(def);
+  }
+  moveAfterOrToFront(op, lastOperandDefinition(op));
+}
+
+/// Replaces the synchronous call `callOp` by a call to `asyncCallee` issued
+/// as early as possible, and awaits its future as late as possible
+mlir::LogicalResult offload(mlir::func::CallOp callOp,
+                            llvm::StringRef asyncCallee) {
+  mlir::OpBuilder builder(callOp);
+  auto futureType = RT::FutureType::get(builder.getIndexType());
+
+  mlir::Value outRoot = getAliasRoot(callOp.getOperand(0));
+  llvm::SmallVector<mlir::Value> inRoots;
+  for (mlir::Value operand : callOp.getOperands().drop_front())
+    if (operand.getType().isa<mlir::MemRefType>())
+      inRoots.push_back(getAliasRoot(operand));
+
+  // Issue the call right after the definition of its operands or the last
+  // operation conflicting with its accesses
+  for (mlir::Value operand : callOp.getOperands()) {
+    mlir::Operation *def = operand.getDefiningOp();
+    if (def && def->getBlock() == callOp->getBlock() &&
+        def->getNumRegions() == 0 && mlir::isMemoryEffectFree(def))
+      hoistPure(def);
+  }
+  mlir::Operation *issuePoint = lastOperandDefinition(callOp);
+  for (mlir::Operation *prev = callOp->getPrevNode(); prev != issuePoint;
+       prev = prev->getPrevNode()) {
+    if (conflicts(prev, outRoot, inRoots)) {
+      issuePoint = prev;
+      break;
+    }
+  }
+  moveAfterOrToFront(callOp, issuePoint);
+
+  auto asyncType = mlir::FunctionType::get(
+      builder.getContext(), callOp.getOperandTypes(), {futureType});
+  if (insertForwardDeclaration(callOp, builder, asyncCallee, asyncType)
+          .failed())
+    return mlir::failure();
+  builder.setInsertionPoint(callOp);
+  auto asyncOp = builder.create<mlir::func::CallOp>(
+      callOp.getLoc(), asyncCallee, mlir::TypeRange{futureType},
+      callOp.getOperands());
+
+  // Await the result right before the first operation conflicting with the
+  // accesses of the call, the output being written in place. The inputs
+  // freed in between are freed after the await instead.
+  llvm::SmallVector<mlir::Operation *> deferredDeallocs;
+  mlir::Operation *awaitPoint = callOp->getNextNode();
+  while (!awaitPoint->hasTrait<mlir::OpTrait::IsTerminator>()) {
+    if (conflicts(awaitPoint, outRoot, inRoots)) {
+      auto deallocOp = llvm::dyn_cast<mlir::memref::DeallocOp>(awaitPoint);
+      if (!deallocOp ||
+          mayAlias(getAliasRoot(deallocOp.getMemref()), outRoot))
+        break;
+      deferredDeallocs.push_back(deallocOp);
+    }
+    awaitPoint = awaitPoint->getNextNode();
+  }
+
+  mlir::Value out = callOp.getOperand(0);
+  auto awaitType = mlir::FunctionType::get(
+      builder.getContext(), {out.getType(), futureType, out.getType()}, {});
+  if (insertForwardDeclaration(callOp, builder, memref_await_future, awaitType)
+          .failed())
+    return mlir::failure();
+  builder.setInsertionPoint(awaitPoint);
+  mlir::Operation *awaitOp = builder.create<mlir::func::CallOp>(
+      callOp.getLoc(), memref_await_future, mlir::TypeRange{},
+      mlir::ValueRange{out, asyncOp.getResult(0), out});
+  for (mlir::Operation *deallocOp : deferredDeallocs) {
+    deallocOp->moveAfter(awaitOp);
+    awaitOp = deallocOp;
+  }
+
+  callOp.erase();
+  return mlir::success();
+}
+
+struct AsyncOffloadPass : public AsyncOffloadBase<AsyncOffloadPass> {
+  void runOnOperation() override {
+    llvm::SmallVector<mlir::func::CallOp> calls;
+    getOperation().walk([&](mlir::func::CallOp callOp) {
+      if (callOp.getCallee() == memref_keyswitch_lwe_u64 ||
+          callOp.getCallee() == memref_bootstrap_lwe_u64)
+        calls.push_back(callOp);
+    });
+
+    for (mlir::func::CallOp callOp : calls) {
+      llvm::StringRef asyncCallee =
+          callOp.getCallee() == memref_keyswitch_lwe_u64
+              ? memref_keyswitch_async_lwe_u64
+              : memref_bootstrap_async_lwe_u64;
+      if (offload(callOp, asyncCallee).failed())
+        return signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<OperationPass<ModuleOp>> createAsyncOffloadPass() {
+  return std::make_unique<AsyncOffloadPass>();
+}
+} // namespace concretelang
+} // namespace mlir
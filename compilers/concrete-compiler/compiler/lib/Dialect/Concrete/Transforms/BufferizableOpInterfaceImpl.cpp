@@ -164,6 +164,20 @@ void mlir::concretelang::Concrete::
     Concrete::BatchedMappedBootstrapLweTensorOp::attachInterface<
         TensorToMemrefOp<Concrete::BatchedMappedBootstrapLweTensorOp,
                          Concrete::BatchedMappedBootstrapLweBufferOp>>(*ctx);
+    // many_lut_bootstrap_lwe_tensor => many_lut_bootstrap_lwe_buffer
+    Concrete::ManyLUTBootstrapLweTensorOp::attachInterface<
+        TensorToMemrefOp<Concrete::ManyLUTBootstrapLweTensorOp,
+                         Concrete::ManyLUTBootstrapLweBufferOp>>(*ctx);
+    // keyswitch_bootstrap_lwe_tensor => keyswitch_bootstrap_lwe_buffer
+    Concrete::KeySwitchBootstrapLweTensorOp::attachInterface<
+        TensorToMemrefOp<Concrete::KeySwitchBootstrapLweTensorOp,
+                         Concrete::KeySwitchBootstrapLweBufferOp>>(*ctx);
+    // batched_keyswitch_bootstrap_lwe_tensor =>
+    // batched_keyswitch_bootstrap_lwe_buffer
+    Concrete::BatchedKeySwitchBootstrapLweTensorOp::attachInterface<
+        TensorToMemrefOp<Concrete::BatchedKeySwitchBootstrapLweTensorOp,
+                         Concrete::BatchedKeySwitchBootstrapLweBufferOp>>(
+        *ctx);
     // wop_pbs_crt_lwe_tensor => wop_pbs_crt_lwe_buffer
     Concrete::WopPBSCRTLweTensorOp::attachInterface<TensorToMemrefOp<
         Concrete::WopPBSCRTLweTensorOp, Concrete::WopPBSCRTLweBufferOp>>(*ctx);
@@ -0,0 +1,75 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Dialect/Concrete/Transforms/Passes.h"
+
+namespace Concrete = mlir::concretelang::Concrete;
+
+namespace {
+
+/// Replaces the bootstrap `bootstrapOp` of type `BootstrapOp` by a fused
+/// operation of type `FusedOp` if its input ciphertext is computed by a
+/// keyswitch of type `KeySwitchOp` that has no other use.
+template <typename KeySwitchOp, typename BootstrapOp, typename FusedOp>
+void fuse(BootstrapOp bootstrapOp) {
+  auto keyswitchOp =
+      bootstrapOp.getInputCiphertext().template getDefiningOp<KeySwitchOp>();
+  if (!keyswitchOp || !keyswitchOp->hasOneUse() ||
+      keyswitchOp.getLweDimOut() != bootstrapOp.getInputLweDim())
+    return;
+
+  mlir::OpBuilder builder(bootstrapOp);
+  auto fusedOp = builder.create<FusedOp>(
+      bootstrapOp.getLoc(), bootstrapOp.getType(),
+      keyswitchOp.getCiphertext(), bootstrapOp.getLookupTable(),
+      keyswitchOp.getLevelAttr(), keyswitchOp.getBaseLogAttr(),
+      keyswitchOp.getLweDimInAttr(), bootstrapOp.getInputLweDimAttr(),
+      bootstrapOp.getPolySizeAttr(), bootstrapOp.getLevelAttr(),
+      bootstrapOp.getBaseLogAttr(), bootstrapOp.getGlweDimensionAttr(),
+      keyswitchOp.getKskIndexAttr(), bootstrapOp.getBskIndexAttr());
+
+  bootstrapOp.getResult().replaceAllUsesWith(fusedOp.getResult());
+  bootstrapOp.erase();
+  keyswitchOp.erase();
+}
+
+struct ConcreteKeyswitchBootstrapFusionPass
+    : public ConcreteKeyswitchBootstrapFusionBase<
+          ConcreteKeyswitchBootstrapFusionPass> {
+  void runOnOperation() override {
+    llvm::SmallVector<mlir::Operation *> bootstraps;
+    getOperation().walk([&](mlir::Operation *op) {
+      if (llvm::isa<Concrete::BootstrapLweTensorOp,
+                    Concrete::BatchedBootstrapLweTensorOp>(op))
+        bootstraps.push_back(op);
+    });
+
+    for (mlir::Operation *op : bootstraps) {
+      if (auto bootstrapOp = llvm::dyn_cast<Concrete::BootstrapLweTensorOp>(op))
+        fuse<Concrete::KeySwitchLweTensorOp, Concrete::BootstrapLweTensorOp,
+             Concrete::KeySwitchBootstrapLweTensorOp>(bootstrapOp);
+      else
+        fuse<Concrete::BatchedKeySwitchLweTensorOp,
+             Concrete::BatchedBootstrapLweTensorOp,
+             Concrete::BatchedKeySwitchBootstrapLweTensorOp>(
+            llvm::cast<Concrete::BatchedBootstrapLweTensorOp>(op));
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<OperationPass<mlir::func::FuncOp>>
+createConcreteKeyswitchBootstrapFusionPass() {
+  return std::make_unique<ConcreteKeyswitchBootstrapFusionPass>();
+}
+} // namespace concretelang
+} // namespace mlir
@@ -0,0 +1,305 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/OpenMP/OpenMPDialect.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+#include "concretelang/Analysis/StaticLoops.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Dialect/Concrete/Transforms/Passes.h"
+
+namespace Concrete = mlir::concretelang::Concrete;
+namespace omp = mlir::omp;
+
+namespace {
+
+// Relative costs of the operations of an iteration, in keyswitches
+constexpr int64_t KEYSWITCH_COST = 1;
+constexpr int64_t BOOTSTRAP_COST = 50;
+
+/// The cost in keyswitches of the iterations dispatched at once by a dynamic
+/// schedule, below which the dispatch overhead is not amortized
+constexpr int64_t MIN_DYNAMIC_CHUNK_COST = 8;
+
+/// The keyswitches and bootstraps of an iteration of a parallel loop
+struct IterationCost {
+  int64_t keyswitches = 0;
+  int64_t bootstraps = 0;
+  /// Whether the iterations may cost differently, as some keyswitches or
+  /// bootstraps are conditional or in loops without a static trip count
+  bool uneven = false;
+
+  int64_t cost() const {
+    return keyswitches * KEYSWITCH_COST + bootstraps * BOOTSTRAP_COST;
+  }
+};
+
+/// Returns the number of ciphertexts of the batch `ciphertexts`, or
+/// std::nullopt if it is not static
+std::optional<int64_t> getBatchSize(mlir::Value ciphertexts) {
+  auto type = ciphertexts.getType().cast<mlir::MemRefType>();
+  if (!type.hasStaticShape())
+    return std::nullopt;
+  int64_t size = 1;
+  for (int64_t dim : type.getShape().drop_back())
+    size *= dim;
+  return size;
+}
+
+/// Adds to `cost` the keyswitches and bootstraps of `op` executed
+/// `tripCount` times, `conditional` telling if they may be skipped
+void accumulateOp(mlir::Operation *op, int64_t tripCount, bool conditional,
+                  IterationCost &cost) {
+  int64_t keyswitches = 0;
+  int64_t bootstraps = 0;
+  std::optional<int64_t> batchSize = 1;
+
+  if (llvm::isa<Concrete::KeySwitchLweBufferOp>(op)) {
+    keyswitches = 1;
+  } else if (llvm::isa<Concrete::BootstrapLweBufferOp,
+                       Concrete::ManyLUTBootstrapLweBufferOp>(op)) {
+    bootstraps = 1;
+  } else if (llvm::isa<Concrete::KeySwitchBootstrapLweBufferOp>(op)) {
+    keyswitches = 1;
+    bootstraps = 1;
+  } else if (auto batchedOp =
+                 llvm::dyn_cast<Concrete::BatchedKeySwitchLweBufferOp>(op)) {
+    keyswitches = 1;
+    batchSize = getBatchSize(batchedOp.getCiphertext());
+  } else if (auto batchedOp =
+                 llvm::dyn_cast<Concrete::BatchedBootstrapLweBufferOp>(op)) {
+    bootstraps = 1;
+    batchSize = getBatchSize(batchedOp.getInputCiphertext());
+  } else if (auto batchedOp =
+                 llvm::dyn_cast<Concrete::BatchedMappedBootstrapLweBufferOp>(
+                     op)) {
+    bootstraps = 1;
+    batchSize = getBatchSize(batchedOp.getInputCiphertext());
+  } else if (auto batchedOp = llvm::dyn_cast<
+                 Concrete::BatchedKeySwitchBootstrapLweBufferOp>(op)) {
+    keyswitches = 1;
+    bootstraps = 1;
+    batchSize = getBatchSize(batchedOp.getInputCiphertext());
+  } else if (auto wopPBSOp =
+                 llvm::dyn_cast<Concrete::WopPBSCRTLweBufferOp>(op)) {
+    // A keyswitch and a bootstrap per extracted bit, at least one per block
+    // of the decomposition
+    keyswitches = 1;
+    bootstraps = 1;
+    batchSize = wopPBSOp.getCrtDecomposition().size();
+  } else {
+    return;
+  }
+
+  if (!batchSize.has_value())
+    cost.uneven = true;
+  cost.keyswitches += keyswitches * batchSize.value_or(1) * tripCount;
+  cost.bootstraps += bootstraps * batchSize.value_or(1) * tripCount;
+  cost.uneven |= conditional;
+}
+
+/// Adds to `cost` the keyswitches and bootstraps of the operations of
+/// `region` executed `tripCount` times
+void accumulateRegion(mlir::Region &region, int64_t tripCount,
+                      bool conditional, IterationCost &cost) {
+  for (mlir::Block &block : region) {
+    for (mlir::Operation &op : block) {
+      if (auto forOp = llvm::dyn_cast<mlir::scf::ForOp>(op)) {
+        std::optional<int64_t> count =
+            mlir::concretelang::tryGetStaticTripCount(forOp);
+        accumulateRegion(forOp.getRegion(), tripCount * count.value_or(1),
+                         conditional || !count.has_value(), cost);
+      } else if (llvm::isa<mlir::scf::IfOp, mlir::scf::WhileOp,
+                           mlir::scf::IndexSwitchOp>(op)) {
+        for (mlir::Region &nested : op.getRegions())
+          accumulateRegion(nested, tripCount, true, cost);
+      } else {
+        accumulateOp(&op, tripCount, conditional, cost);
+        for (mlir::Region &nested : op.getRegions())
+          accumulateRegion(nested, tripCount, conditional, cost);
+      }
+    }
+  }
+}
+
+/// Replaces the nested parallel loop `parallelOp` by a nest of sequential
+/// loops, as the nested parallel regions would only oversubscribe the
+/// threads of the enclosing one
+void serialize(mlir::scf::ParallelOp parallelOp) {
+  mlir::OpBuilder builder(parallelOp);
+  mlir::IRMapping mapping;
+
+  for (auto [lb, ub, step, iv] : llvm::zip(
+           parallelOp.getLowerBound(), parallelOp.getUpperBound(),
+           parallelOp.getStep(), parallelOp.getInductionVars())) {
+    auto forOp = builder.create<mlir::scf::ForOp>(parallelOp.getLoc(), lb, ub,
+                                                  step);
+    mapping.map(iv, forOp.getInductionVar());
+    builder.setInsertionPointToStart(forOp.getBody());
+  }
+
+  for (mlir::Operation &op : parallelOp.getBody()->without_terminator())
+    builder.clone(op, mapping);
+
+  parallelOp.erase();
+}
+
+/// Returns true if `op` may be moved before the parallel loops preceding it
+/// in its block
+bool isHoistable(mlir::Operation *op) {
+  if (op->getNumRegions() != 0 || op->hasTrait<mlir::OpTrait::IsTerminator>())
+    return false;
+  if (mlir::isMemoryEffectFree(op))
+    return true;
+  auto effectOp = llvm::dyn_cast<mlir::MemoryEffectOpInterface>(op);
+  if (!effectOp)
+    return false;
+  llvm::SmallVector<mlir::MemoryEffects::EffectInstance> effects;
+  effectOp.getEffects(effects);
+  return llvm::all_of(effects, [](auto &effect) {
+    return llvm::isa<mlir::MemoryEffects::Allocate>(effect.getEffect());
+  });
+}
+
+bool isConvertible(mlir::Operation *op) {
+  auto parallelOp = llvm::dyn_cast<mlir::scf::ParallelOp>(op);
+  return parallelOp && parallelOp.getNumReductions() == 0;
+}
+
+struct ConcreteSCFToOpenMPPass
+    : public ConcreteSCFToOpenMPBase<ConcreteSCFToOpenMPPass> {
+
+  void runOnOperation() override {
+    mlir::ModuleOp module = getOperation();
+
+    // Serialize the nested parallel loops, innermost first
+    llvm::SmallVector<mlir::scf::ParallelOp> nested;
+    module.walk([&](mlir::scf::ParallelOp parallelOp) {
+      if (isConvertible(parallelOp) &&
+          parallelOp->getParentOfType<mlir::scf::ParallelOp>())
+        nested.push_back(parallelOp);
+    });
+    for (mlir::scf::ParallelOp parallelOp : nested)
+      serialize(parallelOp);
+
+    // Group the consecutive parallel loops of each block, separated at most
+    // by operations that can be hoisted before the group
+    llvm::SmallVector<llvm::SmallVector<mlir::scf::ParallelOp>> groups;
+    module.walk([&](mlir::Block *block) {
+      for (auto it = block->begin(); it != block->end();) {
+        if (!isConvertible(&*it)) {
+          ++it;
+          continue;
+        }
+        mlir::Operation *first = &*it;
+        llvm::SmallVector<mlir::scf::ParallelOp> group;
+        llvm::SmallVector<mlir::Operation *> hoisted;
+        auto end = it;
+        for (auto next = it; next != block->end(); ++next) {
+          if (isConvertible(&*next)) {
+            group.push_back(llvm::cast<mlir::scf::ParallelOp>(*next));
+            end = std::next(next);
+          } else if (!isHoistable(&*next)) {
+            break;
+          }
+        }
+        // Only hoist the operations between the loops of the group
+        for (auto op = std::next(it); op != end; ++op)
+          if (!isConvertible(&*op))
+            hoisted.push_back(&*op);
+        for (mlir::Operation *op : hoisted)
+          op->moveBefore(first);
+        groups.push_back(std::move(group));
+        it = end;
+      }
+    });
+
+    for (auto &group : groups)
+      convert(group);
+  }
+
+  /// Replaces the consecutive parallel loops `group` by worksharing loops
+  /// of a single parallel region, whose implicit barriers keep the order
+  /// of the loops
+  void convert(llvm::ArrayRef<mlir::scf::ParallelOp> group) {
+    mlir::OpBuilder builder(group.front());
+    auto parallelOp = builder.create<omp::ParallelOp>(group.front().getLoc());
+    builder.createBlock(&parallelOp.getRegion());
+
+    for (mlir::scf::ParallelOp loop : group) {
+      mlir::Location loc = loop.getLoc();
+      IterationCost cost;
+      accumulateRegion(loop.getRegion(), 1, false, cost);
+
+      auto wsLoopOp = builder.create<omp::WsLoopOp>(
+          loc, loop.getLowerBound(), loop.getUpperBound(), loop.getStep());
+      setSchedule(builder, wsLoopOp, cost);
+
+      mlir::OpBuilder::InsertionGuard guard(builder);
+      llvm::SmallVector<mlir::Type> types(loop.getNumLoops(),
+                                          builder.getIndexType());
+      llvm::SmallVector<mlir::Location> locs(loop.getNumLoops(), loc);
+      mlir::Block *body =
+          builder.createBlock(&wsLoopOp.getRegion(), {}, types, locs);
+      for (auto [iv, arg] :
+           llvm::zip(loop.getInductionVars(), body->getArguments()))
+        iv.replaceAllUsesWith(arg);
+
+      // Release the stack allocations of each iteration at its end
+      auto scopeOp = builder.create<mlir::memref::AllocaScopeOp>(
+          loc, mlir::TypeRange());
+      builder.create<omp::YieldOp>(loc, mlir::ValueRange());
+      mlir::Block *scope = builder.createBlock(&scopeOp.getBodyRegion());
+      scope->getOperations().splice(scope->end(),
+                                    loop.getBody()->getOperations(),
+                                    loop.getBody()->begin(),
+                                    std::prev(loop.getBody()->end()));
+      builder.create<mlir::memref::AllocaScopeReturnOp>(loc);
+    }
+
+    builder.create<omp::TerminatorOp>(parallelOp.getLoc());
+
+    for (mlir::scf::ParallelOp loop : group)
+      loop.erase();
+  }
+
+  /// Sets the schedule of `wsLoopOp` for iterations of cost `cost`: the
+  /// even iterations are statically split among the threads, the uneven
+  /// ones dispatched dynamically by chunks amortizing the dispatch
+  void setSchedule(mlir::OpBuilder &builder, omp::WsLoopOp wsLoopOp,
+                   const IterationCost &cost) {
+    mlir::MLIRContext *context = builder.getContext();
+
+    if (!cost.uneven || cost.cost() == 0) {
+      wsLoopOp.setScheduleValAttr(omp::ClauseScheduleKindAttr::get(
+          context, omp::ClauseScheduleKind::Static));
+      return;
+    }
+
+    int64_t chunk =
+        (MIN_DYNAMIC_CHUNK_COST + cost.cost() - 1) / cost.cost();
+    mlir::OpBuilder::InsertionGuard guard(builder);
+    builder.setInsertionPoint(wsLoopOp);
+    mlir::Value chunkValue = builder.create<mlir::arith::ConstantOp>(
+        wsLoopOp.getLoc(), builder.getI32IntegerAttr(chunk));
+    wsLoopOp.setScheduleValAttr(omp::ClauseScheduleKindAttr::get(
+        context, omp::ClauseScheduleKind::Dynamic));
+    wsLoopOp.getScheduleChunkVarMutable().assign(chunkValue);
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<OperationPass<ModuleOp>> createConcreteSCFToOpenMPPass() {
+  return std::make_unique<ConcreteSCFToOpenMPPass>();
+}
+} // namespace concretelang
+} // namespace mlir
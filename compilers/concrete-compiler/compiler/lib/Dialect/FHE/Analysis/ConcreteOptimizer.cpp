@@ -6,6 +6,7 @@
 #include <chrono>
 #include <cmath>
 #include <initializer_list>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -17,6 +18,7 @@
 #include "mlir/Pass/PassManager.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Pass.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "concrete-optimizer.hpp"
@@ -150,6 +152,9 @@ struct FunctionToDag {
     if (auto inputType = isLut(op); inputType != nullptr) {
       addLut(dag, op, inputType, encrypted_inputs, precision);
       return;
+    } else if (isBootstrappedBooleanCast(op)) {
+      addBooleanCastLut(dag, op, encrypted_inputs, precision);
+      return;
     } else if (isRound(op)) {
       index = addRound(dag, val, encrypted_inputs, precision);
     } else if (isReinterpretPrecision(op)) {
@@ -226,6 +231,22 @@ struct FunctionToDag {
     index[val] = lutIndex;
   }
 
+  // A cast between a boolean and an integer that can't be done leveled is
+  // lowered to a lookup table of the identity
+  void addBooleanCastLut(optimizer::Dag &dag, mlir::Operation &op,
+                         Inputs &encrypted_inputs, int precision) {
+    auto val = op.getResult(0);
+    assert(encrypted_inputs.size() == 1);
+    std::vector<std::uint64_t> unknowFunction;
+    auto lutIndex =
+        dag->add_lut(encrypted_inputs[0], slice(unknowFunction), precision);
+    mlir::Builder builder(op.getContext());
+    if (setOptimizerID)
+      op.setAttr("TFHE.OId",
+                 builder.getDenseI32ArrayAttr({(int32_t)lutIndex.index}));
+    index[val] = lutIndex;
+  }
+
   concrete_optimizer::dag::OperatorIndex addRound(optimizer::Dag &dag,
                                                   mlir::Value &val,
                                                   Inputs &encrypted_inputs,
@@ -736,7 +757,12 @@ struct FunctionToDag {
       inputSmanp = inputSmanpAttr.getValue();
     }
 
-    const double subManp = sqrt(2 * inputSmanp.roundToDouble() + 1);
+    // The window is reduced by a balanced tree of maximums, the subtraction
+    // of the last level being on two maximums of the previous level
+    const unsigned depth =
+        std::max(llvm::Log2_64_Ceil(numberOfComparisons), 1u);
+    const double previousLevelSmanp = inputSmanp.roundToDouble() + depth - 1;
+    const double subManp = sqrt(2 * previousLevelSmanp);
 
     auto loc = loc_to_string(maxpool2dOp.getLoc());
     auto comment =
@@ -749,7 +775,7 @@ struct FunctionToDag {
     const std::vector<std::uint64_t> unknownFunction;
     auto tluNode = dag->add_lut(subNode, slice(unknownFunction), precision);
 
-    const double addManp = sqrt(inputSmanp.roundToDouble() + 1);
+    const double addManp = sqrt(previousLevelSmanp + 1);
     const std::vector<concrete_optimizer::dag::OperatorIndex> addInputs = {
         tluNode, inputs[0]};
 
@@ -830,6 +856,21 @@ struct FunctionToDag {
     return nullptr;
   }
 
+  bool isBootstrappedBooleanCast(mlir::Operation &op) {
+    auto booleanWidth = FHE::EncryptedBooleanType::getWidth();
+    if (auto toBool = llvm::dyn_cast<FHE::ToBoolOp>(op)) {
+      return !fhe::utils::getLeveledCastShift(
+                  toBool.getInput().getType().getWidth(), booleanWidth)
+                  .has_value();
+    }
+    if (auto fromBool = llvm::dyn_cast<FHE::FromBoolOp>(op)) {
+      return !fhe::utils::getLeveledCastShift(
+                  booleanWidth, fromBool.getResult().getType().getWidth())
+                  .has_value();
+    }
+    return false;
+  }
+
   bool isRound(mlir::Operation &op) {
     return llvm::isa<mlir::concretelang::FHE::RoundEintOp>(op) ||
            llvm::isa<mlir::concretelang::FHELinalg::RoundOp>(op);
@@ -961,6 +1002,9 @@ struct DagPass : ConcreteOptimizerBase<DagPass> {
     DEBUG("ConcreteOptimizer Dag: " << name);
     auto dag = FunctionToDag(func, config).build();
     if (dag) {
+      // The pass may run concurrently on the functions of the module
+      static std::mutex dagsMutex;
+      std::lock_guard<std::mutex> guard(dagsMutex);
       dags.insert(
           optimizer::FunctionsDag::value_type(name, std::move(dag.value())));
     } else {
@@ -17,6 +17,7 @@
 #include <llvm/ADT/APInt.h>
 #include <llvm/ADT/Optional.h>
 #include <llvm/ADT/SmallString.h>
+#include <llvm/Support/MathExtras.h>
 #include <mlir/Analysis/DataFlow/DeadCodeAnalysis.h>
 #include <mlir/Analysis/DataFlow/SparseAnalysis.h>
 #include <mlir/Dialect/Arith/IR/Arith.h>
@@ -277,6 +278,41 @@ static llvm::APInt getSqMANP(mlir::concretelang::FHELinalg::DotEint op,
                               llvm::APInt(ceilLog2(N + 1), N, false));
 }
 
+/// Calculates the squared Minimal Arithmetic Noise Padding of a cast between
+/// an encrypted boolean and an encrypted integer. The cast either multiplies
+/// the ciphertext by a power of two or is a bootstrap.
+static llvm::APInt
+getBooleanCastSqMANP(unsigned fromWidth, unsigned toWidth,
+                     llvm::ArrayRef<const MANPLattice *> operandMANPs) {
+  auto shift =
+      mlir::concretelang::fhe::utils::getLeveledCastShift(fromWidth, toWidth);
+  if (!shift.has_value())
+    return llvm::APInt{1, 1, false};
+
+  llvm::APInt eNorm = getNoOpSqMANP(operandMANPs);
+  llvm::APInt factor = llvm::APInt::getOneBitSet(2 * shift.value() + 1,
+                                                 2 * shift.value());
+  return APIntWidthExtendUMul(eNorm, factor);
+}
+
+/// Calculates the squared Minimal Arithmetic Noise Padding of an
+/// `FHE.to_bool` operation.
+static llvm::APInt getSqMANP(mlir::concretelang::FHE::ToBoolOp op,
+                             llvm::ArrayRef<const MANPLattice *> operandMANPs) {
+  return getBooleanCastSqMANP(
+      op.getInput().getType().getWidth(),
+      mlir::concretelang::FHE::EncryptedBooleanType::getWidth(), operandMANPs);
+}
+
+/// Calculates the squared Minimal Arithmetic Noise Padding of an
+/// `FHE.from_bool` operation.
+static llvm::APInt getSqMANP(mlir::concretelang::FHE::FromBoolOp op,
+                             llvm::ArrayRef<const MANPLattice *> operandMANPs) {
+  return getBooleanCastSqMANP(
+      mlir::concretelang::FHE::EncryptedBooleanType::getWidth(),
+      op.getResult().getType().getWidth(), operandMANPs);
+}
+
 /// Calculates the squared Minimal Arithmetic Noise Padding of an unary FHE
 /// operation.
 static std::optional<llvm::APInt>
@@ -781,9 +817,12 @@ public:
       } else {
         norm2SqEquiv = llvm::APInt{1, 1, false};
       }
-    } else if (llvm::isa<mlir::concretelang::FHE::ToBoolOp>(op) ||
-               llvm::isa<mlir::concretelang::FHE::FromBoolOp>(op)) {
-      norm2SqEquiv = getNoOpSqMANP(operands);
+    } else if (auto toBoolOp =
+                   llvm::dyn_cast<mlir::concretelang::FHE::ToBoolOp>(op)) {
+      norm2SqEquiv = getSqMANP(toBoolOp, operands);
+    } else if (auto fromBoolOp =
+                   llvm::dyn_cast<mlir::concretelang::FHE::FromBoolOp>(op)) {
+      norm2SqEquiv = getSqMANP(fromBoolOp, operands);
     }
     // FHE and FHELinalg Operators
     else if (auto unaryEintOp =
@@ -1256,14 +1295,23 @@ llvm::APInt Maxpool2dOp::sqMANP(llvm::APInt a) {
   // - max(x - y, 0) + y
 
   // max is calculated with a TLU so MANP is {1, 1, false}
-  // y on the other hand comes from the input or from the previous result
+  // x and y are both maximums of the previous level of the balanced tree
+  // reducing the window, of depth ceil(log2(window size))
 
-  // in the current implementation, it's the input
-  // so the resulting MANP is `{1, 1, false} + MANP input`
+  // so the maximums of the level k have the MANP `k * {1, 1, false} + MANP
+  // input`, and the subtraction of the last level is the largest one
+  uint64_t windowSize = 1;
+  for (auto dimensionSize : this->getKernelShape().getValues<int64_t>())
+    windowSize *= dimensionSize;
+  const uint64_t depth = std::max(llvm::Log2_64_Ceil(windowSize), 1u);
 
   const llvm::APInt tlu = {1, 1, false};
-  const llvm::APInt forResult = APIntWidthExtendUAdd(tlu, a);
-  const llvm::APInt forIntermediate = APIntWidthExtendUAdd(forResult, a);
+  llvm::APInt previousLevel = a;
+  for (uint64_t level = 1; level < depth; level++)
+    previousLevel = APIntWidthExtendUAdd(tlu, previousLevel);
+  const llvm::APInt forResult = APIntWidthExtendUAdd(tlu, previousLevel);
+  const llvm::APInt forIntermediate =
+      APIntWidthExtendUAdd(previousLevel, previousLevel);
 
   return APIntUMax(forIntermediate, forResult);
 }
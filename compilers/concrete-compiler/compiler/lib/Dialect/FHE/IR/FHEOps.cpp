@@ -200,18 +200,6 @@ mlir::LogicalResult ToUnsignedOp::verify() {
   return mlir::success();
 }
 
-mlir::LogicalResult ToBoolOp::verify() {
-  auto input = this->getInput().getType().cast<EncryptedUnsignedIntegerType>();
-
-  if (input.getWidth() != 1 && input.getWidth() != 2) {
-    this->emitOpError("should have 1 or 2 as the width of encrypted input to "
-                      "cast to a boolean");
-    return mlir::failure();
-  }
-
-  return mlir::success();
-}
-
 mlir::LogicalResult GenGateOp::verify() {
   auto truth_table = this->getTruthTable().getType().cast<TensorType>();
 
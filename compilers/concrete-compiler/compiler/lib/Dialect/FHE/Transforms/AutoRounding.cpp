@@ -0,0 +1,240 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/MathExtras.h"
+
+#include "concretelang/Dialect/FHE/IR/FHEOps.h"
+#include "concretelang/Dialect/FHE/Transforms/AutoRounding/AutoRounding.h"
+#include "concretelang/Dialect/FHELinalg/IR/FHELinalgOps.h"
+
+namespace arith = mlir::arith;
+
+namespace FHE = mlir::concretelang::FHE;
+namespace FHELinalg = mlir::concretelang::FHELinalg;
+
+namespace {
+
+/// Name of the function attribute recording the rewritten lookup tables, as
+/// pairs of a location and a number of cleared bits.
+const char *AUTO_ROUNDING_ATTR = "FHE.auto_rounding";
+
+/// Returns true if `op` is a lookup table operation taking the encrypted
+/// input as first operand and the table(s) as second operand, the table
+/// being indexed by its last dimension.
+bool isLUT(mlir::Operation *op) {
+  return llvm::isa<FHE::ApplyLookupTableEintOp,
+                   FHELinalg::ApplyLookupTableEintOp,
+                   FHELinalg::ApplyMultiLookupTableEintOp,
+                   FHELinalg::ApplyMappedLookupTableEintOp>(op);
+}
+
+FHE::FheIntegerInterface getEncryptedElementType(mlir::Value value) {
+  return mlir::getElementTypeOrSelf(value.getType())
+      .dyn_cast<FHE::FheIntegerInterface>();
+}
+
+/// Returns the squared MANP of `value` computed by the MANP analysis, or 1
+/// if it has not been computed
+uint64_t getSquaredMANP(mlir::Value value) {
+  if (mlir::Operation *op = value.getDefiningOp()) {
+    if (auto smanp = op->getAttrOfType<mlir::IntegerAttr>("SMANP"))
+      return std::max<uint64_t>(smanp.getValue().getLimitedValue(), 1);
+  }
+  return 1;
+}
+
+/// Returns the number of bits of padding consumed by a noise of squared
+/// MANP `sqMANP`, i.e. `ceil(log2(ceil(sqrt(sqMANP))))`
+unsigned int noiseBits(uint64_t sqMANP) {
+  return (llvm::Log2_64_Ceil(sqMANP) + 1) / 2;
+}
+
+/// Returns the largest number of low bits `k < width` such that every row of
+/// `table` is constant on the aligned blocks of `2^k` entries
+unsigned int getIgnoredLowBits(mlir::DenseIntElementsAttr table,
+                               unsigned int width) {
+  auto values = llvm::to_vector(table.getValues<llvm::APInt>());
+  unsigned int k = 0;
+
+  while (k + 1 < width) {
+    uint64_t block = (uint64_t)1 << (k + 1);
+    for (size_t i = 0; i < values.size(); i++) {
+      if (values[i] != values[i - i % block])
+        return k;
+    }
+    k++;
+  }
+
+  return k;
+}
+
+/// Shrinks the last dimension of `table` by `2^k`, such that
+/// `shrunk[..., j] = table[..., j * 2^k]`
+mlir::DenseIntElementsAttr shrinkTable(mlir::DenseIntElementsAttr table,
+                                       unsigned int k) {
+  auto tableType = table.getType().cast<mlir::RankedTensorType>();
+  llvm::SmallVector<int64_t> shape(tableType.getShape());
+  int64_t stride = (int64_t)1 << k;
+  shape.back() /= stride;
+
+  auto original = llvm::to_vector(table.getValues<llvm::APInt>());
+  llvm::SmallVector<llvm::APInt> shrunk;
+  shrunk.reserve(original.size() / stride);
+  for (size_t i = 0; i < original.size(); i += stride)
+    shrunk.push_back(original[i]);
+
+  return mlir::DenseIntElementsAttr::get(
+      mlir::RankedTensorType::get(shape, tableType.getElementType()), shrunk);
+}
+
+struct FHEAutoRoundingPass
+    : public FHEAutoRoundingBase<FHEAutoRoundingPass> {
+
+  void runOnOperation() override {
+    mlir::func::FuncOp func = getOperation();
+
+    llvm::SmallVector<mlir::Operation *> lutOps;
+    func.walk([&](mlir::Operation *op) {
+      if (isLUT(op))
+        lutOps.push_back(op);
+    });
+
+    mlir::Builder builder(func.getContext());
+    llvm::SmallVector<mlir::Attribute> rewrites;
+    if (auto previous = func->getAttrOfType<mlir::ArrayAttr>(AUTO_ROUNDING_ATTR))
+      rewrites.append(previous.begin(), previous.end());
+    size_t previousCount = rewrites.size();
+
+    for (mlir::Operation *op : lutOps) {
+      unsigned int clearedBits = getClearedBits(op);
+      if (clearedBits == 0)
+        continue;
+
+      rewrite(op, clearedBits);
+      rewrites.push_back(builder.getArrayAttr(
+          {mlir::LocationAttr(op->getLoc()),
+           builder.getI64IntegerAttr(clearedBits)}));
+    }
+
+    if (rewrites.size() > previousCount)
+      func->setAttr(AUTO_ROUNDING_ATTR, builder.getArrayAttr(rewrites));
+
+    for (mlir::Operation *table : deadTables) {
+      if (mlir::isOpTriviallyDead(table))
+        table->erase();
+    }
+  }
+
+private:
+  /// Returns the number of low bits of the input of the lookup table `op`
+  /// to clear, 0 if the lookup table should be left as is
+  unsigned int getClearedBits(mlir::Operation *op) {
+    mlir::Value input = op->getOperand(0);
+    FHE::FheIntegerInterface inputType = getEncryptedElementType(input);
+
+    // Only unsigned inputs with constant tables are rewritten: the tables
+    // need to be shrunk at compile time
+    mlir::DenseIntElementsAttr table;
+    if (!inputType || !inputType.isUnsigned() ||
+        !mlir::matchPattern(op->getOperand(1), mlir::m_Constant(&table)))
+      return 0;
+
+    unsigned int width = inputType.getWidth();
+    auto tableType = table.getType().cast<mlir::RankedTensorType>();
+    if (tableType.getShape().back() != ((int64_t)1 << width))
+      return 0;
+
+    // The bit extraction of step `i` applies to the input with `i` bits
+    // cleared and a squared MANP increased by `i`, so clearing `k` bits is
+    // only worth it if the lookup table of the rewritten input requires less
+    // precision and noise bits than the original one, without any bit
+    // extraction requiring more.
+    uint64_t sqMANP = getSquaredMANP(input);
+    unsigned int original = width + noiseBits(sqMANP);
+    unsigned int maxClearedBits = getIgnoredLowBits(table, width);
+
+    unsigned int extractableBits = 0;
+    while (extractableBits < maxClearedBits &&
+           (width - extractableBits) + noiseBits(sqMANP + extractableBits) <=
+               original)
+      extractableBits++;
+
+    for (unsigned int k = extractableBits; k > 0; k--) {
+      if ((width - k) + noiseBits(sqMANP + k) < original)
+        return k;
+    }
+
+    return 0;
+  }
+
+  /// Clears the `clearedBits` low bits of the input of the lookup table `op`
+  /// and applies it on the input reinterpreted with `clearedBits` bits less
+  void rewrite(mlir::Operation *op, unsigned int clearedBits) {
+    mlir::Value value = op->getOperand(0);
+    unsigned int width = getEncryptedElementType(value).getWidth();
+    auto tensorType = value.getType().dyn_cast<mlir::RankedTensorType>();
+    mlir::Location loc = op->getLoc();
+
+    mlir::OpBuilder builder(op);
+    auto typeOfWidth = [&](unsigned int w) -> mlir::Type {
+      auto elementType =
+          FHE::EncryptedUnsignedIntegerType::get(builder.getContext(), w);
+      if (tensorType)
+        return mlir::RankedTensorType::get(tensorType.getShape(), elementType);
+      return elementType;
+    };
+
+    for (unsigned int i = 0; i < clearedBits; i++, width--) {
+      mlir::Type type = typeOfWidth(width);
+      if (tensorType) {
+        mlir::Value lsb =
+            builder.create<FHELinalg::LsbEintOp>(loc, type, value);
+        value = builder.create<FHELinalg::SubEintOp>(loc, type, value, lsb);
+        value = builder.create<FHELinalg::ReinterpretPrecisionEintOp>(
+            loc, typeOfWidth(width - 1), value);
+      } else {
+        mlir::Value lsb = builder.create<FHE::LsbEintOp>(loc, type, value);
+        value = builder.create<FHE::SubEintOp>(loc, type, value, lsb);
+        value = builder.create<FHE::ReinterpretPrecisionEintOp>(
+            loc, typeOfWidth(width - 1), value);
+      }
+    }
+
+    mlir::DenseIntElementsAttr table;
+    bool isConstant =
+        mlir::matchPattern(op->getOperand(1), mlir::m_Constant(&table));
+    assert(isConstant);
+    (void)isConstant;
+
+    mlir::Value shrunk = builder.create<arith::ConstantOp>(
+        loc, shrinkTable(table, clearedBits));
+
+    if (mlir::Operation *tableOp = op->getOperand(1).getDefiningOp())
+      deadTables.insert(tableOp);
+
+    op->setOperand(0, value);
+    op->setOperand(1, shrunk);
+  }
+
+  llvm::SetVector<mlir::Operation *> deadTables;
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createFHEAutoRoundingPass() {
+  return std::make_unique<FHEAutoRoundingPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
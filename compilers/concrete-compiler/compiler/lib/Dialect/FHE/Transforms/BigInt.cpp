@@ -3,6 +3,8 @@
 // https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
 // for license information.
 
+#include <functional>
+
 #include <mlir/Dialect/Affine/IR/AffineOps.h>
 #include <mlir/Dialect/Arith/IR/Arith.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
@@ -169,12 +171,141 @@ private:
   unsigned int chunkSize, chunkWidth;
 };
 
+/// Lowers the addition of chunked integers with a carry-lookahead adder:
+/// the carry status of each chunk (kill, propagate or generate) is computed
+/// from the sum of its inputs, and the carry status of all prefixes of
+/// chunks are combined with a Kogge-Stone parallel prefix tree of table
+/// lookups. The depth of table lookups is logarithmic in the number of
+/// chunks, instead of linear for the ripple carry adder of `AddEintPattern`,
+/// at the cost of more table lookups.
+class CarryLookaheadAddEintPattern
+    : public mlir::OpConversionPattern<mlir::concretelang::FHE::AddEintOp> {
+public:
+  CarryLookaheadAddEintPattern(mlir::TypeConverter &converter,
+                               mlir::MLIRContext *context,
+                               unsigned int chunkSize, unsigned int chunkWidth)
+      : mlir::OpConversionPattern<mlir::concretelang::FHE::AddEintOp>(
+            converter, context, ::mlir::concretelang::DEFAULT_PATTERN_BENEFIT),
+        chunkSize(chunkSize), chunkWidth(chunkWidth) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(FHE::AddEintOp op, FHE::AddEintOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+    auto tensorType =
+        adaptor.getA().getType().dyn_cast<mlir::RankedTensorType>();
+    assert(tensorType.getShape().size() == 1 &&
+           "chunked integer should be converted to flat tensors, but tensor "
+           "have more than one dimension");
+    int64_t numberOfChunks = tensorType.getShape()[0];
+    mlir::Location loc = op.getLoc();
+    auto eintType = FHE::EncryptedUnsignedIntegerType::get(
+        rewriter.getContext(), chunkSize);
+
+    // Carry status of a chunk or of a sequence of chunks
+    enum Status : uint64_t { KILL = 0, PROPAGATE = 1, GENERATE = 2 };
+    uint64_t maxChunkValue = (1 << chunkWidth) - 1;
+
+    auto applyTable = [&](mlir::Value input,
+                          std::function<uint64_t(uint64_t)> function) {
+      int64_t tableSize = 1 << chunkSize;
+      std::vector<llvm::APInt> values;
+      values.reserve(tableSize);
+      for (int64_t i = 0; i < tableSize; i++)
+        values.push_back(llvm::APInt(64, function(i), false));
+      auto table = rewriter.create<mlir::arith::ConstantOp>(
+          loc, mlir::DenseElementsAttr::get(
+                   mlir::RankedTensorType::get({tableSize},
+                                               rewriter.getIntegerType(64)),
+                   values));
+      return rewriter
+          .create<FHE::ApplyLookupTableEintOp>(loc, eintType, input, table)
+          .getResult();
+    };
+
+    auto constant = [&](int64_t value) {
+      return rewriter
+          .create<mlir::arith::ConstantIntOp>(loc, value, chunkSize + 1)
+          .getResult();
+    };
+
+    // Sum of the chunks of the operands and carry status of each chunk
+    llvm::SmallVector<mlir::Value> sums, prefixes;
+    for (int64_t i = 0; i < numberOfChunks; i++) {
+      mlir::Value index = rewriter.create<mlir::arith::ConstantIndexOp>(loc, i);
+      mlir::Value left =
+          rewriter.create<mlir::tensor::ExtractOp>(loc, adaptor.getA(), index);
+      mlir::Value right =
+          rewriter.create<mlir::tensor::ExtractOp>(loc, adaptor.getB(), index);
+      mlir::Value sum = rewriter.create<FHE::AddEintOp>(loc, left, right);
+      sums.push_back(sum);
+      prefixes.push_back(applyTable(sum, [&](uint64_t x) -> uint64_t {
+        if (x > maxChunkValue)
+          return GENERATE;
+        return x == maxChunkValue ? PROPAGATE : KILL;
+      }));
+    }
+
+    // Kogge-Stone prefix tree combining the status `high` of a sequence of
+    // chunks with the status `low` of the preceding sequence. The combined
+    // status is `low` if `high` propagates the carry, `high` otherwise, and
+    // is looked up from `2 * high + low`, which identifies it uniquely.
+    mlir::Value two = constant(2);
+    for (int64_t distance = 1; distance < numberOfChunks; distance *= 2) {
+      llvm::SmallVector<mlir::Value> next = prefixes;
+      for (int64_t i = distance; i < numberOfChunks; i++) {
+        mlir::Value high =
+            rewriter.create<FHE::MulEintIntOp>(loc, prefixes[i], two);
+        mlir::Value packed =
+            rewriter.create<FHE::AddEintOp>(loc, high, prefixes[i - distance]);
+        next[i] = applyTable(packed, [](uint64_t x) -> uint64_t {
+          if (x < 3)
+            return KILL;
+          return x == 3 ? PROPAGATE : GENERATE;
+        });
+      }
+      prefixes = next;
+    }
+
+    // The carry out of a chunk is set if the prefix of chunks ending with it
+    // generates a carry, as there is no carry in the first chunk. The carry
+    // in of each chunk is added and its carry out is removed.
+    mlir::Value shift = constant(1 << chunkWidth);
+    mlir::Value result =
+        rewriter.create<FHE::ZeroTensorOp>(loc, adaptor.getA().getType());
+    mlir::Value carryIn;
+    for (int64_t i = 0; i < numberOfChunks; i++) {
+      mlir::Value carryOut = applyTable(prefixes[i], [](uint64_t x) {
+        return x == GENERATE ? 1 : 0;
+      });
+      mlir::Value chunk = sums[i];
+      if (carryIn)
+        chunk = rewriter.create<FHE::AddEintOp>(loc, chunk, carryIn);
+      mlir::Value shiftedCarry =
+          rewriter.create<FHE::MulEintIntOp>(loc, carryOut, shift);
+      chunk = rewriter.create<FHE::SubEintOp>(loc, chunk, shiftedCarry);
+
+      mlir::Value index = rewriter.create<mlir::arith::ConstantIndexOp>(loc, i);
+      result =
+          rewriter.create<mlir::tensor::InsertOp>(loc, chunk, result, index);
+      carryIn = carryOut;
+    }
+
+    rewriter.replaceOp(op, result);
+    return mlir::success();
+  }
+
+private:
+  unsigned int chunkSize, chunkWidth;
+};
+
 /// Performs the transformation of big integer operations
 class FHEBigIntTransformPass
     : public FHEBigIntTransformBase<FHEBigIntTransformPass> {
 public:
-  FHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth)
-      : chunkSize(chunkSize), chunkWidth(chunkWidth){};
+  FHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth,
+                         bool carryLookahead)
+      : chunkSize(chunkSize), chunkWidth(chunkWidth),
+        carryLookahead(carryLookahead){};
 
   void runOnOperation() override {
     mlir::Operation *op = getOperation();
@@ -203,8 +334,13 @@ public:
     concretelang::addDynamicallyLegalTypeOp<mlir::func::ReturnOp>(target,
                                                                   converter);
 
-    patterns.add<AddEintPattern>(converter, &getContext(), chunkSize,
-                                 chunkWidth);
+    // The statuses combined by the carry-lookahead adder need 3 bits
+    if (carryLookahead && chunkSize >= 3)
+      patterns.add<CarryLookaheadAddEintPattern>(converter, &getContext(),
+                                                 chunkSize, chunkWidth);
+    else
+      patterns.add<AddEintPattern>(converter, &getContext(), chunkSize,
+                                   chunkWidth);
 
     if (mlir::applyPartialConversion(op, target, std::move(patterns))
             .failed()) {
@@ -214,15 +350,18 @@ public:
 
 private:
   unsigned int chunkSize, chunkWidth;
+  bool carryLookahead;
 };
 
 } // end anonymous namespace
 
 std::unique_ptr<mlir::OperationPass<>>
-createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth) {
+createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth,
+                             bool carryLookahead) {
   assert(chunkSize >= chunkWidth + 1 &&
          "chunkSize must be greater than chunkWidth");
-  return std::make_unique<FHEBigIntTransformPass>(chunkSize, chunkWidth);
+  return std::make_unique<FHEBigIntTransformPass>(chunkSize, chunkWidth,
+                                                  carryLookahead);
 }
 
 } // namespace concretelang
@@ -4,7 +4,9 @@
 // for license information.
 
 #include "concretelang/Dialect/Tracing/IR/TracingOps.h"
+#include <llvm/ADT/bit.h>
 #include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/IR/Matchers.h>
 #include <mlir/IR/PatternMatch.h>
 #include <mlir/Transforms/GreedyPatternRewriteDriver.h>
 
@@ -18,6 +20,207 @@ namespace concretelang {
 
 namespace {
 
+/// Truth tables of the gates, indexed by `2 * left + right`
+const llvm::SmallVector<uint64_t, 4> AND_TRUTH_TABLE = {0, 0, 0, 1};
+const llvm::SmallVector<uint64_t, 4> NAND_TRUTH_TABLE = {1, 1, 1, 0};
+const llvm::SmallVector<uint64_t, 4> OR_TRUTH_TABLE = {0, 1, 1, 1};
+const llvm::SmallVector<uint64_t, 4> XOR_TRUTH_TABLE = {0, 1, 1, 0};
+
+/// Returns the truth table of a two inputs gate, or std::nullopt if `op` is
+/// not a gate or if its truth table is not a constant.
+std::optional<llvm::SmallVector<uint64_t, 4>>
+getGateTruthTable(mlir::Operation *op) {
+  if (llvm::isa<mlir::concretelang::FHE::BoolAndOp>(op))
+    return AND_TRUTH_TABLE;
+  if (llvm::isa<mlir::concretelang::FHE::BoolNandOp>(op))
+    return NAND_TRUTH_TABLE;
+  if (llvm::isa<mlir::concretelang::FHE::BoolOrOp>(op))
+    return OR_TRUTH_TABLE;
+  if (llvm::isa<mlir::concretelang::FHE::BoolXorOp>(op))
+    return XOR_TRUTH_TABLE;
+  if (auto genGate = llvm::dyn_cast<mlir::concretelang::FHE::GenGateOp>(op)) {
+    mlir::DenseIntElementsAttr truthTable;
+    if (!mlir::matchPattern(genGate.getTruthTable(),
+                            mlir::m_Constant(&truthTable)))
+      return std::nullopt;
+    llvm::SmallVector<uint64_t, 4> values;
+    for (auto value : truthTable.getValues<llvm::APInt>())
+      values.push_back(value.isZero() ? 0 : 1);
+    return values;
+  }
+  return std::nullopt;
+}
+
+/// Returns the gate `value` is the single use of, and whose truth table is
+/// known, or nullptr.
+mlir::Operation *getInnerGate(mlir::Value value, mlir::Operation *user) {
+  auto gate = value.getDefiningOp();
+  if (gate == nullptr || !gate->hasOneUse() ||
+      gate->getBlock() != user->getBlock() ||
+      !getGateTruthTable(gate).has_value())
+    return nullptr;
+  return gate;
+}
+
+/// A tree of gates computing a boolean function of its leaves, the results of
+/// the gates below the root having no other use.
+///
+/// An encrypted boolean is represented as an integer of width two, so that
+/// the tree can be computed by a single lookup table when its leaves can be
+/// packed in one ciphertext without overflowing the padding bit:
+/// - two leaves `a` and `b` are packed as `2 * a + b`, as for a single gate,
+///   whatever the function,
+/// - three leaves are packed as their sum, using the carry bit, when the
+///   function only depends on the number of leaves set.
+///
+/// Packing the leaves in a wider ciphertext would need a bootstrap per leaf.
+class BooleanTree {
+public:
+  BooleanTree(mlir::Operation *root) : root(root) { collect(root); }
+
+  /// Replaces the tree by a single lookup table, returns false if the leaves
+  /// can't be packed.
+  bool pack() {
+    if (gates.size() < 2)
+      return false;
+
+    mlir::OpBuilder builder(root);
+    auto loc = root->getLoc();
+    auto eint2 = mlir::concretelang::FHE::EncryptedUnsignedIntegerType::get(
+        root->getContext(), 2);
+    auto truthTableType =
+        mlir::RankedTensorType::get({4}, builder.getIntegerType(64));
+
+    llvm::SmallVector<int64_t, 4> truthTable(4, 0);
+    mlir::Value result;
+    if (leaves.size() <= 2) {
+      // a single leaf is packed as `3 * a`
+      for (uint64_t a = 0; a < 2; a++) {
+        for (uint64_t b = 0; b < 2; b++) {
+          if (leaves.size() == 1 && a != b)
+            continue;
+          truthTable[2 * a + b] = evaluate(root->getResult(0), a | (b << 1));
+        }
+      }
+      auto truthTableCst = builder.create<mlir::arith::ConstantOp>(
+          loc, mlir::DenseElementsAttr::get(truthTableType,
+                                            llvm::ArrayRef(truthTable)));
+      result = builder.create<mlir::concretelang::FHE::GenGateOp>(
+          loc, root->getResult(0).getType(), leaves.front(), leaves.back(),
+          truthTableCst);
+    } else if (leaves.size() == 3) {
+      uint64_t known = 0;
+      for (uint64_t leafValues = 0; leafValues < 8; leafValues++) {
+        auto numberOfSetLeaves = llvm::popcount(leafValues);
+        int64_t value = evaluate(root->getResult(0), leafValues);
+        if ((known >> numberOfSetLeaves) & 1) {
+          if (truthTable[numberOfSetLeaves] != value)
+            return false;
+        } else {
+          truthTable[numberOfSetLeaves] = value;
+          known |= 1 << numberOfSetLeaves;
+        }
+      }
+      mlir::Value sum;
+      for (auto leaf : leaves) {
+        mlir::Value packed =
+            builder.create<mlir::concretelang::FHE::FromBoolOp>(loc, eint2,
+                                                                leaf);
+        if (sum) {
+          sum = builder.create<mlir::concretelang::FHE::AddEintOp>(loc, sum,
+                                                                   packed);
+        } else {
+          sum = packed;
+        }
+      }
+      auto truthTableCst = builder.create<mlir::arith::ConstantOp>(
+          loc, mlir::DenseElementsAttr::get(truthTableType,
+                                            llvm::ArrayRef(truthTable)));
+      auto lut =
+          builder.create<mlir::concretelang::FHE::ApplyLookupTableEintOp>(
+              loc, eint2, sum, truthTableCst);
+      result = builder.create<mlir::concretelang::FHE::ToBoolOp>(
+          loc,
+          mlir::concretelang::FHE::EncryptedBooleanType::get(
+              root->getContext()),
+          lut);
+    } else {
+      return false;
+    }
+
+    root->getResult(0).replaceAllUsesWith(result);
+    erase(root);
+    return true;
+  }
+
+private:
+  mlir::Operation *root;
+  llvm::SmallVector<mlir::Value, 3> leaves;
+  llvm::DenseMap<mlir::Operation *, llvm::SmallVector<uint64_t, 4>> gates;
+
+  void collect(mlir::Operation *gate) {
+    gates[gate] = getGateTruthTable(gate).value();
+    for (auto operand : {gate->getOperand(0), gate->getOperand(1)}) {
+      if (auto inner = getInnerGate(operand, gate)) {
+        collect(inner);
+      } else if (!llvm::is_contained(leaves, operand)) {
+        leaves.push_back(operand);
+      }
+    }
+  }
+
+  /// Evaluates `value` given the values of the leaves, the i-th bit of
+  /// `leafValues` being the value of the i-th leaf.
+  uint64_t evaluate(mlir::Value value, uint64_t leafValues) {
+    auto leaf = llvm::find(leaves, value);
+    if (leaf != leaves.end())
+      return (leafValues >> (leaf - leaves.begin())) & 1;
+    auto gate = value.getDefiningOp();
+    auto left = evaluate(gate->getOperand(0), leafValues);
+    auto right = evaluate(gate->getOperand(1), leafValues);
+    return gates[gate][2 * left + right];
+  }
+
+  void erase(mlir::Operation *gate) {
+    llvm::SmallVector<mlir::Operation *, 2> inners;
+    for (auto operand : {gate->getOperand(0), gate->getOperand(1)}) {
+      auto inner = operand.getDefiningOp();
+      if (inner != nullptr && gates.count(inner) &&
+          !llvm::is_contained(inners, inner))
+        inners.push_back(inner);
+    }
+    gate->erase();
+    for (auto inner : inners)
+      erase(inner);
+  }
+};
+
+/// Packs the trees of gates, from the largest ones.
+void packBooleanTrees(mlir::Operation *op) {
+  llvm::SmallVector<mlir::Operation *> roots;
+  op->walk([&](mlir::Operation *gate) {
+    if (!getGateTruthTable(gate).has_value())
+      return;
+    auto isInner =
+        gate->hasOneUse() &&
+        getGateTruthTable(*gate->user_begin()).has_value() &&
+        getInnerGate(gate->getResult(0), *gate->user_begin()) != nullptr;
+    if (!isInner)
+      roots.push_back(gate);
+  });
+
+  while (!roots.empty()) {
+    auto root = roots.pop_back_val();
+    if (BooleanTree(root).pack())
+      continue;
+    // the subtrees may still be packed
+    for (auto operand : {root->getOperand(0), root->getOperand(1)}) {
+      if (auto inner = getInnerGate(operand, root))
+        roots.push_back(inner);
+    }
+  }
+}
+
 /// Rewrite an `FHE.gen_gate` operation as an LUT operation by composing a
 /// single index from the two boolean inputs.
 class GenGatePattern
@@ -152,17 +355,19 @@ public:
   void runOnOperation() override {
     mlir::Operation *op = getOperation();
 
+    packBooleanTrees(op);
+
     mlir::RewritePatternSet patterns(&getContext());
     patterns.add<GenGatePattern>(&getContext());
     patterns.add<MuxOpPattern>(&getContext());
     patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolAndOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({0, 0, 0, 1}));
+        &getContext(), AND_TRUTH_TABLE);
     patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolNandOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({1, 1, 1, 0}));
+        &getContext(), NAND_TRUTH_TABLE);
     patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolOrOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({0, 1, 1, 1}));
+        &getContext(), OR_TRUTH_TABLE);
     patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolXorOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({0, 1, 1, 0}));
+        &getContext(), XOR_TRUTH_TABLE);
 
     if (mlir::applyPatternsAndFoldGreedily(op, std::move(patterns)).failed()) {
       this->signalPassFailure();
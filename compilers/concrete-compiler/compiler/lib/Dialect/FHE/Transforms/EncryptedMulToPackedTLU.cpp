@@ -0,0 +1,355 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include <cmath>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <concrete-optimizer.hpp>
+#include <concretelang/Dialect/FHE/IR/FHEOps.h>
+#include <concretelang/Dialect/FHE/Transforms/EncryptedMulToDoubleTLU/EncryptedMulToDoubleTLU.h>
+#include <concretelang/Dialect/FHELinalg/IR/FHELinalgOps.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Tensor/IR/Tensor.h>
+#include <mlir/IR/Builders.h>
+#include <mlir/IR/TypeUtilities.h>
+
+namespace mlir {
+namespace concretelang {
+namespace {
+
+/// Widest packed operands, i.e. widest lookup table, the rewrite creates
+constexpr unsigned MAX_PACKED_WIDTH = 16;
+
+template <typename T> rust::Slice<const T> slice(const std::vector<T> &vec) {
+  return rust::Slice<const T>(vec.data(), vec.size());
+}
+
+/// An encrypted inner product on vectors and matrices, i.e. the product of a
+/// `M x K` matrix by a `K x N` matrix where `M` or `N` is absent when the
+/// corresponding operand is a vector.
+struct InnerProduct {
+  mlir::Operation *op;
+  mlir::Value lhs;
+  mlir::Value rhs;
+  /// Width and signedness of the operands
+  unsigned width;
+  bool isSigned;
+  std::vector<int64_t> lhsShape;
+  std::vector<int64_t> rhsShape;
+  /// Shape of the tensor of all the products, `M x K x N`
+  std::vector<int64_t> pairShape;
+  /// Empty for a scalar result
+  std::vector<int64_t> resultShape;
+
+  int64_t reductionSize() const { return lhsShape.back(); }
+  /// Axis of `K` in the tensor of the products
+  int64_t reductionAxis() const { return lhsShape.size() - 1; }
+};
+
+std::vector<int64_t> getShape(mlir::Type type) {
+  if (auto tensorType = type.dyn_cast<mlir::RankedTensorType>())
+    return tensorType.getShape().vec();
+  return {};
+}
+
+std::vector<uint64_t> dagShape(const std::vector<int64_t> &shape) {
+  return std::vector<uint64_t>(shape.begin(), shape.end());
+}
+
+std::optional<InnerProduct> asInnerProduct(mlir::Operation *op) {
+  InnerProduct product;
+  product.op = op;
+  if (auto dot = llvm::dyn_cast<FHELinalg::DotEint>(op)) {
+    product.lhs = dot.getLhs();
+    product.rhs = dot.getRhs();
+  } else if (auto matmul = llvm::dyn_cast<FHELinalg::MatMulEintEintOp>(op)) {
+    product.lhs = matmul.getLhs();
+    product.rhs = matmul.getRhs();
+  } else {
+    return std::nullopt;
+  }
+  product.lhsShape = getShape(product.lhs.getType());
+  product.rhsShape = getShape(product.rhs.getType());
+  // The batched matrix products keep the double table lookup
+  if (product.lhsShape.size() > 2 || product.rhsShape.size() > 2)
+    return std::nullopt;
+
+  auto eintType = product.lhs.getType()
+                      .cast<mlir::RankedTensorType>()
+                      .getElementType()
+                      .cast<FHE::FheIntegerInterface>();
+  product.width = eintType.getWidth();
+  product.isSigned = eintType.isSigned();
+  product.pairShape = product.lhsShape;
+  if (product.rhsShape.size() == 2)
+    product.pairShape.push_back(product.rhsShape[1]);
+  product.resultShape = getShape(op->getResult(0).getType());
+  return product;
+}
+
+/// The complexity found by the optimizer for `dag`, infinite when no
+/// parameters can be found.
+double complexity(const optimizer::Dag &dag, optimizer::Config config) {
+  auto options = options_from_config(config);
+  // The error probability of the whole program is not known yet, the
+  // products are compared under the same error probability
+  double pError = config.p_error;
+  if (std::isnan(pError))
+    pError = config.global_p_error;
+  if (std::isnan(pError))
+    pError = optimizer::DEFAULT_GLOBAL_P_ERROR;
+  options.maximum_acceptable_error_probability = pError;
+
+  if (config.strategy == optimizer::Strategy::DAG_MULTI) {
+    auto solution = dag->optimize_multi(options);
+    if (!solution.is_feasible)
+      return INFINITY;
+    if (config.objective == concrete_optimizer::Objective::CriticalPath)
+      return solution.critical_path_complexity;
+    return solution.complexity;
+  }
+  auto solution = dag->optimize(options);
+  // An impossible solution is signaled by an error probability of 1
+  return solution.p_error < 1.0 ? solution.complexity : INFINITY;
+}
+
+/// The dag of the double table lookup lowering of `product`, see
+/// `addTensorInnerProductEncEnc` in ConcreteOptimizer.cpp. The operands are
+/// considered fresh.
+optimizer::Dag doubleTLUDag(const InnerProduct &product) {
+  auto dag = concrete_optimizer::dag::empty();
+  const std::vector<uint64_t> unknownFunction;
+  const std::vector<uint64_t> pairShape = dagShape(product.pairShape);
+
+  std::vector<concrete_optimizer::dag::OperatorIndex> inputs = {
+      dag->add_input(product.width, slice(dagShape(product.lhsShape))),
+      dag->add_input(product.width, slice(dagShape(product.rhsShape)))};
+
+  // tlu(x + y) and tlu(x - y)
+  auto sum = dag->add_levelled_op(slice(inputs), 0., 0., std::sqrt(2.),
+                                  slice(pairShape), "");
+  auto diff = dag->add_levelled_op(slice(inputs), 0., 0., std::sqrt(2.),
+                                   slice(pairShape), "");
+  std::vector<concrete_optimizer::dag::OperatorIndex> tlus = {
+      dag->add_lut(sum, slice(unknownFunction), product.width),
+      dag->add_lut(diff, slice(unknownFunction), product.width)};
+
+  // Sum(tlu(x + y) - tlu(x - y))
+  std::vector<concrete_optimizer::dag::OperatorIndex> products = {
+      dag->add_levelled_op(slice(tlus), 0., 0., std::sqrt(2.),
+                           slice(pairShape), "")};
+  auto result = dag->add_levelled_op(
+      slice(products), 0., 0., std::sqrt(2. * product.reductionSize()),
+      slice(dagShape(product.resultShape)), "");
+  dag->tag_operator_as_output(result);
+  return dag;
+}
+
+/// The dag of the packed table lookup lowering of `product`, the operands
+/// being considered fresh.
+optimizer::Dag packedTLUDag(const InnerProduct &product) {
+  auto dag = concrete_optimizer::dag::empty();
+  const std::vector<uint64_t> unknownFunction;
+  const std::vector<uint64_t> pairShape = dagShape(product.pairShape);
+  const unsigned packedWidth = 2 * product.width;
+
+  auto lhs = dag->add_input(product.width, slice(dagShape(product.lhsShape)));
+  auto rhs = dag->add_input(product.width, slice(dagShape(product.rhsShape)));
+
+  // x·2^p + tlu(y)
+  std::vector<concrete_optimizer::dag::OperatorIndex> packed = {
+      dag->add_unsafe_cast_op(lhs, packedWidth),
+      dag->add_lut(rhs, slice(unknownFunction), packedWidth)};
+  std::vector<concrete_optimizer::dag::OperatorIndex> pairs = {
+      dag->add_levelled_op(slice(packed), 0., 0., std::sqrt(2.),
+                           slice(pairShape), "")};
+
+  // Sum(tlu(x·2^p + y))
+  std::vector<concrete_optimizer::dag::OperatorIndex> products = {
+      dag->add_lut(pairs[0], slice(unknownFunction), product.width)};
+  auto result = dag->add_levelled_op(
+      slice(products), 0., 0., std::sqrt((double)product.reductionSize()),
+      slice(dagShape(product.resultShape)), "");
+  dag->tag_operator_as_output(result);
+  return dag;
+}
+
+mlir::Value lutConstant(mlir::OpBuilder &builder, mlir::Location loc,
+                        llvm::ArrayRef<int64_t> table) {
+  auto type = mlir::RankedTensorType::get({(int64_t)table.size()},
+                                          builder.getIntegerType(64));
+  return builder.create<mlir::arith::ConstantOp>(
+      loc, mlir::DenseIntElementsAttr::get(type, table));
+}
+
+/// Rewrites `product` as a sum of table lookups on packed operands, and
+/// returns its result.
+mlir::Value packInnerProduct(mlir::OpBuilder &builder,
+                             const InnerProduct &product) {
+  auto loc = product.op->getLoc();
+  auto *context = builder.getContext();
+  const unsigned width = product.width;
+  auto packedType = FHE::EncryptedUnsignedIntegerType::get(context, 2 * width);
+  auto resultType = product.op->getResult(0).getType();
+  auto resultEintType =
+      mlir::getElementTypeOrSelf(resultType).cast<FHE::FheIntegerInterface>();
+
+  // The signed operands are offset by 2^(p-1) to be packed as unsigned
+  // integers of [0, 2^p), the table of the products removes the offset
+  const int64_t offset = product.isSigned ? (int64_t)1 << (width - 1) : 0;
+
+  // x·2^p
+  mlir::Value lhs = product.lhs;
+  if (product.isSigned) {
+    auto offsetType =
+        mlir::RankedTensorType::get({1}, builder.getIntegerType(width + 1));
+    llvm::APInt offsetValue(width + 1, offset);
+    mlir::Value offsetCst = builder.create<mlir::arith::ConstantOp>(
+        loc, mlir::DenseIntElementsAttr::get(offsetType, offsetValue));
+    lhs = builder.create<FHELinalg::AddEintIntOp>(loc, lhs.getType(), lhs,
+                                                  offsetCst);
+    lhs = builder.create<FHELinalg::ToUnsignedOp>(
+        loc,
+        mlir::RankedTensorType::get(
+            product.lhsShape,
+            FHE::EncryptedUnsignedIntegerType::get(context, width)),
+        lhs);
+  }
+  mlir::Value high = builder.create<FHELinalg::ReinterpretPrecisionEintOp>(
+      loc, mlir::RankedTensorType::get(product.lhsShape, packedType), lhs);
+  if (product.rhsShape.size() == 2) {
+    // x[.., k] is paired with all the y[k, n]
+    llvm::SmallVector<mlir::ReassociationIndices> reassociation;
+    int64_t rank = product.lhsShape.size();
+    for (int64_t i = 0; i < rank - 1; i++)
+      reassociation.push_back({i});
+    reassociation.push_back({rank - 1, rank});
+    auto expandedShape = product.lhsShape;
+    expandedShape.push_back(1);
+    high = builder.create<mlir::tensor::ExpandShapeOp>(
+        loc, mlir::RankedTensorType::get(expandedShape, packedType), high,
+        reassociation);
+  }
+
+  // y, moved to the low bits of 2p bits integers
+  llvm::SmallVector<int64_t> lowTable;
+  for (int64_t i = 0; i < ((int64_t)1 << width); i++) {
+    // Adds the offset to the two's complement index of the signed values
+    lowTable.push_back(i ^ offset);
+  }
+  mlir::Value low = builder.create<FHELinalg::ApplyLookupTableEintOp>(
+      loc, mlir::RankedTensorType::get(product.rhsShape, packedType),
+      product.rhs, lutConstant(builder, loc, lowTable));
+
+  // x·2^p + y, for all the pairs
+  mlir::Value pairs = builder.create<FHELinalg::AddEintOp>(
+      loc, mlir::RankedTensorType::get(product.pairShape, packedType), high,
+      low);
+
+  // x·y = tlu(x·2^p + y), reduced modulo 2^q as the double table lookup
+  const unsigned resultWidth = resultEintType.getWidth();
+  const int64_t modulus = (int64_t)1 << resultWidth;
+  llvm::SmallVector<int64_t> productTable;
+  for (int64_t x = 0; x < ((int64_t)1 << width); x++) {
+    for (int64_t y = 0; y < ((int64_t)1 << width); y++) {
+      int64_t value = (((x - offset) * (y - offset)) % modulus + modulus) %
+                      modulus;
+      if (resultEintType.isSigned() && value >= modulus / 2)
+        value -= modulus;
+      productTable.push_back(value);
+    }
+  }
+  mlir::Value products = builder.create<FHELinalg::ApplyLookupTableEintOp>(
+      loc,
+      mlir::RankedTensorType::get(product.pairShape,
+                                  (mlir::Type)resultEintType),
+      pairs, lutConstant(builder, loc, productTable));
+
+  // Sum over k
+  llvm::SmallVector<int64_t> axes;
+  if (!product.resultShape.empty())
+    axes.push_back(product.reductionAxis());
+  return builder.create<FHELinalg::SumOp>(loc, resultType, products,
+                                          builder.getI64ArrayAttr(axes),
+                                          builder.getBoolAttr(false));
+}
+
+} // namespace
+
+/// This pass rewrites the encrypted inner products on vectors and matrices
+/// with a single table lookup per product, on the operands packed in an
+/// integer of twice their width, when the optimizer finds it cheaper than the
+/// double table lookup of `EncryptedMulToDoubleTLU`.
+///
+/// With `x` and `y` of `p` bits, `x·2^p + y` is an unsigned integer of `2p`
+/// bits, from which a table lookup computes `x·y`. `x·2^p` is the leveled
+/// reinterpretation of `x` with `2p` bits, while `y` needs a table lookup to
+/// be moved to the less significant bits. In a matrix product, each `y` is
+/// moved once and reused for all the rows of the left hand side, so the
+/// number of table lookups is roughly halved, while their precision is
+/// doubled.
+class EncryptedMulToPackedTLU
+    : public EncryptedMulToPackedTLUBase<EncryptedMulToPackedTLU> {
+
+public:
+  EncryptedMulToPackedTLU(optimizer::Config config, bool alwaysPack)
+      : config(config) {
+    this->alwaysPack = alwaysPack;
+  }
+
+  void runOnOperation() override {
+    std::vector<InnerProduct> products;
+    getOperation().walk([&](mlir::Operation *op) {
+      auto product = asInnerProduct(op);
+      if (product.has_value() && isPackingCheaper(*product))
+        products.push_back(*product);
+    });
+
+    for (auto &product : products) {
+      mlir::OpBuilder builder(product.op);
+      auto result = packInnerProduct(builder, product);
+      product.op->getResult(0).replaceAllUsesWith(result);
+      product.op->erase();
+    }
+  }
+
+private:
+  bool isPackingCheaper(const InnerProduct &product) {
+    if (2 * product.width > MAX_PACKED_WIDTH)
+      return false;
+    if (alwaysPack)
+      return true;
+
+    auto key = std::make_tuple(product.width, product.lhsShape,
+                               product.rhsShape, product.resultShape);
+    auto decision = decisions.find(key);
+    if (decision != decisions.end())
+      return decision->second;
+
+    bool cheaper = complexity(packedTLUDag(product), config) <
+                   complexity(doubleTLUDag(product), config);
+    decisions[key] = cheaper;
+    return cheaper;
+  }
+
+  optimizer::Config config;
+  /// Decisions by width and shapes of the operations
+  std::map<std::tuple<unsigned, std::vector<int64_t>, std::vector<int64_t>,
+                      std::vector<int64_t>>,
+           bool>
+      decisions;
+};
+
+std::unique_ptr<::mlir::OperationPass<::mlir::func::FuncOp>>
+createEncryptedMulToPackedTLUPass(optimizer::Config config, bool alwaysPack) {
+  return std::make_unique<EncryptedMulToPackedTLU>(config, alwaysPack);
+}
+
+} // namespace concretelang
+} // namespace mlir
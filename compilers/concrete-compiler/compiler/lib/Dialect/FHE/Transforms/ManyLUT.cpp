@@ -0,0 +1,417 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/MathExtras.h"
+
+#include "concretelang/Dialect/FHE/IR/FHEOps.h"
+#include "concretelang/Dialect/FHE/Transforms/ManyLUT/ManyLUT.h"
+#include "concretelang/Dialect/FHELinalg/IR/FHELinalgOps.h"
+
+namespace arith = mlir::arith;
+namespace linalg = mlir::linalg;
+
+namespace FHE = mlir::concretelang::FHE;
+namespace FHELinalg = mlir::concretelang::FHELinalg;
+
+namespace {
+
+/// Name of the attribute holding the number of lookup tables packed in the
+/// accumulator of a many-lut bootstrap.
+const char *MANY_LUT_ATTR = "TFHE.many_lut";
+
+/// Lookup tables are never widened above this precision unless the function
+/// already contains lookup tables on wider inputs, since the cost of a
+/// bootstrap grows quickly with the precision.
+const unsigned int MIN_MANY_LUT_PRECISION_ROOM = 4;
+
+/// Lookup tables are never widened above this precision: the smallest
+/// polynomial size the optimizer can choose is 2^8, and the many-lut packing
+/// needs a polynomial of at least twice the size of the widened table. Up to
+/// this precision, the packing of the grouped bootstraps is thus guaranteed
+/// whatever the parameters.
+const unsigned int MAX_MANY_LUT_PRECISION = 7;
+
+/// Returns true if `op` is a lookup table operation that can be part of a
+/// many-lut group. All of them take the encrypted input as first operand and
+/// the table(s) as second operand, the table being indexed by its last
+/// dimension.
+bool isGroupableLUT(mlir::Operation *op) {
+  return llvm::isa<FHE::ApplyLookupTableEintOp,
+                   FHELinalg::ApplyLookupTableEintOp,
+                   FHELinalg::ApplyMultiLookupTableEintOp,
+                   FHELinalg::ApplyMappedLookupTableEintOp>(op);
+}
+
+FHE::FheIntegerInterface getEncryptedElementType(mlir::Value value) {
+  return mlir::getElementTypeOrSelf(value.getType())
+      .dyn_cast<FHE::FheIntegerInterface>();
+}
+
+/// Returns the length of the longest prefix of `lutOps` whose lookup tables
+/// can be packed together: the results of the prefix must only be used after
+/// its last operation, which is where the packed bootstrap ends up.
+size_t packablePrefixSize(llvm::ArrayRef<mlir::Operation *> lutOps) {
+  mlir::Block *block = lutOps.front()->getBlock();
+
+  size_t size = 1;
+  while (size < lutOps.size()) {
+    mlir::Operation *last = lutOps[size];
+    bool usedBeforeLast =
+        llvm::any_of(lutOps.take_front(size), [&](mlir::Operation *op) {
+          return llvm::any_of(op->getUsers(), [&](mlir::Operation *user) {
+            mlir::Operation *ancestor = block->findAncestorOpInBlock(*user);
+            return ancestor == nullptr || ancestor->isBeforeInBlock(last);
+          });
+        });
+    if (usedBeforeLast)
+      break;
+    size++;
+  }
+
+  return size;
+}
+
+/// Expands the last dimension of `table` by `lutCount`, such that
+/// `expanded[..., i] = table[..., i / lutCount]`. Looking up `x * lutCount`
+/// in the expanded table gives the same result as looking up `x` in `table`.
+mlir::DenseIntElementsAttr expandTable(mlir::DenseIntElementsAttr table,
+                                       unsigned int lutCount) {
+  auto tableType = table.getType().cast<mlir::RankedTensorType>();
+  llvm::SmallVector<int64_t> shape(tableType.getShape());
+  int64_t size = shape.back();
+  shape.back() = size * lutCount;
+
+  auto original = llvm::to_vector(table.getValues<llvm::APInt>());
+  llvm::SmallVector<llvm::APInt> expanded;
+  expanded.reserve(original.size() * lutCount);
+  for (size_t offset = 0; offset < original.size(); offset += size) {
+    for (int64_t i = 0; i < size * lutCount; i++) {
+      expanded.push_back(original[offset + i / lutCount]);
+    }
+  }
+
+  return mlir::DenseIntElementsAttr::get(
+      mlir::RankedTensorType::get(shape, tableType.getElementType()),
+      expanded);
+}
+
+struct FHEManyLUTGroupingPass
+    : public FHEManyLUTGroupingBase<FHEManyLUTGroupingPass> {
+
+  FHEManyLUTGroupingPass(unsigned int maxLUTCount)
+      : maxLUTCount(llvm::PowerOf2Floor(std::max(maxLUTCount, 1u))) {}
+
+  void runOnOperation() override {
+    mlir::func::FuncOp func = getOperation();
+
+    if (maxLUTCount < 2)
+      return;
+
+    // Lookup tables applied to the same input in the same block, grouped by
+    // result type, in program order
+    llvm::MapVector<std::tuple<mlir::Value, mlir::Type, mlir::Block *>,
+                    llvm::SmallVector<mlir::Operation *>>
+        groups;
+    unsigned int maxPrecision = MIN_MANY_LUT_PRECISION_ROOM;
+
+    func.walk([&](mlir::Operation *op) {
+      if (!isGroupableLUT(op))
+        return;
+
+      mlir::Value input = op->getOperand(0);
+      FHE::FheIntegerInterface inputType = getEncryptedElementType(input);
+      maxPrecision = std::max(maxPrecision, inputType.getWidth());
+
+      // Only unsigned inputs with constant tables are grouped: the tables
+      // need to be expanded at compile time
+      mlir::DenseIntElementsAttr table;
+      if (!inputType.isUnsigned() || op->hasAttr(MANY_LUT_ATTR) ||
+          !mlir::matchPattern(op->getOperand(1), mlir::m_Constant(&table)))
+        return;
+
+      groups[{input, op->getResult(0).getType(), op->getBlock()}].push_back(
+          op);
+    });
+
+    for (auto &group : groups) {
+      llvm::ArrayRef<mlir::Operation *> lutOps = group.second;
+      unsigned int width =
+          getEncryptedElementType(lutOps.front()->getOperand(0)).getWidth();
+
+      unsigned int maxWidth = std::min(maxPrecision, MAX_MANY_LUT_PRECISION);
+      if (width >= maxWidth)
+        continue;
+
+      uint64_t maxCount = std::min<uint64_t>(
+          maxLUTCount, (uint64_t)1 << (maxWidth - width));
+
+      // Only complete groups of a power of two lookup tables are rewritten:
+      // the widening is only paid for if the bootstraps are packed, and the
+      // TFHE packing splits the bootstraps of an input in groups of `K` in
+      // program order, so it must find exactly the same groups
+      while (lutOps.size() >= 2) {
+        size_t packable = packablePrefixSize(lutOps.take_front(maxCount));
+        unsigned int lutCount = llvm::PowerOf2Floor(packable);
+
+        if (lutCount >= 2)
+          packGroup(lutOps.take_front(lutCount), lutCount);
+        lutOps = lutOps.drop_front(std::max(lutCount, 1u));
+      }
+    }
+
+    for (mlir::Operation *table : deadTables) {
+      if (mlir::isOpTriviallyDead(table))
+        table->erase();
+    }
+  }
+
+private:
+  /// Rewrites the lookup tables `lutOps` to lookup tables on their input
+  /// reinterpreted with `log2(lutCount)` more bits of precision
+  void packGroup(llvm::ArrayRef<mlir::Operation *> lutOps,
+                 unsigned int lutCount) {
+    mlir::Operation *first = lutOps.front();
+    mlir::Value input = first->getOperand(0);
+    unsigned int width = getEncryptedElementType(input).getWidth();
+
+    mlir::OpBuilder builder(first);
+    auto widenedElementType = FHE::EncryptedUnsignedIntegerType::get(
+        builder.getContext(), width + llvm::Log2_32(lutCount));
+
+    mlir::Value widened;
+    if (auto tensorType = input.getType().dyn_cast<mlir::RankedTensorType>()) {
+      widened = builder.create<FHELinalg::ReinterpretPrecisionEintOp>(
+          first->getLoc(),
+          mlir::RankedTensorType::get(tensorType.getShape(),
+                                      widenedElementType),
+          input);
+    } else {
+      widened = builder.create<FHE::ReinterpretPrecisionEintOp>(
+          first->getLoc(), widenedElementType, input);
+    }
+
+    for (mlir::Operation *op : lutOps) {
+      mlir::DenseIntElementsAttr table;
+      bool isConstant =
+          mlir::matchPattern(op->getOperand(1), mlir::m_Constant(&table));
+      assert(isConstant);
+      (void)isConstant;
+
+      builder.setInsertionPoint(op);
+      mlir::Value expanded = builder.create<arith::ConstantOp>(
+          op->getLoc(), expandTable(table, lutCount));
+
+      if (mlir::Operation *tableOp = op->getOperand(1).getDefiningOp())
+        deadTables.insert(tableOp);
+
+      op->setOperand(0, widened);
+      op->setOperand(1, expanded);
+      op->setAttr(MANY_LUT_ATTR, builder.getI32IntegerAttr(lutCount));
+    }
+  }
+
+  unsigned int maxLUTCount;
+  llvm::SetVector<mlir::Operation *> deadTables;
+};
+
+/// Returns the number of lookup tables of the many-lut group of the lookup
+/// table applied by the body of `op`, or 0 if it does not apply any
+unsigned int getManyLUTCount(linalg::GenericOp op) {
+  for (mlir::Operation &inner : op.getBody()->getOperations()) {
+    if (auto attr = inner.getAttrOfType<mlir::IntegerAttr>(MANY_LUT_ATTR))
+      return attr.getInt();
+  }
+  return 0;
+}
+
+/// Returns true if `a` and `b` iterate over the same domain with the same
+/// iterator types
+bool haveSameIterationDomain(linalg::GenericOp a, linalg::GenericOp b) {
+  return a.getIteratorTypesArray() == b.getIteratorTypesArray() &&
+         a.getStaticLoopRanges() == b.getStaticLoopRanges();
+}
+
+struct FHEManyLUTFusionPass
+    : public FHEManyLUTFusionBase<FHEManyLUTFusionPass> {
+
+  void runOnOperation() override {
+    llvm::SmallVector<mlir::Block *> blocks;
+    getOperation().walk([&](mlir::Block *block) { blocks.push_back(block); });
+
+    for (mlir::Block *block : blocks) {
+      // Sibling operations applying lookup tables to the same input, keyed
+      // by the input and its indexing map
+      llvm::MapVector<std::pair<mlir::Value, mlir::AffineMap>,
+                      llvm::SmallVector<linalg::GenericOp>>
+          candidates;
+
+      for (auto op : block->getOps<linalg::GenericOp>()) {
+        if (op.getNumDpsInputs() == 0 || op->hasAttr("tile-sizes") ||
+            !op.hasTensorSemantics() || getManyLUTCount(op) < 2)
+          continue;
+
+        mlir::OpOperand *input = op.getDpsInputOperand(0);
+        auto &siblings =
+            candidates[{input->get(), op.getMatchingIndexingMap(input)}];
+
+        if (siblings.empty() || haveSameIterationDomain(siblings.front(), op))
+          siblings.push_back(op);
+      }
+
+      // The siblings are fused group by group, as formed by the grouping:
+      // `K` consecutive siblings with the same group size
+      for (auto &candidate : candidates) {
+        llvm::ArrayRef<linalg::GenericOp> remaining = candidate.second;
+
+        while (!remaining.empty()) {
+          unsigned int lutCount = getManyLUTCount(remaining.front());
+          size_t groupSize = 1;
+          while (groupSize < std::min<size_t>(lutCount, remaining.size()) &&
+                 getManyLUTCount(remaining[groupSize]) == lutCount)
+            groupSize++;
+
+          llvm::SmallVector<linalg::GenericOp> siblings =
+              fusableSiblings(remaining.take_front(groupSize));
+          if (siblings.size() >= 2)
+            fuse(siblings);
+          remaining = remaining.drop_front(groupSize);
+        }
+      }
+    }
+  }
+
+private:
+  /// Keeps the siblings whose results are only used after the last sibling,
+  /// which is where the fused operation is created
+  llvm::SmallVector<linalg::GenericOp>
+  fusableSiblings(llvm::ArrayRef<linalg::GenericOp> siblings) {
+    linalg::GenericOp last = siblings.back();
+    mlir::Block *block = last->getBlock();
+
+    llvm::SmallVector<linalg::GenericOp> fusable;
+    for (linalg::GenericOp op : siblings.drop_back()) {
+      bool usedBeforeLast = llvm::any_of(op->getUsers(), [&](auto *user) {
+        mlir::Operation *ancestor = block->findAncestorOpInBlock(*user);
+        return ancestor == nullptr || ancestor->isBeforeInBlock(last);
+      });
+
+      if (!usedBeforeLast)
+        fusable.push_back(op);
+    }
+    fusable.push_back(last);
+
+    return fusable;
+  }
+
+  /// Fuses `siblings` into a single `linalg.generic` operation created at
+  /// the position of the last sibling, whose results are the concatenation
+  /// of the results of the siblings.
+  void fuse(llvm::ArrayRef<linalg::GenericOp> siblings) {
+    linalg::GenericOp last = siblings.back();
+    mlir::IRRewriter rewriter(last->getContext());
+    rewriter.setInsertionPoint(last);
+
+    llvm::SmallVector<mlir::Value> inputs, outputs;
+    llvm::SmallVector<mlir::AffineMap> inputMaps, outputMaps;
+    llvm::SmallVector<mlir::Type> resultTypes;
+    // Position of the inputs of each sibling in the inputs of the fused
+    // operation, identical inputs with identical maps are shared
+    llvm::SmallVector<llvm::SmallVector<size_t>> inputPositions;
+
+    for (linalg::GenericOp op : siblings) {
+      llvm::SmallVector<size_t> positions;
+
+      for (mlir::OpOperand *input : op.getDpsInputOperands()) {
+        mlir::AffineMap map = op.getMatchingIndexingMap(input);
+        size_t position = 0;
+        while (position < inputs.size() &&
+               (inputs[position] != input->get() ||
+                inputMaps[position] != map))
+          position++;
+
+        if (position == inputs.size()) {
+          inputs.push_back(input->get());
+          inputMaps.push_back(map);
+        }
+        positions.push_back(position);
+      }
+
+      for (mlir::OpOperand *output : op.getDpsInitOperands()) {
+        outputs.push_back(output->get());
+        outputMaps.push_back(op.getMatchingIndexingMap(output));
+      }
+
+      resultTypes.append(op->result_type_begin(), op->result_type_end());
+      inputPositions.push_back(positions);
+    }
+
+    llvm::SmallVector<mlir::AffineMap> maps(inputMaps);
+    maps.append(outputMaps);
+
+    auto bodyBuilder = [&](mlir::OpBuilder &builder, mlir::Location loc,
+                           mlir::ValueRange args) {
+      llvm::SmallVector<mlir::Value> yielded;
+      size_t outputPosition = inputs.size();
+
+      for (auto [op, positions] : llvm::zip(siblings, inputPositions)) {
+        mlir::Block *body = op.getBody();
+        mlir::IRMapping mapping;
+
+        for (auto [argIdx, position] : llvm::enumerate(positions))
+          mapping.map(body->getArgument(argIdx), args[position]);
+        for (size_t i = 0; i < op.getNumDpsInits(); i++)
+          mapping.map(body->getArgument(positions.size() + i),
+                      args[outputPosition++]);
+
+        for (mlir::Operation &inner : body->without_terminator())
+          builder.clone(inner, mapping);
+
+        for (mlir::Value v : body->getTerminator()->getOperands())
+          yielded.push_back(mapping.lookupOrDefault(v));
+      }
+
+      builder.create<linalg::YieldOp>(loc, yielded);
+    };
+
+    auto fused = rewriter.create<linalg::GenericOp>(
+        last.getLoc(), resultTypes, inputs, outputs, maps,
+        last.getIteratorTypesArray(), bodyBuilder);
+
+    size_t resultPosition = 0;
+    for (linalg::GenericOp op : siblings) {
+      size_t numResults = op->getNumResults();
+      rewriter.replaceOp(
+          op, fused->getResults().slice(resultPosition, numResults));
+      resultPosition += numResults;
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createFHEManyLUTGroupingPass(unsigned int maxLUTCount) {
+  return std::make_unique<FHEManyLUTGroupingPass>(maxLUTCount);
+}
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+createFHEManyLUTFusionPass() {
+  return std::make_unique<FHEManyLUTFusionPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -3,6 +3,7 @@
 // https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
 // for license information.
 
+#include "llvm/Support/MathExtras.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Transforms/DialectConversion.h"
@@ -91,6 +92,81 @@ struct MaxEintPattern : public mlir::OpRewritePattern<FHE::MaxEintOp> {
 
 namespace {
 
+/// Returns true if `maxOp` is an inner link of a chain of maximums, i.e. its
+/// result is only used by another maximum of the same block and type
+bool isInnerLink(FHE::MaxEintOp maxOp) {
+  if (!maxOp->hasOneUse())
+    return false;
+  auto user = llvm::dyn_cast<FHE::MaxEintOp>(*maxOp->getUsers().begin());
+  return user && user->getBlock() == maxOp->getBlock() &&
+         user.getType() == maxOp.getType();
+}
+
+/// Collects the operands of the chain of maximums ending with `maxOp` in
+/// `leaves`, from left to right, and the maximums of the chain in `links`.
+/// Returns the depth of the chain.
+unsigned int collectChain(FHE::MaxEintOp maxOp,
+                          llvm::SmallVectorImpl<mlir::Value> &leaves,
+                          llvm::SmallVectorImpl<FHE::MaxEintOp> &links) {
+  links.push_back(maxOp);
+  unsigned int depth = 0;
+  for (mlir::Value operand : {maxOp.getX(), maxOp.getY()}) {
+    auto link = operand.getDefiningOp<FHE::MaxEintOp>();
+    if (link && isInnerLink(link))
+      depth = std::max(depth, collectChain(link, leaves, links));
+    else
+      leaves.push_back(operand);
+  }
+  return depth + 1;
+}
+
+/// Rebalances the chains of `FHE.max_eint` operations, e.g. the sequential
+/// reduction `max(max(max(a, b), c), d)`, into balanced trees, e.g.
+/// `max(max(a, b), max(c, d))`. The maximums of a level of the tree are
+/// independent, so the depth of lookups becomes logarithmic in the number of
+/// reduced values. The optimizer identifiers of the original maximums are
+/// reused, as the tree has as many maximums as the chain, though the chains
+/// are rebalanced before the parameters are determined.
+void balanceMaxChains(mlir::Operation *op) {
+  llvm::SmallVector<FHE::MaxEintOp> roots;
+  op->walk([&](FHE::MaxEintOp maxOp) {
+    if (!isInnerLink(maxOp))
+      roots.push_back(maxOp);
+  });
+
+  for (FHE::MaxEintOp root : roots) {
+    llvm::SmallVector<mlir::Value> leaves;
+    llvm::SmallVector<FHE::MaxEintOp> links;
+    unsigned int depth = collectChain(root, leaves, links);
+
+    if (depth <= llvm::Log2_64_Ceil(leaves.size()) ||
+        llvm::any_of(leaves, [&](mlir::Value leaf) {
+          return leaf.getType() != root.getType();
+        }))
+      continue;
+
+    mlir::OpBuilder builder(root);
+    auto nextLink = links.begin();
+    while (leaves.size() > 1) {
+      llvm::SmallVector<mlir::Value> level;
+      for (size_t i = 0; i + 1 < leaves.size(); i += 2) {
+        auto maxOp = builder.create<FHE::MaxEintOp>(
+            root.getLoc(), root.getType(), leaves[i], leaves[i + 1]);
+        if (auto oid = (*nextLink++)->getAttr("TFHE.OId"))
+          maxOp->setAttr("TFHE.OId", oid);
+        level.push_back(maxOp);
+      }
+      if (leaves.size() % 2 == 1)
+        level.push_back(leaves.back());
+      leaves = std::move(level);
+    }
+
+    root.getResult().replaceAllUsesWith(leaves.front());
+    for (FHE::MaxEintOp link : links)
+      link->erase();
+  }
+}
+
 struct FHEMaxTransform : public FHEMaxTransformBase<FHEMaxTransform> {
   void runOnOperation() final;
 };
@@ -110,6 +186,10 @@ void FHEMaxTransform::runOnOperation() {
   }
 }
 
+struct FHEBalanceMax : public FHEBalanceMaxBase<FHEBalanceMax> {
+  void runOnOperation() final { balanceMaxChains(this->getOperation()); }
+};
+
 } // namespace
 
 namespace mlir {
@@ -119,5 +199,9 @@ std::unique_ptr<mlir::OperationPass<>> createFHEMaxTransformPass() {
   return std::make_unique<FHEMaxTransform>();
 }
 
+std::unique_ptr<mlir::OperationPass<>> createFHEBalanceMaxPass() {
+  return std::make_unique<FHEBalanceMax>();
+}
+
 } // namespace concretelang
 } // namespace mlir
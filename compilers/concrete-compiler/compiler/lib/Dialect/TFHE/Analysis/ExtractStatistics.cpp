@@ -54,6 +54,20 @@ struct ExtractTFHEStatisticsPass
       assert(funcOp != funcs.end());
       this->circuitFeedback = &circuitFeedback;
 
+      if (auto eliminated = (*funcOp)->getAttrOfType<mlir::IntegerAttr>(
+              "TFHE.eliminated_pbs"))
+        circuitFeedback.eliminatedPBSCount = eliminated.getInt();
+
+      if (auto rewrites = (*funcOp)->getAttrOfType<mlir::ArrayAttr>(
+              "FHE.auto_rounding")) {
+        for (auto rewrite : rewrites.getAsRange<mlir::ArrayAttr>()) {
+          auto location =
+              locationString(rewrite[0].cast<mlir::LocationAttr>());
+          int64_t &bits = circuitFeedback.autoRoundedBitsPerLoc[location];
+          bits = std::max(bits, rewrite[1].cast<mlir::IntegerAttr>().getInt());
+        }
+      }
+
       WalkResult walk =
           (*funcOp)->walk([&](Operation *op, const WalkStage &stage) {
             if (stage.isBeforeAllRegions()) {
@@ -88,6 +102,7 @@ struct ExtractTFHEStatisticsPass
     DISPATCH_ENTER(TFHE::AddGLWEIntOp)
     DISPATCH_ENTER(TFHE::BootstrapGLWEOp)
     DISPATCH_ENTER(TFHE::KeySwitchGLWEOp)
+    DISPATCH_ENTER(TFHE::ManyLUTBootstrapGLWEOp)
     DISPATCH_ENTER(TFHE::MulGLWEIntOp)
     DISPATCH_ENTER(TFHE::NegGLWEOp)
     DISPATCH_ENTER(TFHE::SubGLWEIntOp)
@@ -202,6 +217,35 @@ struct ExtractTFHEStatisticsPass
     return std::nullopt;
   }
 
+  // ############################
+  // TFHE.many_lut_bootstrap_glwe
+  // ############################
+
+  static std::optional<StringError> on_enter(TFHE::ManyLUTBootstrapGLWEOp &op,
+                                             ExtractTFHEStatisticsPass &pass) {
+    auto bsk = op.getKey();
+
+    // All the lookup tables share a single blind rotation, so the operation
+    // counts as one PBS
+    auto location = locationString(op.getLoc());
+    auto operation = PrimitiveOperation::PBS;
+    auto keys = std::vector<std::pair<KeyType, int64_t>>();
+    auto count = pass.getTripCount();
+
+    std::pair<KeyType, int64_t> key =
+        std::make_pair(KeyType::BOOTSTRAP, (int64_t)bsk.getIndex());
+    keys.push_back(key);
+
+    pass.circuitFeedback->statistics.push_back(concretelang::Statistic{
+        location,
+        operation,
+        keys,
+        count,
+    });
+
+    return std::nullopt;
+  }
+
   // ###################
   // TFHE.keyswitch_glwe
   // ###################
@@ -356,6 +400,47 @@ struct ExtractTFHEStatisticsPass
   }
 };
 
+/// Reports the parallel bands recorded on the functions by the collapse of
+/// the parallel loops, which only runs once lowered to std
+struct ExtractParallelBandsPass
+    : public PassWrapper<ExtractParallelBandsPass, OperationPass<ModuleOp>> {
+
+  ProgramCompilationFeedback &feedback;
+
+  ExtractParallelBandsPass(ProgramCompilationFeedback &feedback)
+      : feedback{feedback} {};
+
+  void runOnOperation() override {
+    auto module = getOperation();
+    auto funcs = module.getOps<mlir::func::FuncOp>();
+    for (CircuitCompilationFeedback &circuitFeedback :
+         feedback.circuitFeedbacks) {
+      auto funcOp = llvm::find_if(funcs, [&](mlir::func::FuncOp op) {
+        return op.getName() == circuitFeedback.name;
+      });
+      assert(funcOp != funcs.end());
+
+      auto bands =
+          (*funcOp)->getAttrOfType<mlir::ArrayAttr>("SCF.parallel_bands");
+      if (!bands)
+        continue;
+      for (auto band : bands.getAsRange<mlir::ArrayAttr>()) {
+        auto location = locationString(band[0].cast<mlir::LocationAttr>());
+        int64_t size = band[1].cast<mlir::IntegerAttr>().getInt();
+        std::optional<int64_t> bandSize =
+            size < 0 ? std::nullopt : std::optional<int64_t>(size);
+        auto known = circuitFeedback.parallelBandSizePerLoc.find(location);
+        if (known == circuitFeedback.parallelBandSizePerLoc.end())
+          circuitFeedback.parallelBandSizePerLoc[location] = bandSize;
+        else if (known->second.has_value() && bandSize.has_value())
+          known->second = std::max(*known->second, *bandSize);
+        else
+          known->second = std::nullopt;
+      }
+    }
+  }
+};
+
 } // namespace TFHE
 
 std::unique_ptr<OperationPass<ModuleOp>>
@@ -363,5 +448,10 @@ createStatisticExtractionPass(ProgramCompilationFeedback &feedback) {
   return std::make_unique<TFHE::ExtractTFHEStatisticsPass>(feedback);
 }
 
+std::unique_ptr<OperationPass<ModuleOp>>
+createParallelBandExtractionPass(ProgramCompilationFeedback &feedback) {
+  return std::make_unique<TFHE::ExtractParallelBandsPass>(feedback);
+}
+
 } // namespace concretelang
 } // namespace mlir
@@ -169,6 +169,31 @@ mlir::LogicalResult BatchedBootstrapGLWEOp::verify() {
   return verifyBootstrapSingleLUTConstraints(*this);
 }
 
+mlir::LogicalResult ManyLUTBootstrapGLWEOp::verify() {
+  if (verifyBootstrapSingleLUTConstraints(*this).failed())
+    return mlir::failure();
+
+  GLWEBootstrapKeyAttr keyAttr = this->getKeyAttr();
+
+  if (keyAttr && keyAttr.getPolySize() != kUndefined) {
+    int64_t lutCount = this->getResult()
+                           .getType()
+                           .cast<mlir::RankedTensorType>()
+                           .getShape()[0];
+    int64_t stride = this->getSampleStride();
+
+    if (stride <= 0 || lutCount * stride > keyAttr.getPolySize()) {
+      this->emitError("Extracting ")
+          << lutCount << " samples with a stride of " << stride
+          << " does not fit in a polynom of size " << keyAttr.getPolySize();
+
+      return mlir::failure();
+    }
+  }
+
+  return mlir::success();
+}
+
 mlir::LogicalResult BatchedMappedBootstrapGLWEOp::verify() {
   GLWEBootstrapKeyAttr keyAttr = this->getKeyAttr();
 
@@ -0,0 +1,171 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/MapVector.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/SCF/IR/SCF.h>
+#include <mlir/Dialect/Tensor/IR/Tensor.h>
+#include <mlir/IR/OperationSupport.h>
+
+#include <concretelang/Analysis/StaticLoops.h>
+#include <concretelang/Dialect/TFHE/IR/TFHEOps.h>
+#include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
+
+namespace mlir {
+namespace concretelang {
+
+namespace {
+
+bool isKeyswitch(mlir::Operation *op) {
+  return llvm::isa<TFHE::KeySwitchGLWEOp, TFHE::BatchedKeySwitchGLWEOp>(op);
+}
+
+/// Returns true if `op` only selects or reshapes ciphertexts of a tensor,
+/// such that two equivalent operations of this kind yield the same
+/// ciphertexts
+bool isCiphertextView(mlir::Operation *op) {
+  return llvm::isa<mlir::tensor::ExtractOp, mlir::tensor::ExtractSliceOp,
+                   mlir::tensor::CollapseShapeOp, mlir::tensor::ExpandShapeOp>(
+      op);
+}
+
+/// Returns the outermost operation enclosing the keyswitch `op` out of which
+/// it can be hoisted, i.e. the outermost `scf.for` loop executed at least
+/// once whose body does not define the keyswitched ciphertext, or `op`
+/// itself.
+mlir::Operation *getHoistingTarget(mlir::Operation *op) {
+  mlir::Value input = op->getOperand(0);
+  mlir::Operation *target = op;
+
+  while (auto loop =
+             llvm::dyn_cast_or_null<mlir::scf::ForOp>(target->getParentOp())) {
+    std::optional<int64_t> tripCount = tryGetStaticTripCount(loop);
+    if (!tripCount.has_value() || *tripCount < 1 ||
+        !loop.isDefinedOutsideOfLoop(input))
+      break;
+    target = loop;
+  }
+
+  return target;
+}
+
+/// Shares the keyswitches of a function that apply to the same ciphertext
+/// with the same key: a single keyswitch is placed before the first of
+/// them, hoisted out of the loops that do not define the ciphertext, and
+/// feeds all the bootstraps that consumed one of them.
+class TFHEKeyswitchSharingPass
+    : public TFHEKeyswitchSharingBase<TFHEKeyswitchSharingPass> {
+public:
+  void runOnOperation() override {
+    mlir::func::FuncOp func = getOperation();
+    if (func.isExternal())
+      return;
+
+    mergeEquivalentViews(func);
+
+    // Keyswitches grouped by operation, ciphertext, key and the block they
+    // can be hoisted to, in program order
+    using GroupKey = std::tuple<const void *, mlir::Value, mlir::Attribute,
+                                mlir::Type, mlir::Block *>;
+    llvm::MapVector<GroupKey, llvm::SmallVector<mlir::Operation *>> groups;
+
+    func.walk([&](mlir::Operation *op) {
+      if (!isKeyswitch(op))
+        return;
+
+      GroupKey key{op->getName().getAsOpaquePointer(), op->getOperand(0),
+                   op->getAttr("key"), op->getResult(0).getType(),
+                   getHoistingTarget(op)->getBlock()};
+      groups[key].push_back(op);
+    });
+
+    for (auto &group : groups) {
+      llvm::ArrayRef<mlir::Operation *> keyswitches = group.second;
+      mlir::Block *block = std::get<mlir::Block *>(group.first);
+
+      // Nothing to share or hoist
+      if (keyswitches.size() == 1 &&
+          keyswitches.front()->getBlock() == block)
+        continue;
+
+      mlir::Operation *first = nullptr;
+      for (mlir::Operation *op : keyswitches) {
+        mlir::Operation *ancestor = block->findAncestorOpInBlock(*op);
+        if (first == nullptr || ancestor->isBeforeInBlock(first))
+          first = ancestor;
+      }
+
+      mlir::Operation *shared = keyswitches.front();
+      shared->moveBefore(first);
+
+      for (mlir::Operation *op : keyswitches.drop_front()) {
+        op->getResult(0).replaceAllUsesWith(shared->getResult(0));
+        op->erase();
+      }
+    }
+  }
+
+private:
+  /// Merges, in each block, the equivalent operations extracting or
+  /// reshaping the ciphertexts that are keyswitched, such that keyswitches
+  /// of the same ciphertexts have the same operand.
+  void mergeEquivalentViews(mlir::func::FuncOp func) {
+    llvm::SmallVector<mlir::Operation *> views;
+    func.walk([&](mlir::Operation *op) {
+      if (isKeyswitch(op)) {
+        mlir::Operation *view = op->getOperand(0).getDefiningOp();
+        if (view != nullptr && isCiphertextView(view))
+          views.push_back(view);
+      }
+    });
+
+    // Views of a tensor already met in each block
+    llvm::DenseMap<std::pair<mlir::Block *, mlir::Value>,
+                   llvm::SmallVector<mlir::Operation *>>
+        known;
+    llvm::SmallPtrSet<mlir::Operation *, 16> erased;
+
+    for (mlir::Operation *view : views) {
+      if (erased.contains(view))
+        continue;
+
+      auto &equivalents = known[{view->getBlock(), view->getOperand(0)}];
+      auto equivalent = llvm::find_if(equivalents, [&](mlir::Operation *op) {
+        return op != view &&
+               mlir::OperationEquivalence::isEquivalentTo(
+                   op, view, mlir::OperationEquivalence::exactValueMatch,
+                   /*markEquivalent=*/nullptr,
+                   mlir::OperationEquivalence::IgnoreLocations);
+      });
+
+      if (equivalent == equivalents.end()) {
+        if (!llvm::is_contained(equivalents, view))
+          equivalents.push_back(view);
+        continue;
+      }
+
+      // Keep the view that comes first in the block
+      mlir::Operation *kept = *equivalent;
+      if (view->isBeforeInBlock(kept)) {
+        kept->moveBefore(view);
+      }
+      view->getResult(0).replaceAllUsesWith(kept->getResult(0));
+      view->erase();
+      erased.insert(view);
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::func::FuncOp>>
+createTFHEKeyswitchSharingPass() {
+  return std::make_unique<TFHEKeyswitchSharingPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
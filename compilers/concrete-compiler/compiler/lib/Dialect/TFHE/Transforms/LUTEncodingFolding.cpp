@@ -0,0 +1,141 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include <llvm/ADT/SetVector.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/IR/Matchers.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+
+#include <concretelang/Common/LookupTable.h>
+#include <concretelang/Dialect/TFHE/IR/TFHEOps.h>
+#include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
+
+namespace mlir {
+namespace concretelang {
+
+namespace {
+
+/// Returns the content of the lookup table `lut` if it is defined by a
+/// constant.
+std::optional<std::vector<uint64_t>> getConstantLut(mlir::Value lut) {
+  mlir::DenseIntElementsAttr attr;
+  if (!mlir::matchPattern(lut, mlir::m_Constant(&attr)))
+    return std::nullopt;
+
+  std::vector<uint64_t> values;
+  values.reserve(attr.getNumElements());
+  for (llvm::APInt value : attr.getValues<llvm::APInt>())
+    values.push_back(value.getZExtValue());
+  return values;
+}
+
+std::vector<uint64_t> toUnsigned(mlir::ArrayAttr array) {
+  std::vector<uint64_t> values;
+  values.reserve(array.size());
+  for (mlir::Attribute attr : array)
+    values.push_back(attr.cast<mlir::IntegerAttr>().getValue().getZExtValue());
+  return values;
+}
+
+/// Evaluates the encoding of a constant lookup table for a bootstrap.
+std::optional<mlir::DenseIntElementsAttr>
+foldEncoding(TFHE::EncodeExpandLutForBootstrapOp op) {
+  auto input = getConstantLut(op.getInputLookupTable());
+  auto resultType = op.getResult().getType().cast<mlir::RankedTensorType>();
+  if (!input.has_value() || !resultType.hasStaticShape())
+    return std::nullopt;
+
+  std::vector<uint64_t> output(resultType.getNumElements());
+  lut::encodeExpandLutForBootstrap(output.data(), output.size(),
+                                   input->data(), input->size(),
+                                   op.getOutputBits(), op.getIsSigned());
+  return mlir::DenseIntElementsAttr::get(resultType,
+                                         llvm::ArrayRef<uint64_t>(output));
+}
+
+/// Evaluates the encoding of a constant lookup table for a crt wop pbs.
+std::optional<mlir::DenseIntElementsAttr>
+foldEncoding(TFHE::EncodeLutForCrtWopPBSOp op) {
+  auto input = getConstantLut(op.getInputLookupTable());
+  auto resultType = op.getResult().getType().cast<mlir::RankedTensorType>();
+  if (!input.has_value() || !resultType.hasStaticShape())
+    return std::nullopt;
+
+  auto crtDecomposition = toUnsigned(op.getCrtDecomposition());
+  auto crtBits = toUnsigned(op.getCrtBits());
+  if (crtDecomposition.size() != crtBits.size() ||
+      (int64_t)crtDecomposition.size() != resultType.getDimSize(0) ||
+      op.getModulusProduct() < input->size())
+    return std::nullopt;
+
+  std::vector<uint64_t> output(resultType.getNumElements());
+  lut::encodeLutForCrtWopPBS(output.data(), resultType.getDimSize(1),
+                             input->data(), input->size(),
+                             crtDecomposition.data(), crtBits.data(),
+                             crtDecomposition.size(), op.getModulusProduct(),
+                             op.getIsSigned());
+  return mlir::DenseIntElementsAttr::get(resultType,
+                                         llvm::ArrayRef<uint64_t>(output));
+}
+
+/// Replaces the lookup table encodings whose input is a constant by the
+/// constant encoded table, computed at compile time. As attributes are
+/// uniqued in the context, identical encoded tables of a function are
+/// materialized only once, at the beginning of the function.
+class TFHELUTEncodingFoldingPass
+    : public TFHELUTEncodingFoldingBase<TFHELUTEncodingFoldingPass> {
+public:
+  void runOnOperation() override {
+    mlir::func::FuncOp func = getOperation();
+    if (func.isExternal())
+      return;
+
+    mlir::OpBuilder builder(func.getBody());
+    llvm::DenseMap<mlir::Attribute, mlir::Value> encodedTables;
+    llvm::SetVector<mlir::Operation *> deadInputs;
+
+    auto replace = [&](mlir::Operation *op,
+                       std::optional<mlir::DenseIntElementsAttr> encoded) {
+      if (!encoded.has_value())
+        return;
+      auto it = encodedTables.find(*encoded);
+      if (it == encodedTables.end()) {
+        auto cst =
+            builder.create<mlir::arith::ConstantOp>(op->getLoc(), *encoded);
+        it = encodedTables.try_emplace(*encoded, cst.getResult()).first;
+      }
+      mlir::Operation *input = op->getOperand(0).getDefiningOp();
+      op->getResult(0).replaceAllUsesWith(it->second);
+      op->erase();
+      if (input != nullptr && input->use_empty())
+        deadInputs.insert(input);
+    };
+
+    func.walk([&](mlir::Operation *op) {
+      if (auto encodeOp =
+              llvm::dyn_cast<TFHE::EncodeExpandLutForBootstrapOp>(op))
+        replace(op, foldEncoding(encodeOp));
+      else if (auto encodeOp =
+                   llvm::dyn_cast<TFHE::EncodeLutForCrtWopPBSOp>(op))
+        replace(op, foldEncoding(encodeOp));
+    });
+
+    for (mlir::Operation *input : deadInputs) {
+      if (mlir::isOpTriviallyDead(input))
+        input->erase();
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::func::FuncOp>>
+createTFHELUTEncodingFoldingPass() {
+  return std::make_unique<TFHELUTEncodingFoldingPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
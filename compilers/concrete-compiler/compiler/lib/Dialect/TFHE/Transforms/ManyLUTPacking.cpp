@@ -0,0 +1,271 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include <llvm/ADT/MapVector.h>
+#include <llvm/ADT/SetVector.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Tensor/IR/Tensor.h>
+#include <mlir/IR/Matchers.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+
+#include <concretelang/Dialect/TFHE/IR/TFHEOps.h>
+#include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
+
+namespace mlir {
+namespace concretelang {
+
+namespace {
+
+/// A bootstrap marked by the `TFHE.many_lut` attribute, with the values it
+/// depends on
+struct ManyLUTCandidate {
+  TFHE::BootstrapGLWEOp bootstrap;
+  TFHE::EncodeExpandLutForBootstrapOp encoding;
+  unsigned int lutCount;
+};
+
+/// Returns the bootstrap as a candidate to many-lut packing, if it has been
+/// marked as part of a many-lut group, and if the polynomial size leaves room
+/// for the interleaved lookup tables.
+std::optional<ManyLUTCandidate> getCandidate(TFHE::BootstrapGLWEOp op) {
+  auto lutCountAttr = op->getAttrOfType<mlir::IntegerAttr>("TFHE.many_lut");
+  if (lutCountAttr == nullptr || lutCountAttr.getInt() < 2)
+    return std::nullopt;
+
+  auto encoding =
+      op.getLookupTable().getDefiningOp<TFHE::EncodeExpandLutForBootstrapOp>();
+  if (encoding == nullptr || encoding.getIsSigned())
+    return std::nullopt;
+
+  unsigned int lutCount = lutCountAttr.getInt();
+  int64_t inputSize = encoding.getInputLookupTable()
+                          .getType()
+                          .cast<mlir::RankedTensorType>()
+                          .getDimSize(0);
+  int64_t polySize = op.getKeyAttr().getPolySize();
+
+  // The expanded table is split into mega cases of even size, one per
+  // interleaved entry
+  if (mlir::ShapedType::isDynamic(inputSize) || inputSize % lutCount != 0 ||
+      polySize < 2 * inputSize)
+    return std::nullopt;
+
+  return ManyLUTCandidate{op, encoding, lutCount};
+}
+
+/// Returns the value from which the input of the bootstrap has been
+/// keyswitched, and the keyswitch key, or the input itself
+std::pair<mlir::Value, mlir::Attribute> getSource(TFHE::BootstrapGLWEOp op) {
+  if (auto ks = op.getCiphertext().getDefiningOp<TFHE::KeySwitchGLWEOp>())
+    return {ks.getCiphertext(), ks.getKeyAttr()};
+  return {op.getCiphertext(), nullptr};
+}
+
+/// Builds the lookup table interleaving the lookup tables of `group`:
+/// `packed[m * K + j] = T_j[m * K]`. The lookup tables of the group have been
+/// expanded by `K` by the FHE many-lut grouping, so `T_j[m * K] = f_j(m)`.
+/// The slots of the missing lookup tables of an incomplete group are filled
+/// with the first lookup table.
+mlir::Value buildPackedLUT(mlir::OpBuilder &builder, mlir::Location loc,
+                           llvm::ArrayRef<ManyLUTCandidate> group) {
+  unsigned int lutCount = group.front().lutCount;
+  auto tableType = group.front()
+                       .encoding.getInputLookupTable()
+                       .getType()
+                       .cast<mlir::RankedTensorType>();
+  int64_t size = tableType.getDimSize(0);
+  int64_t entries = size / lutCount;
+
+  auto tableOf = [&](unsigned int j) {
+    return group[j < group.size() ? j : 0].encoding.getInputLookupTable();
+  };
+
+  // Constant tables are interleaved at compile time
+  llvm::SmallVector<llvm::SmallVector<llvm::APInt>> constants;
+  for (unsigned int j = 0; j < lutCount; j++) {
+    mlir::DenseIntElementsAttr attr;
+    if (!mlir::matchPattern(tableOf(j), mlir::m_Constant(&attr)))
+      break;
+    constants.push_back(llvm::to_vector(attr.getValues<llvm::APInt>()));
+  }
+
+  if (constants.size() == lutCount) {
+    llvm::SmallVector<llvm::APInt> packed;
+    packed.reserve(size);
+    for (int64_t m = 0; m < entries; m++) {
+      for (unsigned int j = 0; j < lutCount; j++)
+        packed.push_back(constants[j][m * lutCount]);
+    }
+    return builder.create<mlir::arith::ConstantOp>(
+        loc, mlir::DenseIntElementsAttr::get(tableType, packed));
+  }
+
+  auto entriesType =
+      mlir::RankedTensorType::get({entries}, tableType.getElementType());
+  mlir::Value packed = builder.create<mlir::tensor::EmptyOp>(
+      loc, tableType.getShape(), tableType.getElementType());
+
+  llvm::SmallVector<mlir::OpFoldResult> sizes{builder.getIndexAttr(entries)};
+  llvm::SmallVector<mlir::OpFoldResult> strides{
+      builder.getIndexAttr(lutCount)};
+
+  for (unsigned int j = 0; j < lutCount; j++) {
+    mlir::Value entriesOfJ = builder.create<mlir::tensor::ExtractSliceOp>(
+        loc, entriesType, tableOf(j),
+        llvm::SmallVector<mlir::OpFoldResult>{builder.getIndexAttr(0)}, sizes,
+        strides);
+    packed = builder.create<mlir::tensor::InsertSliceOp>(
+        loc, entriesOfJ, packed,
+        llvm::SmallVector<mlir::OpFoldResult>{builder.getIndexAttr(j)}, sizes,
+        strides);
+  }
+
+  return packed;
+}
+
+/// Replaces the bootstraps of `group`, which all apply to the same
+/// ciphertext, by a single many-lut bootstrap created at the position of the
+/// last bootstrap of the group.
+void packGroup(llvm::ArrayRef<ManyLUTCandidate> group,
+               llvm::SetVector<mlir::Operation *> &deadOps) {
+  TFHE::BootstrapGLWEOp last = group.back().bootstrap;
+  TFHE::EncodeExpandLutForBootstrapOp encoding = group.front().encoding;
+  mlir::Location loc = last.getLoc();
+  mlir::OpBuilder builder(last);
+
+  mlir::Value packedLUT = buildPackedLUT(builder, loc, group);
+  auto packedEncoding = builder.create<TFHE::EncodeExpandLutForBootstrapOp>(
+      loc, encoding.getResult().getType(), packedLUT,
+      encoding.getPolySizeAttr(), encoding.getOutputBitsAttr(),
+      encoding.getIsSignedAttr());
+
+  int64_t inputSize =
+      packedLUT.getType().cast<mlir::ShapedType>().getDimSize(0);
+  int64_t polySize = last.getKeyAttr().getPolySize();
+  auto resultType = mlir::RankedTensorType::get(
+      {(int64_t)group.size()}, last.getResult().getType());
+
+  auto manyLUT = builder.create<TFHE::ManyLUTBootstrapGLWEOp>(
+      loc, resultType, last.getCiphertext(), packedEncoding,
+      last.getKeyAttr(), builder.getI32IntegerAttr(polySize / inputSize));
+  if (auto oid = group.front().bootstrap->getAttr("TFHE.OId"))
+    manyLUT->setAttr("TFHE.OId", oid);
+
+  for (auto [i, candidate] : llvm::enumerate(group)) {
+    mlir::Value index = builder.create<mlir::arith::ConstantIndexOp>(loc, i);
+    mlir::Value sample =
+        builder.create<mlir::tensor::ExtractOp>(loc, manyLUT, index);
+
+    TFHE::BootstrapGLWEOp bootstrap = candidate.bootstrap;
+    mlir::Operation *input = bootstrap.getCiphertext().getDefiningOp();
+    bootstrap.getResult().replaceAllUsesWith(sample);
+    bootstrap.erase();
+
+    if (input != nullptr && input != manyLUT.getCiphertext().getDefiningOp())
+      deadOps.insert(input);
+    deadOps.insert(candidate.encoding);
+  }
+}
+
+/// Packs the bootstraps marked by the FHE many-lut grouping, which apply
+/// several lookup tables to the same ciphertext, into many-lut bootstraps.
+class TFHEManyLUTPackingPass
+    : public TFHEManyLUTPackingBase<TFHEManyLUTPackingPass> {
+public:
+  void runOnOperation() override {
+    mlir::func::FuncOp func = getOperation();
+
+    // Candidates grouped by source ciphertext, keys, result type, block and
+    // encoding, in program order
+    using GroupKey =
+        std::tuple<mlir::Value, mlir::Attribute, mlir::Attribute, mlir::Type,
+                   mlir::Block *, unsigned int, int64_t, int64_t>;
+    llvm::MapVector<GroupKey, llvm::SmallVector<ManyLUTCandidate>> groups;
+
+    func.walk([&](TFHE::BootstrapGLWEOp op) {
+      std::optional<ManyLUTCandidate> candidate = getCandidate(op);
+      if (!candidate.has_value())
+        return;
+
+      auto [source, ksk] = getSource(op);
+      int64_t inputSize = candidate->encoding.getInputLookupTable()
+                              .getType()
+                              .cast<mlir::RankedTensorType>()
+                              .getDimSize(0);
+      GroupKey key{source,
+                   ksk,
+                   op.getKeyAttr(),
+                   op.getResult().getType(),
+                   op->getBlock(),
+                   candidate->lutCount,
+                   candidate->encoding.getOutputBits(),
+                   inputSize};
+      groups[key].push_back(*candidate);
+    });
+
+    llvm::SetVector<mlir::Operation *> deadOps;
+
+    for (auto &group : groups) {
+      llvm::ArrayRef<ManyLUTCandidate> candidates = group.second;
+      unsigned int lutCount = candidates.front().lutCount;
+
+      while (candidates.size() >= 2) {
+        size_t chunkSize = std::min<size_t>(lutCount, candidates.size());
+        auto chunk = packable(candidates.take_front(chunkSize));
+        if (chunk.size() >= 2)
+          packGroup(chunk, deadOps);
+        candidates = candidates.drop_front(chunkSize);
+      }
+    }
+
+    // Erase the keyswitches, encodings and lookup tables that are not used
+    // anymore
+    while (!deadOps.empty()) {
+      mlir::Operation *op = deadOps.pop_back_val();
+      if (!mlir::isOpTriviallyDead(op))
+        continue;
+      for (mlir::Value operand : op->getOperands()) {
+        if (mlir::Operation *def = operand.getDefiningOp())
+          deadOps.insert(def);
+      }
+      op->erase();
+    }
+  }
+
+private:
+  /// Keeps the bootstraps of `chunk` whose results are only used after the
+  /// last bootstrap of the chunk, which is where they are packed
+  llvm::SmallVector<ManyLUTCandidate>
+  packable(llvm::ArrayRef<ManyLUTCandidate> chunk) {
+    mlir::Operation *last = chunk.back().bootstrap;
+    mlir::Block *block = last->getBlock();
+
+    llvm::SmallVector<ManyLUTCandidate> packable;
+    for (const ManyLUTCandidate &candidate : chunk.drop_back()) {
+      bool usedBeforeLast =
+          llvm::any_of(candidate.bootstrap->getUsers(), [&](auto *user) {
+            mlir::Operation *ancestor = block->findAncestorOpInBlock(*user);
+            return ancestor == nullptr || ancestor->isBeforeInBlock(last);
+          });
+
+      if (!usedBeforeLast)
+        packable.push_back(candidate);
+    }
+    packable.push_back(chunk.back());
+
+    return packable;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::func::FuncOp>>
+createTFHEManyLUTPackingPass() {
+  return std::make_unique<TFHEManyLUTPackingPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
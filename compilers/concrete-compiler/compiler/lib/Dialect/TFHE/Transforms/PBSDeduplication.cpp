@@ -0,0 +1,202 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SetVector.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/SCF/IR/SCF.h>
+#include <mlir/IR/Dominance.h>
+
+#include <concretelang/Analysis/StaticLoops.h>
+#include <concretelang/Dialect/TFHE/IR/TFHEOps.h>
+#include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
+
+namespace mlir {
+namespace concretelang {
+
+namespace {
+
+/// Operation name, operands, result type and inherent attributes of an
+/// operation. Two operations with the same key compute the same value.
+using ValueNumberKey = std::tuple<const void *, mlir::Value, mlir::Value,
+                                  mlir::Type, mlir::Attribute>;
+
+/// Returns true if `op` is considered for the deduplication: the lookup
+/// tables, their encoding, and the keyswitches and bootstraps
+bool isCandidate(mlir::Operation *op) {
+  if (auto cst = llvm::dyn_cast<mlir::arith::ConstantOp>(op))
+    return cst.getType().isa<mlir::RankedTensorType>();
+
+  return llvm::isa<TFHE::EncodeExpandLutForBootstrapOp,
+                   TFHE::KeySwitchGLWEOp, TFHE::BootstrapGLWEOp>(op);
+}
+
+ValueNumberKey getValueNumberKey(mlir::Operation *op) {
+  assert(op->getNumOperands() <= 2 && op->getNumResults() == 1);
+
+  // Discardable attributes (e.g. the optimizer identifier), which are
+  // prefixed by their dialect, have no effect on the computed value
+  llvm::SmallVector<mlir::NamedAttribute> inherentAttrs;
+  for (mlir::NamedAttribute attr : op->getAttrs()) {
+    if (!attr.getName().getValue().contains('.'))
+      inherentAttrs.push_back(attr);
+  }
+
+  auto operand = [&](unsigned int i) {
+    return i < op->getNumOperands() ? op->getOperand(i) : mlir::Value();
+  };
+
+  return {op->getName().getAsOpaquePointer(), operand(0), operand(1),
+          op->getResult(0).getType(),
+          mlir::DictionaryAttr::get(op->getContext(), inherentAttrs)};
+}
+
+/// Returns the number of times `op` is executed, considering the loops with
+/// an unknown trip count as executed once
+int64_t getExecutionCount(mlir::Operation *op) {
+  int64_t count = 1;
+  for (auto loop = op->getParentOfType<mlir::scf::ForOp>(); loop;
+       loop = loop->getParentOfType<mlir::scf::ForOp>()) {
+    count *= tryGetStaticTripCount(loop).value_or(1);
+  }
+  return count;
+}
+
+/// Merges the redundant bootstraps and keyswitches of a function, i.e. the
+/// ones applied to the same ciphertext with the same keys and the same
+/// lookup table. Lookup tables are compared by content, and the loop
+/// invariant bootstraps are hoisted out of `scf.for` loops beforehand, so
+/// that identical bootstraps of different loop bodies can be merged.
+///
+/// The number of eliminated bootstrap executions is recorded on the
+/// function in the `TFHE.eliminated_pbs` attribute.
+class TFHEPBSDeduplicationPass
+    : public TFHEPBSDeduplicationBase<TFHEPBSDeduplicationPass> {
+public:
+  void runOnOperation() override {
+    mlir::func::FuncOp func = getOperation();
+    if (func.isExternal())
+      return;
+
+    int64_t eliminated = hoistLoopInvariants(func);
+    eliminated += mergeEquivalents(func);
+
+    if (eliminated > 0) {
+      mlir::Builder builder(func.getContext());
+      int64_t previous = 0;
+      if (auto attr =
+              func->getAttrOfType<mlir::IntegerAttr>("TFHE.eliminated_pbs"))
+        previous = attr.getInt();
+      func->setAttr("TFHE.eliminated_pbs",
+                    builder.getI64IntegerAttr(previous + eliminated));
+    }
+  }
+
+private:
+  /// Hoists the loop invariant bootstraps, together with the keyswitches,
+  /// lookup tables and encodings of the loop body computing their operands,
+  /// out of the `scf.for` loops known to execute at least once, innermost
+  /// loops first. Other candidates are left in place, as hoisting them alone
+  /// does not save any bootstrap.
+  int64_t hoistLoopInvariants(mlir::func::FuncOp func) {
+    llvm::SmallVector<mlir::scf::ForOp> loops;
+    func.walk([&](mlir::scf::ForOp loop) { loops.push_back(loop); });
+
+    int64_t eliminated = 0;
+    for (mlir::scf::ForOp loop : loops) {
+      std::optional<int64_t> tripCount = tryGetStaticTripCount(loop);
+      if (!tripCount.has_value() || *tripCount < 1)
+        continue;
+
+      llvm::SmallVector<TFHE::BootstrapGLWEOp> bootstraps;
+      for (mlir::Operation &op : loop.getBody()->without_terminator()) {
+        if (auto bootstrap = llvm::dyn_cast<TFHE::BootstrapGLWEOp>(op))
+          bootstraps.push_back(bootstrap);
+      }
+
+      for (TFHE::BootstrapGLWEOp bootstrap : bootstraps) {
+        llvm::SetVector<mlir::Operation *> chain;
+        if (!collectInvariantChain(loop, bootstrap, chain))
+          continue;
+
+        eliminated += getExecutionCount(bootstrap) - getExecutionCount(loop);
+        for (mlir::Operation *op : chain)
+          loop.moveOutOfLoop(op);
+      }
+    }
+
+    return eliminated;
+  }
+
+  /// Collects in `chain`, operands first, `op` and the candidates of the
+  /// body of `loop` it depends on. Returns false if `op` depends on a value
+  /// of the loop body that is not computed by a loop invariant candidate.
+  bool collectInvariantChain(mlir::scf::ForOp loop, mlir::Operation *op,
+                             llvm::SetVector<mlir::Operation *> &chain) {
+    if (!isCandidate(op))
+      return false;
+
+    for (mlir::Value operand : op->getOperands()) {
+      if (loop.isDefinedOutsideOfLoop(operand))
+        continue;
+
+      mlir::Operation *def = operand.getDefiningOp();
+      if (def == nullptr || def->getBlock() != loop.getBody() ||
+          !collectInvariantChain(loop, def, chain))
+        return false;
+    }
+
+    chain.insert(op);
+    return true;
+  }
+
+  /// Replaces each candidate by an equivalent operation dominating it, if
+  /// any. Operations are visited in pre-order, so the operands of an
+  /// operation are already deduplicated when it is visited.
+  int64_t mergeEquivalents(mlir::func::FuncOp func) {
+    llvm::SmallVector<mlir::Operation *> candidates;
+    func.walk<mlir::WalkOrder::PreOrder>([&](mlir::Operation *op) {
+      if (isCandidate(op))
+        candidates.push_back(op);
+    });
+
+    mlir::DominanceInfo dominance(func);
+    llvm::DenseMap<ValueNumberKey, llvm::SmallVector<mlir::Operation *, 1>>
+        known;
+
+    int64_t eliminated = 0;
+    for (mlir::Operation *op : candidates) {
+      auto &equivalents = known[getValueNumberKey(op)];
+      auto equivalent =
+          llvm::find_if(equivalents, [&](mlir::Operation *candidate) {
+            return dominance.properlyDominates(candidate, op);
+          });
+
+      if (equivalent == equivalents.end()) {
+        equivalents.push_back(op);
+        continue;
+      }
+
+      if (llvm::isa<TFHE::BootstrapGLWEOp>(op))
+        eliminated += getExecutionCount(op);
+
+      op->getResult(0).replaceAllUsesWith((*equivalent)->getResult(0));
+      op->erase();
+    }
+
+    return eliminated;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::func::FuncOp>>
+createTFHEPBSDeduplicationPass() {
+  return std::make_unique<TFHEPBSDeduplicationPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
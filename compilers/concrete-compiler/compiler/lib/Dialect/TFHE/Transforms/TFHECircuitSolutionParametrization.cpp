@@ -262,14 +262,10 @@ public:
                                                             solution.value());
           }
 
-          // TODO: This can be quite slow for `tensor.from_elements`
-          // with lots of operands; implement
-          // SameOperandTypeConstraint taking into account all
-          // operands at once.
-          for (size_t i = 1; i < op.getNumOperands(); i++) {
-            cs.addConstraint<
-                DynamicSameTypeConstraint<DynamicOperandValueYield>>(0, i);
-          }
+          // Constrain all operands at once, as fully unrolled
+          // circuits may pack thousands of ciphertexts
+          cs.addConstraint<SameTypeClassesConstraint>().uniteAll(
+              op->getOperands());
 
           cs.addConstraint<SameOperandAndResultElementTypeConstraint<0, 0>>();
           cs.converge(op, *this, state, inferredTypes);
@@ -298,6 +294,9 @@ public:
                                                             solution.value());
           }
 
+          SameTypeClassesConstraint &sameTypes =
+              cs.addConstraint<SameTypeClassesConstraint>();
+
           for (size_t i = 0; i < op.getNumIterOperands(); i++) {
             mlir::Value initArg = op.getInitArgs()[i];
             mlir::Value regionIterArg = op.getRegionIterArg(i);
@@ -307,14 +306,9 @@ public:
 
             // Ensure that init args, return values, region iter args and
             // operands of terminator all have the same type
-            cs.addConstraint<DynamicSameTypeConstraint<DynamicFunctorYield>>(
-                [=]() { return initArg; }, [=]() { return regionIterArg; });
-
-            cs.addConstraint<DynamicSameTypeConstraint<DynamicFunctorYield>>(
-                [=]() { return initArg; }, [=]() { return result; });
-
-            cs.addConstraint<DynamicSameTypeConstraint<DynamicFunctorYield>>(
-                [=]() { return result; }, [=]() { return terminatorOperand; });
+            sameTypes.unite(initArg, regionIterArg);
+            sameTypes.unite(initArg, result);
+            sameTypes.unite(result, terminatorOperand);
           }
 
           cs.converge(op, *this, state, inferredTypes);
@@ -322,22 +316,16 @@ public:
 
         .Case<mlir::scf::ForallOp>([&](mlir::scf::ForallOp op) {
           TypeConstraintSet<> cs;
+          SameTypeClassesConstraint &sameTypes =
+              cs.addConstraint<SameTypeClassesConstraint>();
 
           for (auto [output, outputBlockArg, result] :
                llvm::zip_equal(op.getOutputs(), op.getOutputBlockArguments(),
                                op.getResults())) {
             // Ensure that shared outputs and the corresponding block
             // arguments all have the same type
-            //
-            // Use initializers for the captures to circumvent
-            // ill-formed capturing of the structured bindings
-            cs.addConstraint<DynamicSameTypeConstraint<DynamicFunctorYield>>(
-                [output = output]() { return output; },
-                [outputBlockArg = outputBlockArg]() { return outputBlockArg; });
-
-            cs.addConstraint<DynamicSameTypeConstraint<DynamicFunctorYield>>(
-                [output = output]() { return output; },
-                [result = result]() { return result; });
+            sameTypes.unite(output, outputBlockArg);
+            sameTypes.unite(output, result);
           }
 
           cs.converge(op, *this, state, inferredTypes);
@@ -351,10 +339,12 @@ public:
                                                             solution.value());
           }
 
+          SameTypeClassesConstraint &sameTypes =
+              cs.addConstraint<SameTypeClassesConstraint>();
+
           for (size_t i = 0; i < op.getNumOperands(); i++) {
-            cs.addConstraint<DynamicSameTypeConstraint<DynamicFunctorYield>>(
-                [=]() { return op->getParentOp()->getResult(i); },
-                [=]() { return op->getOperand(i); });
+            sameTypes.unite(op->getParentOp()->getResult(i),
+                            op->getOperand(i));
           }
 
           cs.converge(op, *this, state, inferredTypes);
@@ -0,0 +1,315 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include <unordered_map>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/Hashing.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Tensor/IR/Tensor.h>
+#include <mlir/IR/ImplicitLocOpBuilder.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+
+#include <concretelang/Dialect/TFHE/IR/TFHEOps.h>
+#include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
+#include <concretelang/Interfaces/BatchableInterface.h>
+
+namespace mlir {
+namespace concretelang {
+
+namespace {
+
+/// Returns true if `op` is a scalar keyswitch or bootstrap, which can be
+/// batched with independent operations of the same kind
+bool isCandidate(mlir::Operation *op) {
+  return llvm::isa<TFHE::KeySwitchGLWEOp, TFHE::BootstrapGLWEOp>(op);
+}
+
+/// Returns the attributes of `op` that are not prefixed by their dialect,
+/// i.e. the ones that have an effect on the computed value
+mlir::DictionaryAttr getInherentAttrs(mlir::Operation *op) {
+  llvm::SmallVector<mlir::NamedAttribute> attrs;
+  for (mlir::NamedAttribute attr : op->getAttrs()) {
+    if (!attr.getName().getValue().contains('.'))
+      attrs.push_back(attr);
+  }
+  return mlir::DictionaryAttr::get(op->getContext(), attrs);
+}
+
+/// Returns true if the operand `operand` is batched by the batching variant
+/// `variant` of `op`
+bool isBatchedOperand(BatchableOpInterface op, unsigned variant,
+                      mlir::OpOperand &operand) {
+  return llvm::any_of(op.getBatchableOperands(variant),
+                      [&](mlir::OpOperand &batchable) {
+                        return batchable.getOperandNumber() ==
+                               operand.getOperandNumber();
+                      });
+}
+
+/// Assigns a wavefront level to the operations of `block`, i.e. the number
+/// of candidates on the longest chain of operations of the block they
+/// depend on, such that two candidates of the same level are independent.
+/// Operations with side effects additionally depend on the previous
+/// operation with side effects, so that their order is preserved.
+llvm::DenseMap<mlir::Operation *, int64_t> computeLevels(mlir::Block &block) {
+  llvm::DenseMap<mlir::Operation *, int64_t> levels;
+  mlir::Operation *lastEffecting = nullptr;
+
+  auto levelAfter = [&](mlir::Operation *def) {
+    return levels.lookup(def) + (isCandidate(def) ? 1 : 0);
+  };
+
+  for (mlir::Operation &op : block.without_terminator()) {
+    int64_t level = 0;
+
+    // The values used in the regions of the operation are dependences too
+    op.walk([&](mlir::Operation *nested) {
+      for (mlir::Value operand : nested->getOperands()) {
+        mlir::Operation *def = operand.getDefiningOp();
+        if (def != nullptr)
+          def = block.findAncestorOpInBlock(*def);
+        if (def != nullptr && def != &op)
+          level = std::max(level, levelAfter(def));
+      }
+    });
+
+    if (!mlir::isMemoryEffectFree(&op)) {
+      if (lastEffecting != nullptr)
+        level = std::max(level, levelAfter(lastEffecting));
+      lastEffecting = &op;
+    }
+
+    levels[&op] = level;
+  }
+
+  return levels;
+}
+
+/// Returns a tensor whose elements along the first dimension are `values`,
+/// which are either scalars or tensors of the same type
+mlir::Value packValues(mlir::ImplicitLocOpBuilder &builder,
+                       llvm::ArrayRef<mlir::Value> values) {
+  auto type = values.front().getType().dyn_cast<mlir::RankedTensorType>();
+  if (!type)
+    return builder.create<mlir::tensor::FromElementsOp>(values);
+
+  llvm::SmallVector<int64_t> shape{(int64_t)values.size()};
+  shape.append(type.getShape().begin(), type.getShape().end());
+  mlir::Value packed =
+      builder.create<mlir::tensor::EmptyOp>(shape, type.getElementType());
+
+  llvm::SmallVector<mlir::OpFoldResult> sizes{builder.getIndexAttr(1)};
+  for (int64_t dim : type.getShape())
+    sizes.push_back(builder.getIndexAttr(dim));
+  llvm::SmallVector<mlir::OpFoldResult> strides(shape.size(),
+                                                builder.getIndexAttr(1));
+
+  for (auto [i, value] : llvm::enumerate(values)) {
+    llvm::SmallVector<mlir::OpFoldResult> offsets(shape.size(),
+                                                  builder.getIndexAttr(0));
+    offsets[0] = builder.getIndexAttr(i);
+    packed = builder.create<mlir::tensor::InsertSliceOp>(value, packed,
+                                                         offsets, sizes,
+                                                         strides);
+  }
+
+  return packed;
+}
+
+/// Replaces the independent operations `ops`, in program order, by a
+/// single batched operation of the batching variant `variant`, created at
+/// the position of the last operation. The results of the batched
+/// operation are extracted for the users of the original operations.
+void batchOperations(llvm::ArrayRef<mlir::Operation *> ops,
+                     unsigned variant) {
+  auto last = llvm::cast<BatchableOpInterface>(ops.back());
+  mlir::ImplicitLocOpBuilder builder(last->getLoc(), last);
+
+  llvm::SmallVector<mlir::Value> batchedOperands;
+  llvm::SmallVector<mlir::Value> nonBatchableOperands;
+
+  for (mlir::OpOperand &operand : last->getOpOperands()) {
+    if (!isBatchedOperand(last, variant, operand)) {
+      nonBatchableOperands.push_back(operand.get());
+      continue;
+    }
+
+    unsigned int idx = operand.getOperandNumber();
+    auto values = llvm::to_vector(llvm::map_range(
+        ops, [&](mlir::Operation *op) { return op->getOperand(idx); }));
+    batchedOperands.push_back(packValues(builder, values));
+  }
+
+  mlir::Value batched = last.createBatchedOperation(
+      variant, builder, batchedOperands, nonBatchableOperands);
+
+  for (auto [i, op] : llvm::enumerate(ops)) {
+    mlir::Value idx = builder.create<mlir::arith::ConstantIndexOp>(i);
+    mlir::Value result = builder.create<mlir::tensor::ExtractOp>(batched, idx);
+    op->getResult(0).replaceAllUsesWith(result);
+    op->erase();
+  }
+}
+
+/// Batches the keyswitches and bootstraps of a function that are not part
+/// of a perfect loop nest, e.g. in unrolled code. In each block, the
+/// candidates of the same wavefront level are independent, and those with
+/// the same keys are grouped into a batched operation. Bootstraps of a
+/// group that do not share their lookup table use the mapped lookup table
+/// variant of the batched bootstrap.
+class TFHEWavefrontBatchingPass
+    : public TFHEWavefrontBatchingBase<TFHEWavefrontBatchingPass> {
+public:
+  TFHEWavefrontBatchingPass(int64_t maxBatchSize)
+      : maxBatchSize(maxBatchSize) {}
+
+  void runOnOperation() override {
+    llvm::SmallVector<mlir::Block *> blocks;
+    getOperation()->walk([&](mlir::Block *block) { blocks.push_back(block); });
+
+    for (mlir::Block *block : blocks)
+      batchBlock(*block);
+  }
+
+private:
+  /// Candidate operations of the same level that can be batched together
+  /// by a batching variant
+  struct Group {
+    int64_t level;
+    mlir::OperationName name;
+    mlir::Attribute attrs;
+    mlir::Type resultType;
+    llvm::SmallVector<mlir::Type> batchedTypes;
+    llvm::SmallVector<mlir::Value> nonBatchedValues;
+    llvm::SmallVector<mlir::Operation *> ops;
+
+    bool accepts(const Group &other) const {
+      return level == other.level && name == other.name &&
+             attrs == other.attrs && resultType == other.resultType &&
+             batchedTypes == other.batchedTypes &&
+             nonBatchedValues == other.nonBatchedValues;
+    }
+
+    llvm::hash_code hash() const {
+      return llvm::hash_combine(
+          level, name.getAsOpaquePointer(), attrs, resultType,
+          llvm::hash_combine_range(batchedTypes.begin(), batchedTypes.end()),
+          llvm::hash_combine_range(nonBatchedValues.begin(),
+                                   nonBatchedValues.end()));
+    }
+  };
+
+  void batchBlock(mlir::Block &block) {
+    if (block.empty() || !block.back().hasTrait<mlir::OpTrait::IsTerminator>())
+      return;
+
+    llvm::SmallVector<mlir::Operation *> candidates;
+    for (mlir::Operation &op : block.without_terminator()) {
+      if (isCandidate(&op))
+        candidates.push_back(&op);
+    }
+
+    if (candidates.size() < 2)
+      return;
+
+    llvm::DenseMap<mlir::Operation *, int64_t> levels = computeLevels(block);
+
+    // Batches of operations, in program order, with their variant
+    using Batch = std::pair<llvm::SmallVector<mlir::Operation *>, unsigned>;
+    llvm::SmallVector<Batch> batches;
+    llvm::DenseSet<mlir::Operation *> batched;
+
+    // Variants batching fewer operands come first, e.g. bootstraps are only
+    // batched with their lookup tables if they could not be batched with a
+    // shared lookup table
+    for (unsigned variant = 0;; variant++) {
+      llvm::SmallVector<Group> groups;
+      std::unordered_map<size_t, llvm::SmallVector<size_t, 1>> groupsByHash;
+      bool hasVariant = false;
+
+      for (mlir::Operation *op : candidates) {
+        auto batchableOp = llvm::cast<BatchableOpInterface>(op);
+        if (batched.contains(op) ||
+            variant >= batchableOp.getNumBatchingVariants())
+          continue;
+        hasVariant = true;
+
+        Group group{levels.lookup(op), op->getName(), getInherentAttrs(op),
+                    op->getResult(0).getType()};
+        for (mlir::OpOperand &operand : op->getOpOperands()) {
+          if (isBatchedOperand(batchableOp, variant, operand))
+            group.batchedTypes.push_back(operand.get().getType());
+          else
+            group.nonBatchedValues.push_back(operand.get());
+        }
+
+        auto &sameHash = groupsByHash[group.hash()];
+        auto existing = llvm::find_if(
+            sameHash, [&](size_t i) { return groups[i].accepts(group); });
+
+        if (existing != sameHash.end()) {
+          groups[*existing].ops.push_back(op);
+        } else {
+          group.ops.push_back(op);
+          sameHash.push_back(groups.size());
+          groups.push_back(std::move(group));
+        }
+      }
+
+      if (!hasVariant)
+        break;
+
+      for (Group &group : groups) {
+        llvm::ArrayRef<mlir::Operation *> ops = group.ops;
+        while (ops.size() >= 2 && maxBatchSize >= 2) {
+          auto chunk =
+              ops.take_front(std::min<size_t>(maxBatchSize, ops.size()));
+          batches.push_back({llvm::to_vector(chunk), variant});
+          batched.insert(chunk.begin(), chunk.end());
+          ops = ops.drop_front(chunk.size());
+        }
+      }
+    }
+
+    if (batches.empty())
+      return;
+
+    // Schedule the operations of the block by level. The level of an
+    // operation is never lower than the level of its dependences, and the
+    // sort is stable, so the dependences are preserved. The users of the
+    // candidates of a level are then located after the last candidate of
+    // the level, where the batched operation is created.
+    llvm::SmallVector<mlir::Operation *> schedule;
+    for (mlir::Operation &op : block.without_terminator())
+      schedule.push_back(&op);
+
+    std::stable_sort(schedule.begin(), schedule.end(),
+                     [&](mlir::Operation *a, mlir::Operation *b) {
+                       return levels.lookup(a) < levels.lookup(b);
+                     });
+
+    mlir::Operation *terminator = block.getTerminator();
+    for (mlir::Operation *op : schedule)
+      op->moveBefore(terminator);
+
+    for (Batch &batch : batches)
+      batchOperations(batch.first, batch.second);
+  }
+
+  int64_t maxBatchSize;
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<mlir::func::FuncOp>>
+createTFHEWavefrontBatchingPass(int64_t maxBatchSize) {
+  return std::make_unique<TFHEWavefrontBatchingPass>(maxBatchSize);
+}
+
+} // namespace concretelang
+} // namespace mlir
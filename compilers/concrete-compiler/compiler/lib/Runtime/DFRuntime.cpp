@@ -179,6 +179,7 @@ bool _dfr_is_jit() { return is_jit_p; }
 bool _dfr_is_root_node() { return is_root_node_p; }
 bool _dfr_use_omp() { return use_omp_p; }
 bool _dfr_is_distributed() { return num_nodes > 1; }
+bool _dfr_is_worker_thread() { return hpx::threads::get_self_ptr() != nullptr; }
 } // namespace dfr
 } // namespace concretelang
 } // namespace mlir
@@ -484,6 +485,7 @@ bool _dfr_is_jit() { return is_jit_p; }
 bool _dfr_is_root_node() { return true; }
 bool _dfr_use_omp() { return use_omp_p; }
 bool _dfr_is_distributed() { return num_nodes > 1; }
+bool _dfr_is_worker_thread() { return false; }
 
 } // namespace dfr
 } // namespace concretelang
@@ -51,7 +51,7 @@ RuntimeContext::RuntimeContext(ServerKeyset serverKeyset)
 #endif
 }
 
-std::pair<FFT, std::shared_ptr<std::vector<std::complex<double>>>>
+std::pair<FFT, std::shared_ptr<LweBootstrapKey::FourierBufferType>>
 RuntimeContext::convert_to_fourier_domain(LweBootstrapKey &bsk) {
   auto info = bsk.getInfo().asReader();
 
@@ -64,6 +64,11 @@ RuntimeContext::convert_to_fourier_domain(LweBootstrapKey &bsk) {
   // Create the FFT
   FFT fft(polynomial_size);
 
+  // Reuse the key converted when the keyset has been prepared
+  if (auto prepared = bsk.getFourierBuffer())
+    return std::pair<FFT, std::shared_ptr<LweBootstrapKey::FourierBufferType>>(
+        std::move(fft), prepared);
+
   // Allocate scratch for key conversion
   size_t scratch_size;
   size_t scratch_align;
@@ -73,7 +78,7 @@ RuntimeContext::convert_to_fourier_domain(LweBootstrapKey &bsk) {
 
   // Allocate the fourier_bootstrap_key
   auto &bsk_buffer = bsk.getBuffer();
-  auto fourier_data = std::make_shared<std::vector<std::complex<double>>>();
+  auto fourier_data = std::make_shared<LweBootstrapKey::FourierBufferType>();
   fourier_data->resize(bsk_buffer.size() / 2);
   auto bsk_data = bsk_buffer.data();
 
@@ -84,7 +89,7 @@ RuntimeContext::convert_to_fourier_domain(LweBootstrapKey &bsk) {
       input_lwe_dimension, fft.fft, scratch, scratch_size);
   free(scratch);
 
-  return std::pair<FFT, std::shared_ptr<std::vector<std::complex<double>>>>(
+  return std::pair<FFT, std::shared_ptr<LweBootstrapKey::FourierBufferType>>(
       std::move(fft), fourier_data);
 }
 } // namespace concretelang
@@ -126,7 +131,7 @@ void DistributedRuntimeContext::getBSKonNode(size_t keyId) {
 
   auto fdbsk = convert_to_fourier_domain(bskw.keys[0]);
   fbks.insert(
-      std::pair<size_t, std::shared_ptr<std::vector<std::complex<double>>>>(
+      std::pair<size_t, std::shared_ptr<LweBootstrapKey::FourierBufferType>>(
           keyId, fdbsk.second));
   dffts.insert(std::pair<size_t, FFT>(keyId, std::move(fdbsk.first)));
 }
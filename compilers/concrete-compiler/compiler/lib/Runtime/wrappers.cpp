@@ -6,17 +6,28 @@
 #include "concretelang/Runtime/wrappers.h"
 #include "concrete-cpu.h"
 #include "concretelang/Common/Error.h"
+#include <algorithm>
 #include <assert.h>
 #include <bitset>
 #include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <omp.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <thread>
 #include <vector>
 
 #include "concretelang/Common/CRT.h"
+#include "concretelang/Common/HugePages.h"
+#include "concretelang/Common/LookupTable.h"
+#include "concretelang/Runtime/DFRuntime.hpp"
 #include "concretelang/Runtime/wrappers.h"
 
 #ifdef CONCRETELANG_CUDA_SUPPORT
@@ -368,52 +379,10 @@ void memref_encode_expand_lut_for_bootstrap(
   assert(output_lut_stride == 1 && "Runtime: stride not equal to 1, check "
                                    "memref_encode_expand_lut_bootstrap");
 
-  size_t mega_case_size = output_lut_size / input_lut_size;
-
-  assert((mega_case_size % 2) == 0);
-
-  // When the bootstrap is executed on encrypted signed integers, the lut must
-  // be half-rotated. This map takes care about properly indexing into the input
-  // lut depending on what bootstrap gets executed.
-  std::function<size_t(size_t)> indexMap;
-  if (is_signed) {
-    size_t halfInputSize = input_lut_size / 2;
-    indexMap = [=](size_t idx) {
-      if (idx < halfInputSize) {
-        return idx + halfInputSize;
-      } else {
-        return idx - halfInputSize;
-      }
-    };
-  } else {
-    indexMap = [=](size_t idx) { return idx; };
-  }
-
-  // The first lut value should be centered over zero. This means that half of
-  // it should appear at the beginning of the output lut, and half of it at the
-  // end (but negated).
-  for (size_t idx = 0; idx < mega_case_size / 2; ++idx) {
-    output_lut_aligned[output_lut_offset + idx] =
-        input_lut_aligned[input_lut_offset + indexMap(0)]
-        << (64 - out_MESSAGE_BITS - 1);
-  }
-  for (size_t idx = (input_lut_size - 1) * mega_case_size + mega_case_size / 2;
-       idx < output_lut_size; ++idx) {
-    output_lut_aligned[output_lut_offset + idx] =
-        -(input_lut_aligned[input_lut_offset + indexMap(0)]
-          << (64 - out_MESSAGE_BITS - 1));
-  }
-
-  // Treats the other ut values.
-  for (size_t lut_idx = 1; lut_idx < input_lut_size; ++lut_idx) {
-    uint64_t lut_value = input_lut_aligned[input_lut_offset + indexMap(lut_idx)]
-                         << (64 - out_MESSAGE_BITS - 1);
-    size_t start = mega_case_size * (lut_idx - 1) + mega_case_size / 2;
-    for (size_t output_idx = start; output_idx < start + mega_case_size;
-         ++output_idx) {
-      output_lut_aligned[output_lut_offset + output_idx] = lut_value;
-    }
-  }
+  concretelang::lut::encodeExpandLutForBootstrap(
+      output_lut_aligned + output_lut_offset, output_lut_size,
+      input_lut_aligned + input_lut_offset, input_lut_size, out_MESSAGE_BITS,
+      is_signed);
 
   return;
 }
@@ -446,104 +415,17 @@ void memref_encode_lut_for_crt_woppbs(
   assert(output_lut_stride1 == 1 && "Runtime: stride not equal to 1, check "
                                     "memref_encode_lut_woppbs");
 
-  assert(modulus_product >= input_lut_size);
-
-  // Initialize lut cases not supposed to be reached
-  for (uint64_t i = 0; i < output_lut_size0 * output_lut_size1; i++) {
-    output_lut_aligned[output_lut_offset + i] = 0;
-  }
-
-  // When the woppbs is executed on encrypted signed integers, the index of the
-  // lut elements must be adapted to fit the way signed are encrypted in CRT
-  // (to ensure the lookup falls into the proper case).
-  // This map takes care about properly indexing into the output lut depending
-  // on what bootstrap gets executed.
-  std::function<uint64_t(uint64_t)> indexMap;
-  if (!is_signed) {
-    // When not signed, the integer values are encoded in increasing order. That
-    // is (example of 9 bits values, using crt decomposition [5,7,16]):
-    //
-    // |0     511|
-    // |---------|
-    // |0     511|
-    //
-    // is encoded as
-    //
-    // |0   511|  INVALID  |
-    // |-------|-----------|
-    // |0   511|512     559|
-    //
-    // Where on top are represented the semantic values, and below, the actual
-    // encoding of values, either on uint64_t or as increasing crt values.
-    //
-    // As a consequence, there is nothing particular to do to map the index of
-    // the input lut to an index of the output lut.
-    indexMap = [=](uint64_t plaintext) { return plaintext; };
-  } else {
-    // When signed, the integer values are encoded in a way that resembles 2s
-    // complement. That is (example of 9 bits values, using crt decomposition
-    // [5,7,16]):
-    //
-    // |0     255|-256    -1|
-    // |---------|----------|
-    // |0     255|256    511|
-    //
-    // is encoded as
-    //
-    // |0     255|   INVALID   |-256    -1|
-    // |---------|-------------|----------|
-    // |0     255|256       303|304    559|
-    //
-    // Where on top are represented the semantic values, and below, the actual
-    // encoding of values, either on uint64_t or as increasing crt values.
-    //
-    // As a consequence, to map the index of the input lut to an index of the
-    // output lut we must take care of crossing the invalid range in between
-    // positive values and negative values.
-    indexMap = [=](uint64_t plaintext) {
-      if (plaintext >= (input_lut_size / 2)) {
-        plaintext += modulus_product - input_lut_size;
-      }
-      return plaintext;
-    };
-  }
-
-  uint64_t log_lut_crt_size = 0;
-
-  for (size_t in_block = 0; in_block < crt_decomposition_size; in_block++) {
-    auto bits_count = crt_bits_aligned[crt_bits_offset + in_block];
-    log_lut_crt_size += bits_count;
-  }
-
-  uint64_t lut_crt_size = 1 << log_lut_crt_size;
-  assert(lut_crt_size == output_lut_size1);
+  assert(crt_bits_stride == 1 && crt_decomposition_stride == 1 &&
+         "Runtime: stride not equal to 1, check memref_encode_lut_woppbs");
   assert(crt_decomposition_size == output_lut_size0);
-
-  for (uint64_t in_index = 0; in_index < input_lut_size; in_index++) {
-    uint64_t out_index = 0;
-
-    {
-      uint64_t total_bit_count = 0;
-      for (size_t in_block = 0; in_block < crt_decomposition_size; in_block++) {
-        auto in_base =
-            crt_decomposition_aligned[crt_decomposition_offset + in_block];
-        auto bits_count = crt_bits_aligned[crt_bits_offset + in_block];
-        out_index += (((indexMap(in_index) % in_base) << bits_count) / in_base)
-                     << total_bit_count;
-        total_bit_count += bits_count;
-      }
-    }
-
-    for (size_t out_block = 0; out_block < crt_decomposition_size;
-         out_block++) {
-      auto out_base =
-          crt_decomposition_aligned[crt_decomposition_offset + out_block];
-      auto v = encode_crt(input_lut_aligned[input_lut_offset + in_index],
-                          out_base, modulus_product);
-      output_lut_aligned[output_lut_offset + out_block * lut_crt_size +
-                         out_index] = v;
-    }
-  }
+  assert(crt_bits_size == crt_decomposition_size);
+
+  concretelang::lut::encodeLutForCrtWopPBS(
+      output_lut_aligned + output_lut_offset, output_lut_size1,
+      input_lut_aligned + input_lut_offset, input_lut_size,
+      crt_decomposition_aligned + crt_decomposition_offset,
+      crt_bits_aligned + crt_bits_offset, crt_decomposition_size,
+      modulus_product, is_signed);
 }
 
 void memref_add_lwe_ciphertexts_u64(
@@ -817,6 +699,386 @@ void memref_batched_mapped_bootstrap_lwe_u64(
   }
 }
 
+void memref_many_lut_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size, uint64_t ct0_stride,
+    uint64_t *tlu_allocated, uint64_t *tlu_aligned, uint64_t tlu_offset,
+    uint64_t tlu_size, uint64_t tlu_stride, uint32_t input_lwe_dimension,
+    uint32_t polynomial_size, uint32_t decomposition_level_count,
+    uint32_t decomposition_base_log, uint32_t glwe_dimension,
+    uint32_t bsk_index, uint32_t sample_stride,
+    mlir::concretelang::RuntimeContext *context) {
+  assert(out_size1 == polynomial_size * glwe_dimension + 1 &&
+         "Output ciphertexts size does not match the bootstrap key");
+  assert(out_size0 * sample_stride <= polynomial_size &&
+         "Extracted samples do not fit in the accumulator");
+
+  uint64_t glwe_ct_size = polynomial_size * (glwe_dimension + 1);
+  uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_size * sizeof(uint64_t));
+  auto tlu = tlu_aligned + tlu_offset;
+
+  // Glwe trivial encryption of the packed lookup tables
+  for (size_t i = 0; i < polynomial_size * glwe_dimension; i++) {
+    glwe_ct[i] = 0;
+  }
+  for (size_t i = 0; i < polynomial_size; i++) {
+    glwe_ct[polynomial_size * glwe_dimension + i] = tlu[i];
+  }
+
+  // Get fourrier bootstrap key
+  const auto &fft = context->fft(bsk_index);
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+  // Get stack parameter
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratch_size, &scratch_align, glwe_dimension, polynomial_size, fft);
+  // Allocate scratch
+  auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+
+  // One blind rotation, then one sample extraction per lookup table
+  concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64(
+      out_aligned + out_offset, ct0_aligned + ct0_offset, glwe_ct,
+      bootstrap_key, out_size0, sample_stride, decomposition_level_count,
+      decomposition_base_log, glwe_dimension, polynomial_size,
+      input_lwe_dimension, fft, scratch, scratch_size);
+
+  free(glwe_ct);
+  free(scratch);
+}
+
+namespace {
+
+/// Scratch of the concrete-cpu operations, grown on demand and reused by
+/// the calls of a thread
+struct ScratchBuffer {
+  uint8_t *data = nullptr;
+  size_t capacity = 0;
+  size_t align = 0;
+
+  ~ScratchBuffer() { free(data); }
+
+  /// Returns a scratch of at least `size` bytes aligned on `alignment` bytes
+  uint8_t *get(size_t size, size_t alignment) {
+    if (data == nullptr || size > capacity || alignment > align) {
+      free(data);
+      data = (uint8_t *)aligned_alloc(alignment, size);
+      capacity = size;
+      align = alignment;
+    }
+    return data;
+  }
+};
+
+thread_local ScratchBuffer scratch_buffer;
+
+/// Buffers of the fused keyswitch and bootstrap, reused by the calls of a
+/// thread: the keyswitched ciphertexts, which stay in cache between the
+/// keyswitch and the bootstrap, and the accumulator.
+struct KeySwitchBootstrapWorkspace {
+  std::vector<uint64_t> keyswitched[2];
+  std::vector<uint64_t> accumulator;
+
+  /// Fills the accumulator with the GLWE trivial encryption of `tlu`
+  void set_accumulator(const uint64_t *tlu, uint32_t glwe_dimension,
+                       uint32_t polynomial_size) {
+    accumulator.assign(polynomial_size * (glwe_dimension + 1), 0);
+    std::copy(tlu, tlu + polynomial_size,
+              accumulator.begin() + polynomial_size * glwe_dimension);
+  }
+};
+
+thread_local KeySwitchBootstrapWorkspace keyswitch_bootstrap_workspace;
+
+/// Buffers of the CRT WoP-PBS, reused by the calls of a thread. The
+/// ciphertexts are on huge pages when they reach the threshold.
+struct WopPBSWorkspace {
+  std::vector<uint64_t> bits_per_block;
+  std::vector<uint64_t> bits_offset;
+  ::concretelang::hugepages::Vector<uint64_t> in_copy;
+  ::concretelang::hugepages::Vector<uint64_t> extracted_bits;
+  std::vector<std::complex<double>> fourier_ggsw;
+};
+
+thread_local WopPBSWorkspace wop_pbs_workspace;
+
+/// True on the threads of the worker pool
+thread_local bool is_pool_worker = false;
+
+/// Returns true if the calling thread already runs alongside other busy
+/// threads: in an OpenMP team, in the worker pool or in a dataflow task. The
+/// parallel loops of the wrappers then run sequentially, to not oversubscribe
+/// the cores.
+bool in_parallel_context() {
+  return omp_in_parallel() || is_pool_worker ||
+         mlir::concretelang::dfr::_dfr_is_worker_thread();
+}
+
+/// Returns the size of the OpenMP team running a loop of `num_iterations`
+/// independent iterations, or 1 to run it sequentially
+int parallel_team_size(size_t num_iterations) {
+  if (in_parallel_context())
+    return 1;
+  return (int)std::clamp<size_t>(num_iterations, 1, omp_get_max_threads());
+}
+
+/// Pool of workers running the asynchronous keyswitches and bootstraps. The
+/// workers are started on the first submitted task and keep their thread
+/// local scratches between tasks.
+class WorkerPool {
+public:
+  static WorkerPool &get() {
+    static WorkerPool pool;
+    return pool;
+  }
+
+  /// Enqueues `task` and returns the future signaled on its completion
+  std::future<void> submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    auto future = packaged.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push_back(std::move(packaged));
+    }
+    cv.notify_one();
+    return future;
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+    }
+    cv.notify_all();
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+private:
+  WorkerPool() {
+    size_t num_workers = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < num_workers; i++)
+      workers.emplace_back([this] { run(); });
+  }
+
+  void run() {
+    is_pool_worker = true;
+    while (true) {
+      std::packaged_task<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return stopped || !tasks.empty(); });
+        if (tasks.empty())
+          return;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers;
+  std::deque<std::packaged_task<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool stopped = false;
+};
+
+/// Returns an opaque handle on the completion of `task` run by the worker
+/// pool, to be released by `memref_await_future`
+void *submit_async(std::function<void()> task) {
+  return new std::future<void>(WorkerPool::get().submit(std::move(task)));
+}
+
+} // namespace
+
+void memref_keyswitch_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t *tlu_allocated, uint64_t *tlu_aligned,
+    uint64_t tlu_offset, uint64_t tlu_size, uint64_t tlu_stride,
+    uint32_t ksk_level, uint32_t ksk_base_log, uint32_t ksk_input_lwe_dim,
+    uint32_t input_lwe_dim, uint32_t poly_size, uint32_t bsk_level,
+    uint32_t bsk_base_log, uint32_t glwe_dim, uint32_t ksk_index,
+    uint32_t bsk_index, mlir::concretelang::RuntimeContext *context) {
+  assert(out_stride == 1 && ct0_stride == 1);
+  auto &workspace = keyswitch_bootstrap_workspace;
+
+  // Get the keys
+  const uint64_t *keyswitch_key = context->keyswitch_key_buffer(ksk_index);
+  const auto &fft = context->fft(bsk_index);
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+
+  // Keyswitch in the reused buffer
+  workspace.keyswitched[0].resize(input_lwe_dim + 1);
+  uint64_t *keyswitched = workspace.keyswitched[0].data();
+  concrete_cpu_keyswitch_lwe_ciphertext_u64(
+      keyswitched, ct0_aligned + ct0_offset, keyswitch_key, ksk_level,
+      ksk_base_log, ksk_input_lwe_dim, input_lwe_dim);
+
+  // Bootstrap the keyswitched ciphertext
+  workspace.set_accumulator(tlu_aligned + tlu_offset, glwe_dim, poly_size);
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratch_size, &scratch_align, glwe_dim, poly_size, fft);
+  uint8_t *scratch = scratch_buffer.get(scratch_size, scratch_align);
+
+  concrete_cpu_bootstrap_lwe_ciphertext_u64(
+      out_aligned + out_offset, keyswitched, workspace.accumulator.data(),
+      bootstrap_key, bsk_level, bsk_base_log, glwe_dim, poly_size,
+      input_lwe_dim, fft, scratch, scratch_size);
+}
+
+void memref_batched_keyswitch_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *tlu_allocated,
+    uint64_t *tlu_aligned, uint64_t tlu_offset, uint64_t tlu_size,
+    uint64_t tlu_stride, uint32_t ksk_level, uint32_t ksk_base_log,
+    uint32_t ksk_input_lwe_dim, uint32_t input_lwe_dim, uint32_t poly_size,
+    uint32_t bsk_level, uint32_t bsk_base_log, uint32_t glwe_dim,
+    uint32_t ksk_index, uint32_t bsk_index,
+    mlir::concretelang::RuntimeContext *context) {
+  if (ct0_size0 == 0)
+    return;
+
+  auto &workspace = keyswitch_bootstrap_workspace;
+
+  // Get the keys once for the whole batch
+  const uint64_t *keyswitch_key = context->keyswitch_key_buffer(ksk_index);
+  const auto &fft = context->fft(bsk_index);
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+
+  // The lookup table is shared by the samples, so are the accumulator and
+  // the scratch
+  workspace.set_accumulator(tlu_aligned + tlu_offset, glwe_dim, poly_size);
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratch_size, &scratch_align, glwe_dim, poly_size, fft);
+  uint8_t *scratch = scratch_buffer.get(scratch_size, scratch_align);
+
+  workspace.keyswitched[0].resize(input_lwe_dim + 1);
+  workspace.keyswitched[1].resize(input_lwe_dim + 1);
+
+  auto keyswitch = [&](size_t i, uint64_t *keyswitched) {
+    concrete_cpu_keyswitch_lwe_ciphertext_u64(
+        keyswitched, ct0_aligned + ct0_offset + i * ct0_size1, keyswitch_key,
+        ksk_level, ksk_base_log, ksk_input_lwe_dim, input_lwe_dim);
+  };
+
+  auto bootstrap = [&](size_t i, uint64_t *keyswitched) {
+    concrete_cpu_bootstrap_lwe_ciphertext_u64(
+        out_aligned + out_offset + i * out_size1, keyswitched,
+        workspace.accumulator.data(), bootstrap_key, bsk_level, bsk_base_log,
+        glwe_dim, poly_size, input_lwe_dim, fft, scratch, scratch_size);
+  };
+
+  if (ct0_size0 == 1) {
+    keyswitch(0, workspace.keyswitched[0].data());
+    bootstrap(0, workspace.keyswitched[0].data());
+    return;
+  }
+
+  // Software pipeline over two keyswitched buffers: a single helper thread
+  // keyswitches the samples in order, at most one sample ahead of the
+  // bootstraps, which run on the calling thread
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t num_keyswitched = 0;
+  size_t num_bootstrapped = 0;
+
+  std::thread helper([&] {
+    for (size_t i = 0; i < ct0_size0; i++) {
+      {
+        // The buffer of sample `i` is free once sample `i - 2` is
+        // bootstrapped
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return num_bootstrapped + 2 > i; });
+      }
+      keyswitch(i, workspace.keyswitched[i % 2].data());
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        num_keyswitched = i + 1;
+      }
+      cv.notify_one();
+    }
+  });
+
+  for (size_t i = 0; i < ct0_size0; i++) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return num_keyswitched > i; });
+    }
+    bootstrap(i, workspace.keyswitched[i % 2].data());
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      num_bootstrapped = i + 1;
+    }
+    cv.notify_one();
+  }
+
+  helper.join();
+}
+
+void *memref_keyswitch_async_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint32_t level, uint32_t base_log,
+    uint32_t input_lwe_dim, uint32_t output_lwe_dim, uint32_t ksk_index,
+    mlir::concretelang::RuntimeContext *context) {
+  return submit_async([=] {
+    memref_keyswitch_lwe_u64(out_allocated, out_aligned, out_offset, out_size,
+                             out_stride, ct0_allocated, ct0_aligned,
+                             ct0_offset, ct0_size, ct0_stride, level, base_log,
+                             input_lwe_dim, output_lwe_dim, ksk_index, context);
+  });
+}
+
+void *memref_bootstrap_async_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t *tlu_allocated, uint64_t *tlu_aligned,
+    uint64_t tlu_offset, uint64_t tlu_size, uint64_t tlu_stride,
+    uint32_t input_lwe_dim, uint32_t poly_size, uint32_t level,
+    uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
+    mlir::concretelang::RuntimeContext *context) {
+  return submit_async([=] {
+    memref_bootstrap_lwe_u64(out_allocated, out_aligned, out_offset, out_size,
+                             out_stride, ct0_allocated, ct0_aligned,
+                             ct0_offset, ct0_size, ct0_stride, tlu_allocated,
+                             tlu_aligned, tlu_offset, tlu_size, tlu_stride,
+                             input_lwe_dim, poly_size, level, base_log,
+                             glwe_dim, bsk_index, context);
+  });
+}
+
+void memref_await_future(uint64_t *out_allocated, uint64_t *out_aligned,
+                         uint64_t out_offset, uint64_t out_size,
+                         uint64_t out_stride, void *future,
+                         uint64_t *in_allocated, uint64_t *in_aligned,
+                         uint64_t in_offset, uint64_t in_size,
+                         uint64_t in_stride) {
+  auto f = (std::future<void> *)future;
+  f->get();
+  delete f;
+  // The asynchronous operation wrote its result in `in`, which is usually
+  // the `out` buffer itself
+  if (out_aligned + out_offset != in_aligned + in_offset) {
+    assert(out_size == in_size && out_stride == 1 && in_stride == 1);
+    memcpy(out_aligned + out_offset, in_aligned + in_offset,
+           out_size * sizeof(uint64_t));
+  }
+}
+
 uint64_t encode_crt(int64_t plaintext, uint64_t modulus, uint64_t product) {
   return concretelang::crt::encode(plaintext, modulus, product);
 }
@@ -869,9 +1131,12 @@ void memref_wop_pbs_crt_buffer(
   assert(lwe_big_dim % polynomial_size == 0);
   uint64_t glwe_dim = lwe_big_dim / polynomial_size;
 
+  auto &workspace = wop_pbs_workspace;
+
   // Compute the numbers of bits to extract for each block and the total one.
   uint64_t total_number_of_bits_per_block = 0;
-  auto number_of_bits_per_block = new uint64_t[crt_decomp_size]();
+  auto &number_of_bits_per_block = workspace.bits_per_block;
+  number_of_bits_per_block.resize(crt_decomp_size);
   for (uint64_t i = 0; i < crt_decomp_size; i++) {
     uint64_t modulus = crt_decomp_aligned[i + crt_decomp_offset];
     uint64_t nb_bit_to_extract =
@@ -887,21 +1152,34 @@ void memref_wop_pbs_crt_buffer(
   //
   // [msb(m%crt[n-1])..lsb(m%crt[n-1])...msb(m%crt[0])..lsb(m%crt[0])] where n
   // is the size of the crt decomposition
-  auto extract_bits_output_buffer =
-      new uint64_t[lwe_small_size * total_number_of_bits_per_block]{0};
+  auto &extract_bits_output_buffer = workspace.extracted_bits;
+  extract_bits_output_buffer.resize(lwe_small_size *
+                                    total_number_of_bits_per_block);
+
+  // Offset of the bits of each block in the output buffer
+  auto &extract_bits_output_offset = workspace.bits_offset;
+  extract_bits_output_offset.resize(crt_decomp_size);
+  for (int64_t i = crt_decomp_size - 1, offset = 0; i >= 0;
+       offset += number_of_bits_per_block[i--]) {
+    extract_bits_output_offset[i] = offset;
+  }
 
   // We make a private copy to apply a subtraction on the body
   auto first_ciphertext = in_aligned + in_offset;
   auto copy_size = crt_decomp_size * lwe_big_size;
-  std::vector<uint64_t> in_copy(first_ciphertext, first_ciphertext + copy_size);
-  // Extraction of each bit for each block
+  auto &in_copy = workspace.in_copy;
+  in_copy.assign(first_ciphertext, first_ciphertext + copy_size);
 
   const auto &fft = context->fft(bsk_index);
   auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
   auto keyswicth_key = context->keyswitch_key_buffer(ksk_index);
+  auto fp_keyswicth_key = context->fp_keyswitch_key_buffer(pksk_index);
 
-  for (int64_t i = crt_decomp_size - 1, extract_bits_output_offset = 0; i >= 0;
-       extract_bits_output_offset += number_of_bits_per_block[i--]) {
+  // Extraction of each bit for each block. The blocks are independent, and
+  // each thread uses its own scratch.
+#pragma omp parallel for schedule(dynamic, 1)                                  \
+    num_threads(parallel_team_size(crt_decomp_size))
+  for (int64_t i = 0; i < (int64_t)crt_decomp_size; i++) {
     auto nb_bits_to_extract = number_of_bits_per_block[i];
 
     size_t delta_log = 64 - nb_bits_to_extract;
@@ -918,19 +1196,16 @@ void memref_wop_pbs_crt_buffer(
     concrete_cpu_extract_bit_lwe_ciphertext_u64_scratch(
         &scratch_size, &scratch_align, lwe_small_dim, lwe_big_dim, glwe_dim,
         polynomial_size, fft);
-    // Allocate scratch
-    auto *scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+    auto *scratch = scratch_buffer.get(scratch_size, scratch_align);
 
     concrete_cpu_extract_bit_lwe_ciphertext_u64(
         &extract_bits_output_buffer[lwe_small_size *
-                                    extract_bits_output_offset],
+                                    extract_bits_output_offset[i]],
         in_block, bootstrap_key, keyswicth_key, lwe_small_dim,
         nb_bits_to_extract, lwe_big_dim, nb_bits_to_extract, delta_log,
         bsk_level_count, bsk_base_log, glwe_dim, polynomial_size, lwe_small_dim,
         ksk_level_count, ksk_base_log, lwe_big_dim, lwe_small_dim, fft, scratch,
         scratch_size);
-
-    free(scratch);
   }
 
   size_t ct_in_count = total_number_of_bits_per_block;
@@ -941,28 +1216,50 @@ void memref_wop_pbs_crt_buffer(
   assert(lut_ct_size0 == lut_count);
   assert(lut_ct_size1 == lut_size);
 
-  // Vertical packing
-  size_t scratch_size;
-  size_t scratch_align;
-  concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64_scratch(
-      &scratch_size, &scratch_align, ct_out_count, lwe_small_dim, ct_in_count,
-      lut_size, lut_count, glwe_dim, polynomial_size, polynomial_size,
-      cbs_level_count, fft);
-
-  auto *scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  // Circuit bootstrap of each extracted bit into a fourier GGSW ciphertext.
+  // The bits are independent.
+  size_t fourier_ggsw_size = concrete_cpu_fourier_ggsw_ciphertext_size_u64(
+      glwe_dim, polynomial_size, cbs_level_count);
+  auto &fourier_ggsw = workspace.fourier_ggsw;
+  fourier_ggsw.resize(fourier_ggsw_size * ct_in_count);
 
-  auto fp_keyswicth_key = context->fp_keyswitch_key_buffer(pksk_index);
+#pragma omp parallel for schedule(dynamic, 1)                                  \
+    num_threads(parallel_team_size(ct_in_count))
+  for (int64_t i = 0; i < (int64_t)ct_in_count; i++) {
+    size_t scratch_size;
+    size_t scratch_align;
+    concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64_scratch(
+        &scratch_size, &scratch_align, lwe_small_dim, glwe_dim,
+        polynomial_size, fft);
+    auto *scratch = scratch_buffer.get(scratch_size, scratch_align);
+
+    concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64(
+        &fourier_ggsw[fourier_ggsw_size * i],
+        &extract_bits_output_buffer[lwe_small_size * i], bootstrap_key,
+        fp_keyswicth_key, lwe_small_dim, bsk_level_count, bsk_base_log,
+        glwe_dim, polynomial_size, lwe_small_dim, fpksk_level_count,
+        fpksk_base_log, lwe_big_dim, glwe_dim, polynomial_size,
+        cbs_level_count, cbs_base_log, fft, scratch, scratch_size);
+  }
 
-  concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64(
-      out_aligned + out_offset, extract_bits_output_buffer,
-      lut_ct_aligned + lut_ct_offset, bootstrap_key, fp_keyswicth_key,
-      lwe_big_dim, ct_out_count, lwe_small_dim, ct_in_count, lut_size,
-      lut_count, bsk_level_count, bsk_base_log, glwe_dim, polynomial_size,
-      lwe_small_dim, fpksk_level_count, fpksk_base_log, lwe_big_dim, glwe_dim,
-      polynomial_size, glwe_dim + 1, cbs_level_count, cbs_base_log, fft,
-      scratch, scratch_size);
+  // Vertical packing of the lookup table of each output block, all indexed by
+  // the circuit bootstrapped bits. The lookup tables are independent.
+#pragma omp parallel for schedule(dynamic, 1)                                  \
+    num_threads(parallel_team_size(lut_count))
+  for (int64_t i = 0; i < (int64_t)lut_count; i++) {
+    size_t scratch_size;
+    size_t scratch_align;
+    concrete_cpu_vertical_packing_lwe_ciphertext_u64_scratch(
+        &scratch_size, &scratch_align, ct_in_count, lut_size, glwe_dim,
+        polynomial_size, fft);
+    auto *scratch = scratch_buffer.get(scratch_size, scratch_align);
 
-  free(scratch);
+    concrete_cpu_vertical_packing_lwe_ciphertext_u64(
+        out_aligned + out_offset + out_stride_0 * i, fourier_ggsw.data(),
+        lut_ct_aligned + lut_ct_offset + lut_ct_stride0 * i, ct_in_count,
+        lut_size, glwe_dim, polynomial_size, cbs_level_count, cbs_base_log,
+        fft, scratch, scratch_size);
+  }
 }
 
 void memref_copy_one_rank(uint64_t *src_allocated, uint64_t *src_aligned,
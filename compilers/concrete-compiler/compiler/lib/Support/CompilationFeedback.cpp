@@ -240,6 +240,10 @@ llvm::json::Array circuitFeedbacksToJson(
          crtDecompositionToJson(circuit.crtDecompositionsOfOutputs)},
         {"statistics", statisticsToJson(circuit.statistics)},
         {"memoryUsagePerLoc", memoryUsageToJson(circuit.memoryUsagePerLoc)},
+        {"eliminatedPBSCount", circuit.eliminatedPBSCount},
+        {"autoRoundedBitsPerLoc", circuit.autoRoundedBitsPerLoc},
+        {"parallelBandSizePerLoc",
+         memoryUsageToJson(circuit.parallelBandSizePerLoc)},
     };
     object.push_back(std::move(circuitObject));
   }
@@ -250,6 +254,8 @@ llvm::json::Value
 toJSON(const mlir::concretelang::ProgramCompilationFeedback &program) {
   llvm::json::Object programObject{
       {"complexity", program.complexity},
+      {"optimizerObjective", program.optimizerObjective},
+      {"criticalPathComplexity", program.criticalPathComplexity},
       {"pError", program.pError},
       {"globalPError", program.globalPError},
       {"totalSecretKeysSize", program.totalSecretKeysSize},
@@ -351,7 +357,10 @@ bool fromJSON(const llvm::json::Value j,
          O.map("totalOutputsSize", v.totalOutputsSize) &&
          O.map("crtDecompositionsOfOutputs", v.crtDecompositionsOfOutputs) &&
          O.map("statistics", v.statistics) &&
-         O.map("memoryUsagePerLoc", v.memoryUsagePerLoc);
+         O.map("memoryUsagePerLoc", v.memoryUsagePerLoc) &&
+         O.mapOptional("eliminatedPBSCount", v.eliminatedPBSCount) &&
+         O.mapOptional("autoRoundedBitsPerLoc", v.autoRoundedBitsPerLoc) &&
+         O.mapOptional("parallelBandSizePerLoc", v.parallelBandSizePerLoc);
 }
 
 bool fromJSON(const llvm::json::Value j,
@@ -359,8 +368,10 @@ bool fromJSON(const llvm::json::Value j,
               llvm::json::Path p) {
   llvm::json::ObjectMapper O(j, p);
 
-  return O && O.map("complexity", v.complexity) && O.map("pError", v.pError) &&
-         O.map("globalPError", v.globalPError) &&
+  return O && O.map("complexity", v.complexity) &&
+         O.mapOptional("optimizerObjective", v.optimizerObjective) &&
+         O.mapOptional("criticalPathComplexity", v.criticalPathComplexity) &&
+         O.map("pError", v.pError) && O.map("globalPError", v.globalPError) &&
          O.map("totalSecretKeysSize", v.totalSecretKeysSize) &&
          O.map("totalBootstrapKeysSize", v.totalBootstrapKeysSize) &&
          O.map("totalKeyswitchKeysSize", v.totalKeyswitchKeysSize) &&
@@ -132,6 +132,28 @@ llvm::LLVMContext *CompilationContext::getLLVMContext() {
   return this->llvmContext;
 }
 
+void CompilationContext::setCompileThreads(unsigned int numThreads) {
+  mlir::MLIRContext *context = this->getMLIRContext();
+  context->disableMultithreading();
+
+  if (numThreads == 1)
+    return;
+
+  llvm::ThreadPoolStrategy strategy =
+      (numThreads == 0) ? llvm::hardware_concurrency()
+                        : llvm::hardware_concurrency(numThreads);
+
+  // Reuse the pool of a previous compilation if it has the right size
+  if (!this->threadPool ||
+      this->threadPool->getThreadCount() != strategy.compute_thread_count()) {
+    auto pool = std::make_unique<llvm::ThreadPool>(strategy);
+    context->setThreadPool(*pool);
+    this->threadPool = std::move(pool);
+  } else {
+    context->setThreadPool(*this->threadPool);
+  }
+}
+
 /// Sets the FHE constraints for the compilation. Overrides any
 /// automatically detected configuration and prevents the autodetection
 /// pass from running.
@@ -348,6 +370,10 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
   if (dataflowParallelize)
     mlir::concretelang::dfr::_dfr_set_required(true);
 
+  // Function-level passes are run concurrently on the circuits of the
+  // program if requested
+  this->compilationContext->setCompileThreads(options.compileThreads);
+
   mlir::OwningOpRef<mlir::ModuleOp> mlirModuleRef(moduleOp);
   res.mlirModuleRef = std::move(mlirModuleRef);
   mlir::ModuleOp module = res.mlirModuleRef->get();
@@ -376,12 +402,64 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
   if (options.chunkIntegers) {
     if (mlir::concretelang::pipeline::transformFHEBigInt(
             mlirContext, module, enablePass, options.chunkSize,
-            options.chunkWidth)
+            options.chunkWidth, options.chunkCarryLookahead)
             .failed()) {
       return StreamStringError("Transforming FHE big integer ops failed");
     }
   }
 
+  // The chains of maximums are lowered as balanced trees, which must be
+  // visible to the noise analysis
+  if (mlir::concretelang::pipeline::balanceMaxChains(mlirContext, module,
+                                                     enablePass)
+          .failed()) {
+    return StreamStringError("Balancing of max chains failed");
+  }
+
+  // The packed lowering of the encrypted inner products must be decided
+  // before the optimizer dag is built, it only uses FHELinalg operations. Its
+  // cost is compared on the products alone, which does not hold with a single
+  // precision for the whole circuit: the packed table would raise the
+  // precision of every table lookup.
+  bool packEncryptedMul =
+      !options.v0Parameter.has_value() &&
+      options.optimizerConfig.strategy != optimizer::Strategy::V0 &&
+      (options.alwaysPackEncryptedMul ||
+       (options.packEncryptedMul &&
+        options.optimizerConfig.strategy == optimizer::Strategy::DAG_MULTI));
+  if (packEncryptedMul) {
+    if (mlir::concretelang::pipeline::packEncryptedMul(
+            mlirContext, module, options.optimizerConfig,
+            options.alwaysPackEncryptedMul, enablePass)
+            .failed()) {
+      return StreamStringError("Packing of encrypted multiplications failed");
+    }
+  }
+
+  if (options.autoRounding) {
+    if (mlir::concretelang::pipeline::insertAutoRounding(mlirContext, module,
+                                                         enablePass)
+            .failed()) {
+      return StreamStringError("Automatic rounding of lookup tables failed");
+    }
+  }
+
+  // Group the lookup tables sharing an input before the parameters are
+  // determined, so that the optimizer accounts for the precision of the
+  // packed lookup tables. The tiling and the dataflow tasks split the grouped
+  // lookup tables apart, which would prevent their packing.
+  bool manyLUT = options.maxManyLUTCount > 1 && !options.emitGPUOps &&
+                 !options.v0Parameter.has_value() &&
+                 !options.fhelinalgTileSizes.has_value() &&
+                 !dataflowParallelize;
+  if (manyLUT) {
+    if (mlir::concretelang::pipeline::groupManyLUTs(
+            mlirContext, module, enablePass, options.maxManyLUTCount)
+            .failed()) {
+      return StreamStringError("Grouping of lookup tables failed");
+    }
+  }
+
   // FHE High level pass to determine FHE parameters
   if (auto err = this->determineFHEParameters(res))
     return std::move(err);
@@ -495,6 +573,42 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
   if (target == Target::PARAMETRIZED_TFHE)
     return std::move(res);
 
+  // Merge the redundant bootstraps and keyswitches, now that their keys are
+  // known
+  if (this->compilerOptions.optimizeTFHE &&
+      mlir::concretelang::pipeline::deduplicateTFHEOps(mlirContext, module,
+                                                       this->enablePass)
+          .failed()) {
+    return StreamStringError("Deduplication of TFHE operations failed");
+  }
+
+  // Share the keyswitches of a ciphertext between the bootstraps consuming
+  // it
+  if (this->compilerOptions.optimizeTFHE &&
+      mlir::concretelang::pipeline::shareTFHEKeyswitches(mlirContext, module,
+                                                         this->enablePass)
+          .failed()) {
+    return StreamStringError("Sharing of TFHE keyswitches failed");
+  }
+
+  // Pack the grouped lookup tables that fit in a polynomial into many-lut
+  // bootstraps
+  if (manyLUT &&
+      mlir::concretelang::pipeline::packManyLUTBootstraps(mlirContext, module,
+                                                          this->enablePass)
+          .failed()) {
+    return StreamStringError("Packing of many-lut bootstraps failed");
+  }
+
+  // Encode constant lookup tables at compile time, now that the parameters
+  // are known
+  if (this->compilerOptions.optimizeTFHE &&
+      mlir::concretelang::pipeline::foldTFHELUTEncodings(mlirContext, module,
+                                                         this->enablePass)
+          .failed()) {
+    return StreamStringError("Folding of TFHE lookup table encodings failed");
+  }
+
   // Normalize TFHE keys
   if (mlir::concretelang::pipeline::normalizeTFHEKeys(mlirContext, module,
                                                       this->enablePass)
@@ -560,6 +674,15 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
             .failed()) {
       return StreamStringError("Batching of TFHE operations");
     }
+
+    // Batching may produce several batched keyswitches of the same
+    // ciphertexts
+    if (this->compilerOptions.optimizeTFHE &&
+        mlir::concretelang::pipeline::shareTFHEKeyswitches(mlirContext, module,
+                                                           this->enablePass)
+            .failed()) {
+      return StreamStringError("Sharing of TFHE keyswitches failed");
+    }
   }
 
   if (target == Target::BATCHED_TFHE)
@@ -572,6 +695,17 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
     return StreamStringError("Lowering from TFHE to Concrete failed");
   }
 
+  // Fuse the keyswitches with the bootstraps consuming them. The fused
+  // operations are only implemented by the CPU runtime, and are not
+  // convertible to SDFG operations.
+  if (this->compilerOptions.optimizeTFHE && !options.emitGPUOps &&
+      !options.emitSDFGOps && !options.asyncOffload &&
+      mlir::concretelang::pipeline::fuseConcreteKeyswitchBootstrap(
+          mlirContext, module, this->enablePass)
+          .failed()) {
+    return StreamStringError("Fusion of keyswitches and bootstraps failed");
+  }
+
   if (target == Target::CONCRETE)
     return std::move(res);
 
@@ -617,6 +751,11 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
     return std::move(res);
 
   if (res.feedback) {
+    if (mlir::concretelang::pipeline::extractParallelBands(
+            mlirContext, module, this->enablePass, res.feedback.value())
+            .failed()) {
+      return StreamStringError("Extracting parallel bands failed");
+    }
     if (mlir::concretelang::pipeline::computeMemoryUsage(
             mlirContext, module, this->enablePass, res.feedback.value())
             .failed()) {
@@ -630,6 +769,13 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
     return StreamStringError("Failed to lower to CAPI");
   }
 
+  if (options.asyncOffload && !options.emitGPUOps &&
+      mlir::concretelang::pipeline::asyncOffload(mlirContext, module,
+                                                 enablePass)
+          .failed()) {
+    return StreamStringError("Asynchronous offloading failed");
+  }
+
   // MLIR canonical dialects -> LLVM Dialect
   if (mlir::concretelang::pipeline::lowerStdToLLVMDialect(mlirContext, module,
                                                           enablePass)
@@ -666,7 +812,8 @@ CompilerEngine::compile(mlir::ModuleOp moduleOp, Target target,
       return StreamStringError(
           "Internal Error: Please provide a library parameter");
     }
-    auto objPath = lib.value()->setCompilationResult(res);
+    auto objPath =
+        lib.value()->setCompilationResult(res, options.compileThreads);
     if (!objPath) {
       return StreamStringError(llvm::toString(objPath.takeError()));
     }
@@ -881,7 +1028,8 @@ void printTluFusing(mlir::Value v1, mlir::Value v2, mlir::Value v1v2) {
 }
 
 llvm::Expected<std::string>
-CompilerEngine::Library::setCompilationResult(CompilationResult &compilation) {
+CompilerEngine::Library::setCompilationResult(CompilationResult &compilation,
+                                              unsigned int compileThreads) {
   llvm::Module *module = compilation.llvmModule.get();
   auto sourceName = module->getSourceFileName();
   if (sourceName == "" || sourceName == "LLVMDialectModule") {
@@ -889,18 +1037,22 @@ CompilerEngine::Library::setCompilationResult(CompilationResult &compilation) {
                  std::to_string(objectsPath.size()) + ".mlir";
   }
   auto objectPath = sourceName + OBJECT_EXT;
-  if (auto error = mlir::concretelang::emitObject(*module, objectPath)) {
-    return std::move(error);
+  auto objectPaths =
+      mlir::concretelang::emitObjects(*module, objectPath, compileThreads);
+  if (!objectPaths) {
+    return objectPaths.takeError();
   }
 
-  addExtraObjectFilePath(objectPath);
+  for (auto &path : *objectPaths) {
+    addExtraObjectFilePath(path);
+  }
   if (compilation.programInfo) {
     programInfo = *compilation.programInfo;
   }
   if (compilation.feedback.has_value()) {
     compilationFeedback = compilation.feedback.value();
   }
-  return objectPath;
+  return objectPaths->front();
 }
 
 bool stringEndsWith(std::string path, std::string requiredExt) {
@@ -6,13 +6,17 @@
 #include <errno.h>
 
 #include "llvm/MC/SubtargetFeature.h"
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/Support/ToolOutputFile.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/TargetParser/Host.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 
 #include <mlir/Support/FileUtilities.h>
 
@@ -129,7 +133,10 @@ static void packFunctionArguments(llvm::Module *module) {
   }
 }
 
-llvm::Error emitObject(llvm::Module &module, string objectPath) {
+// Generates the object file `objectPath` for a module whose functions have
+// already been packed.
+static llvm::Error generateObjectFile(llvm::Module &module,
+                                      string objectPath) {
   auto targetMachine = getTargetMachineAndSetupModule(&module);
   if (!targetMachine) {
     return StreamStringError("No default target machine for object generation");
@@ -142,8 +149,6 @@ llvm::Error emitObject(llvm::Module &module, string objectPath) {
     return StreamStringError("Cannot create/open " + objectPath);
   }
 
-  packFunctionArguments(&module);
-
   // The legacy PassManager is mandatory for final code generation.
   // https://llvm.org/docs/NewPassManager.html#status-of-the-new-and-legacy-pass-managers
   llvm::legacy::PassManager pm;
@@ -162,6 +167,92 @@ llvm::Error emitObject(llvm::Module &module, string objectPath) {
   return llvm::Error::success();
 }
 
+llvm::Error emitObject(llvm::Module &module, string objectPath) {
+  packFunctionArguments(&module);
+  return generateObjectFile(module, objectPath);
+}
+
+// Returns the number of circuits defined in the module, i.e. the functions
+// with a definition that are visible from outside of the module.
+static unsigned int countCircuits(llvm::Module &module) {
+  unsigned int count = 0;
+  for (auto &func : module.getFunctionList()) {
+    if (!func.isDeclaration() && !func.hasLocalLinkage())
+      count++;
+  }
+  return count;
+}
+
+// Returns the path of the object file of the `index`-th part of a module
+static string partObjectPath(string objectPath, size_t index) {
+  llvm::StringRef base(objectPath);
+  base.consume_back(".o");
+  return base.str() + ".part-" + std::to_string(index) + ".o";
+}
+
+llvm::Expected<vector<string>>
+emitObjects(llvm::Module &module, string objectPath, unsigned int numThreads) {
+  llvm::ThreadPoolStrategy strategy =
+      (numThreads == 0) ? llvm::hardware_concurrency()
+                        : llvm::hardware_concurrency(numThreads);
+  unsigned int numParts =
+      std::min(strategy.compute_thread_count(), countCircuits(module));
+
+  if (numParts <= 1) {
+    if (auto err = emitObject(module, objectPath))
+      return std::move(err);
+    return vector<string>{objectPath};
+  }
+
+  packFunctionArguments(&module);
+
+  // Split the module so that each circuit goes with its local callees (e.g.
+  // outlined OpenMP regions) into one of the parts. Local symbols shared by
+  // several parts are externalized with a hidden visibility, so that the
+  // parts can be linked back in the library. As an LLVM context cannot be
+  // used concurrently, each part is serialized to bitcode and materialized
+  // in its own context by the thread generating its code.
+  vector<llvm::SmallString<0>> bitcodes;
+  llvm::SplitModule(
+      module, numParts,
+      [&](std::unique_ptr<llvm::Module> part) {
+        bitcodes.emplace_back();
+        llvm::raw_svector_ostream os(bitcodes.back());
+        llvm::WriteBitcodeToFile(*part, os);
+      },
+      /*PreserveLocals=*/false);
+
+  vector<string> objectPaths(bitcodes.size());
+  vector<string> errors(bitcodes.size());
+  llvm::ThreadPool pool(strategy);
+
+  for (size_t i = 0; i < bitcodes.size(); i++) {
+    objectPaths[i] = partObjectPath(objectPath, i);
+    pool.async([&, i]() {
+      llvm::LLVMContext context;
+      auto part = llvm::parseBitcodeFile(
+          llvm::MemoryBufferRef(bitcodes[i], objectPaths[i]), context);
+      if (!part) {
+        errors[i] = llvm::toString(part.takeError());
+        return;
+      }
+      if (auto err = generateObjectFile(**part, objectPaths[i]))
+        errors[i] = llvm::toString(std::move(err));
+    });
+  }
+
+  pool.wait();
+
+  for (size_t i = 0; i < errors.size(); i++) {
+    if (!errors[i].empty()) {
+      return StreamStringError("Cannot emit part ")
+             << i << " of " << objectPath << ": " << errors[i];
+    }
+  }
+
+  return objectPaths;
+}
+
 string linkerCmd(vector<string> objectsPath, string libraryPath, string linker,
                  std::optional<vector<string>> extraArgs) {
   string cmd = linker + libraryPath;
@@ -13,6 +13,7 @@
 #include "mlir/Dialect/Func/Transforms/Passes.h"
 #include "mlir/Transforms/Passes.h"
 #include "llvm/Support/Error.h"
+#include <mutex>
 
 #include "mlir/Dialect/Affine/Passes.h"
 #include "mlir/Dialect/Arith/Transforms/Passes.h"
@@ -36,10 +37,12 @@
 #include "concretelang/Dialect/Concrete/Transforms/Passes.h"
 #include "concretelang/Dialect/FHE/Analysis/ConcreteOptimizer.h"
 #include "concretelang/Dialect/FHE/Analysis/MANP.h"
+#include "concretelang/Dialect/FHE/Transforms/AutoRounding/AutoRounding.h"
 #include "concretelang/Dialect/FHE/Transforms/BigInt/BigInt.h"
 #include "concretelang/Dialect/FHE/Transforms/Boolean/Boolean.h"
 #include "concretelang/Dialect/FHE/Transforms/DynamicTLU/DynamicTLU.h"
 #include "concretelang/Dialect/FHE/Transforms/EncryptedMulToDoubleTLU/EncryptedMulToDoubleTLU.h"
+#include "concretelang/Dialect/FHE/Transforms/ManyLUT/ManyLUT.h"
 #include "concretelang/Dialect/FHE/Transforms/Max/Max.h"
 #include "concretelang/Dialect/FHE/Transforms/Optimizer/Optimizer.h"
 #include "concretelang/Dialect/FHELinalg/Transforms/Tiling.h"
@@ -95,6 +98,8 @@ getFHEContextFromFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
                      std::function<bool(mlir::Pass *)> enablePass) {
   std::optional<size_t> oMax2norm;
   std::optional<size_t> oMaxWidth;
+  // The analysis passes may run concurrently on several functions
+  std::mutex maxMutex;
   optimizer::FunctionsDag dags;
 
   mlir::PassManager pm(&context);
@@ -107,6 +112,7 @@ getFHEContextFromFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
       pm,
       mlir::concretelang::createMaxMANPPass(
           [&](const uint64_t manp, unsigned width) {
+            std::lock_guard<std::mutex> guard(maxMutex);
             if (!oMax2norm.has_value() || oMax2norm.value() < manp)
               oMax2norm.emplace(manp);
 
@@ -239,6 +245,8 @@ lowerFHELinalgToLinalg(mlir::MLIRContext &context, mlir::ModuleOp &module,
       pm, mlir::concretelang::createConvertFHETensorOpsToLinalg(), enablePass);
   addPotentiallyNestedPass(pm, mlir::createLinalgGeneralizationPass(),
                            enablePass);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createFHEManyLUTFusionPass(), enablePass);
   return pm.run(module.getOperation());
 }
 
@@ -268,14 +276,60 @@ transformFHEBoolean(mlir::MLIRContext &context, mlir::ModuleOp &module,
 }
 
 mlir::LogicalResult
-transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
-                   std::function<bool(mlir::Pass *)> enablePass,
-                   unsigned int chunkSize, unsigned int chunkWidth) {
+balanceMaxChains(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                 std::function<bool(mlir::Pass *)> enablePass) {
   mlir::PassManager pm(&context);
+  pipelinePrinting("BalanceMaxChains", pm, context);
+  addPotentiallyNestedPass(pm, createFHEBalanceMaxPass(), enablePass);
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+groupManyLUTs(mlir::MLIRContext &context, mlir::ModuleOp &module,
+              std::function<bool(mlir::Pass *)> enablePass,
+              unsigned int maxLUTCount) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("FHEManyLUTGrouping", pm, context);
   addPotentiallyNestedPass(
-      pm,
-      mlir::concretelang::createFHEBigIntTransformPass(chunkSize, chunkWidth),
+      pm, mlir::concretelang::createFHEManyLUTGroupingPass(maxLUTCount),
       enablePass);
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+insertAutoRounding(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                   std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("FHEAutoRounding", pm, context);
+  // The noise of the lookup table inputs guides the rewrite
+  addPotentiallyNestedPass(pm, mlir::concretelang::createMANPPass(),
+                           enablePass);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createFHEAutoRoundingPass(), enablePass);
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+packEncryptedMul(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                 optimizer::Config config, bool alwaysPack,
+                 std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("EncryptedMulToPackedTLU", pm, context);
+  addPotentiallyNestedPass(
+      pm, createEncryptedMulToPackedTLUPass(config, alwaysPack), enablePass);
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                   std::function<bool(mlir::Pass *)> enablePass,
+                   unsigned int chunkSize, unsigned int chunkWidth,
+                   bool carryLookahead) {
+  mlir::PassManager pm(&context);
+  addPotentiallyNestedPass(pm,
+                           mlir::concretelang::createFHEBigIntTransformPass(
+                               chunkSize, chunkWidth, carryLookahead),
+                           enablePass);
   // We want to fully unroll for loops introduced by the BigInt transform since
   // MANP doesn't support loops. This is a workaround that make the IR much
   // bigger than it should be
@@ -362,6 +416,57 @@ mlir::LogicalResult batchTFHE(mlir::MLIRContext &context,
 
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createBatchingPass(maxBatchSize), enablePass);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createTFHEWavefrontBatchingPass(maxBatchSize),
+      enablePass);
+
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+deduplicateTFHEOps(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                   std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("TFHEPBSDeduplication", pm, context);
+
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createTFHEPBSDeduplicationPass(), enablePass);
+
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+shareTFHEKeyswitches(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                     std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("TFHEKeyswitchSharing", pm, context);
+
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createTFHEKeyswitchSharingPass(), enablePass);
+
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+packManyLUTBootstraps(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                      std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("TFHEManyLUTPacking", pm, context);
+
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createTFHEManyLUTPackingPass(), enablePass);
+
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+foldTFHELUTEncodings(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                     std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("TFHELUTEncodingFolding", pm, context);
+
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createTFHELUTEncodingFoldingPass(), enablePass);
 
   return pm.run(module.getOperation());
 }
@@ -404,6 +509,34 @@ lowerTFHEToConcrete(mlir::MLIRContext &context, mlir::ModuleOp &module,
   return pm.run(module.getOperation());
 }
 
+mlir::LogicalResult
+fuseConcreteKeyswitchBootstrap(mlir::MLIRContext &context,
+                               mlir::ModuleOp &module,
+                               std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("ConcreteKeyswitchBootstrapFusion", pm, context);
+
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createConcreteKeyswitchBootstrapFusionPass(),
+      enablePass);
+
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+extractParallelBands(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                     std::function<bool(mlir::Pass *)> enablePass,
+                     ProgramCompilationFeedback &feedback) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("ParallelBands", pm, context);
+
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createParallelBandExtractionPass(feedback),
+      enablePass);
+
+  return pm.run(module.getOperation());
+}
+
 mlir::LogicalResult
 computeMemoryUsage(mlir::MLIRContext &context, mlir::ModuleOp &module,
                    std::function<bool(mlir::Pass *)> enablePass,
@@ -522,9 +655,15 @@ mlir::LogicalResult lowerToStd(mlir::MLIRContext &context,
                              enablePass);
   }
 
-  if (parallelizeLoops)
+  // Lower the parallel loops with schedules fit to their keyswitches and
+  // bootstraps; The generic conversion only handles the remaining loops
+  // with reductions
+  if (parallelizeLoops) {
+    addPotentiallyNestedPass(
+        pm, mlir::concretelang::createConcreteSCFToOpenMPPass(), enablePass);
     addPotentiallyNestedPass(pm, mlir::createConvertSCFToOpenMPPass(),
                              enablePass);
+  }
   // Lower affine
   addPotentiallyNestedPass(pm, mlir::createLowerAffinePass(), enablePass);
 
@@ -559,6 +698,18 @@ mlir::LogicalResult lowerToCAPI(mlir::MLIRContext &context,
   return pm.run(module);
 }
 
+mlir::LogicalResult asyncOffload(mlir::MLIRContext &context,
+                                 mlir::ModuleOp &module,
+                                 std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("AsyncOffload", pm, context);
+
+  addPotentiallyNestedPass(pm, mlir::concretelang::createAsyncOffloadPass(),
+                           enablePass);
+
+  return pm.run(module);
+}
+
 mlir::LogicalResult
 lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
                       std::function<bool(mlir::Pass *)> enablePass) {
@@ -14,6 +14,8 @@
 #include <iostream>
 #include <optional>
 
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "concrete-optimizer.hpp"
@@ -24,20 +26,54 @@
 namespace mlir {
 namespace concretelang {
 
-concrete_optimizer::Options options_from_config(optimizer::Config config) {
-  concrete_optimizer::Options options = {
-      /* .security_level = */ config.security,
-      /* .maximum_acceptable_error_probability = */ config.p_error,
-      /* .key_sharing = */ config.key_sharing,
-      /* .multi_param_strategy = */ config.multi_param_strategy,
-      /* .default_log_norm2_woppbs = */ config.fallback_log_norm_woppbs,
-      /* .use_gpu_constraints = */ config.use_gpu_constraints,
-      /* .encoding = */ config.encoding,
-      /* .cache_on_disk = */ config.cache_on_disk,
-      /* .ciphertext_modulus_log = */ config.ciphertext_modulus_log,
-      /* .fft_precision = */ config.fft_precision,
-      /* .composable = */ config.composable};
-  return options;
+/// Loads the costs of the cpu operators measured by the `cpu-calibration`
+/// tool of the concrete-optimizer.
+llvm::Expected<concrete_optimizer::CpuCalibration>
+loadCpuCalibration(llvm::StringRef path) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    return StreamStringError("Cannot read the cpu calibration file ")
+           << path << ": " << buffer.getError().message();
+  }
+
+  auto json = llvm::json::parse(buffer.get()->getBuffer());
+  if (!json) {
+    auto err = json.takeError();
+    return StreamStringError("Invalid cpu calibration file ")
+           << path << ": " << err;
+  }
+
+  const llvm::json::Object *root = json->getAsObject();
+  if (root == nullptr || root->getInteger("version") != 1) {
+    return StreamStringError("Unsupported cpu calibration file ") << path;
+  }
+
+  auto getCost = [&](llvm::StringRef op,
+                     llvm::StringRef field) -> std::optional<double> {
+    if (const llvm::json::Object *cost = root->getObject(op))
+      return cost->getNumber(field);
+    return std::nullopt;
+  };
+
+  auto ksConstant = getCost("ks", "constant_ns");
+  auto ksPerOp = getCost("ks", "ns_per_op");
+  auto pbsConstant = getCost("pbs", "constant_ns");
+  auto pbsPerOp = getCost("pbs", "ns_per_op");
+  auto levelledPerOp = root->getNumber("levelled_ns_per_op");
+
+  if (!ksConstant || !ksPerOp || !pbsConstant || !pbsPerOp ||
+      !levelledPerOp || *ksPerOp <= 0 || *pbsPerOp <= 0) {
+    return StreamStringError("Incomplete cpu calibration file ") << path;
+  }
+
+  concrete_optimizer::CpuCalibration calibration;
+  calibration.calibrated = true;
+  calibration.ks_constant_ns = *ksConstant;
+  calibration.ks_ns_per_op = *ksPerOp;
+  calibration.pbs_constant_ns = *pbsConstant;
+  calibration.pbs_ns_per_op = *pbsPerOp;
+  calibration.levelled_ns_per_op = *levelledPerOp;
+  return calibration;
 }
 
 optimizer::DagSolution getV0Solution(V0FHEConstraint constraint,
@@ -266,9 +302,28 @@ optimizer::Solution convertSolution(optimizer::CircuitSolution sol) {
   return optimizer::Solution(sol);
 }
 
+/// Returns the complexity of the critical path of a `solution` returned by
+/// the optimizer, or 0 if it is not estimated
+template <typename Solution> double getCriticalPathComplexity(Solution) {
+  return 0.;
+}
+
+template <>
+double getCriticalPathComplexity(optimizer::CircuitSolution solution) {
+  return solution.critical_path_complexity;
+}
+
 /// Fill the compilation `feedback` from a `solution` returned by the optmizer.
 template <typename Solution>
-void fillFeedback(Solution solution, ProgramCompilationFeedback &feedback) {
+void fillFeedback(Solution solution, ProgramCompilationFeedback &feedback,
+                  optimizer::Config config) {
+  // Only the dag-multi strategy takes the objective into account
+  auto objective = config.strategy == optimizer::Strategy::DAG_MULTI
+                       ? config.objective
+                       : concrete_optimizer::Objective::Complexity;
+  feedback.optimizerObjective =
+      optimizer::ObjectiveLabel[static_cast<size_t>(objective)];
+  feedback.criticalPathComplexity = getCriticalPathComplexity(solution);
   feedback.complexity = solution.complexity;
   feedback.pError = solution.p_error;
   feedback.globalPError =
@@ -320,7 +375,7 @@ toCompilerSolution(Solution solution, ProgramCompilationFeedback &feedback,
   if (auto err = checkPErrorSolution(solution, config); err) {
     return std::move(err);
   }
-  fillFeedback(solution, feedback);
+  fillFeedback(solution, feedback, config);
   return convertSolution(solution);
 }
 
@@ -329,6 +384,7 @@ optimizer::Solution emptySolution() {
   optimizer::CircuitSolution solution;
   solution.is_feasible = true;
   solution.complexity = 0.;
+  solution.critical_path_complexity = 0.;
   solution.global_p_error = 0;
   solution.p_error = 0;
   return solution;
@@ -352,6 +408,19 @@ getSolution(optimizer::Description &descr, ProgramCompilationFeedback &feedback,
     config.p_error = config.global_p_error;
   }
 
+  if (!config.cpu_calibration_path.empty() &&
+      !config.cpu_calibration.calibrated) {
+    if (config.use_gpu_constraints) {
+      return StreamStringError(
+          "A cpu calibration cannot be used with the gpu constraints");
+    }
+    auto calibration = loadCpuCalibration(config.cpu_calibration_path);
+    if (!calibration) {
+      return calibration.takeError();
+    }
+    config.cpu_calibration = *calibration;
+  }
+
   // This happens for programs without fhe computation
   if (!descr.dag) {
     if (config.display) {
@@ -3,19 +3,126 @@
 // https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
 // for license information.
 
+#include "concretelang/Analysis/StaticLoops.h"
 #include "concretelang/Transforms/Passes.h"
 
 #include "mlir/Dialect/Bufferization/Transforms/Bufferize.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/SCF/Utils/Utils.h"
 #include "mlir/IR/IRMapping.h"
 #include "mlir/IR/Operation.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Transforms/DialectConversion.h"
+#include "mlir/Transforms/LoopInvariantCodeMotionUtils.h"
 #include "mlir/Transforms/Passes.h"
 #include "mlir/Transforms/RegionUtils.h"
 #include <mlir/Transforms/GreedyPatternRewriteDriver.h>
 
 namespace {
+
+/// Name of the function attribute recording the parallel bands, as pairs of
+/// the location of their outermost loop and their number of iterations.
+const char *PARALLEL_BANDS_ATTR = "SCF.parallel_bands";
+
+bool isParallel(mlir::scf::ForOp forOp) {
+  auto attr = forOp->getAttrOfType<mlir::BoolAttr>("parallel");
+  return attr != nullptr && attr.getValue();
+}
+
+/// Returns the single scf.for of the body of `forOp` if the other operations
+/// of the body are side effect free and region free, nullptr otherwise
+mlir::scf::ForOp getSinkTarget(mlir::scf::ForOp forOp) {
+  mlir::scf::ForOp target;
+  for (mlir::Operation &op : forOp.getBody()->without_terminator()) {
+    if (auto nested = llvm::dyn_cast<mlir::scf::ForOp>(op)) {
+      if (target)
+        return nullptr;
+      target = nested;
+    } else if (op.getNumRegions() != 0 || !mlir::isMemoryEffectFree(&op)) {
+      return nullptr;
+    }
+  }
+  return target;
+}
+
+/// Sinks the side effect free operations of the body of `forOp` only used by
+/// its nested loop `inner` into the body of `inner`, making the nest perfect.
+/// Returns false if some operations could not be sunk.
+bool sinkIntoNestedLoop(mlir::scf::ForOp forOp, mlir::scf::ForOp inner) {
+  llvm::SmallVector<mlir::Operation *> ops;
+  for (mlir::Operation &op : forOp.getBody()->without_terminator())
+    if (&op != inner.getOperation())
+      ops.push_back(&op);
+
+  bool perfect = true;
+  for (mlir::Operation *op : llvm::reverse(ops)) {
+    if (op->use_empty()) {
+      op->erase();
+    } else if (llvm::all_of(op->getUsers(), [&](mlir::Operation *user) {
+                 return inner.getRegion().isAncestor(user->getParentRegion());
+               })) {
+      op->moveBefore(&inner.getBody()->front());
+    } else {
+      perfect = false;
+    }
+  }
+  return perfect;
+}
+
+/// Returns true if the perfectly nested loops `outer` and `inner` can be
+/// interchanged. As for the linalg iterators they come from, loops marked
+/// parallel are assumed to have no dependence along their induction variable
+/// in the whole nest, so a parallel loop can always be moved outward.
+bool canInterchange(mlir::scf::ForOp outer, mlir::scf::ForOp inner) {
+  return isParallel(inner) && outer.getNumResults() == 0 &&
+         inner.getNumResults() == 0 &&
+         mlir::areValuesDefinedAbove(inner->getOperands(), outer.getRegion());
+}
+
+/// Interchanges the perfectly nested loops `outer` and `inner` by swapping
+/// their bounds, steps, induction variables, attributes and locations
+void interchange(mlir::scf::ForOp outer, mlir::scf::ForOp inner) {
+  mlir::Value lb = outer.getLowerBound();
+  mlir::Value ub = outer.getUpperBound();
+  mlir::Value step = outer.getStep();
+  outer.setLowerBound(inner.getLowerBound());
+  outer.setUpperBound(inner.getUpperBound());
+  outer.setStep(inner.getStep());
+  inner.setLowerBound(lb);
+  inner.setUpperBound(ub);
+  inner.setStep(step);
+
+  mlir::Value outerIV = outer.getInductionVar();
+  mlir::Value innerIV = inner.getInductionVar();
+  llvm::SmallVector<mlir::OpOperand *> outerUses;
+  for (mlir::OpOperand &use : outerIV.getUses())
+    outerUses.push_back(&use);
+  innerIV.replaceAllUsesWith(outerIV);
+  for (mlir::OpOperand *use : outerUses)
+    use->set(innerIV);
+
+  mlir::DictionaryAttr attrs = outer->getAttrDictionary();
+  outer->setAttrs(inner->getAttrDictionary());
+  inner->setAttrs(attrs);
+  mlir::Location loc = outer.getLoc();
+  outer->setLoc(inner.getLoc());
+  inner->setLoc(loc);
+}
+
+std::optional<int64_t>
+getBandTripCount(llvm::ArrayRef<mlir::scf::ForOp> band) {
+  int64_t tripCount = 1;
+  for (mlir::scf::ForOp forOp : band) {
+    std::optional<int64_t> count =
+        mlir::concretelang::tryGetStaticTripCount(forOp);
+    if (!count.has_value())
+      return std::nullopt;
+    tripCount *= *count;
+  }
+  return tripCount;
+}
+
 struct CollapseParallelLoopsPass
     : public CollapseParallelLoopsBase<CollapseParallelLoopsPass> {
 
@@ -24,16 +131,47 @@ struct CollapseParallelLoopsPass
 
   void runOnOperation() override {
     mlir::ModuleOp module = getOperation();
+    // Ignore nested loops.
+    mlir::SmallVector<mlir::scf::ForOp> nests;
     module.walk([&](mlir::scf::ForOp forOp) {
-      // Ignore nested loops.
-      if (forOp->getParentOfType<mlir::scf::ForOp>())
-        return;
+      if (!forOp->getParentOfType<mlir::scf::ForOp>())
+        nests.push_back(forOp);
+    });
+
+    for (mlir::scf::ForOp forOp : nests) {
+      // Hoist the invariant code out of the nest, innermost loops first
+      forOp->walk([](mlir::scf::ForOp loop) {
+        (void)mlir::moveLoopInvariantCode(loop);
+      });
+
+      // Sink what remains between the loops into the nested loops leading to
+      // a parallel loop, to get a perfect nest
+      mlir::scf::ForOp loop = forOp;
+      while (mlir::scf::ForOp inner = getSinkTarget(loop)) {
+        bool leadsToParallel =
+            inner->walk([](mlir::scf::ForOp nested) {
+                   return isParallel(nested) ? mlir::WalkResult::interrupt()
+                                             : mlir::WalkResult::advance();
+                 })
+                .wasInterrupted();
+        if (!leadsToParallel || !sinkIntoNestedLoop(loop, inner))
+          break;
+        loop = inner;
+      }
 
-      // Determine which sequences of nested loops can be coalesced
-      // TODO: add loop interchange and hoisting to find more
-      // opportunities by getting multiple parallel loops in sequence
       mlir::SmallVector<mlir::scf::ForOp, 4> loops;
       getPerfectlyNestedLoops(loops, forOp);
+
+      // Move the parallel loops outward past the sequential ones, keeping
+      // the relative order of the parallel loops
+      for (unsigned i = 1, e = loops.size(); i < e; ++i) {
+        for (unsigned j = i; j > 0 && !isParallel(loops[j - 1]) &&
+                             canInterchange(loops[j - 1], loops[j]);
+             --j)
+          interchange(loops[j - 1], loops[j]);
+      }
+
+      // Determine which sequences of nested loops can be coalesced
       mlir::SmallVector<unsigned, 4> coalesceableLoopRanges(loops.size());
       for (unsigned i = 0, e = loops.size(); i < e; ++i) {
         // Any loop is coalesceable to itself
@@ -70,6 +208,16 @@ struct CollapseParallelLoopsPass
         }
       }
 
+      // The outermost parallel loop, the iterations of the band it ends up in
+      // being the ones distributed between the threads
+      auto outermostParallel = llvm::find_if(loops, isParallel);
+      if (outermostParallel == loops.end())
+        continue;
+      unsigned outermostPos = outermostParallel - loops.begin();
+      mlir::Location bandLoc = outermostParallel->getLoc();
+      std::optional<int64_t> bandSize =
+          mlir::concretelang::tryGetStaticTripCount(*outermostParallel);
+
       for (unsigned end = loops.size(); end > 0; --end) {
         unsigned start = 0;
         for (; start < end - 1; ++start) {
@@ -80,6 +228,8 @@ struct CollapseParallelLoopsPass
             continue;
 
           auto band = llvm::MutableArrayRef(loops.data() + start, end - start);
+          if (start <= outermostPos && outermostPos < end)
+            bandSize = getBandTripCount(band);
           (void)mlir::coalesceLoops(band);
           break;
         }
@@ -88,7 +238,28 @@ struct CollapseParallelLoopsPass
         if (start != end - 1)
           end = start + 1;
       }
-    });
+
+      recordParallelBand(forOp->getParentOfType<mlir::func::FuncOp>(),
+                         bandLoc, bandSize);
+    }
+  }
+
+  /// Records the size of the parallel band on the function for the
+  /// compilation feedback, -1 standing for a dynamic size
+  static void recordParallelBand(mlir::func::FuncOp funcOp,
+                                 mlir::Location loc,
+                                 std::optional<int64_t> size) {
+    if (!funcOp)
+      return;
+    mlir::Builder builder(funcOp.getContext());
+    llvm::SmallVector<mlir::Attribute> bands;
+    if (auto previous = funcOp->getAttrOfType<mlir::ArrayAttr>(
+            PARALLEL_BANDS_ATTR))
+      bands.append(previous.begin(), previous.end());
+    bands.push_back(builder.getArrayAttr(
+        {mlir::LocationAttr(loc),
+         builder.getI64IntegerAttr(size.value_or(-1))}));
+    funcOp->setAttr(PARALLEL_BANDS_ATTR, builder.getArrayAttr(bands));
   }
 };
 } // namespace
@@ -231,6 +231,44 @@ llvm::cl::opt<bool> dataflowParallelize(
     llvm::cl::desc("Generate the program as a dataflow graph"),
     llvm::cl::init(false));
 
+llvm::cl::opt<unsigned int> compileThreads(
+    "compile-threads",
+    llvm::cl::desc("Number of threads used to compile the circuits, 0 uses "
+                   "all hardware threads, default is 1 (sequential)"),
+    llvm::cl::init<unsigned int>(1));
+
+llvm::cl::opt<unsigned int> maxManyLUTCount(
+    "max-many-lut-count",
+    llvm::cl::desc("Maximal number of lookup tables applied to the same input "
+                   "evaluated by a single many-lut bootstrap, default is 1 "
+                   "(disabled)"),
+    llvm::cl::init<unsigned int>(1));
+
+llvm::cl::opt<bool> autoRounding(
+    "auto-rounding",
+    llvm::cl::desc("Clear the low bits of the inputs of the lookup tables "
+                   "that do not depend on them, default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<bool> asyncOffload(
+    "async-offload",
+    llvm::cl::desc("Run the keyswitches and bootstraps asynchronously on a "
+                   "pool of workers, default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<bool> packEncryptedMul(
+    "pack-encrypted-mul",
+    llvm::cl::desc("Lower the encrypted inner products with a single table "
+                   "lookup per product on packed operands when it is cheaper, "
+                   "with the dag-multi strategy only, default is true"),
+    llvm::cl::init<bool>(true));
+
+llvm::cl::opt<bool> alwaysPackEncryptedMul(
+    "always-pack-encrypted-mul",
+    llvm::cl::desc("Lower the encrypted inner products on packed operands "
+                   "without comparing the costs, default is false"),
+    llvm::cl::init<bool>(false));
+
 llvm::cl::opt<bool>
     chunkIntegers("chunk-integers",
                   llvm::cl::desc("Whether to decompose integer into chunks or "
@@ -249,6 +287,13 @@ llvm::cl::opt<unsigned int> chunkWidth(
         "Chunk width while decomposing big integers into chunks, default is 2"),
     llvm::cl::init<unsigned int>(2));
 
+llvm::cl::opt<bool> chunkCarryLookahead(
+    "chunk-carry-lookahead",
+    llvm::cl::desc("Propagate carries between chunks with a carry-lookahead "
+                   "adder of logarithmic depth instead of a ripple carry "
+                   "adder, default is false"),
+    llvm::cl::init<bool>(false));
+
 llvm::cl::opt<double> pbsErrorProbability(
     "pbs-error-probability",
     llvm::cl::desc("Change the default probability of error for all pbs"),
@@ -332,6 +377,26 @@ llvm::cl::opt<bool> optimizerNoCacheOnDisk(
                    "cache issues."),
     llvm::cl::init(false));
 
+llvm::cl::opt<std::string> optimizerCpuCalibration(
+    "optimizer-cpu-calibration",
+    llvm::cl::desc("Calibration file written by the cpu-calibration tool of "
+                   "the concrete-optimizer. The optimizer then minimizes the "
+                   "execution time measured on the calibrated host."),
+    llvm::cl::init(optimizer::DEFAULT_CONFIG.cpu_calibration_path));
+
+llvm::cl::opt<concrete_optimizer::Objective> optimizerObjective(
+    "optimizer-objective",
+    llvm::cl::desc("Select what the dag-multi optimizer strategy minimizes"),
+    llvm::cl::init(optimizer::DEFAULT_OBJECTIVE),
+    llvm::cl::values(clEnumValN(concrete_optimizer::Objective::Complexity,
+                                "complexity",
+                                "The complexity of the whole program, i.e. its "
+                                "throughput [default]")),
+    llvm::cl::values(clEnumValN(
+        concrete_optimizer::Objective::CriticalPath, "critical-path",
+        "The complexity of the longest chain of dependent bootstraps, i.e. "
+        "the latency when independent operations run in parallel")));
+
 llvm::cl::opt<bool> optimizerAllowComposition(
     "optimizer-allow-composition",
     llvm::cl::desc("Optimizer is parameterized to allow calling the circuit on "
@@ -420,18 +485,25 @@ cmdlineCompilationOptions() {
   options.autoParallelize = cmdline::autoParallelize;
   options.loopParallelize = cmdline::loopParallelize;
   options.dataflowParallelize = cmdline::dataflowParallelize;
+  options.compileThreads = cmdline::compileThreads;
   options.batchTFHEOps = cmdline::batchTFHEOps;
   options.maxBatchSize = cmdline::maxBatchSize;
   options.emitSDFGOps = cmdline::emitSDFGOps;
   options.unrollLoopsWithSDFGConvertibleOps =
       cmdline::unrollLoopsWithSDFGConvertibleOps;
   options.optimizeTFHE = cmdline::optimizeTFHE;
+  options.maxManyLUTCount = cmdline::maxManyLUTCount;
+  options.autoRounding = cmdline::autoRounding;
+  options.packEncryptedMul = cmdline::packEncryptedMul;
+  options.alwaysPackEncryptedMul = cmdline::alwaysPackEncryptedMul;
+  options.asyncOffload = cmdline::asyncOffload;
   options.simulate = cmdline::simulate;
   options.emitGPUOps = cmdline::emitGPUOps;
   options.compressEvaluationKeys = cmdline::compressEvaluationKeys;
   options.chunkIntegers = cmdline::chunkIntegers;
   options.chunkSize = cmdline::chunkSize;
   options.chunkWidth = cmdline::chunkWidth;
+  options.chunkCarryLookahead = cmdline::chunkCarryLookahead;
   options.skipProgramInfo = cmdline::skipProgramInfo;
 
   if (!cmdline::v0Constraint.empty()) {
@@ -509,6 +581,9 @@ cmdlineCompilationOptions() {
   options.optimizerConfig.encoding = cmdline::optimizerEncoding;
   options.optimizerConfig.cache_on_disk = !cmdline::optimizerNoCacheOnDisk;
   options.optimizerConfig.composable = cmdline::optimizerAllowComposition;
+  options.optimizerConfig.cpu_calibration_path =
+      cmdline::optimizerCpuCalibration;
+  options.optimizerConfig.objective = cmdline::optimizerObjective;
 
   if (!std::isnan(options.optimizerConfig.global_p_error) &&
       options.optimizerConfig.strategy == optimizer::Strategy::V0) {
@@ -2,11 +2,46 @@
 
 // -----
 
+// CHECK:      #[[$MAP:.*]] = affine_map<(d0, d1, d2, d3, d4) -> (d0, d1, d2, d3, d4)>
+
 // CHECK:      func.func @main(%[[a0:.*]]: tensor<1x1x8x10x!FHE.eint<5>>) -> tensor<1x1x6x9x!FHE.eint<5>> {
-// CHECK-NEXT:   %[[v0:.*]] = "FHE.zero_tensor"() : () -> tensor<1x1x6x9x!FHE.eint<5>>
-// CHECK-NEXT:   %[[v1:.*]] = tensor.empty() : tensor<3x2xi64>
-// CHECK-NEXT:   %[[v2:.*]] = linalg.pooling_nchw_max {dilations = dense<1> : vector<2xi64>, max_signed = {op = "FHE.max_eint", op_attrs = {}}, strides = dense<1> : vector<2xi64>} ins(%arg0, %1 : tensor<1x1x8x10x!FHE.eint<5>>, tensor<3x2xi64>) outs(%0 : tensor<1x1x6x9x!FHE.eint<5>>) -> tensor<1x1x6x9x!FHE.eint<5>>
-// CHECK-NEXT:   return %[[v2]] : tensor<1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.zero_tensor"() : () -> tensor<6x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[w0:.*]] = tensor.extract_slice %[[a0]][0, 0, 0, 0] [1, 1, 6, 9] [1, 1, 1, 1] : tensor<1x1x8x10x!FHE.eint<5>> to tensor<1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[e0:.*]] = tensor.insert_slice %[[w0]] into %[[v0]][0, 0, 0, 0, 0] [1, 1, 1, 6, 9] [1, 1, 1, 1, 1] : tensor<1x1x6x9x!FHE.eint<5>> into tensor<6x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[w1:.*]] = tensor.extract_slice %[[a0]][0, 0, 0, 1] [1, 1, 6, 9] [1, 1, 1, 1] : tensor<1x1x8x10x!FHE.eint<5>> to tensor<1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[e1:.*]] = tensor.insert_slice %[[w1]] into %[[e0]][1, 0, 0, 0, 0] [1, 1, 1, 6, 9] [1, 1, 1, 1, 1] : tensor<1x1x6x9x!FHE.eint<5>> into tensor<6x1x1x6x9x!FHE.eint<5>>
+// CHECK:        %[[w5:.*]] = tensor.extract_slice %[[a0]][0, 0, 2, 1] [1, 1, 6, 9] [1, 1, 1, 1] : tensor<1x1x8x10x!FHE.eint<5>> to tensor<1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[e5:.*]] = tensor.insert_slice %[[w5]] into %{{.*}}[5, 0, 0, 0, 0] [1, 1, 1, 6, 9] [1, 1, 1, 1, 1] : tensor<1x1x6x9x!FHE.eint<5>> into tensor<6x1x1x6x9x!FHE.eint<5>>
+
+// First level: 6 elements to 3
+// CHECK-NEXT:   %[[l0:.*]] = tensor.extract_slice %[[e5]][0, 0, 0, 0, 0] [3, 1, 1, 6, 9] [2, 1, 1, 1, 1] : tensor<6x1x1x6x9x!FHE.eint<5>> to tensor<3x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[r0:.*]] = tensor.extract_slice %[[e5]][1, 0, 0, 0, 0] [3, 1, 1, 6, 9] [2, 1, 1, 1, 1] : tensor<6x1x1x6x9x!FHE.eint<5>> to tensor<3x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[z0:.*]] = "FHE.zero_tensor"() : () -> tensor<3x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[m0:.*]] = linalg.generic {indexing_maps = [#[[$MAP]], #[[$MAP]], #[[$MAP]]], iterator_types = ["parallel", "parallel", "parallel", "parallel", "parallel"]} ins(%[[l0]], %[[r0]] : tensor<3x1x1x6x9x!FHE.eint<5>>, tensor<3x1x1x6x9x!FHE.eint<5>>) outs(%[[z0]] : tensor<3x1x1x6x9x!FHE.eint<5>>) {
+// CHECK-NEXT:   ^bb0(%[[aa0:.*]]: !FHE.eint<5>, %[[aa1:.*]]: !FHE.eint<5>, %[[aa2:.*]]: !FHE.eint<5>):
+// CHECK-NEXT:     %[[vv0:.*]] = "FHE.max_eint"(%[[aa0]], %[[aa1]]) : (!FHE.eint<5>, !FHE.eint<5>) -> !FHE.eint<5>
+// CHECK-NEXT:     linalg.yield %[[vv0]] : !FHE.eint<5>
+// CHECK-NEXT:   } -> tensor<3x1x1x6x9x!FHE.eint<5>>
+
+// Second level: 3 elements to 2, the last one being forwarded
+// CHECK-NEXT:   %[[l1:.*]] = tensor.extract_slice %[[m0]][0, 0, 0, 0, 0] [1, 1, 1, 6, 9] [2, 1, 1, 1, 1] : tensor<3x1x1x6x9x!FHE.eint<5>> to tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[r1:.*]] = tensor.extract_slice %[[m0]][1, 0, 0, 0, 0] [1, 1, 1, 6, 9] [2, 1, 1, 1, 1] : tensor<3x1x1x6x9x!FHE.eint<5>> to tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[z1:.*]] = "FHE.zero_tensor"() : () -> tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[m1:.*]] = linalg.generic {{.*}} ins(%[[l1]], %[[r1]] : tensor<1x1x1x6x9x!FHE.eint<5>>, tensor<1x1x1x6x9x!FHE.eint<5>>) outs(%[[z1]] : tensor<1x1x1x6x9x!FHE.eint<5>>) {
+// CHECK:        } -> tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[last:.*]] = tensor.extract_slice %[[m0]][2, 0, 0, 0, 0] [1, 1, 1, 6, 9] [1, 1, 1, 1, 1] : tensor<3x1x1x6x9x!FHE.eint<5>> to tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[z2:.*]] = "FHE.zero_tensor"() : () -> tensor<2x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[n0:.*]] = tensor.insert_slice %[[m1]] into %[[z2]][0, 0, 0, 0, 0] [1, 1, 1, 6, 9] [1, 1, 1, 1, 1] : tensor<1x1x1x6x9x!FHE.eint<5>> into tensor<2x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[n1:.*]] = tensor.insert_slice %[[last]] into %[[n0]][1, 0, 0, 0, 0] [1, 1, 1, 6, 9] [1, 1, 1, 1, 1] : tensor<1x1x1x6x9x!FHE.eint<5>> into tensor<2x1x1x6x9x!FHE.eint<5>>
+
+// Third level: 2 elements to 1
+// CHECK-NEXT:   %[[l2:.*]] = tensor.extract_slice %[[n1]][0, 0, 0, 0, 0] [1, 1, 1, 6, 9] [2, 1, 1, 1, 1] : tensor<2x1x1x6x9x!FHE.eint<5>> to tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[r2:.*]] = tensor.extract_slice %[[n1]][1, 0, 0, 0, 0] [1, 1, 1, 6, 9] [2, 1, 1, 1, 1] : tensor<2x1x1x6x9x!FHE.eint<5>> to tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[z3:.*]] = "FHE.zero_tensor"() : () -> tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[m2:.*]] = linalg.generic {{.*}} ins(%[[l2]], %[[r2]] : tensor<1x1x1x6x9x!FHE.eint<5>>, tensor<1x1x1x6x9x!FHE.eint<5>>) outs(%[[z3]] : tensor<1x1x1x6x9x!FHE.eint<5>>) {
+// CHECK:        } -> tensor<1x1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   %[[res:.*]] = tensor.extract_slice %[[m2]][0, 0, 0, 0, 0] [1, 1, 1, 6, 9] [1, 1, 1, 1, 1] : tensor<1x1x1x6x9x!FHE.eint<5>> to tensor<1x1x6x9x!FHE.eint<5>>
+// CHECK-NEXT:   return %[[res]] : tensor<1x1x6x9x!FHE.eint<5>>
 // CHECK-NEXT: }
 func.func @main(%arg0: tensor<1x1x8x10x!FHE.eint<5>>) -> tensor<1x1x6x9x!FHE.eint<5>> {
   %0 = "FHELinalg.maxpool2d"(%arg0) { kernel_shape = dense<[3, 2]> : tensor<2xi64> } : (tensor<1x1x8x10x!FHE.eint<5>>) -> tensor<1x1x6x9x!FHE.eint<5>>
@@ -15,24 +50,17 @@ func.func @main(%arg0: tensor<1x1x8x10x!FHE.eint<5>>) -> tensor<1x1x6x9x!FHE.ein
 
 // -----
 
-
-// CHECK: #[[$MAP0:.*]] = affine_map<(d0, d1, d2, d3) -> (d0, d1, d2, d3)>
-// CHECK: #[[$MAP1:.*]] = affine_map<(d0, d1, d2, d3) -> (0)>
-
-// CHECK:      func.func @main(%[[a0:.*]]: tensor<1x1x6x5x!FHE.esint<6>>) -> tensor<1x1x5x3x!FHE.esint<6>> {
-// CHECK-NEXT:   %[[v0:.*]] = "FHE.zero_tensor"() : () -> tensor<1x1x5x3x!FHE.esint<6>>
-// CHECK-NEXT:   %[[v1:.*]] = arith.constant dense<16> : tensor<1xi7>
-// CHECK-NEXT:   %[[v2:.*]] = "FHE.zero_tensor"() : () -> tensor<1x1x5x3x!FHE.esint<6>>
-// CHECK-NEXT:   %[[v3:.*]] = linalg.generic {indexing_maps = [#[[$MAP0]], #[[$MAP1]], #[[$MAP0]]], iterator_types = ["parallel", "parallel", "parallel", "parallel"]} ins(%[[v0]], %[[v1]] : tensor<1x1x5x3x!FHE.esint<6>>, tensor<1xi7>) outs(%[[v2]] : tensor<1x1x5x3x!FHE.esint<6>>) {
-// CHECK-NEXT:   ^bb0(%[[aa0:.*]]: !FHE.esint<6>, %[[aa1:.*]]: i7, %[[aa2:.*]]: !FHE.esint<6>):
-// CHECK-NEXT:     %[[vv0:.*]] = "FHE.sub_eint_int"(%[[aa0]], %[[aa1]]) : (!FHE.esint<6>, i7) -> !FHE.esint<6>
-// CHECK-NEXT:     linalg.yield %[[vv0]] : !FHE.esint<6>
-// CHECK-NEXT:   } -> tensor<1x1x5x3x!FHE.esint<6>>
-// CHECK-NEXT:   %[[v4:.*]] = tensor.empty() : tensor<2x3xi64>
-// CHECK-NEXT:   %[[v5:.*]] = linalg.pooling_nchw_max {dilations = dense<1> : vector<2xi64>, max_signed = {op = "FHE.max_eint", op_attrs = {}}, strides = dense<1> : vector<2xi64>} ins(%arg0, %[[v4]] : tensor<1x1x6x5x!FHE.esint<6>>, tensor<2x3xi64>) outs(%[[v3]] : tensor<1x1x5x3x!FHE.esint<6>>) -> tensor<1x1x5x3x!FHE.esint<6>>
-// CHECK-NEXT:   return %[[v5]] : tensor<1x1x5x3x!FHE.esint<6>>
-// CHECK-NEXT: }
-func.func @main(%arg0: tensor<1x1x6x5x!FHE.esint<6>>) -> tensor<1x1x5x3x!FHE.esint<6>> {
-  %0 = "FHELinalg.maxpool2d"(%arg0) { kernel_shape = dense<[2, 3]> : tensor<2xi64> } : (tensor<1x1x6x5x!FHE.esint<6>>) -> tensor<1x1x5x3x!FHE.esint<6>>
-  return %0 : tensor<1x1x5x3x!FHE.esint<6>>
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<1x1x5x5x!FHE.esint<6>>) -> tensor<1x1x2x2x!FHE.esint<6>> {
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.zero_tensor"() : () -> tensor<4x1x1x2x2x!FHE.esint<6>>
+// CHECK-NEXT:   %[[w0:.*]] = tensor.extract_slice %[[a0]][0, 0, 0, 0] [1, 1, 2, 2] [1, 1, 2, 2] : tensor<1x1x5x5x!FHE.esint<6>> to tensor<1x1x2x2x!FHE.esint<6>>
+// CHECK:        %[[w1:.*]] = tensor.extract_slice %[[a0]][0, 0, 0, 2] [1, 1, 2, 2] [1, 1, 2, 2] : tensor<1x1x5x5x!FHE.esint<6>> to tensor<1x1x2x2x!FHE.esint<6>>
+// CHECK:        %[[w2:.*]] = tensor.extract_slice %[[a0]][0, 0, 2, 0] [1, 1, 2, 2] [1, 1, 2, 2] : tensor<1x1x5x5x!FHE.esint<6>> to tensor<1x1x2x2x!FHE.esint<6>>
+// CHECK:        %[[w3:.*]] = tensor.extract_slice %[[a0]][0, 0, 2, 2] [1, 1, 2, 2] [1, 1, 2, 2] : tensor<1x1x5x5x!FHE.esint<6>> to tensor<1x1x2x2x!FHE.esint<6>>
+// CHECK-NOT:    "FHE.sub_eint_int"
+// CHECK-COUNT-2: "FHE.max_eint"({{.*}}) : (!FHE.esint<6>, !FHE.esint<6>) -> !FHE.esint<6>
+// CHECK-NOT:    "FHE.max_eint"
+// CHECK:        return
+func.func @main(%arg0: tensor<1x1x5x5x!FHE.esint<6>>) -> tensor<1x1x2x2x!FHE.esint<6>> {
+  %0 = "FHELinalg.maxpool2d"(%arg0) { kernel_shape = dense<[2, 2]> : tensor<2xi64>, dilations = dense<[2, 2]> : tensor<2xi64>, strides = dense<[2, 2]> : tensor<2xi64> } : (tensor<1x1x5x5x!FHE.esint<6>>) -> tensor<1x1x2x2x!FHE.esint<6>>
+  return %0 : tensor<1x1x2x2x!FHE.esint<6>>
 }
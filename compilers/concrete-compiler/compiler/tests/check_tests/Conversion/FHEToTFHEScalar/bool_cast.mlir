@@ -0,0 +1,53 @@
+// RUN: concretecompiler %s --optimize-tfhe=false --optimizer-strategy=dag-mono --action=dump-tfhe 2>&1| FileCheck %s
+
+// CHECK-LABEL: func.func @to_bool_2(%arg0: !TFHE.glwe<sk?>) -> !TFHE.glwe<sk?>
+func.func @to_bool_2(%arg0: !FHE.eint<2>) -> !FHE.ebool {
+  // CHECK-NEXT: return %arg0 : !TFHE.glwe<sk?>
+
+  %1 = "FHE.to_bool"(%arg0): (!FHE.eint<2>) -> (!FHE.ebool)
+  return %1: !FHE.ebool
+}
+
+// CHECK-LABEL: func.func @to_bool_4(%arg0: !TFHE.glwe<sk?>) -> !TFHE.glwe<sk?>
+func.func @to_bool_4(%arg0: !FHE.eint<4>) -> !FHE.ebool {
+  // CHECK-NEXT: %[[C4:.*]] = arith.constant 4 : i64
+  // CHECK-NEXT: %[[V0:.*]] = "TFHE.mul_glwe_int"(%arg0, %[[C4]]) : (!TFHE.glwe<sk?>, i64) -> !TFHE.glwe<sk?>
+  // CHECK-NEXT: return %[[V0]] : !TFHE.glwe<sk?>
+
+  %1 = "FHE.to_bool"(%arg0): (!FHE.eint<4>) -> (!FHE.ebool)
+  return %1: !FHE.ebool
+}
+
+// CHECK-LABEL: func.func @to_bool_1(%arg0: !TFHE.glwe<sk?>) -> !TFHE.glwe<sk?>
+func.func @to_bool_1(%arg0: !FHE.eint<1>) -> !FHE.ebool {
+  // CHECK-NEXT: %[[LUT:.*]] = arith.constant dense<[0, 1]> : tensor<2xi64>
+  // CHECK-NEXT: %[[V0:.*]] = "TFHE.encode_expand_lut_for_bootstrap"(%[[LUT]]) {isSigned = false, outputBits = 2 : i32, polySize = 256 : i32} : (tensor<2xi64>) -> tensor<256xi64>
+  // CHECK-NEXT: %[[V1:.*]] = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk?, sk?, -1, -1>} : (!TFHE.glwe<sk?>) -> !TFHE.glwe<sk?>
+  // CHECK-NEXT: %[[V2:.*]] = "TFHE.bootstrap_glwe"(%[[V1]], %[[V0]]) {key = #TFHE.bsk<sk?, sk?, -1, -1, -1, -1>} : (!TFHE.glwe<sk?>, tensor<256xi64>) -> !TFHE.glwe<sk?>
+  // CHECK-NEXT: return %[[V2]] : !TFHE.glwe<sk?>
+
+  %1 = "FHE.to_bool"(%arg0): (!FHE.eint<1>) -> (!FHE.ebool)
+  return %1: !FHE.ebool
+}
+
+// CHECK-LABEL: func.func @from_bool_1(%arg0: !TFHE.glwe<sk?>) -> !TFHE.glwe<sk?>
+func.func @from_bool_1(%arg0: !FHE.ebool) -> !FHE.eint<1> {
+  // CHECK-NEXT: %[[C2:.*]] = arith.constant 2 : i64
+  // CHECK-NEXT: %[[V0:.*]] = "TFHE.mul_glwe_int"(%arg0, %[[C2]]) : (!TFHE.glwe<sk?>, i64) -> !TFHE.glwe<sk?>
+  // CHECK-NEXT: return %[[V0]] : !TFHE.glwe<sk?>
+
+  %1 = "FHE.from_bool"(%arg0): (!FHE.ebool) -> (!FHE.eint<1>)
+  return %1: !FHE.eint<1>
+}
+
+// CHECK-LABEL: func.func @from_bool_3(%arg0: !TFHE.glwe<sk?>) -> !TFHE.glwe<sk?>
+func.func @from_bool_3(%arg0: !FHE.ebool) -> !FHE.eint<3> {
+  // CHECK-NEXT: %[[LUT:.*]] = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  // CHECK-NEXT: %[[V0:.*]] = "TFHE.encode_expand_lut_for_bootstrap"(%[[LUT]]) {isSigned = false, outputBits = 3 : i32, polySize = 256 : i32} : (tensor<4xi64>) -> tensor<256xi64>
+  // CHECK-NEXT: %[[V1:.*]] = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk?, sk?, -1, -1>} : (!TFHE.glwe<sk?>) -> !TFHE.glwe<sk?>
+  // CHECK-NEXT: %[[V2:.*]] = "TFHE.bootstrap_glwe"(%[[V1]], %[[V0]]) {key = #TFHE.bsk<sk?, sk?, -1, -1, -1, -1>} : (!TFHE.glwe<sk?>, tensor<256xi64>) -> !TFHE.glwe<sk?>
+  // CHECK-NEXT: return %[[V2]] : !TFHE.glwe<sk?>
+
+  %1 = "FHE.from_bool"(%arg0): (!FHE.ebool) -> (!FHE.eint<3>)
+  return %1: !FHE.eint<3>
+}
@@ -0,0 +1,82 @@
+// RUN: concretecompiler --passes async-offload --async-offload --action=dump-llvm-dialect --skip-program-info %s 2>&1| FileCheck %s
+
+func.func private @memref_keyswitch_lwe_u64(memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, i32, i32, i32, i32, i32, !Concrete.context)
+func.func private @memref_bootstrap_lwe_u64(memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, i32, i32, i32, i32, i32, i32, !Concrete.context)
+func.func private @memref_add_lwe_ciphertexts_u64(memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>)
+
+// The second bootstrap is issued before the first one is awaited, both being
+// awaited by the addition only. The keyswitched ciphertext read by the first
+// bootstrap is freed once it is awaited.
+
+// CHECK:      func.func @main(%[[A0:.*]]: memref<1025xi64>, %[[A1:.*]]: memref<1025xi64>, %[[A2:.*]]: memref<1024xi64>, %[[A3:.*]]: !Concrete.context) -> memref<1025xi64> {
+// CHECK:        %[[KS:.*]] = call @memref_keyswitch_async_lwe_u64(%[[KSOUT:[^,]+]], %{{.*}}, %[[A3]])
+// CHECK-NEXT:   call @memref_await_future(%[[KSOUT]], %[[KS]], %[[KSOUT]])
+// CHECK:        %[[BS0:.*]] = call @memref_bootstrap_async_lwe_u64(%[[BS0OUT:[^,]+]], %[[KSOUT]], %{{.*}}, %[[A3]])
+// CHECK:        %[[BS1:.*]] = call @memref_bootstrap_async_lwe_u64(%[[BS1OUT:[^,]+]], %{{.*}}, %[[A3]])
+// CHECK:        call @memref_await_future(%[[BS0OUT]], %[[BS0]], %[[BS0OUT]])
+// CHECK-NEXT:   memref.dealloc
+// CHECK-NEXT:   call @memref_await_future(%[[BS1OUT]], %[[BS1]], %[[BS1OUT]])
+// CHECK-NEXT:   call @memref_add_lwe_ciphertexts_u64
+func.func @main(%arg0: memref<1025xi64>, %arg1: memref<1025xi64>, %arg2: memref<1024xi64>, %arg3: !Concrete.context) -> memref<1025xi64> {
+  %c1_i32 = arith.constant 1 : i32
+  %c2_i32 = arith.constant 2 : i32
+  %c3_i32 = arith.constant 3 : i32
+  %c600_i32 = arith.constant 600 : i32
+  %c1024_i32 = arith.constant 1024 : i32
+  %c-1_i32 = arith.constant -1 : i32
+  %lut = memref.cast %arg2 : memref<1024xi64> to memref<?xi64, strided<[?], offset: ?>>
+
+  %ks = memref.alloc() : memref<601xi64>
+  %ks_out = memref.cast %ks : memref<601xi64> to memref<?xi64, strided<[?], offset: ?>>
+  %in0 = memref.cast %arg0 : memref<1025xi64> to memref<?xi64, strided<[?], offset: ?>>
+  call @memref_keyswitch_lwe_u64(%ks_out, %in0, %c2_i32, %c3_i32, %c1024_i32, %c600_i32, %c-1_i32, %arg3) : (memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, i32, i32, i32, i32, i32, !Concrete.context) -> ()
+
+  %bs0 = memref.alloc() : memref<1025xi64>
+  %bs0_out = memref.cast %bs0 : memref<1025xi64> to memref<?xi64, strided<[?], offset: ?>>
+  call @memref_bootstrap_lwe_u64(%bs0_out, %ks_out, %lut, %c600_i32, %c1024_i32, %c3_i32, %c1_i32, %c1_i32, %c-1_i32, %arg3) : (memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, i32, i32, i32, i32, i32, i32, !Concrete.context) -> ()
+  memref.dealloc %ks : memref<601xi64>
+
+  %bs1 = memref.alloc() : memref<1025xi64>
+  %bs1_out = memref.cast %bs1 : memref<1025xi64> to memref<?xi64, strided<[?], offset: ?>>
+  %in1 = memref.cast %arg1 : memref<1025xi64> to memref<?xi64, strided<[?], offset: ?>>
+  call @memref_bootstrap_lwe_u64(%bs1_out, %in1, %lut, %c600_i32, %c1024_i32, %c3_i32, %c1_i32, %c1_i32, %c-1_i32, %arg3) : (memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, i32, i32, i32, i32, i32, i32, !Concrete.context) -> ()
+
+  %res = memref.alloc() : memref<1025xi64>
+  %res_out = memref.cast %res : memref<1025xi64> to memref<?xi64, strided<[?], offset: ?>>
+  call @memref_add_lwe_ciphertexts_u64(%res_out, %bs0_out, %bs1_out) : (memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>) -> ()
+  memref.dealloc %bs0 : memref<1025xi64>
+  memref.dealloc %bs1 : memref<1025xi64>
+  return %res : memref<1025xi64>
+}
+
+// The loop-carried buffer may be the local buffer written by the bootstrap,
+// which is thus awaited before the buffer is read.
+
+// CHECK:      func.func @loop_carried(%[[A0:.*]]: memref<1025xi64>, %[[A1:.*]]: memref<1024xi64>, %[[A2:.*]]: !Concrete.context) -> i64 {
+// CHECK:        %[[BS:.*]] = {{(func\.)?}}call @memref_bootstrap_async_lwe_u64(%[[BSOUT:[^,]+]], %{{.*}}, %[[A2]])
+// CHECK-NEXT:   {{(func\.)?}}call @memref_await_future(%[[BSOUT]], %[[BS]], %[[BSOUT]])
+// CHECK-NEXT:   memref.load
+func.func @loop_carried(%arg0: memref<1025xi64>, %arg1: memref<1024xi64>, %arg2: !Concrete.context) -> i64 {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c0_i64 = arith.constant 0 : i64
+  %c1_i32 = arith.constant 1 : i32
+  %c3_i32 = arith.constant 3 : i32
+  %c600_i32 = arith.constant 600 : i32
+  %c1024_i32 = arith.constant 1024 : i32
+  %c-1_i32 = arith.constant -1 : i32
+  %lut = memref.cast %arg1 : memref<1024xi64> to memref<?xi64, strided<[?], offset: ?>>
+  %in = memref.cast %arg0 : memref<1025xi64> to memref<?xi64, strided<[?], offset: ?>>
+
+  %buf = memref.alloc() : memref<1025xi64>
+  %res:2 = scf.for %i = %c0 to %c4 step %c1 iter_args(%acc = %buf, %sum = %c0_i64) -> (memref<1025xi64>, i64) {
+    %out = memref.cast %buf : memref<1025xi64> to memref<?xi64, strided<[?], offset: ?>>
+    func.call @memref_bootstrap_lwe_u64(%out, %in, %lut, %c600_i32, %c1024_i32, %c3_i32, %c1_i32, %c1_i32, %c-1_i32, %arg2) : (memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, memref<?xi64, strided<[?], offset: ?>>, i32, i32, i32, i32, i32, i32, !Concrete.context) -> ()
+    %v = memref.load %acc[%c0] : memref<1025xi64>
+    %s = arith.addi %sum, %v : i64
+    scf.yield %acc, %s : memref<1025xi64>, i64
+  }
+  memref.dealloc %buf : memref<1025xi64>
+  return %res#1 : i64
+}
@@ -0,0 +1,34 @@
+// RUN: concretecompiler --passes tfhe-to-concrete --passes concrete-keyswitch-bootstrap-fusion --action=dump-concrete --skip-program-info %s 2>&1| FileCheck %s
+
+// CHECK: func.func @fuse(%[[A0:.*]]: tensor<1025xi64>, %[[A1:.*]]: tensor<1024xi64>) -> tensor<1025xi64> {
+// CHECK-NEXT:   %[[V0:.*]] = "Concrete.keyswitch_bootstrap_lwe_tensor"(%[[A0]], %[[A1]]) {bootstrapBaseLog = 1 : i32, bootstrapLevel = 3 : i32, bskIndex = -1 : i32, glweDimension = 1 : i32, inputLweDim = 600 : i32, keyswitchBaseLog = 3 : i32, keyswitchInputLweDim = 1024 : i32, keyswitchLevel = 2 : i32, kskIndex = -1 : i32, polySize = 1024 : i32} : (tensor<1025xi64>, tensor<1024xi64>) -> tensor<1025xi64>
+// CHECK-NEXT:   return %[[V0]] : tensor<1025xi64>
+// CHECK-NEXT: }
+func.func @fuse(%arg0: !TFHE.glwe<sk[1]<1,1024>>, %lut: tensor<1024xi64>) -> !TFHE.glwe<sk[1]<1,1024>> {
+  %0 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk[1]<1,1024>, sk[2]<1,600>, 2, 3>} : (!TFHE.glwe<sk[1]<1,1024>>) -> !TFHE.glwe<sk[2]<1,600>>
+  %1 = "TFHE.bootstrap_glwe"(%0, %lut) {key = #TFHE.bsk<sk[2]<1,600>, sk[1]<1,1024>, 1024, 1, 3, 1>} : (!TFHE.glwe<sk[2]<1,600>>, tensor<1024xi64>) -> !TFHE.glwe<sk[1]<1,1024>>
+  return %1 : !TFHE.glwe<sk[1]<1,1024>>
+}
+
+// The keyswitched ciphertext is used twice, it needs to be materialized
+
+// CHECK: func.func @shared_keyswitch(%[[A0:.*]]: tensor<1025xi64>, %[[A1:.*]]: tensor<1024xi64>) -> (tensor<1025xi64>, tensor<601xi64>) {
+// CHECK-NEXT:   %[[V0:.*]] = "Concrete.keyswitch_lwe_tensor"(%[[A0]])
+// CHECK-NEXT:   %[[V1:.*]] = "Concrete.bootstrap_lwe_tensor"(%[[V0]], %[[A1]])
+// CHECK-NEXT:   return %[[V1]], %[[V0]] : tensor<1025xi64>, tensor<601xi64>
+// CHECK-NEXT: }
+func.func @shared_keyswitch(%arg0: !TFHE.glwe<sk[1]<1,1024>>, %lut: tensor<1024xi64>) -> (!TFHE.glwe<sk[1]<1,1024>>, !TFHE.glwe<sk[2]<1,600>>) {
+  %0 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk[1]<1,1024>, sk[2]<1,600>, 2, 3>} : (!TFHE.glwe<sk[1]<1,1024>>) -> !TFHE.glwe<sk[2]<1,600>>
+  %1 = "TFHE.bootstrap_glwe"(%0, %lut) {key = #TFHE.bsk<sk[2]<1,600>, sk[1]<1,1024>, 1024, 1, 3, 1>} : (!TFHE.glwe<sk[2]<1,600>>, tensor<1024xi64>) -> !TFHE.glwe<sk[1]<1,1024>>
+  return %1, %0 : !TFHE.glwe<sk[1]<1,1024>>, !TFHE.glwe<sk[2]<1,600>>
+}
+
+// CHECK: func.func @fuse_batched(%[[A0:.*]]: tensor<4x1025xi64>, %[[A1:.*]]: tensor<1024xi64>) -> tensor<4x1025xi64> {
+// CHECK-NEXT:   %[[V0:.*]] = "Concrete.batched_keyswitch_bootstrap_lwe_tensor"(%[[A0]], %[[A1]]) {bootstrapBaseLog = 1 : i32, bootstrapLevel = 3 : i32, bskIndex = -1 : i32, glweDimension = 1 : i32, inputLweDim = 600 : i32, keyswitchBaseLog = 3 : i32, keyswitchInputLweDim = 1024 : i32, keyswitchLevel = 2 : i32, kskIndex = -1 : i32, polySize = 1024 : i32} : (tensor<4x1025xi64>, tensor<1024xi64>) -> tensor<4x1025xi64>
+// CHECK-NEXT:   return %[[V0]] : tensor<4x1025xi64>
+// CHECK-NEXT: }
+func.func @fuse_batched(%arg0: tensor<4x!TFHE.glwe<sk[1]<1,1024>>>, %lut: tensor<1024xi64>) -> tensor<4x!TFHE.glwe<sk[1]<1,1024>>> {
+  %0 = "TFHE.batched_keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk[1]<1,1024>, sk[2]<1,600>, 2, 3>} : (tensor<4x!TFHE.glwe<sk[1]<1,1024>>>) -> tensor<4x!TFHE.glwe<sk[2]<1,600>>>
+  %1 = "TFHE.batched_bootstrap_glwe"(%0, %lut) {key = #TFHE.bsk<sk[2]<1,600>, sk[1]<1,1024>, 1024, 1, 3, 1>} : (tensor<4x!TFHE.glwe<sk[2]<1,600>>>, tensor<1024xi64>) -> tensor<4x!TFHE.glwe<sk[1]<1,1024>>>
+  return %1 : tensor<4x!TFHE.glwe<sk[1]<1,1024>>>
+}
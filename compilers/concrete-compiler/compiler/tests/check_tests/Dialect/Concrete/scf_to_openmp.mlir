@@ -0,0 +1,78 @@
+// RUN: concretecompiler --split-input-file --passes concrete-scf-to-openmp --parallelize-loops --action=dump-std --skip-program-info %s 2>&1| FileCheck %s
+
+// The consecutive loops are lowered in a single parallel region, the
+// constant between them being hoisted, with static schedules as the
+// iterations cost the same
+
+// CHECK-LABEL: func.func @consecutive
+// CHECK:      %[[C8:.*]] = arith.constant 8 : index
+// CHECK-NEXT: omp.parallel {
+// CHECK-NEXT:   omp.wsloop schedule(static) for
+// CHECK:          "Concrete.bootstrap_lwe_buffer"
+// CHECK:        omp.wsloop schedule(static) for
+// CHECK:          "Concrete.keyswitch_lwe_buffer"
+// CHECK:        omp.terminator
+// CHECK-NEXT: }
+// CHECK-NOT:  omp.parallel
+func.func @consecutive(%arg0: memref<2049xi64>, %arg1: memref<16xi64>, %arg2: memref<2049xi64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  scf.parallel (%i) = (%c0) to (%c4) step (%c1) {
+    "Concrete.bootstrap_lwe_buffer"(%arg2, %arg0, %arg1) {baseLog = 2 : i32, bskIndex = 0 : i32, glweDimension = 4 : i32, inputLweDim = 600 : i32, level = 3 : i32, outPrecision = 4 : i32, polySize = 2048 : i32} : (memref<2049xi64>, memref<2049xi64>, memref<16xi64>) -> ()
+    scf.yield
+  }
+  %c8 = arith.constant 8 : index
+  scf.parallel (%i) = (%c0) to (%c8) step (%c1) {
+    "Concrete.keyswitch_lwe_buffer"(%arg2, %arg0) {baseLog = 2 : i32, kskIndex = 0 : i32, level = 3 : i32, lwe_dim_in = 2048 : i32, lwe_dim_out = 2048 : i32} : (memref<2049xi64>, memref<2049xi64>) -> ()
+    scf.yield
+  }
+  return
+}
+
+// -----
+
+// The conditional bootstraps are dispatched dynamically, one iteration at
+// a time
+
+// CHECK-LABEL: func.func @conditional
+// CHECK:      omp.parallel {
+// CHECK-NEXT:   %[[CHUNK:.*]] = arith.constant 1 : i32
+// CHECK-NEXT:   omp.wsloop schedule(dynamic = %[[CHUNK]] : i32) for
+func.func @conditional(%arg0: memref<2049xi64>, %arg1: memref<16xi64>, %arg2: memref<2049xi64>, %arg3: memref<8xi1>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c8 = arith.constant 8 : index
+  scf.parallel (%i) = (%c0) to (%c8) step (%c1) {
+    %cond = memref.load %arg3[%i] : memref<8xi1>
+    scf.if %cond {
+      "Concrete.bootstrap_lwe_buffer"(%arg2, %arg0, %arg1) {baseLog = 2 : i32, bskIndex = 0 : i32, glweDimension = 4 : i32, inputLweDim = 600 : i32, level = 3 : i32, outPrecision = 4 : i32, polySize = 2048 : i32} : (memref<2049xi64>, memref<2049xi64>, memref<16xi64>) -> ()
+    }
+    scf.yield
+  }
+  return
+}
+
+// -----
+
+// The nested parallel loop is serialized
+
+// CHECK-LABEL: func.func @nested
+// CHECK:      omp.parallel {
+// CHECK-NEXT:   omp.wsloop schedule(static) for
+// CHECK:          scf.for
+// CHECK:            "Concrete.keyswitch_lwe_buffer"
+// CHECK-NOT:  omp.parallel
+func.func @nested(%arg0: memref<2049xi64>, %arg1: memref<2049xi64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  scf.parallel (%i) = (%c0) to (%c4) step (%c1) {
+    scf.parallel (%j) = (%c0) to (%c4) step (%c1) {
+      "Concrete.keyswitch_lwe_buffer"(%arg1, %arg0) {baseLog = 2 : i32, kskIndex = 0 : i32, level = 3 : i32, lwe_dim_in = 2048 : i32, lwe_dim_out = 2048 : i32} : (memref<2049xi64>, memref<2049xi64>) -> ()
+      scf.yield
+    }
+    scf.yield
+  }
+  return
+}
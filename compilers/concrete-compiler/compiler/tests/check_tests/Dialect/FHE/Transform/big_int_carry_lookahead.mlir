@@ -0,0 +1,25 @@
+// RUN: concretecompiler --chunk-integers --chunk-size 4 --chunk-width 2 --chunk-carry-lookahead --passes fhe-big-int-transform --action=dump-fhe  %s 2>&1| FileCheck %s
+
+// CHECK-LABEL: func.func @add_chunked_eint(%arg0: tensor<4x!FHE.eint<4>>, %arg1: tensor<4x!FHE.eint<4>>) -> tensor<4x!FHE.eint<4>>
+func.func @add_chunked_eint(%arg0: !FHE.eint<8>, %arg1: !FHE.eint<8>) -> !FHE.eint<8> {
+  // CHECK-NOT: affine.for
+  // Status of each chunk
+  // CHECK:      %[[S0:.*]] = "FHE.add_eint"
+  // CHECK-NEXT: %[[STATUS:.*]] = arith.constant dense<[0, 0, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2]> : tensor<16xi64>
+  // CHECK-NEXT: "FHE.apply_lookup_table"(%[[S0]], %[[STATUS]])
+  // CHECK-COUNT-3: "FHE.apply_lookup_table"
+  // Prefix tree of depth 2 over 4 chunks
+  // CHECK:      "FHE.mul_eint_int"
+  // CHECK-NEXT: "FHE.add_eint"
+  // CHECK-NEXT: %[[COMBINE:.*]] = arith.constant dense<[0, 0, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2]> : tensor<16xi64>
+  // CHECK-NEXT: "FHE.apply_lookup_table"
+  // CHECK-COUNT-4: "FHE.apply_lookup_table"
+  // Carry out of each chunk
+  // CHECK:      %[[CARRY:.*]] = arith.constant dense<[0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0]> : tensor<16xi64>
+  // CHECK-NEXT: "FHE.apply_lookup_table"
+  // CHECK-COUNT-3: "FHE.apply_lookup_table"
+  // CHECK-NOT: "FHE.apply_lookup_table"
+  // CHECK: return
+  %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<8>, !FHE.eint<8>) -> (!FHE.eint<8>)
+  return %1: !FHE.eint<8>
+}
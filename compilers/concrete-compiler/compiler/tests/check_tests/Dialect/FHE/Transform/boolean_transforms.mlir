@@ -105,3 +105,50 @@ func.func @mux(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: !FHE.ebool) -> !FHE.
   %1 = "FHE.mux"(%arg0, %arg1, %arg2) : (!FHE.ebool, !FHE.ebool, !FHE.ebool) -> !FHE.ebool
   return %1: !FHE.ebool
 }
+
+// CHECK-LABEL: func.func @pack_two_leaves(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool
+func.func @pack_two_leaves(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool {
+  // CHECK-DAG:  %[[TT:.*]] = arith.constant dense<[0, 0, 1, 0]> : tensor<4xi64>
+  // CHECK-DAG:  %[[C0:.*]] = arith.constant 2 : i3
+  // CHECK:      %[[V0:.*]] = "FHE.from_bool"(%arg0) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V1:.*]] = "FHE.from_bool"(%arg1) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V2:.*]] = "FHE.mul_eint_int"(%[[V0]], %[[C0]]) : (!FHE.eint<2>, i3) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V3:.*]] = "FHE.add_eint"(%[[V2]], %[[V1]]) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V4:.*]] = "FHE.apply_lookup_table"(%[[V3]], %[[TT]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V5:.*]] = "FHE.to_bool"(%[[V4]]) : (!FHE.eint<2>) -> !FHE.ebool
+  // CHECK-NEXT: return %[[V5]] : !FHE.ebool
+
+  %1 = "FHE.and"(%arg0, %arg1) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  %2 = "FHE.xor"(%1, %arg0) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  return %2: !FHE.ebool
+}
+
+// CHECK-LABEL: func.func @pack_three_leaves(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: !FHE.ebool) -> !FHE.ebool
+func.func @pack_three_leaves(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: !FHE.ebool) -> !FHE.ebool {
+  // CHECK-DAG:  %[[TT:.*]] = arith.constant dense<[0, 0, 0, 1]> : tensor<4xi64>
+  // CHECK:      %[[V0:.*]] = "FHE.from_bool"(%arg0) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V1:.*]] = "FHE.from_bool"(%arg1) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V2:.*]] = "FHE.add_eint"(%[[V0]], %[[V1]]) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V3:.*]] = "FHE.from_bool"(%arg2) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V4:.*]] = "FHE.add_eint"(%[[V2]], %[[V3]]) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V5:.*]] = "FHE.apply_lookup_table"(%[[V4]], %[[TT]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V6:.*]] = "FHE.to_bool"(%[[V5]]) : (!FHE.eint<2>) -> !FHE.ebool
+  // CHECK-NEXT: return %[[V6]] : !FHE.ebool
+
+  %1 = "FHE.and"(%arg0, %arg1) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  %2 = "FHE.and"(%1, %arg2) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  return %2: !FHE.ebool
+}
+
+// The function of the three leaves depends on which leaves are set, the
+// gates are kept
+
+// CHECK-LABEL: func.func @no_pack_three_leaves(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: !FHE.ebool) -> !FHE.ebool
+func.func @no_pack_three_leaves(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: !FHE.ebool) -> !FHE.ebool {
+  // CHECK-COUNT-2: "FHE.apply_lookup_table"
+  // CHECK-NOT: "FHE.apply_lookup_table"
+
+  %1 = "FHE.xor"(%arg0, %arg1) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  %2 = "FHE.and"(%1, %arg2) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  return %2: !FHE.ebool
+}
@@ -0,0 +1,68 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe --passes fhe-auto-rounding --auto-rounding %s 2>&1 | FileCheck %s
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<4>) -> !FHE.eint<2> attributes {FHE.auto_rounding = {{.*}}} {
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.lsb"(%[[a0]]) : (!FHE.eint<4>) -> !FHE.eint<4>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.sub_eint"(%[[a0]], %[[v0]]) : (!FHE.eint<4>, !FHE.eint<4>) -> !FHE.eint<4>
+// CHECK-NEXT:   %[[v2:.*]] = "FHE.reinterpret_precision"(%[[v1]]) : (!FHE.eint<4>) -> !FHE.eint<3>
+// CHECK-NEXT:   %[[v3:.*]] = "FHE.lsb"(%[[v2]]) : (!FHE.eint<3>) -> !FHE.eint<3>
+// CHECK-NEXT:   %[[v4:.*]] = "FHE.sub_eint"(%[[v2]], %[[v3]]) : (!FHE.eint<3>, !FHE.eint<3>) -> !FHE.eint<3>
+// CHECK-NEXT:   %[[v5:.*]] = "FHE.reinterpret_precision"(%[[v4]]) : (!FHE.eint<3>) -> !FHE.eint<2>
+// CHECK-NEXT:   %[[v6:.*]] = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v7:.*]] = "FHE.apply_lookup_table"(%[[v5]], %[[v6]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   return %[[v7]] : !FHE.eint<2>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<4>) -> !FHE.eint<2> {
+  %lut = arith.constant dense<[0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3]> : tensor<16xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<2>
+  return %0 : !FHE.eint<2>
+}
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<3x!FHE.eint<4>>) -> tensor<3x!FHE.eint<3>> attributes {FHE.auto_rounding = {{.*}}} {
+// CHECK-NEXT:   %[[v0:.*]] = "FHELinalg.lsb"(%[[a0]]) : (tensor<3x!FHE.eint<4>>) -> tensor<3x!FHE.eint<4>>
+// CHECK-NEXT:   %[[v1:.*]] = "FHELinalg.sub_eint"(%[[a0]], %[[v0]]) : (tensor<3x!FHE.eint<4>>, tensor<3x!FHE.eint<4>>) -> tensor<3x!FHE.eint<4>>
+// CHECK-NEXT:   %[[v2:.*]] = "FHELinalg.reinterpret_precision"(%[[v1]]) : (tensor<3x!FHE.eint<4>>) -> tensor<3x!FHE.eint<3>>
+// CHECK-NEXT:   %[[v3:.*]] = "FHELinalg.lsb"(%[[v2]]) : (tensor<3x!FHE.eint<3>>) -> tensor<3x!FHE.eint<3>>
+// CHECK-NEXT:   %[[v4:.*]] = "FHELinalg.sub_eint"(%[[v2]], %[[v3]]) : (tensor<3x!FHE.eint<3>>, tensor<3x!FHE.eint<3>>) -> tensor<3x!FHE.eint<3>>
+// CHECK-NEXT:   %[[v5:.*]] = "FHELinalg.reinterpret_precision"(%[[v4]]) : (tensor<3x!FHE.eint<3>>) -> tensor<3x!FHE.eint<2>>
+// CHECK-NEXT:   %[[v6:.*]] = arith.constant dense<[5, 0, 7, 1]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v7:.*]] = "FHELinalg.apply_lookup_table"(%[[v5]], %[[v6]]) : (tensor<3x!FHE.eint<2>>, tensor<4xi64>) -> tensor<3x!FHE.eint<3>>
+// CHECK-NEXT:   return %[[v7]] : tensor<3x!FHE.eint<3>>
+// CHECK-NEXT: }
+func.func @main(%arg0: tensor<3x!FHE.eint<4>>) -> tensor<3x!FHE.eint<3>> {
+  %lut = arith.constant dense<[5, 5, 5, 5, 0, 0, 0, 0, 7, 7, 7, 7, 1, 1, 1, 1]> : tensor<16xi64>
+  %0 = "FHELinalg.apply_lookup_table"(%arg0, %lut) : (tensor<3x!FHE.eint<4>>, tensor<16xi64>) -> tensor<3x!FHE.eint<3>>
+  return %0 : tensor<3x!FHE.eint<3>>
+}
+
+// -----
+
+// Clearing a single bit of a fresh input does not lower the precision plus
+// noise bits of the lookup table
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<3>) -> !FHE.eint<2> {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[0, 0, 1, 1, 2, 2, 3, 3]> : tensor<8xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[v0]]) : (!FHE.eint<3>, tensor<8xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   return %[[v1]] : !FHE.eint<2>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<3>) -> !FHE.eint<2> {
+  %lut = arith.constant dense<[0, 0, 1, 1, 2, 2, 3, 3]> : tensor<8xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut) : (!FHE.eint<3>, tensor<8xi64>) -> !FHE.eint<2>
+  return %0 : !FHE.eint<2>
+}
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<4>) -> !FHE.eint<4> {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]> : tensor<16xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[v0]]) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+// CHECK-NEXT:   return %[[v1]] : !FHE.eint<4>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<4>) -> !FHE.eint<4> {
+  %lut = arith.constant dense<[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]> : tensor<16xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+  return %0 : !FHE.eint<4>
+}
@@ -0,0 +1,86 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe --passes fhe-many-lut-grouping --max-many-lut-count=4 %s 2>&1 | FileCheck %s
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.reinterpret_precision"(%[[a0]]) : (!FHE.eint<2>) -> !FHE.eint<3>
+// CHECK-NEXT:   %[[v1:.*]] = arith.constant dense<[0, 0, 1, 1, 2, 2, 3, 3]> : tensor<8xi64>
+// CHECK-NEXT:   %[[v2:.*]] = "FHE.apply_lookup_table"(%[[v0]], %[[v1]]) {TFHE.many_lut = 2 : i32} : (!FHE.eint<3>, tensor<8xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   %[[v3:.*]] = arith.constant dense<[3, 3, 2, 2, 1, 1, 0, 0]> : tensor<8xi64>
+// CHECK-NEXT:   %[[v4:.*]] = "FHE.apply_lookup_table"(%[[v0]], %[[v3]]) {TFHE.many_lut = 2 : i32} : (!FHE.eint<3>, tensor<8xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   return %[[v2]], %[[v4]] : !FHE.eint<2>, !FHE.eint<2>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut1) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  return %0, %1 : !FHE.eint<2>, !FHE.eint<2>
+}
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<3x!FHE.eint<3>>) -> (tensor<3x!FHE.eint<3>>, tensor<3x!FHE.eint<3>>) {
+// CHECK-NEXT:   %[[v0:.*]] = "FHELinalg.reinterpret_precision"(%[[a0]]) : (tensor<3x!FHE.eint<3>>) -> tensor<3x!FHE.eint<4>>
+// CHECK-NEXT:   %[[v1:.*]] = arith.constant dense<[0, 0, 2, 2, 4, 4, 6, 6, 1, 1, 3, 3, 5, 5, 7, 7]> : tensor<16xi64>
+// CHECK-NEXT:   %[[v2:.*]] = "FHELinalg.apply_lookup_table"(%[[v0]], %[[v1]]) {TFHE.many_lut = 2 : i32} : (tensor<3x!FHE.eint<4>>, tensor<16xi64>) -> tensor<3x!FHE.eint<3>>
+// CHECK-NEXT:   %[[v3:.*]] = arith.constant dense<[7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0]> : tensor<16xi64>
+// CHECK-NEXT:   %[[v4:.*]] = "FHELinalg.apply_lookup_table"(%[[v0]], %[[v3]]) {TFHE.many_lut = 2 : i32} : (tensor<3x!FHE.eint<4>>, tensor<16xi64>) -> tensor<3x!FHE.eint<3>>
+// CHECK-NEXT:   return %[[v2]], %[[v4]] : tensor<3x!FHE.eint<3>>, tensor<3x!FHE.eint<3>>
+// CHECK-NEXT: }
+func.func @main(%arg0: tensor<3x!FHE.eint<3>>) -> (tensor<3x!FHE.eint<3>>, tensor<3x!FHE.eint<3>>) {
+  %lut0 = arith.constant dense<[0, 2, 4, 6, 1, 3, 5, 7]> : tensor<8xi64>
+  %lut1 = arith.constant dense<[7, 6, 5, 4, 3, 2, 1, 0]> : tensor<8xi64>
+  %0 = "FHELinalg.apply_lookup_table"(%arg0, %lut0) : (tensor<3x!FHE.eint<3>>, tensor<8xi64>) -> tensor<3x!FHE.eint<3>>
+  %1 = "FHELinalg.apply_lookup_table"(%arg0, %lut1) : (tensor<3x!FHE.eint<3>>, tensor<8xi64>) -> tensor<3x!FHE.eint<3>>
+  return %0, %1 : tensor<3x!FHE.eint<3>>, tensor<3x!FHE.eint<3>>
+}
+
+// -----
+
+// The lookup tables are not grouped as it would increase the maximal precision
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<4>) -> (!FHE.eint<4>, !FHE.eint<4>) {
+// CHECK-NOT:    FHE.reinterpret_precision
+// CHECK-NOT:    TFHE.many_lut
+func.func @main(%arg0: !FHE.eint<4>) -> (!FHE.eint<4>, !FHE.eint<4>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]> : tensor<16xi64>
+  %lut1 = arith.constant dense<[15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0]> : tensor<16xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut1) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+  return %0, %1 : !FHE.eint<4>, !FHE.eint<4>
+}
+
+// -----
+
+// Only complete groups are formed, the last lookup table is left alone
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>) {
+// CHECK:        %[[v0:.*]] = "FHE.reinterpret_precision"(%[[a0]]) : (!FHE.eint<2>) -> !FHE.eint<3>
+// CHECK:        "FHE.apply_lookup_table"(%[[v0]], %{{.*}}) {TFHE.many_lut = 2 : i32} : (!FHE.eint<3>, tensor<8xi64>) -> !FHE.eint<2>
+// CHECK:        "FHE.apply_lookup_table"(%[[v0]], %{{.*}}) {TFHE.many_lut = 2 : i32} : (!FHE.eint<3>, tensor<8xi64>) -> !FHE.eint<2>
+// CHECK:        "FHE.apply_lookup_table"(%[[a0]], %{{.*}}) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+func.func @main(%arg0: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+  %lut2 = arith.constant dense<[1, 2, 3, 0]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut1) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %2 = "FHE.apply_lookup_table"(%arg0, %lut2) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  return %0, %1, %2 : !FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>
+}
+
+// -----
+
+// The lookup tables are not grouped as the first result is used before the
+// second lookup table, where the packed bootstrap would be
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> !FHE.eint<2> {
+// CHECK-NOT:    FHE.reinterpret_precision
+// CHECK-NOT:    TFHE.many_lut
+func.func @main(%arg0: !FHE.eint<2>) -> !FHE.eint<2> {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %1 = "FHE.add_eint"(%0, %arg0) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  %2 = "FHE.apply_lookup_table"(%arg0, %lut1) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %3 = "FHE.add_eint"(%1, %2) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  return %3 : !FHE.eint<2>
+}
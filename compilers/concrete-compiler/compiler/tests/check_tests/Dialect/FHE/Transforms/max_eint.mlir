@@ -1,4 +1,4 @@
-// RUN: concretecompiler --split-input-file --action=dump-tfhe --passes fhe-max-transform %s 2>&1 | FileCheck %s
+// RUN: concretecompiler --split-input-file --action=dump-tfhe --passes fhe-balance-max --passes fhe-max-transform %s 2>&1 | FileCheck %s
 
 // -----
 
@@ -29,3 +29,21 @@ func.func @main(%arg0: !FHE.esint<5>, %arg1: !FHE.esint<5>) -> !FHE.esint<5> {
   %0 = "FHE.max_eint"(%arg0, %arg1) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
   return %0 : !FHE.esint<5>
 }
+
+// -----
+
+// CHECK:      func.func @chain(%[[a0:.*]]: !FHE.esint<5>, %[[a1:.*]]: !FHE.esint<5>, %[[a2:.*]]: !FHE.esint<5>, %[[a3:.*]]: !FHE.esint<5>) -> !FHE.esint<5> {
+// CHECK:        %[[v1:.*]] = "FHE.sub_eint"(%[[a0]], %[[a1]]) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+// CHECK:        %[[v3:.*]] = "FHE.add_eint"(%{{.*}}, %[[a1]]) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+// CHECK:        %[[v5:.*]] = "FHE.sub_eint"(%[[a2]], %[[a3]]) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+// CHECK:        %[[v7:.*]] = "FHE.add_eint"(%{{.*}}, %[[a3]]) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+// CHECK:        %[[v9:.*]] = "FHE.sub_eint"(%[[v3]], %[[v7]]) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+// CHECK:        %[[v11:.*]] = "FHE.add_eint"(%{{.*}}, %[[v7]]) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+// CHECK-NEXT:   return %[[v11]] : !FHE.esint<5>
+// CHECK-NEXT: }
+func.func @chain(%arg0: !FHE.esint<5>, %arg1: !FHE.esint<5>, %arg2: !FHE.esint<5>, %arg3: !FHE.esint<5>) -> !FHE.esint<5> {
+  %0 = "FHE.max_eint"(%arg0, %arg1) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+  %1 = "FHE.max_eint"(%0, %arg2) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+  %2 = "FHE.max_eint"(%1, %arg3) : (!FHE.esint<5>, !FHE.esint<5>) -> !FHE.esint<5>
+  return %2 : !FHE.esint<5>
+}
@@ -0,0 +1,67 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe --passes fhe-encrypted-mul-to-packed-tlu --always-pack-encrypted-mul %s 2>&1 | FileCheck %s
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<3x2x!FHE.eint<2>>, %[[a1:.*]]: tensor<2x4x!FHE.eint<2>>) -> tensor<3x4x!FHE.eint<2>> {
+// CHECK-NEXT:   %[[v0:.*]] = "FHELinalg.reinterpret_precision"(%[[a0]]) : (tensor<3x2x!FHE.eint<2>>) -> tensor<3x2x!FHE.eint<4>>
+// CHECK-NEXT:   %[[v1:.*]] = tensor.expand_shape %[[v0]] {{\[\[}}0], [1, 2]] : tensor<3x2x!FHE.eint<4>> into tensor<3x2x1x!FHE.eint<4>>
+// CHECK-NEXT:   %[[v2:.*]] = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v3:.*]] = "FHELinalg.apply_lookup_table"(%[[a1]], %[[v2]]) : (tensor<2x4x!FHE.eint<2>>, tensor<4xi64>) -> tensor<2x4x!FHE.eint<4>>
+// CHECK-NEXT:   %[[v4:.*]] = "FHELinalg.add_eint"(%[[v1]], %[[v3]]) : (tensor<3x2x1x!FHE.eint<4>>, tensor<2x4x!FHE.eint<4>>) -> tensor<3x2x4x!FHE.eint<4>>
+// CHECK-NEXT:   %[[v5:.*]] = arith.constant dense<[0, 0, 0, 0, 0, 1, 2, 3, 0, 2, 0, 2, 0, 3, 2, 1]> : tensor<16xi64>
+// CHECK-NEXT:   %[[v6:.*]] = "FHELinalg.apply_lookup_table"(%[[v4]], %[[v5]]) : (tensor<3x2x4x!FHE.eint<4>>, tensor<16xi64>) -> tensor<3x2x4x!FHE.eint<2>>
+// CHECK-NEXT:   %[[v7:.*]] = "FHELinalg.sum"(%[[v6]]) {axes = [1], keep_dims = false} : (tensor<3x2x4x!FHE.eint<2>>) -> tensor<3x4x!FHE.eint<2>>
+// CHECK-NEXT:   return %[[v7]] : tensor<3x4x!FHE.eint<2>>
+// CHECK-NEXT: }
+func.func @main(%x: tensor<3x2x!FHE.eint<2>>, %y: tensor<2x4x!FHE.eint<2>>) -> tensor<3x4x!FHE.eint<2>> {
+  %0 = "FHELinalg.matmul_eint_eint"(%x, %y): (tensor<3x2x!FHE.eint<2>>, tensor<2x4x!FHE.eint<2>>) -> tensor<3x4x!FHE.eint<2>>
+  return %0 : tensor<3x4x!FHE.eint<2>>
+}
+
+// -----
+
+// The signed operands are offset by 2^(p-1) before being packed
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<3x!FHE.esint<3>>, %[[a1:.*]]: tensor<3x!FHE.esint<3>>) -> !FHE.esint<3> {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<4> : tensor<1xi4>
+// CHECK-NEXT:   %[[v1:.*]] = "FHELinalg.add_eint_int"(%[[a0]], %[[v0]]) : (tensor<3x!FHE.esint<3>>, tensor<1xi4>) -> tensor<3x!FHE.esint<3>>
+// CHECK-NEXT:   %[[v2:.*]] = "FHELinalg.to_unsigned"(%[[v1]]) : (tensor<3x!FHE.esint<3>>) -> tensor<3x!FHE.eint<3>>
+// CHECK-NEXT:   %[[v3:.*]] = "FHELinalg.reinterpret_precision"(%[[v2]]) : (tensor<3x!FHE.eint<3>>) -> tensor<3x!FHE.eint<6>>
+// CHECK-NEXT:   %[[v4:.*]] = arith.constant dense<[4, 5, 6, 7, 0, 1, 2, 3]> : tensor<8xi64>
+// CHECK-NEXT:   %[[v5:.*]] = "FHELinalg.apply_lookup_table"(%[[a1]], %[[v4]]) : (tensor<3x!FHE.esint<3>>, tensor<8xi64>) -> tensor<3x!FHE.eint<6>>
+// CHECK-NEXT:   %[[v6:.*]] = "FHELinalg.add_eint"(%[[v3]], %[[v5]]) : (tensor<3x!FHE.eint<6>>, tensor<3x!FHE.eint<6>>) -> tensor<3x!FHE.eint<6>>
+// CHECK-NEXT:   %[[v7:.*]] = arith.constant dense<[0, -4, 0, -4, 0, -4, 0, -4, -4, 1, -2, 3, 0, -3, 2, -1, 0, -2, -4, 2, 0, -2, -4, 2, -4, 3, 2, 1, 0, -1, -2, -3, 0, 0, 0, 0, 0, 0, 0, 0, -4, -3, -2, -1, 0, 1, 2, 3, 0, 2, -4, -2, 0, 2, -4, -2, -4, -1, 2, -3, 0, 3, -2, 1]> : tensor<64xi64>
+// CHECK-NEXT:   %[[v8:.*]] = "FHELinalg.apply_lookup_table"(%[[v6]], %[[v7]]) : (tensor<3x!FHE.eint<6>>, tensor<64xi64>) -> tensor<3x!FHE.esint<3>>
+// CHECK-NEXT:   %[[v9:.*]] = "FHELinalg.sum"(%[[v8]]) {axes = [], keep_dims = false} : (tensor<3x!FHE.esint<3>>) -> !FHE.esint<3>
+// CHECK-NEXT:   return %[[v9]] : !FHE.esint<3>
+// CHECK-NEXT: }
+func.func @main(%x: tensor<3x!FHE.esint<3>>, %y: tensor<3x!FHE.esint<3>>) -> !FHE.esint<3> {
+  %0 = "FHELinalg.dot_eint_eint"(%x, %y): (tensor<3x!FHE.esint<3>>, tensor<3x!FHE.esint<3>>) -> !FHE.esint<3>
+  return %0 : !FHE.esint<3>
+}
+
+// -----
+
+// The packed operands would need more than 16 bits
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<2x3x!FHE.eint<9>>, %[[a1:.*]]: tensor<3x!FHE.eint<9>>) -> tensor<2x!FHE.eint<9>> {
+// CHECK-NEXT:   %[[v0:.*]] = "FHELinalg.matmul_eint_eint"(%[[a0]], %[[a1]]) : (tensor<2x3x!FHE.eint<9>>, tensor<3x!FHE.eint<9>>) -> tensor<2x!FHE.eint<9>>
+// CHECK-NEXT:   return %[[v0]] : tensor<2x!FHE.eint<9>>
+// CHECK-NEXT: }
+func.func @main(%x: tensor<2x3x!FHE.eint<9>>, %y: tensor<3x!FHE.eint<9>>) -> tensor<2x!FHE.eint<9>> {
+  %0 = "FHELinalg.matmul_eint_eint"(%x, %y): (tensor<2x3x!FHE.eint<9>>, tensor<3x!FHE.eint<9>>) -> tensor<2x!FHE.eint<9>>
+  return %0 : tensor<2x!FHE.eint<9>>
+}
+
+// -----
+
+// The batched matrix products keep the double table lookup
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<2x3x4x!FHE.eint<3>>, %[[a1:.*]]: tensor<2x4x2x!FHE.eint<3>>) -> tensor<2x3x2x!FHE.eint<3>> {
+// CHECK-NEXT:   %[[v0:.*]] = "FHELinalg.matmul_eint_eint"(%[[a0]], %[[a1]]) : (tensor<2x3x4x!FHE.eint<3>>, tensor<2x4x2x!FHE.eint<3>>) -> tensor<2x3x2x!FHE.eint<3>>
+// CHECK-NEXT:   return %[[v0]] : tensor<2x3x2x!FHE.eint<3>>
+// CHECK-NEXT: }
+func.func @main(%x: tensor<2x3x4x!FHE.eint<3>>, %y: tensor<2x4x2x!FHE.eint<3>>) -> tensor<2x3x2x!FHE.eint<3>> {
+  %0 = "FHELinalg.matmul_eint_eint"(%x, %y): (tensor<2x3x4x!FHE.eint<3>>, tensor<2x4x2x!FHE.eint<3>>) -> tensor<2x3x2x!FHE.eint<3>>
+  return %0 : tensor<2x3x2x!FHE.eint<3>>
+}
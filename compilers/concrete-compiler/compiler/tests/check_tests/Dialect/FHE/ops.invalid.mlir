@@ -16,14 +16,6 @@ func.func @zero_plaintext() -> tensor<4x9xi32> {
 
 // -----
 
-func.func @to_bool(%arg0: !FHE.eint<3>) -> !FHE.ebool {
-  // expected-error @+1 {{'FHE.to_bool' op}}
-  %1 = "FHE.to_bool"(%arg0): (!FHE.eint<3>) -> (!FHE.ebool)
-  return %1: !FHE.ebool
-}
-
-// -----
-
 func.func @gen_gate(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: tensor<5xi1>) -> !FHE.ebool {
   // expected-error @+1 {{'FHE.gen_gate' op}}
   %1 = "FHE.gen_gate"(%arg0, %arg1, %arg2) : (!FHE.ebool, !FHE.ebool, tensor<5xi1>) -> !FHE.ebool
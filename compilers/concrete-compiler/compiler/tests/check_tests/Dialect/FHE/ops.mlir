@@ -294,6 +294,15 @@ func.func @to_bool(%arg0: !FHE.eint<1>) -> !FHE.ebool {
   return %1: !FHE.ebool
 }
 
+// CHECK-LABEL: func.func @to_bool_wide(%arg0: !FHE.eint<3>) -> !FHE.ebool
+func.func @to_bool_wide(%arg0: !FHE.eint<3>) -> !FHE.ebool {
+  // CHECK-NEXT: %[[V1:.*]] = "FHE.to_bool"(%arg0) : (!FHE.eint<3>) -> !FHE.ebool
+  // CHECK-NEXT: return %[[V1]] : !FHE.ebool
+
+  %1 = "FHE.to_bool"(%arg0): (!FHE.eint<3>) -> (!FHE.ebool)
+  return %1: !FHE.ebool
+}
+
 // CHECK-LABEL: func.func @from_bool(%arg0: !FHE.ebool) -> !FHE.eint<1>
 func.func @from_bool(%arg0: !FHE.ebool) -> !FHE.eint<1> {
   // CHECK-NEXT: %[[V1:.*]] = "FHE.from_bool"(%arg0) : (!FHE.ebool) -> !FHE.eint<1>
@@ -0,0 +1,40 @@
+// RUN: concretecompiler --passes tfhe-keyswitch-sharing --action=dump-normalized-tfhe --skip-program-info %s 2>&1| FileCheck %s
+
+// CHECK-LABEL: func.func @share_extracted_ciphertext
+// CHECK-NEXT:   %[[C0:.*]] = arith.constant 0 : index
+// CHECK-NEXT:   %[[EXT:.*]] = tensor.extract %arg0[%[[C0]]]
+// CHECK-NEXT:   %[[KS:.*]] = "TFHE.keyswitch_glwe"(%[[EXT]])
+// CHECK-NEXT:   %[[BS0:.*]] = "TFHE.bootstrap_glwe"(%[[KS]], %arg1)
+// CHECK-NEXT:   %[[BS1:.*]] = "TFHE.bootstrap_glwe"(%[[KS]], %arg2)
+// CHECK-NEXT:   return %[[BS0]], %[[BS1]]
+func.func @share_extracted_ciphertext(%arg0: tensor<4x!TFHE.glwe<sk<0,1,2048>>>, %arg1: tensor<1024xi64>, %arg2: tensor<1024xi64>) -> (!TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>) {
+  %c0 = arith.constant 0 : index
+  %ext0 = tensor.extract %arg0[%c0] : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+  %ks0 = "TFHE.keyswitch_glwe"(%ext0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs0 = "TFHE.bootstrap_glwe"(%ks0, %arg1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  %ext1 = tensor.extract %arg0[%c0] : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+  %ks1 = "TFHE.keyswitch_glwe"(%ext1) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs1 = "TFHE.bootstrap_glwe"(%ks1, %arg2) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %bs0, %bs1 : !TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>
+}
+
+// CHECK-LABEL: func.func @hoist_loop_invariant_keyswitch
+// CHECK:        %[[KS:.*]] = "TFHE.keyswitch_glwe"(%arg0)
+// CHECK-NEXT:   scf.for
+// CHECK-NEXT:     %[[LUT:.*]] = tensor.extract_slice %arg1
+// CHECK-NEXT:     "TFHE.bootstrap_glwe"(%[[KS]], %[[LUT]])
+// CHECK-NOT:    "TFHE.keyswitch_glwe"
+func.func @hoist_loop_invariant_keyswitch(%arg0: !TFHE.glwe<sk<0,1,2048>>, %arg1: tensor<4x1024xi64>) -> tensor<4x!TFHE.glwe<sk<0,1,2048>>> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %init = bufferization.alloc_tensor() : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+  %r = scf.for %i = %c0 to %c4 step %c1 iter_args(%acc = %init) -> (tensor<4x!TFHE.glwe<sk<0,1,2048>>>) {
+    %lut = tensor.extract_slice %arg1[%i, 0] [1, 1024] [1, 1] : tensor<4x1024xi64> to tensor<1024xi64>
+    %ks = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+    %bs = "TFHE.bootstrap_glwe"(%ks, %lut) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+    %ins = tensor.insert %bs into %acc[%i] : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+    scf.yield %ins : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+  }
+  return %r : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+}
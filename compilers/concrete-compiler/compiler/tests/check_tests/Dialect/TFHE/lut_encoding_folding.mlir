@@ -0,0 +1,27 @@
+// RUN: concretecompiler --passes tfhe-lut-encoding-folding --action=dump-normalized-tfhe --skip-program-info %s 2>&1| FileCheck %s
+
+// CHECK-LABEL: func.func @fold_and_dedup_bootstrap_encoding
+// CHECK-NEXT: %[[V0:.*]] = arith.constant dense<{{\[}}0, 2305843009213693952, 2305843009213693952, 4611686018427387904, 4611686018427387904, 6917529027641081856, 6917529027641081856, 0]> : tensor<8xi64>
+// CHECK-NEXT: return %[[V0]], %[[V0]] : tensor<8xi64>, tensor<8xi64>
+func.func @fold_and_dedup_bootstrap_encoding() -> (tensor<8xi64>, tensor<8xi64>) {
+  %lut = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %0 = "TFHE.encode_expand_lut_for_bootstrap"(%lut) {isSigned = false, outputBits = 2 : i32, polySize = 8 : i32} : (tensor<4xi64>) -> tensor<8xi64>
+  %1 = "TFHE.encode_expand_lut_for_bootstrap"(%lut) {isSigned = false, outputBits = 2 : i32, polySize = 8 : i32} : (tensor<4xi64>) -> tensor<8xi64>
+  return %0, %1 : tensor<8xi64>, tensor<8xi64>
+}
+
+// CHECK-LABEL: func.func @fold_woppbs_encoding
+// CHECK-NEXT: %[[V0:.*]] = arith.constant dense<{{\[\[}}0, -9223372036854775808, 0, 0], [0, 6148914691236517205, -6148914691236517206, 0]]> : tensor<2x4xi64>
+// CHECK-NEXT: return %[[V0]] : tensor<2x4xi64>
+func.func @fold_woppbs_encoding() -> tensor<2x4xi64> {
+  %lut = arith.constant dense<[0, 1, 2]> : tensor<3xi64>
+  %0 = "TFHE.encode_lut_for_crt_woppbs"(%lut) {crtBits = [1, 1], crtDecomposition = [2, 3], isSigned = false, modulusProduct = 6 : i32} : (tensor<3xi64>) -> tensor<2x4xi64>
+  return %0 : tensor<2x4xi64>
+}
+
+// CHECK-LABEL: func.func @no_fold_dynamic_lut
+// CHECK-NEXT: %[[V0:.*]] = "TFHE.encode_expand_lut_for_bootstrap"(%arg0)
+func.func @no_fold_dynamic_lut(%arg0: tensor<4xi64>) -> tensor<8xi64> {
+  %0 = "TFHE.encode_expand_lut_for_bootstrap"(%arg0) {isSigned = false, outputBits = 2 : i32, polySize = 8 : i32} : (tensor<4xi64>) -> tensor<8xi64>
+  return %0 : tensor<8xi64>
+}
@@ -0,0 +1,34 @@
+// RUN: concretecompiler --passes tfhe-many-lut-packing --max-many-lut-count=4 --action=dump-normalized-tfhe --skip-program-info %s 2>&1| FileCheck %s
+
+// CHECK-LABEL: func.func @pack_bootstraps
+// CHECK-NEXT:   %[[V0:.*]] = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+// CHECK-NEXT:   %[[V1:.*]] = arith.constant dense<[0, 1, 3, 2]> : tensor<4xi64>
+// CHECK-NEXT:   %[[V2:.*]] = "TFHE.encode_expand_lut_for_bootstrap"(%[[V1]]) {isSigned = false, outputBits = 1 : i32, polySize = 1024 : i32} : (tensor<4xi64>) -> tensor<1024xi64>
+// CHECK-NEXT:   %[[V3:.*]] = "TFHE.many_lut_bootstrap_glwe"(%[[V0]], %[[V2]]) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>, sampleStride = 256 : i32} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> tensor<2x!TFHE.glwe<sk<0,1,2048>>>
+// CHECK-NEXT:   %[[C0:.*]] = arith.constant 0 : index
+// CHECK-NEXT:   %[[V4:.*]] = tensor.extract %[[V3]][%[[C0]]] : tensor<2x!TFHE.glwe<sk<0,1,2048>>>
+// CHECK-NEXT:   %[[C1:.*]] = arith.constant 1 : index
+// CHECK-NEXT:   %[[V5:.*]] = tensor.extract %[[V3]][%[[C1]]] : tensor<2x!TFHE.glwe<sk<0,1,2048>>>
+// CHECK-NEXT:   return %[[V4]], %[[V5]] : !TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>
+func.func @pack_bootstraps(%arg0: !TFHE.glwe<sk<0,1,2048>>) -> (!TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>) {
+  %lut0 = arith.constant dense<[0, 0, 3, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[1, 1, 2, 2]> : tensor<4xi64>
+  %enc0 = "TFHE.encode_expand_lut_for_bootstrap"(%lut0) {isSigned = false, outputBits = 1 : i32, polySize = 1024 : i32} : (tensor<4xi64>) -> tensor<1024xi64>
+  %enc1 = "TFHE.encode_expand_lut_for_bootstrap"(%lut1) {isSigned = false, outputBits = 1 : i32, polySize = 1024 : i32} : (tensor<4xi64>) -> tensor<1024xi64>
+  %ks0 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs0 = "TFHE.bootstrap_glwe"(%ks0, %enc0) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>, TFHE.many_lut = 2 : i32} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  %ks1 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs1 = "TFHE.bootstrap_glwe"(%ks1, %enc1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>, TFHE.many_lut = 2 : i32} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %bs0, %bs1 : !TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>
+}
+
+// CHECK-LABEL: func.func @no_packing_without_room
+// CHECK-COUNT-2: "TFHE.bootstrap_glwe"
+// CHECK-NOT: TFHE.many_lut_bootstrap_glwe
+func.func @no_packing_without_room(%arg0: !TFHE.glwe<sk<1,1,750>>, %lut0: tensor<1024xi64>, %lut1: tensor<1024xi64>) -> (!TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>) {
+  %enc0 = "TFHE.encode_expand_lut_for_bootstrap"(%lut0) {isSigned = false, outputBits = 1 : i32, polySize = 1024 : i32} : (tensor<1024xi64>) -> tensor<1024xi64>
+  %enc1 = "TFHE.encode_expand_lut_for_bootstrap"(%lut1) {isSigned = false, outputBits = 1 : i32, polySize = 1024 : i32} : (tensor<1024xi64>) -> tensor<1024xi64>
+  %bs0 = "TFHE.bootstrap_glwe"(%arg0, %enc0) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>, TFHE.many_lut = 2 : i32} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  %bs1 = "TFHE.bootstrap_glwe"(%arg0, %enc1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>, TFHE.many_lut = 2 : i32} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %bs0, %bs1 : !TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>
+}
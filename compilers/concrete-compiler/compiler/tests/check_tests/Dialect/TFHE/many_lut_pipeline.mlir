@@ -0,0 +1,19 @@
+// RUN: concretecompiler --max-many-lut-count=4 --action=dump-normalized-tfhe --skip-program-info %s 2>&1| FileCheck %s
+
+// The four lookup tables applied to the same input are evaluated by a single
+// many-lut bootstrap
+// CHECK-LABEL: func.func @main
+// CHECK:         "TFHE.many_lut_bootstrap_glwe"
+// CHECK-SAME:    -> tensor<4x!TFHE.glwe
+// CHECK-NOT:     "TFHE.bootstrap_glwe"
+func.func @main(%arg0: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+  %lut2 = arith.constant dense<[0, 1, 0, 1]> : tensor<4xi64>
+  %lut3 = arith.constant dense<[1, 3, 0, 2]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut1) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %2 = "FHE.apply_lookup_table"(%arg0, %lut2) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %3 = "FHE.apply_lookup_table"(%arg0, %lut3) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  return %0, %1, %2, %3 : !FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>
+}
@@ -0,0 +1,56 @@
+// RUN: concretecompiler --passes tfhe-pbs-deduplication --action=dump-normalized-tfhe --skip-program-info %s 2>&1| FileCheck %s
+
+// CHECK-LABEL: func.func @merge_identical_lookups
+// CHECK-SAME: attributes {TFHE.eliminated_pbs = 1 : i64}
+// CHECK-NEXT:   %[[LUT:.*]] = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+// CHECK-NEXT:   %[[ENC:.*]] = "TFHE.encode_expand_lut_for_bootstrap"(%[[LUT]])
+// CHECK-NEXT:   %[[KS:.*]] = "TFHE.keyswitch_glwe"(%arg0)
+// CHECK-NEXT:   %[[BS:.*]] = "TFHE.bootstrap_glwe"(%[[KS]], %[[ENC]])
+// CHECK-NEXT:   return %[[BS]], %[[BS]]
+func.func @merge_identical_lookups(%arg0: !TFHE.glwe<sk<0,1,2048>>) -> (!TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %enc0 = "TFHE.encode_expand_lut_for_bootstrap"(%lut0) {isSigned = false, outputBits = 2 : i32, polySize = 1024 : i32} : (tensor<4xi64>) -> tensor<1024xi64>
+  %enc1 = "TFHE.encode_expand_lut_for_bootstrap"(%lut1) {isSigned = false, outputBits = 2 : i32, polySize = 1024 : i32} : (tensor<4xi64>) -> tensor<1024xi64>
+  %ks0 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>, TFHE.OId = 0 : i32} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs0 = "TFHE.bootstrap_glwe"(%ks0, %enc0) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>, TFHE.OId = 0 : i32} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  %ks1 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>, TFHE.OId = 1 : i32} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs1 = "TFHE.bootstrap_glwe"(%ks1, %enc1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>, TFHE.OId = 1 : i32} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %bs0, %bs1 : !TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>
+}
+
+// CHECK-LABEL: func.func @keep_different_keys
+// CHECK-COUNT-2: "TFHE.bootstrap_glwe"
+func.func @keep_different_keys(%arg0: !TFHE.glwe<sk<1,1,750>>, %lut: tensor<1024xi64>) -> (!TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>) {
+  %bs0 = "TFHE.bootstrap_glwe"(%arg0, %lut) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  %bs1 = "TFHE.bootstrap_glwe"(%arg0, %lut) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 2, 15>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %bs0, %bs1 : !TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>
+}
+
+// CHECK-LABEL: func.func @hoist_loop_invariant
+// CHECK-SAME: attributes {TFHE.eliminated_pbs = 7 : i64}
+// CHECK:        %[[KS:.*]] = "TFHE.keyswitch_glwe"(%arg0)
+// CHECK-NEXT:   %[[BS:.*]] = "TFHE.bootstrap_glwe"(%[[KS]], %arg1)
+// CHECK-NEXT:   %[[R0:.*]] = scf.for
+// CHECK-NEXT:     tensor.insert %[[BS]]
+// CHECK:        %[[R1:.*]] = scf.for
+// CHECK-NEXT:     tensor.insert %[[BS]]
+func.func @hoist_loop_invariant(%arg0: !TFHE.glwe<sk<0,1,2048>>, %arg1: tensor<1024xi64>) -> (tensor<4x!TFHE.glwe<sk<0,1,2048>>>, tensor<4x!TFHE.glwe<sk<0,1,2048>>>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %init = bufferization.alloc_tensor() : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+  %r0 = scf.for %i = %c0 to %c4 step %c1 iter_args(%acc = %init) -> (tensor<4x!TFHE.glwe<sk<0,1,2048>>>) {
+    %ks = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+    %bs = "TFHE.bootstrap_glwe"(%ks, %arg1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+    %ins = tensor.insert %bs into %acc[%i] : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+    scf.yield %ins : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+  }
+  %r1 = scf.for %i = %c0 to %c4 step %c1 iter_args(%acc = %init) -> (tensor<4x!TFHE.glwe<sk<0,1,2048>>>) {
+    %ks = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+    %bs = "TFHE.bootstrap_glwe"(%ks, %arg1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+    %ins = tensor.insert %bs into %acc[%i] : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+    scf.yield %ins : tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+  }
+  return %r0, %r1 : tensor<4x!TFHE.glwe<sk<0,1,2048>>>, tensor<4x!TFHE.glwe<sk<0,1,2048>>>
+}
@@ -0,0 +1,32 @@
+// RUN: concretecompiler --passes tfhe-wavefront-batching --action=dump-batched-tfhe --batch-tfhe-ops --skip-program-info %s 2>&1| FileCheck %s
+
+// CHECK-LABEL: func.func @batch_independent_lookups
+// CHECK:        %[[CTS:.*]] = tensor.from_elements %arg0, %arg1
+// CHECK-NEXT:   %[[KS:.*]] = "TFHE.batched_keyswitch_glwe"(%[[CTS]])
+// CHECK:        %[[KS0:.*]] = tensor.extract %[[KS]]
+// CHECK:        %[[KS1:.*]] = tensor.extract %[[KS]]
+// CHECK-NEXT:   %[[KSS:.*]] = tensor.from_elements %[[KS0]], %[[KS1]]
+// CHECK-NEXT:   %[[EMPTY:.*]] = tensor.empty() : tensor<2x1024xi64>
+// CHECK-NEXT:   %[[LUT0:.*]] = tensor.insert_slice %arg2 into %[[EMPTY]][0, 0] [1, 1024] [1, 1]
+// CHECK-NEXT:   %[[LUTS:.*]] = tensor.insert_slice %arg3 into %[[LUT0]][1, 0] [1, 1024] [1, 1]
+// CHECK-NEXT:   %[[BS:.*]] = "TFHE.batched_mapped_bootstrap_glwe"(%[[KSS]], %[[LUTS]])
+// CHECK:        %[[BS0:.*]] = tensor.extract %[[BS]]
+// CHECK:        %[[BS1:.*]] = tensor.extract %[[BS]]
+// CHECK-NEXT:   return %[[BS0]], %[[BS1]]
+func.func @batch_independent_lookups(%arg0: !TFHE.glwe<sk<0,1,2048>>, %arg1: !TFHE.glwe<sk<0,1,2048>>, %arg2: tensor<1024xi64>, %arg3: tensor<1024xi64>) -> (!TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>) {
+  %ks0 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs0 = "TFHE.bootstrap_glwe"(%ks0, %arg2) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  %ks1 = "TFHE.keyswitch_glwe"(%arg1) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs1 = "TFHE.bootstrap_glwe"(%ks1, %arg3) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %bs0, %bs1 : !TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>
+}
+
+// CHECK-LABEL: func.func @keep_dependent_lookups
+// CHECK-NOT:    "TFHE.batched_bootstrap_glwe"
+// CHECK-COUNT-2: "TFHE.bootstrap_glwe"
+func.func @keep_dependent_lookups(%arg0: !TFHE.glwe<sk<1,1,750>>, %arg1: tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>> {
+  %bs0 = "TFHE.bootstrap_glwe"(%arg0, %arg1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  %ks = "TFHE.keyswitch_glwe"(%bs0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %bs1 = "TFHE.bootstrap_glwe"(%ks, %arg1) {key = #TFHE.bsk<sk<1,1,750>, sk<0,1,2048>, 1024, 2, 1, 23>} : (!TFHE.glwe<sk<1,1,750>>, tensor<1024xi64>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %bs1 : !TFHE.glwe<sk<0,1,2048>>
+}
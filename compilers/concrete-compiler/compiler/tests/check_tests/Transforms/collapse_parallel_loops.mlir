@@ -0,0 +1,66 @@
+// RUN: concretecompiler --passes collapse-parallel-loops --parallelize-loops --action=dump-std --skip-program-info %s 2>&1| FileCheck %s
+
+// The parallel loop is moved outward past the reduction loop, the invariant
+// constant being hoisted out of the nest and the index computation between
+// the loops being sunk into the nested loop
+
+// CHECK-LABEL: func.func @interchange
+// CHECK-SAME: attributes {SCF.parallel_bands = {{\[\[}}{{.*}}, 4 : i64]]}
+// CHECK:      %[[C2:.*]] = arith.constant 2 : i64
+// CHECK-NEXT: scf.for %[[I:.*]] = %c0 to %c4 step %c1 {
+// CHECK-NEXT:   scf.for %[[K:.*]] = %c0 to %c8 step %c1 {
+// CHECK-NEXT:     %[[KK:.*]] = arith.addi %[[K]], %c1 : index
+// CHECK-NEXT:     %[[X:.*]] = memref.load %arg0[%[[I]], %[[KK]]] : memref<4x9xi64>
+// CHECK-NEXT:     %[[Y:.*]] = arith.muli %[[X]], %[[C2]] : i64
+// CHECK-NEXT:     %[[ACC:.*]] = memref.load %arg1[%[[I]]] : memref<4xi64>
+// CHECK-NEXT:     %[[S:.*]] = arith.addi %[[ACC]], %[[Y]] : i64
+// CHECK-NEXT:     memref.store %[[S]], %arg1[%[[I]]] : memref<4xi64>
+// CHECK-NEXT:   } {parallel = false}
+// CHECK-NEXT: } {parallel = true}
+func.func @interchange(%arg0: memref<4x9xi64>, %arg1: memref<4xi64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c8 = arith.constant 8 : index
+  scf.for %k = %c0 to %c8 step %c1 {
+    %kk = arith.addi %k, %c1 : index
+    scf.for %i = %c0 to %c4 step %c1 {
+      %c2_i64 = arith.constant 2 : i64
+      %x = memref.load %arg0[%i, %kk] : memref<4x9xi64>
+      %y = arith.muli %x, %c2_i64 : i64
+      %acc = memref.load %arg1[%i] : memref<4xi64>
+      %s = arith.addi %acc, %y : i64
+      memref.store %s, %arg1[%i] : memref<4xi64>
+    } {parallel = true}
+  } {parallel = false}
+  return
+}
+
+// Once the reduction loop is innermost, the two parallel loops are collapsed
+// in a band of 4x3 iterations
+
+// CHECK-LABEL: func.func @collapse
+// CHECK-SAME: attributes {SCF.parallel_bands = {{\[\[}}{{.*}}, 12 : i64]]}
+// CHECK:      scf.for
+// CHECK-NOT:  parallel = true
+// CHECK:        scf.for %{{.*}} = %c0 to %c8 step %c1 {
+// CHECK:        } {parallel = false}
+// CHECK-NEXT: } {parallel = true}
+func.func @collapse(%arg0: memref<4x8x3xi64>, %arg1: memref<4x3xi64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c3 = arith.constant 3 : index
+  %c4 = arith.constant 4 : index
+  %c8 = arith.constant 8 : index
+  scf.for %i = %c0 to %c4 step %c1 {
+    scf.for %k = %c0 to %c8 step %c1 {
+      scf.for %j = %c0 to %c3 step %c1 {
+        %x = memref.load %arg0[%i, %k, %j] : memref<4x8x3xi64>
+        %acc = memref.load %arg1[%i, %j] : memref<4x3xi64>
+        %s = arith.addi %acc, %x : i64
+        memref.store %s, %arg1[%i, %j] : memref<4x3xi64>
+      } {parallel = true}
+    } {parallel = false}
+  } {parallel = true}
+  return
+}
@@ -5,6 +5,7 @@
 
 #include <benchmark/benchmark.h>
 #include <filesystem>
+#include <thread>
 
 #define BENCHMARK_HAS_CXX11
 #include "llvm/Support/Path.h"
@@ -20,13 +21,16 @@ using namespace concretelang::testlib;
     assert(false && "See error above");                                        \
   }
 
-/// Benchmark time of the compilation
+/// Benchmark time of the compilation with `state.range(0)` compilation
+/// threads
 static void BM_Compile(benchmark::State &state, EndToEndDesc description,
                        mlir::concretelang::CompilationOptions options) {
+  options.compileThreads = state.range(0);
   TestProgram tc(options);
   for (auto _ : state) {
     assert(tc.compile(description.program));
   }
+  state.counters["compile_threads"] = options.compileThreads;
 }
 
 /// Benchmark time of the key generation
@@ -124,12 +128,22 @@ void registerEndToEndBenchmark(std::string suiteName,
     };
     for (auto action : actions) {
       switch (action) {
-      case Action::COMPILE:
-        benchmark::RegisterBenchmark(benchName("compile").c_str(),
-                                     [=](::benchmark::State &st) {
-                                       BM_Compile(st, description, options);
-                                     });
+      case Action::COMPILE: {
+        auto bench = benchmark::RegisterBenchmark(
+            benchName("compile").c_str(), [=](::benchmark::State &st) {
+              BM_Compile(st, description, options);
+            });
+        // Report the scaling of the compilation time with the number of
+        // compilation threads, the wall clock time is the relevant measure
+        // as the work is spread over several threads.
+        bench->ArgName("threads")->UseRealTime();
+        unsigned int maxThreads =
+            std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+          bench->Arg(threads);
+        bench->Arg(maxThreads);
         break;
+      }
       case Action::KEYGEN:
         benchmark::RegisterBenchmark(benchName("keygen").c_str(),
                                      [=](::benchmark::State &st) {
@@ -0,0 +1,174 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "concrete-cpu.h"
+#include "concretelang/Common/HugePages.h"
+
+#include <benchmark/benchmark.h>
+#include <complex>
+#include <cstring>
+#include <random>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using concretelang::hugepages::Mode;
+using concretelang::hugepages::Vector;
+
+namespace {
+
+// Parameters of a bootstrap of the usual size, whose fourier bootstrap key
+// takes about 50MB
+constexpr size_t INPUT_LWE_DIMENSION = 800;
+constexpr size_t GLWE_DIMENSION = 1;
+constexpr size_t POLYNOMIAL_SIZE = 2048;
+constexpr size_t LEVEL_COUNT = 1;
+constexpr size_t BASE_LOG = 23;
+
+/// Counts the data TLB read misses of the calling thread, when the perf
+/// events are available.
+struct DTLBMissCounter {
+  int fd = -1;
+
+  DTLBMissCounter() {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~DTLBMissCounter() {
+#ifdef __linux__
+    if (fd >= 0)
+      close(fd);
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  /// Returns the misses since `start`, or -1 if they are not counted
+  double stop() {
+#ifdef __linux__
+    uint64_t count;
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) == sizeof(count))
+        return count;
+    }
+#endif
+    return -1;
+  }
+};
+
+size_t fourierBootstrapKeySize() {
+  return concrete_cpu_bootstrap_key_size_u64(LEVEL_COUNT, GLWE_DIMENSION,
+                                             POLYNOMIAL_SIZE,
+                                             INPUT_LWE_DIMENSION) /
+         2;
+}
+
+/// A fourier bootstrap key with random coefficients, which cost as much to
+/// stream as an actual key
+Vector<std::complex<double>> randomFourierBootstrapKey() {
+  std::mt19937_64 generator(0);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  Vector<std::complex<double>> key(fourierBootstrapKeySize());
+  for (auto &coefficient : key)
+    coefficient = {distribution(generator), distribution(generator)};
+  return key;
+}
+
+} // namespace
+
+/// Benchmark time of the allocation and the first touch of a fourier
+/// bootstrap key with `mode`, the latency added to the first call.
+static void BM_FirstTouch(benchmark::State &state, Mode mode) {
+  concretelang::hugepages::setMode(mode);
+  for (auto _ : state) {
+    Vector<std::complex<double>> key(fourierBootstrapKeySize());
+    benchmark::DoNotOptimize(key.data());
+  }
+  state.SetBytesProcessed(state.iterations() * fourierBootstrapKeySize() *
+                          sizeof(std::complex<double>));
+}
+
+/// Benchmark throughput of the bootstrap with a fourier bootstrap key
+/// allocated with `mode`, and its data TLB misses.
+static void BM_Bootstrap(benchmark::State &state, Mode mode) {
+  concretelang::hugepages::setMode(mode);
+  auto key = randomFourierBootstrapKey();
+
+  auto fft = (struct Fft *)aligned_alloc(CONCRETE_FFT_ALIGN, CONCRETE_FFT_SIZE);
+  concrete_cpu_construct_concrete_fft(fft, POLYNOMIAL_SIZE);
+  size_t scratchSize;
+  size_t scratchAlign;
+  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratchSize, &scratchAlign, GLWE_DIMENSION, POLYNOMIAL_SIZE, fft);
+  auto scratch = (uint8_t *)aligned_alloc(scratchAlign, scratchSize);
+
+  std::mt19937_64 generator(0);
+  std::vector<uint64_t> input(INPUT_LWE_DIMENSION + 1);
+  for (auto &coefficient : input)
+    coefficient = generator();
+  std::vector<uint64_t> accumulator((GLWE_DIMENSION + 1) * POLYNOMIAL_SIZE);
+  for (auto &coefficient : accumulator)
+    coefficient = generator();
+  std::vector<uint64_t> output(GLWE_DIMENSION * POLYNOMIAL_SIZE + 1);
+
+  DTLBMissCounter misses;
+  misses.start();
+  for (auto _ : state) {
+    concrete_cpu_bootstrap_lwe_ciphertext_u64(
+        output.data(), input.data(), accumulator.data(), key.data(),
+        LEVEL_COUNT, BASE_LOG, GLWE_DIMENSION, POLYNOMIAL_SIZE,
+        INPUT_LWE_DIMENSION, fft, scratch, scratchSize);
+    benchmark::DoNotOptimize(output.data());
+  }
+  auto count = misses.stop();
+  if (count >= 0)
+    state.counters["dtlb_misses"] =
+        benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations());
+
+  free(scratch);
+  concrete_cpu_destroy_concrete_fft(fft);
+  free(fft);
+}
+
+BENCHMARK_CAPTURE(BM_FirstTouch, none, Mode::NONE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FirstTouch, transparent, Mode::TRANSPARENT)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FirstTouch, explicit, Mode::EXPLICIT)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_Bootstrap, none, Mode::NONE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Bootstrap, transparent, Mode::TRANSPARENT)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Bootstrap, explicit, Mode::EXPLICIT)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
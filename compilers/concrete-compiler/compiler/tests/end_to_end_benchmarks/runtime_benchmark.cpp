@@ -0,0 +1,584 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete/blob/main/LICENSE.txt
+// for license information.
+
+#include "concretelang/Common/Csprng.h"
+#include "concretelang/Common/Keysets.h"
+#include "concretelang/Common/Transformers.h"
+#include "concretelang/Common/Values.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Runtime/context.h"
+#include "concretelang/Runtime/wrappers.h"
+#include "concretelang/Support/CompilerEngine.h"
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <random>
+#include <sstream>
+
+#include "tests_tools/keySetCache.h"
+
+namespace Concrete = mlir::concretelang::Concrete;
+using concretelang::keysets::Keyset;
+using concretelang::transformers::TransformerFactory;
+using concretelang::values::Tensor;
+using concretelang::values::Value;
+using mlir::concretelang::CompilerEngine;
+using mlir::concretelang::RuntimeContext;
+
+namespace {
+
+/// The number of ciphertexts of the batched operations and of the encrypted
+/// inputs
+constexpr size_t BATCH_SIZE = 16;
+
+/// A parameter set chosen by the optimizer for the table lookups of
+/// `precision` bits with `encoding`
+struct ParameterSetDesc {
+  std::string name;
+  unsigned precision;
+  concrete_optimizer::Encoding encoding;
+};
+
+const std::vector<ParameterSetDesc> PARAMETER_SETS = {
+    {"native_2bits", 2, concrete_optimizer::Encoding::Native},
+    {"native_4bits", 4, concrete_optimizer::Encoding::Native},
+    {"native_6bits", 6, concrete_optimizer::Encoding::Native},
+    {"native_8bits", 8, concrete_optimizer::Encoding::Native},
+    {"crt_8bits", 8, concrete_optimizer::Encoding::Crt},
+    {"crt_12bits", 12, concrete_optimizer::Encoding::Crt},
+};
+
+struct KeySwitchParameters {
+  uint32_t level;
+  uint32_t baseLog;
+  uint32_t inputLweDim;
+  uint32_t outputLweDim;
+  uint32_t kskIndex;
+};
+
+struct BootstrapParameters {
+  uint32_t inputLweDim;
+  uint32_t polySize;
+  uint32_t level;
+  uint32_t baseLog;
+  uint32_t glweDim;
+  uint32_t bskIndex;
+  uint32_t outputBits;
+  bool isSigned;
+};
+
+struct WopPBSParameters {
+  uint32_t lweDim;
+  uint32_t bootstrapLevel;
+  uint32_t bootstrapBaseLog;
+  uint32_t keyswitchLevel;
+  uint32_t keyswitchBaseLog;
+  uint32_t packingKeySwitchInputLweDim;
+  uint32_t packingKeySwitchPolySize;
+  uint32_t packingKeySwitchLevel;
+  uint32_t packingKeySwitchBaseLog;
+  uint32_t circuitBootstrapLevel;
+  uint32_t circuitBootstrapBaseLog;
+  uint32_t kskIndex;
+  uint32_t bskIndex;
+  uint32_t pkskIndex;
+  std::vector<uint64_t> crtDecomposition;
+  std::vector<uint64_t> crtBits;
+  uint32_t modulusProduct;
+  uint64_t lutSize;
+  bool isSigned;
+};
+
+/// The parameters of the keyswitches and bootstraps of a table lookup
+/// compiled by the optimizer, with the keys to evaluate them
+struct ParameterSet {
+  std::optional<KeySwitchParameters> keyswitch;
+  std::optional<BootstrapParameters> bootstrap;
+  std::optional<WopPBSParameters> wopPBS;
+  Message<concreteprotocol::ProgramInfo> programInfo;
+  Keyset keyset;
+  std::unique_ptr<RuntimeContext> context;
+};
+
+std::vector<uint64_t> toVector(mlir::ArrayAttr attr) {
+  std::vector<uint64_t> values;
+  for (auto value : attr.getAsValueRange<mlir::IntegerAttr>())
+    values.push_back(value.getZExtValue());
+  return values;
+}
+
+/// Returns the encoding of the lookup table `lut` of a bootstrap
+Concrete::EncodeExpandLutForBootstrapTensorOp getLutEncoding(mlir::Value lut) {
+  return lut.getDefiningOp<Concrete::EncodeExpandLutForBootstrapTensorOp>();
+}
+
+std::string lookupTableProgram(const ParameterSetDesc &desc) {
+  std::ostringstream lut;
+  uint64_t size = 1 << desc.precision;
+  for (uint64_t i = 0; i < size; i++)
+    lut << (i ? ", " : "") << (i + 1) % size;
+  std::ostringstream program;
+  std::string type = "tensor<" + std::to_string(BATCH_SIZE) + "x!FHE.eint<" +
+                     std::to_string(desc.precision) + ">>";
+  program << "func.func @main(%x: " << type << ") -> " << type << " {\n"
+          << "  %lut = arith.constant dense<[" << lut.str()
+          << "]> : tensor<" << size << "xi64>\n"
+          << "  %0 = \"FHELinalg.apply_lookup_table\"(%x, %lut) : (" << type
+          << ", tensor<" << size << "xi64>) -> " << type << "\n"
+          << "  return %0 : " << type << "\n"
+          << "}\n";
+  return program.str();
+}
+
+/// Compiles a table lookup for `desc` down to the Concrete dialect, and
+/// collects the parameters of its operations
+llvm::Expected<std::unique_ptr<ParameterSet>>
+compileParameterSet(const ParameterSetDesc &desc) {
+  mlir::concretelang::CompilationOptions options;
+  options.optimizerConfig.encoding = desc.encoding;
+  CompilerEngine engine(mlir::concretelang::CompilationContext::createShared());
+  engine.setCompilationOptions(options);
+  auto compilation = engine.compile(lookupTableProgram(desc),
+                                    CompilerEngine::Target::CONCRETE);
+  if (!compilation)
+    return compilation.takeError();
+
+  auto set = std::make_unique<ParameterSet>();
+  set->programInfo = *compilation->programInfo;
+  compilation->mlirModuleRef->get().walk([&](mlir::Operation *op) {
+    if (auto ksOp = llvm::dyn_cast<Concrete::KeySwitchLweTensorOp>(op)) {
+      set->keyswitch = KeySwitchParameters{
+          ksOp.getLevel(), ksOp.getBaseLog(), ksOp.getLweDimIn(),
+          ksOp.getLweDimOut(), ksOp.getKskIndex()};
+    } else if (auto bsOp =
+                   llvm::dyn_cast<Concrete::BootstrapLweTensorOp>(op)) {
+      auto lutOp = getLutEncoding(bsOp.getLookupTable());
+      set->bootstrap = BootstrapParameters{
+          bsOp.getInputLweDim(),   bsOp.getPolySize(),
+          bsOp.getLevel(),         bsOp.getBaseLog(),
+          bsOp.getGlweDimension(), bsOp.getBskIndex(),
+          lutOp ? lutOp.getOutputBits() : desc.precision,
+          lutOp ? lutOp.getIsSigned() : false};
+    } else if (auto fusedOp =
+                   llvm::dyn_cast<Concrete::KeySwitchBootstrapLweTensorOp>(
+                       op)) {
+      auto lutOp = getLutEncoding(fusedOp.getLookupTable());
+      set->keyswitch = KeySwitchParameters{
+          fusedOp.getKeyswitchLevel(), fusedOp.getKeyswitchBaseLog(),
+          fusedOp.getKeyswitchInputLweDim(), fusedOp.getInputLweDim(),
+          fusedOp.getKskIndex()};
+      set->bootstrap = BootstrapParameters{
+          fusedOp.getInputLweDim(), fusedOp.getPolySize(),
+          fusedOp.getBootstrapLevel(), fusedOp.getBootstrapBaseLog(),
+          fusedOp.getGlweDimension(), fusedOp.getBskIndex(),
+          lutOp ? lutOp.getOutputBits() : desc.precision,
+          lutOp ? lutOp.getIsSigned() : false};
+    } else if (auto wopOp =
+                   llvm::dyn_cast<Concrete::WopPBSCRTLweTensorOp>(op)) {
+      auto lutOp = llvm::dyn_cast_or_null<
+          Concrete::EncodeLutForCrtWopPBSTensorOp>(
+          wopOp.getLookupTable().getDefiningOp());
+      if (!lutOp)
+        return;
+      auto lutType = lutOp.getType().cast<mlir::RankedTensorType>();
+      auto ctType = wopOp.getType().cast<mlir::RankedTensorType>();
+      set->wopPBS = WopPBSParameters{
+          (uint32_t)ctType.getDimSize(1) - 1,
+          wopOp.getBootstrapLevel(),
+          wopOp.getBootstrapBaseLog(),
+          wopOp.getKeyswitchLevel(),
+          wopOp.getKeyswitchBaseLog(),
+          wopOp.getPackingKeySwitchInputLweDimension(),
+          wopOp.getPackingKeySwitchoutputPolynomialSize(),
+          wopOp.getPackingKeySwitchLevel(),
+          wopOp.getPackingKeySwitchBaseLog(),
+          wopOp.getCircuitBootstrapLevel(),
+          wopOp.getCircuitBootstrapBaseLog(),
+          wopOp.getKskIndex(),
+          wopOp.getBskIndex(),
+          wopOp.getPkskIndex(),
+          toVector(lutOp.getCrtDecomposition()),
+          toVector(lutOp.getCrtBits()),
+          lutOp.getModulusProduct(),
+          (uint64_t)lutType.getDimSize(1),
+          lutOp.getIsSigned()};
+    }
+  });
+
+  bool found = desc.encoding == concrete_optimizer::Encoding::Crt
+                   ? set->wopPBS.has_value()
+                   : set->keyswitch.has_value() && set->bootstrap.has_value();
+  if (!found)
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "The optimizer did not choose the expected operations for " +
+            desc.name);
+
+  auto keyset = getTestKeySetCachePtr()->getKeyset(
+      set->programInfo.asReader().getKeyset(), 0, 0);
+  if (keyset.has_failure())
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   keyset.as_failure().error().mesg);
+  set->keyset = keyset.value();
+  set->context = std::make_unique<RuntimeContext>(set->keyset.server);
+  return std::move(set);
+}
+
+/// Returns the parameter set of `desc`, compiled and keyed on first use so
+/// that only the selected benchmarks pay for it
+ParameterSet *getParameterSet(benchmark::State &state,
+                              const ParameterSetDesc &desc) {
+  static std::map<std::string, std::unique_ptr<ParameterSet>> sets;
+  auto it = sets.find(desc.name);
+  if (it == sets.end()) {
+    auto set = compileParameterSet(desc);
+    if (!set) {
+      state.SkipWithError(llvm::toString(set.takeError()).c_str());
+      return nullptr;
+    }
+    it = sets.emplace(desc.name, std::move(*set)).first;
+  }
+  return it->second.get();
+}
+
+/// Random ciphertexts, which cost as much to keyswitch or bootstrap as
+/// actual encryptions
+std::vector<uint64_t> randomCiphertexts(size_t count, size_t lweDim) {
+  std::mt19937_64 generator(0);
+  std::vector<uint64_t> ciphertexts(count * (lweDim + 1));
+  for (auto &coefficient : ciphertexts)
+    coefficient = generator();
+  return ciphertexts;
+}
+
+std::vector<uint64_t> identityLookupTable(unsigned precision) {
+  std::vector<uint64_t> lut(1 << precision);
+  for (size_t i = 0; i < lut.size(); i++)
+    lut[i] = i;
+  return lut;
+}
+
+/// The expanded lookup table of a bootstrap with `params`
+std::vector<uint64_t> expandedLookupTable(const BootstrapParameters &params) {
+  auto lut = identityLookupTable(params.outputBits);
+  std::vector<uint64_t> expanded(params.polySize);
+  memref_encode_expand_lut_for_bootstrap(
+      expanded.data(), expanded.data(), 0, expanded.size(), 1, lut.data(),
+      lut.data(), 0, lut.size(), 1, params.polySize, params.outputBits,
+      params.isSigned);
+  return expanded;
+}
+
+void setCounters(benchmark::State &state, const KeySwitchParameters &params) {
+  state.counters["ks_level"] = params.level;
+  state.counters["ks_base_log"] = params.baseLog;
+  state.counters["ks_input_lwe_dim"] = params.inputLweDim;
+  state.counters["ks_output_lwe_dim"] = params.outputLweDim;
+}
+
+void setCounters(benchmark::State &state, const BootstrapParameters &params) {
+  state.counters["bs_input_lwe_dim"] = params.inputLweDim;
+  state.counters["bs_poly_size"] = params.polySize;
+  state.counters["bs_level"] = params.level;
+  state.counters["bs_base_log"] = params.baseLog;
+  state.counters["bs_glwe_dim"] = params.glweDim;
+}
+
+void setCounters(benchmark::State &state, const WopPBSParameters &params) {
+  state.counters["wop_lwe_dim"] = params.lweDim;
+  state.counters["wop_crt_blocks"] = params.crtDecomposition.size();
+  state.counters["wop_cbs_level"] = params.circuitBootstrapLevel;
+  state.counters["wop_pksk_level"] = params.packingKeySwitchLevel;
+  state.counters["wop_poly_size"] = params.packingKeySwitchPolySize;
+}
+
+} // namespace
+
+/// Benchmark time of the encoding and expansion of a lookup table for a
+/// bootstrap
+static void BM_EncodeExpandLut(benchmark::State &state,
+                               ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->bootstrap;
+  auto lut = identityLookupTable(params.outputBits);
+  std::vector<uint64_t> expanded(params.polySize);
+  for (auto _ : state) {
+    memref_encode_expand_lut_for_bootstrap(
+        expanded.data(), expanded.data(), 0, expanded.size(), 1, lut.data(),
+        lut.data(), 0, lut.size(), 1, params.polySize, params.outputBits,
+        params.isSigned);
+    benchmark::DoNotOptimize(expanded.data());
+  }
+  setCounters(state, params);
+}
+
+/// Benchmark time of a keyswitch
+static void BM_Keyswitch(benchmark::State &state, ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->keyswitch;
+  auto in = randomCiphertexts(1, params.inputLweDim);
+  std::vector<uint64_t> out(params.outputLweDim + 1);
+  for (auto _ : state) {
+    memref_keyswitch_lwe_u64(out.data(), out.data(), 0, out.size(), 1,
+                             in.data(), in.data(), 0, in.size(), 1,
+                             params.level, params.baseLog, params.inputLweDim,
+                             params.outputLweDim, params.kskIndex,
+                             set->context.get());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCounters(state, params);
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// Benchmark time of a batch of keyswitches
+static void BM_BatchedKeyswitch(benchmark::State &state,
+                                ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->keyswitch;
+  size_t inSize = params.inputLweDim + 1;
+  size_t outSize = params.outputLweDim + 1;
+  auto in = randomCiphertexts(BATCH_SIZE, params.inputLweDim);
+  std::vector<uint64_t> out(BATCH_SIZE * outSize);
+  for (auto _ : state) {
+    memref_batched_keyswitch_lwe_u64(
+        out.data(), out.data(), 0, BATCH_SIZE, outSize, outSize, 1, in.data(),
+        in.data(), 0, BATCH_SIZE, inSize, inSize, 1, params.level,
+        params.baseLog, params.inputLweDim, params.outputLweDim,
+        params.kskIndex, set->context.get());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCounters(state, params);
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+/// Benchmark time of a bootstrap
+static void BM_Bootstrap(benchmark::State &state, ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->bootstrap;
+  auto lut = expandedLookupTable(params);
+  auto in = randomCiphertexts(1, params.inputLweDim);
+  std::vector<uint64_t> out(params.glweDim * params.polySize + 1);
+  for (auto _ : state) {
+    memref_bootstrap_lwe_u64(out.data(), out.data(), 0, out.size(), 1,
+                             in.data(), in.data(), 0, in.size(), 1,
+                             lut.data(), lut.data(), 0, lut.size(), 1,
+                             params.inputLweDim, params.polySize,
+                             params.level, params.baseLog, params.glweDim,
+                             params.bskIndex, set->context.get());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCounters(state, params);
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// Benchmark time of a batch of bootstraps with the same lookup table
+static void BM_BatchedBootstrap(benchmark::State &state,
+                                ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->bootstrap;
+  size_t inSize = params.inputLweDim + 1;
+  size_t outSize = params.glweDim * params.polySize + 1;
+  auto lut = expandedLookupTable(params);
+  auto in = randomCiphertexts(BATCH_SIZE, params.inputLweDim);
+  std::vector<uint64_t> out(BATCH_SIZE * outSize);
+  for (auto _ : state) {
+    memref_batched_bootstrap_lwe_u64(
+        out.data(), out.data(), 0, BATCH_SIZE, outSize, outSize, 1, in.data(),
+        in.data(), 0, BATCH_SIZE, inSize, inSize, 1, lut.data(), lut.data(),
+        0, lut.size(), 1, params.inputLweDim, params.polySize, params.level,
+        params.baseLog, params.glweDim, params.bskIndex, set->context.get());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCounters(state, params);
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+/// Benchmark time of a batch of bootstraps with a lookup table per
+/// ciphertext
+static void BM_BatchedMappedBootstrap(benchmark::State &state,
+                                      ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->bootstrap;
+  size_t inSize = params.inputLweDim + 1;
+  size_t outSize = params.glweDim * params.polySize + 1;
+  auto lut = expandedLookupTable(params);
+  std::vector<uint64_t> luts;
+  for (size_t i = 0; i < BATCH_SIZE; i++)
+    luts.insert(luts.end(), lut.begin(), lut.end());
+  auto in = randomCiphertexts(BATCH_SIZE, params.inputLweDim);
+  std::vector<uint64_t> out(BATCH_SIZE * outSize);
+  for (auto _ : state) {
+    memref_batched_mapped_bootstrap_lwe_u64(
+        out.data(), out.data(), 0, BATCH_SIZE, outSize, outSize, 1, in.data(),
+        in.data(), 0, BATCH_SIZE, inSize, inSize, 1, luts.data(), luts.data(),
+        0, BATCH_SIZE, lut.size(), lut.size(), 1, params.inputLweDim,
+        params.polySize, params.level, params.baseLog, params.glweDim,
+        params.bskIndex, set->context.get());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCounters(state, params);
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+/// Benchmark time of a batch of fused keyswitches and bootstraps
+static void BM_BatchedKeyswitchBootstrap(benchmark::State &state,
+                                         ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &ks = *set->keyswitch;
+  auto &bs = *set->bootstrap;
+  size_t inSize = ks.inputLweDim + 1;
+  size_t outSize = bs.glweDim * bs.polySize + 1;
+  auto lut = expandedLookupTable(bs);
+  auto in = randomCiphertexts(BATCH_SIZE, ks.inputLweDim);
+  std::vector<uint64_t> out(BATCH_SIZE * outSize);
+  for (auto _ : state) {
+    memref_batched_keyswitch_bootstrap_lwe_u64(
+        out.data(), out.data(), 0, BATCH_SIZE, outSize, outSize, 1, in.data(),
+        in.data(), 0, BATCH_SIZE, inSize, inSize, 1, lut.data(), lut.data(),
+        0, lut.size(), 1, ks.level, ks.baseLog, ks.inputLweDim,
+        bs.inputLweDim, bs.polySize, bs.level, bs.baseLog, bs.glweDim,
+        ks.kskIndex, bs.bskIndex, set->context.get());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCounters(state, ks);
+  setCounters(state, bs);
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+/// Benchmark time of the encoding of a lookup table for a wop-PBS
+static void BM_EncodeLutForCrtWopPBS(benchmark::State &state,
+                                     ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->wopPBS;
+  auto lut = identityLookupTable(desc.precision);
+  size_t blocks = params.crtDecomposition.size();
+  std::vector<uint64_t> encoded(blocks * params.lutSize);
+  for (auto _ : state) {
+    memref_encode_lut_for_crt_woppbs(
+        encoded.data(), encoded.data(), 0, blocks, params.lutSize,
+        params.lutSize, 1, lut.data(), lut.data(), 0, lut.size(), 1,
+        params.crtDecomposition.data(), params.crtDecomposition.data(), 0,
+        blocks, 1, params.crtBits.data(), params.crtBits.data(), 0, blocks, 1,
+        params.modulusProduct, params.isSigned);
+    benchmark::DoNotOptimize(encoded.data());
+  }
+  setCounters(state, params);
+}
+
+/// Benchmark time of a wop-PBS of a ciphertext decomposed in CRT blocks
+static void BM_WopPBS(benchmark::State &state, ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto &params = *set->wopPBS;
+  size_t blocks = params.crtDecomposition.size();
+  size_t ctSize = params.lweDim + 1;
+  auto lut = identityLookupTable(desc.precision);
+  std::vector<uint64_t> encoded(blocks * params.lutSize);
+  memref_encode_lut_for_crt_woppbs(
+      encoded.data(), encoded.data(), 0, blocks, params.lutSize,
+      params.lutSize, 1, lut.data(), lut.data(), 0, lut.size(), 1,
+      params.crtDecomposition.data(), params.crtDecomposition.data(), 0,
+      blocks, 1, params.crtBits.data(), params.crtBits.data(), 0, blocks, 1,
+      params.modulusProduct, params.isSigned);
+  auto in = randomCiphertexts(blocks, params.lweDim);
+  std::vector<uint64_t> out(blocks * ctSize);
+  for (auto _ : state) {
+    memref_wop_pbs_crt_buffer(
+        out.data(), out.data(), 0, blocks, ctSize, ctSize, 1, in.data(),
+        in.data(), 0, blocks, ctSize, ctSize, 1, encoded.data(),
+        encoded.data(), 0, blocks, params.lutSize, params.lutSize, 1,
+        params.crtDecomposition.data(), params.crtDecomposition.data(), 0,
+        blocks, 1, params.packingKeySwitchInputLweDim,
+        params.circuitBootstrapLevel, params.circuitBootstrapBaseLog,
+        params.keyswitchLevel, params.keyswitchBaseLog, params.bootstrapLevel,
+        params.bootstrapBaseLog, params.packingKeySwitchLevel,
+        params.packingKeySwitchBaseLog, params.packingKeySwitchPolySize,
+        params.kskIndex, params.bskIndex, params.pkskIndex,
+        set->context.get());
+    benchmark::DoNotOptimize(out.data());
+  }
+  setCounters(state, params);
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// Benchmark time of the encryption of a batch of inputs by the transformer
+/// of the client
+static void BM_Encrypt(benchmark::State &state, ParameterSetDesc desc) {
+  auto set = getParameterSet(state, desc);
+  if (set == nullptr)
+    return;
+  auto gateInfo =
+      set->programInfo.asReader().getCircuits()[0].getInputs()[0];
+  auto csprng = std::make_shared<concretelang::csprng::EncryptionCSPRNG>(0);
+  auto transformer = TransformerFactory::getLweCiphertextInputTransformer(
+      set->keyset.client, gateInfo, csprng, false);
+  if (transformer.has_failure()) {
+    state.SkipWithError(transformer.as_failure().error().mesg.c_str());
+    return;
+  }
+  auto lut = identityLookupTable(desc.precision);
+  std::vector<uint64_t> values(BATCH_SIZE);
+  for (size_t i = 0; i < BATCH_SIZE; i++)
+    values[i] = lut[i % lut.size()];
+  Value input = Tensor<uint64_t>(values, {BATCH_SIZE});
+  for (auto _ : state) {
+    auto encrypted = transformer.value()(input);
+    benchmark::DoNotOptimize(encrypted);
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+
+  auto registerBenchmark = [](std::string name, ParameterSetDesc desc,
+                              void (*bench)(benchmark::State &,
+                                            ParameterSetDesc)) {
+    benchmark::RegisterBenchmark(
+        (name + "/" + desc.name).c_str(),
+        [=](benchmark::State &state) { bench(state, desc); })
+        ->Unit(benchmark::kMicrosecond);
+  };
+
+  for (auto &desc : PARAMETER_SETS) {
+    if (desc.encoding == concrete_optimizer::Encoding::Crt) {
+      registerBenchmark("encode_lut_for_crt_woppbs", desc,
+                        BM_EncodeLutForCrtWopPBS);
+      registerBenchmark("wop_pbs_crt", desc, BM_WopPBS);
+    } else {
+      registerBenchmark("encode_expand_lut", desc, BM_EncodeExpandLut);
+      registerBenchmark("keyswitch", desc, BM_Keyswitch);
+      registerBenchmark("batched_keyswitch", desc, BM_BatchedKeyswitch);
+      registerBenchmark("bootstrap", desc, BM_Bootstrap);
+      registerBenchmark("batched_bootstrap", desc, BM_BatchedBootstrap);
+      registerBenchmark("batched_mapped_bootstrap", desc,
+                        BM_BatchedMappedBootstrap);
+      registerBenchmark("batched_keyswitch_bootstrap", desc,
+                        BM_BatchedKeyswitchBootstrap);
+    }
+    registerBenchmark("encrypt", desc, BM_Encrypt);
+  }
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
@@ -252,6 +252,8 @@ template <> struct llvm::yaml::MappingTraits<EndToEndDesc> {
       desc.largeIntegerParameter = largeInterger;
     }
     io.mapOptional("test-error-rates", desc.test_error_rates);
+    io.mapOptional("always-pack-encrypted-mul", desc.alwaysPackEncryptedMul,
+                   false);
   }
 };
 
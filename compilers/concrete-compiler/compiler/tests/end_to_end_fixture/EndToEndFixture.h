@@ -63,6 +63,7 @@ struct EndToEndDesc {
   std::optional<mlir::concretelang::LargeIntegerParameter>
       largeIntegerParameter;
   std::vector<TestErrorRate> test_error_rates;
+  bool alwaysPackEncryptedMul; // force the packed lowering of the products
 };
 
 struct EndToEndDescFile {
@@ -0,0 +1,96 @@
+import argparse
+
+import numpy as np
+
+from end_to_end_linalg_leveled_gen import P_ERROR
+
+# Fully unrolled circuits, packing thousands of scalar ciphertexts back
+# into tensors, mostly stress the compilation time
+
+
+def print_unrolled_luts(n_ct, p):
+    # Extracts all the elements of %arg0 and applies %tlu on each of them,
+    # leaving the results in %lut0 ... %lut{n_ct-1}
+    for i in range(n_ct):
+        print(f"    %c{i} = arith.constant {i} : index")
+        print(f"    %ct{i} = tensor.extract %arg0[%c{i}] : tensor<{n_ct}x!FHE.eint<{p}>>")
+        print(
+            f"    %lut{i} = \"FHE.apply_lookup_table\"(%ct{i}, %tlu): "
+            f"(!FHE.eint<{p}>, tensor<{2**p}xi64>) -> !FHE.eint<{p}>"
+        )
+
+
+def print_test(n_ct, p, random_lut):
+    random_input = np.random.randint(2**p, size=n_ct)
+    outputs = [random_lut[v] for v in random_input]
+    print(f"p-error: {P_ERROR}")
+    print("tests:")
+    print("  - inputs:")
+    print(f"    - tensor: [{','.join(map(str, random_input))}]")
+    print(f"      shape: [{n_ct}]")
+    print("    outputs:")
+    print(f"    - tensor: [{','.join(map(str, outputs))}]")
+    print(f"      shape: [{n_ct}]")
+    print("---")
+
+
+def generate(args):
+    print("# /!\ DO NOT EDIT MANUALLY THIS FILE MANUALLY")
+    print("# /!\ THIS FILE HAS BEEN GENERATED")
+    np.random.seed(0)
+    for n_ct in args.n_ct:
+        for p in args.bitwidth:
+            random_lut = np.random.randint(2**p, size=2**p)
+            tensor_type = f"tensor<{n_ct}x!FHE.eint<{p}>>"
+            lut_cst = f"arith.constant dense<[{','.join(map(str, random_lut))}]> : tensor<{2**p}xi64>"
+
+            # All the results packed by a single tensor.from_elements
+            print(f"description: from_elements_{p}bits_{n_ct}ct")
+            print("program: |")
+            print(f"  func.func @main(%arg0: {tensor_type}) -> {tensor_type} {{")
+            print(f"    %tlu = {lut_cst}")
+            print_unrolled_luts(n_ct, p)
+            operands = ", ".join(f"%lut{i}" for i in range(n_ct))
+            print(f"    %res = tensor.from_elements {operands} : {tensor_type}")
+            print(f"    return %res : {tensor_type}")
+            print("  }")
+            print_test(n_ct, p, random_lut)
+
+            # All the results packed by a concatenation, i.e. a chain of
+            # tensor.insert_slice once lowered
+            print(f"description: concat_{p}bits_{n_ct}ct")
+            print("program: |")
+            print(f"  func.func @main(%arg0: {tensor_type}) -> {tensor_type} {{")
+            print(f"    %tlu = {lut_cst}")
+            print_unrolled_luts(n_ct, p)
+            unit_type = f"tensor<1x!FHE.eint<{p}>>"
+            for i in range(n_ct):
+                print(f"    %unit{i} = tensor.from_elements %lut{i} : {unit_type}")
+            operands = ", ".join(f"%unit{i}" for i in range(n_ct))
+            operand_types = ", ".join([unit_type] * n_ct)
+            print(
+                f"    %res = \"FHELinalg.concat\"({operands}) : "
+                f"({operand_types}) -> {tensor_type}"
+            )
+            print(f"    return %res : {tensor_type}")
+            print("  }")
+            print_test(n_ct, p, random_lut)
+
+
+if __name__ == "__main__":
+    CLI = argparse.ArgumentParser()
+    CLI.add_argument(
+        "--bitwidth",
+        help="Specify the list of bitwidth to generate",
+        nargs="+",
+        type=int,
+        default=[3],
+    )
+    CLI.add_argument(
+        "--n-ct",
+        help="Specify the numbers of packed ciphertexts to generate",
+        nargs="+",
+        type=int,
+        default=[10000],
+    )
+    generate(CLI.parse_args())
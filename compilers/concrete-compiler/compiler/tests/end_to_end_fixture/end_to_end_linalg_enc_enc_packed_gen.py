@@ -0,0 +1,95 @@
+import argparse
+import numpy as np
+
+from end_to_end_linalg_enc_enc_matmul_dot_gen import P_ERROR, flatten_and_to_str, format_shape
+
+# Encrypted inner products on small precisions, computed by a single table
+# lookup on packed operands whatever their cost (see EncryptedMulToPackedTLU)
+PRECISION = 4
+# Bounds of the operands, such that all the results fit in the precision
+UNSIGNED_RANGE = (0, 2)
+SIGNED_RANGE = (-1, 1)
+SHAPES = {
+    "matmul_eint_eint": [((8, 3), (3, 2)), ((6, 2), (2, 3))],
+    "dot_eint_eint": [((3,), (3,))],
+}
+
+
+def generate(op):
+    p = PRECISION
+    for shapes in SHAPES[op]:
+        for signed in [False, True]:
+            min_value, max_value = SIGNED_RANGE if signed else UNSIGNED_RANGE
+
+            inp_0 = np.random.randint(min_value, max_value + 1, size=shapes[0])
+            inp_1 = np.random.randint(min_value, max_value + 1, size=shapes[1])
+
+            expected_result = inp_0 @ inp_1
+
+            if signed:
+                assert np.all(expected_result >= -(2 ** (p - 1)))
+                assert np.all(expected_result < 2 ** (p - 1))
+            else:
+                assert np.all(expected_result < 2**p)
+            out_shape = expected_result.shape
+            scalar_output = len(out_shape) == 0
+
+            dtype = "esint" if signed else "eint"
+            shape_0_str = format_shape(shapes[0])
+            shape_1_str = format_shape(shapes[1])
+            out_type = (
+                f"!FHE.{dtype}<{p}>"
+                if scalar_output
+                else f"tensor<{format_shape(out_shape)}!FHE.{dtype}<{p}>>"
+            )
+            in_0_type = f"tensor<{shape_0_str}!FHE.{dtype}<{p}>>"
+            in_1_type = f"tensor<{shape_1_str}!FHE.{dtype}<{p}>>"
+            signed_line = "      signed: True\n" if signed else ""
+
+            program = (
+                f"description: packed_{op}_{p}bits_{'s' if signed else 'u'}_{shape_0_str}_{shape_1_str}\n"
+                f"program: |\n"
+                f"  func.func @main(%x: {in_0_type}, %y: {in_1_type}) -> {out_type} {{\n"
+                f'       %0 = "FHELinalg.{op}"(%x, %y): ({in_0_type}, {in_1_type}) -> {out_type}\n'
+                f"       return %0 : {out_type}\n"
+                f"  }}\n"
+                f"p-error: {P_ERROR}\n"
+                "always-pack-encrypted-mul: true\n"
+                "tests:\n"
+                "  - inputs:\n"
+                f"    - tensor: {flatten_and_to_str(inp_0)}\n"
+                f"      shape: [{','.join(map(str, shapes[0]))}]\n"
+                f"{signed_line}"
+                f"    - tensor: {flatten_and_to_str(inp_1)}\n"
+                f"      shape: [{','.join(map(str, shapes[1]))}]\n"
+                f"{signed_line}"
+                f"    outputs:\n"
+            )
+            if scalar_output:
+                program += (
+                    f"    - scalar: {flatten_and_to_str(expected_result, is_tensor=False)}\n"
+                    f"{signed_line}"
+                )
+            else:
+                program += (
+                    f"    - tensor: {flatten_and_to_str(expected_result)}\n"
+                    f"      shape: [{','.join(map(str, out_shape))}]\n"
+                    f"{signed_line}"
+                )
+            program += "---"
+            print(program)
+
+
+if __name__ == "__main__":
+    CLI = argparse.ArgumentParser()
+    CLI.add_argument(
+        "--minimal",
+        help="Specify whether to generate minimal tests only",
+        type=bool,
+        default=False,
+    )
+    CLI.parse_args()
+    print("# /!\ DO NOT EDIT MANUALLY THIS FILE MANUALLY")
+    print("# /!\ THIS FILE HAS BEEN GENERATED")
+    generate("matmul_eint_eint")
+    generate("dot_eint_eint")
@@ -28,3 +28,36 @@ TEST(Lambda_chunked_int, chunked_int_add_eint) {
       lambda({Tensor<uint64_t>(2057594037927936), Tensor<uint64_t>(1111)}),
       (uint64_t)2057594037929047);
 }
+
+TEST(Lambda_chunked_int, chunked_int_add_eint_carry_lookahead) {
+  mlir::concretelang::CompilationOptions options;
+  options.chunkIntegers = true;
+  options.chunkSize = 4;
+  options.chunkWidth = 2;
+  options.chunkCarryLookahead = true;
+  TestProgram circuit(options);
+  ASSERT_OUTCOME_HAS_VALUE(circuit.compile(R"XXX(
+    func.func @main(%arg0: !FHE.eint<16>, %arg1: !FHE.eint<16>) -> !FHE.eint<16> {
+      %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<16>, !FHE.eint<16>) -> (!FHE.eint<16>)
+      return %1: !FHE.eint<16>
+    }
+    )XXX"));
+  ASSERT_OUTCOME_HAS_VALUE(circuit.generateKeyset());
+  auto lambda = [&](uint64_t a, uint64_t b) {
+    return circuit.call({Tensor<uint64_t>(a), Tensor<uint64_t>(b)})
+        .value()[0]
+        .template getTensor<uint64_t>()
+        .value()[0];
+  };
+  // no carry
+  ASSERT_EQ(lambda(0x1234, 0x4321), (uint64_t)0x5555);
+  // carry generated by the low chunk and propagated by the next ones
+  ASSERT_EQ(lambda(0xFF, 0x1), (uint64_t)0x100);
+  ASSERT_EQ(lambda(0x7FFF, 0x0001), (uint64_t)0x8000);
+  // carries generated by several chunks
+  ASSERT_EQ(lambda(0x0F0F, 0x0F0F), (uint64_t)0x1E1E);
+  // the carry out of the top chunk is dropped
+  ASSERT_EQ(lambda(0xFFFF, 0x0001), (uint64_t)0x0);
+  ASSERT_EQ(lambda(0xFFFF, 0xFFFF), (uint64_t)0xFFFE);
+  ASSERT_EQ(lambda(0x8000, 0x8000), (uint64_t)0x0);
+}
@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <gtest/gtest.h>
+#include <llvm/Support/FileSystem.h>
 #include <type_traits>
 
 #include "concretelang/TestLib/TestProgram.h"
@@ -497,6 +498,193 @@ func.func @dec(%arg0: !FHE.eint<3>) -> !FHE.eint<3> {
   ASSERT_EQ(lambda_dec({Tensor<uint64_t>(4)}), (uint64_t)3);
 }
 
+TEST(CompileMultiFunctions, multi_functions_compile_threads) {
+  std::string program = R"XXX(
+func.func @inc(%arg0: !FHE.eint<3>) -> !FHE.eint<3> {
+  %lut = arith.constant dense<[1, 2, 3, 4, 5, 6, 7, 0]> : tensor<8xi64>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut): (!FHE.eint<3>, tensor<8xi64>) -> (!FHE.eint<3>)
+  return %1: !FHE.eint<3>
+}
+func.func @dec(%arg0: !FHE.eint<3>) -> !FHE.eint<3> {
+  %lut = arith.constant dense<[7, 0, 1, 2, 3, 4, 5, 6]> : tensor<8xi64>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut): (!FHE.eint<3>, tensor<8xi64>) -> (!FHE.eint<3>)
+  return %1: !FHE.eint<3>
+}
+func.func @square(%arg0: !FHE.eint<3>) -> !FHE.eint<3> {
+  %lut = arith.constant dense<[0, 1, 4, 1, 0, 1, 4, 1]> : tensor<8xi64>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut): (!FHE.eint<3>, tensor<8xi64>) -> (!FHE.eint<3>)
+  return %1: !FHE.eint<3>
+}
+func.func @double(%arg0: tensor<4x!FHE.eint<3>>) -> tensor<4x!FHE.eint<3>> {
+  %lut = arith.constant dense<[0, 2, 4, 6, 0, 2, 4, 6]> : tensor<8xi64>
+  %1 = "FHELinalg.apply_lookup_table"(%arg0, %lut): (tensor<4x!FHE.eint<3>>, tensor<8xi64>) -> (tensor<4x!FHE.eint<3>>)
+  return %1: tensor<4x!FHE.eint<3>>
+}
+)XXX";
+  mlir::concretelang::CompilationOptions options;
+  options.optimizerConfig.strategy = mlir::concretelang::optimizer::V0;
+
+  // The library built with several threads describes the same circuits as
+  // the one built with a single thread
+  auto compileProgramInfo = [&](unsigned int threads) {
+    options.compileThreads = threads;
+    llvm::SmallString<128> outputDir;
+    if (llvm::sys::fs::createUniqueDirectory("compile_threads", outputDir)) {
+      ADD_FAILURE() << "Cannot create the output directory";
+      return std::string();
+    }
+    mlir::concretelang::CompilerEngine compiler(
+        mlir::concretelang::CompilationContext::createShared());
+    compiler.setCompilationOptions(options);
+    auto library = compiler.compile({program}, outputDir.str().str());
+    std::string json;
+    if (library)
+      json = library->getProgramInfo().writeJsonToString().value();
+    else
+      ADD_FAILURE() << llvm::toString(library.takeError());
+    llvm::sys::fs::remove_directories(outputDir);
+    return json;
+  };
+  ASSERT_EQ(compileProgramInfo(1), compileProgramInfo(4));
+
+  options.compileThreads = 4;
+  TestProgram circuit(options);
+  ASSERT_OUTCOME_HAS_VALUE(circuit.compile(program));
+  ASSERT_OUTCOME_HAS_VALUE(circuit.generateKeyset());
+  auto call = [&](std::string name, Tensor<uint64_t> arg) {
+    return circuit.call({arg}, name).value()[0].getTensor<uint64_t>().value();
+  };
+  for (uint64_t x = 0; x < 8; x++) {
+    ASSERT_EQ(call("inc", Tensor<uint64_t>(x))[0], (x + 1) % 8);
+    ASSERT_EQ(call("dec", Tensor<uint64_t>(x))[0], (x + 7) % 8);
+    ASSERT_EQ(call("square", Tensor<uint64_t>(x))[0], (x * x) % 8);
+  }
+  Tensor<uint64_t> doubled =
+      call("double", Tensor<uint64_t>({0, 1, 2, 3}, {4}));
+  for (uint64_t i = 0; i < 4; i++)
+    ASSERT_EQ(doubled[i], (2 * i) % 8);
+}
+
+TEST(CompileAndRunManyLUT, many_lut_bootstrap) {
+  mlir::concretelang::CompilationOptions options;
+  options.maxManyLUTCount = 4;
+  TestProgram circuit(options);
+  ASSERT_OUTCOME_HAS_VALUE(circuit.compile(R"XXX(
+func.func @scalar(%arg0: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+  %lut2 = arith.constant dense<[0, 1, 0, 1]> : tensor<4xi64>
+  %lut3 = arith.constant dense<[1, 3, 0, 2]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut1) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %2 = "FHE.apply_lookup_table"(%arg0, %lut2) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  %3 = "FHE.apply_lookup_table"(%arg0, %lut3) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  return %0, %1, %2, %3 : !FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>, !FHE.eint<2>
+}
+func.func @tensor(%arg0: tensor<3x!FHE.eint<3>>) -> (tensor<3x!FHE.eint<3>>, tensor<3x!FHE.eint<3>>) {
+  %lut0 = arith.constant dense<[0, 2, 4, 6, 1, 3, 5, 7]> : tensor<8xi64>
+  %lut1 = arith.constant dense<[7, 6, 5, 4, 3, 2, 1, 0]> : tensor<8xi64>
+  %0 = "FHELinalg.apply_lookup_table"(%arg0, %lut0) : (tensor<3x!FHE.eint<3>>, tensor<8xi64>) -> tensor<3x!FHE.eint<3>>
+  %1 = "FHELinalg.apply_lookup_table"(%arg0, %lut1) : (tensor<3x!FHE.eint<3>>, tensor<8xi64>) -> tensor<3x!FHE.eint<3>>
+  return %0, %1 : tensor<3x!FHE.eint<3>>, tensor<3x!FHE.eint<3>>
+}
+)XXX"));
+  ASSERT_OUTCOME_HAS_VALUE(circuit.generateKeyset());
+
+  // Every sample extracted from the many-lut bootstraps holds the result of
+  // its own lookup table
+  std::vector<std::vector<uint64_t>> scalarLUTs = {
+      {0, 1, 2, 3}, {3, 2, 1, 0}, {0, 1, 0, 1}, {1, 3, 0, 2}};
+  for (uint64_t x = 0; x < 4; x++) {
+    auto res = circuit.call({Tensor<uint64_t>(x)}, "scalar").value();
+    ASSERT_EQ(res.size(), scalarLUTs.size());
+    for (size_t i = 0; i < scalarLUTs.size(); i++)
+      ASSERT_EQ(res[i].getTensor<uint64_t>().value()[0], scalarLUTs[i][x]);
+  }
+
+  std::vector<std::vector<uint64_t>> tensorLUTs = {{0, 2, 4, 6, 1, 3, 5, 7},
+                                                   {7, 6, 5, 4, 3, 2, 1, 0}};
+  for (uint64_t x = 0; x < 8; x += 3) {
+    Tensor<uint64_t> arg({x, (x + 1) % 8, (x + 2) % 8}, {3});
+    auto res = circuit.call({arg}, "tensor").value();
+    ASSERT_EQ(res.size(), tensorLUTs.size());
+    for (size_t i = 0; i < tensorLUTs.size(); i++) {
+      Tensor<uint64_t> out = res[i].getTensor<uint64_t>().value();
+      for (size_t j = 0; j < 3; j++)
+        ASSERT_EQ(out[j], tensorLUTs[i][arg[j]]);
+    }
+  }
+}
+
+TEST(CompileAndRunAsyncOffload, chained_lookup_tables) {
+  mlir::concretelang::CompilationOptions options;
+  options.asyncOffload = true;
+  TestProgram circuit(options);
+  ASSERT_OUTCOME_HAS_VALUE(circuit.compile(R"XXX(
+func.func @main(%arg0: tensor<4x!FHE.eint<4>>) -> (tensor<4x!FHE.eint<4>>, tensor<4x!FHE.eint<4>>) {
+  %lut0 = arith.constant dense<[7, 6, 5, 4, 3, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0]> : tensor<16xi64>
+  %lut1 = arith.constant dense<[0, 1, 4, 1, 0, 1, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0]> : tensor<16xi64>
+  %0 = "FHELinalg.apply_lookup_table"(%arg0, %lut0) : (tensor<4x!FHE.eint<4>>, tensor<16xi64>) -> tensor<4x!FHE.eint<4>>
+  %1 = "FHELinalg.apply_lookup_table"(%0, %lut1) : (tensor<4x!FHE.eint<4>>, tensor<16xi64>) -> tensor<4x!FHE.eint<4>>
+  %2 = "FHELinalg.add_eint"(%0, %1) : (tensor<4x!FHE.eint<4>>, tensor<4x!FHE.eint<4>>) -> tensor<4x!FHE.eint<4>>
+  return %1, %2 : tensor<4x!FHE.eint<4>>, tensor<4x!FHE.eint<4>>
+}
+)XXX"));
+  ASSERT_OUTCOME_HAS_VALUE(circuit.generateKeyset());
+
+  // The keyswitches and bootstraps issued asynchronously are awaited before
+  // their results are read, by the next lookup table and by the addition
+  for (uint64_t x = 0; x < 8; x += 4) {
+    Tensor<uint64_t> arg({x, x + 1, x + 2, x + 3}, {4});
+    auto res = circuit.call({arg}).value();
+    ASSERT_EQ(res.size(), (size_t)2);
+    Tensor<uint64_t> squared = res[0].getTensor<uint64_t>().value();
+    Tensor<uint64_t> sum = res[1].getTensor<uint64_t>().value();
+    for (size_t i = 0; i < 4; i++) {
+      uint64_t negated = 7 - arg[i];
+      ASSERT_EQ(squared[i], (negated * negated) % 8);
+      ASSERT_EQ(sum[i], negated + (negated * negated) % 8);
+    }
+  }
+}
+
+TEST(CompileAndRunAutoRounding, rounded_lookup_tables) {
+  mlir::concretelang::CompilationOptions options;
+  options.autoRounding = true;
+  TestProgram circuit(options);
+  ASSERT_OUTCOME_HAS_VALUE(circuit.compile(R"XXX(
+func.func @scalar(%arg0: !FHE.eint<4>) -> !FHE.eint<2> {
+  %lut = arith.constant dense<[0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3]> : tensor<16xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<2>
+  return %0 : !FHE.eint<2>
+}
+func.func @tensor(%arg0: tensor<4x!FHE.eint<4>>, %arg1: tensor<4x!FHE.eint<4>>) -> tensor<4x!FHE.eint<3>> {
+  %lut = arith.constant dense<[5, 5, 0, 0, 7, 7, 1, 1, 2, 2, 6, 6, 3, 3, 4, 4]> : tensor<16xi64>
+  %0 = "FHELinalg.add_eint"(%arg0, %arg1) : (tensor<4x!FHE.eint<4>>, tensor<4x!FHE.eint<4>>) -> tensor<4x!FHE.eint<4>>
+  %1 = "FHELinalg.apply_lookup_table"(%0, %lut) : (tensor<4x!FHE.eint<4>>, tensor<16xi64>) -> tensor<4x!FHE.eint<3>>
+  return %1 : tensor<4x!FHE.eint<3>>
+}
+)XXX"));
+  ASSERT_OUTCOME_HAS_VALUE(circuit.generateKeyset());
+
+  // The rounded lookup tables only read the highest bits of their inputs,
+  // which the rewrite keeps exact
+  for (uint64_t x = 0; x < 16; x++) {
+    auto res = circuit.call({Tensor<uint64_t>(x)}, "scalar").value();
+    ASSERT_EQ(res[0].getTensor<uint64_t>().value()[0], x / 4);
+  }
+
+  std::vector<uint64_t> lut = {5, 5, 0, 0, 7, 7, 1, 1, 2, 2, 6, 6, 3, 3, 4, 4};
+  for (uint64_t x = 0; x < 8; x += 2) {
+    Tensor<uint64_t> lhs({x, x + 1, x + 4, x + 7}, {4});
+    Tensor<uint64_t> rhs({x, 3, 1, 1}, {4});
+    auto res = circuit.call({lhs, rhs}, "tensor").value();
+    Tensor<uint64_t> out = res[0].getTensor<uint64_t>().value();
+    for (size_t i = 0; i < 4; i++)
+      ASSERT_EQ(out[i], lut[lhs[i] + rhs[i]]);
+  }
+}
+
 /// https://github.com/zama-ai/concrete-internal/issues/655
 TEST(CompileAndRun, compress_input_and_simulate) {
   mlir::concretelang::CompilationOptions options;
@@ -166,6 +166,9 @@ void registerEndToEnd(std::string suiteName, EndToEndDesc desc,
     options.compilationOptions.optimizerConfig.p_error = *desc.p_error;
     options.compilationOptions.optimizerConfig.global_p_error = NAN;
   }
+  if (desc.alwaysPackEncryptedMul) {
+    options.compilationOptions.alwaysPackEncryptedMul = true;
+  }
   auto i = 0;
   for (auto test : desc.tests) {
     auto valueName = std::to_string(i);
@@ -5,6 +5,7 @@ import tempfile
 
 from concrete.compiler import (
     ClientSupport,
+    CompilationOptions,
     EvaluationKeys,
     LibrarySupport,
     PublicArguments,
@@ -134,3 +135,34 @@ def test_client_server_end_to_end(mlir, args, expected_result, keyset_cache):
             client_parameters, keyset, result_deserialized
         )
         assert np.array_equal(output, expected_result)
+
+
+def test_client_server_prepared_compressed_keys(keyset_cache):
+    mlir = """
+func.func @main(%arg0: !FHE.eint<4>) -> !FHE.eint<4> {
+    %lut = arith.constant dense<[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]> : tensor<16xi64>
+    %0 = "FHE.apply_lookup_table"(%arg0, %lut): (!FHE.eint<4>, tensor<16xi64>) -> (!FHE.eint<4>)
+    return %0: !FHE.eint<4>
+}
+"""
+    with tempfile.TemporaryDirectory() as tmpdirname:
+        support = LibrarySupport.new(str(tmpdirname))
+        options = CompilationOptions.new()
+        options.set_compress_evaluation_keys(True)
+        compilation_result = support.compile(mlir, options)
+        server_lambda = support.load_server_lambda(compilation_result, False)
+
+        client_parameters = support.load_client_parameters(compilation_result)
+        keyset = ClientSupport.key_set(client_parameters, keyset_cache)
+
+        evaluation_keys = EvaluationKeys.deserialize(
+            keyset.get_evaluation_keys().serialize()
+        )
+        evaluation_keys.prepare(2)
+
+        # The prepared keys are reused by every call
+        for value in (3, 12):
+            args = ClientSupport.encrypt_arguments(client_parameters, keyset, (value,))
+            result = support.server_call(server_lambda, args, evaluation_keys)
+            output = ClientSupport.decrypt_result(client_parameters, keyset, result)
+            assert output == value
@@ -439,6 +439,36 @@ func.func @main(%arg0: !FHE.eint<16>) -> !FHE.eint<16> {
     ]
 
 
+def test_auto_rounding_feedback(keyset_cache):
+    mlir = """
+
+func.func @main(%arg0: !FHE.eint<4>) -> !FHE.eint<2> {
+    %tlu = arith.constant dense<[0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3]> : tensor<16xi64> loc("some/random/location.py":10:2)
+    %1 = "FHE.apply_lookup_table"(%arg0, %tlu): (!FHE.eint<4>, tensor<16xi64>) -> (!FHE.eint<2>) loc("some/random/location.py":10:2)
+    return %1: !FHE.eint<2>
+}
+
+    """
+
+    artifact_dir = "./py_test_auto_rounding_feedback"
+    engine = LibrarySupport.new(artifact_dir)
+    options = CompilationOptions.new()
+    options.set_auto_rounding(True)
+    compilation_result = engine.compile(mlir, options)
+
+    # The feedback is loaded from the json file emitted with the library
+    compilation_feedback = engine.load_compilation_feedback(compilation_result)
+    circuit_feedback = compilation_feedback.circuit_feedbacks[0]
+    assert circuit_feedback.auto_rounded_bits_per_location == {
+        'loc("some/random/location.py":10:2)': 2
+    }
+
+    for x in range(16):
+        assert_result(run(engine, (x,), compilation_result, keyset_cache), x // 4)
+
+    shutil.rmtree(artifact_dir)
+
+
 @pytest.mark.parametrize(
     "mlir, expected_memory_usage_per_loc",
     [
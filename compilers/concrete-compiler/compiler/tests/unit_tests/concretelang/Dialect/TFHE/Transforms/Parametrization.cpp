@@ -6,6 +6,7 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
@@ -17,8 +18,8 @@ std::string transform(std::string source,
                       concrete_optimizer::dag::CircuitSolution solution) {
   // Register dialect
   mlir::DialectRegistry registry;
-  registry
-      .insert<mlir::concretelang::TFHE::TFHEDialect, mlir::func::FuncDialect>();
+  registry.insert<mlir::concretelang::TFHE::TFHEDialect,
+                  mlir::func::FuncDialect, mlir::tensor::TensorDialect>();
   mlir::MLIRContext mlirContext;
   mlirContext.appendDialectRegistry(registry);
 
@@ -247,3 +248,27 @@ TEST(TFHECircuitParametrization, extra_conversion_key) {
   std::string output = transform(source, solution);
   ASSERT_EQ(output, expected);
 }
+
+// Test the propagation of a type to all operands of a
+// `tensor.from_elements` and to its result
+TEST(TFHECircuitParametrization, from_elements) {
+  std::string source = R"(
+  func.func @main(%arg0: !TFHE.glwe<sk?> {TFHE.OId = 0 : i32}, %arg1: !TFHE.glwe<sk?>, %arg2: !TFHE.glwe<sk?>) -> tensor<3x!TFHE.glwe<sk?>> {
+    %0 = tensor.from_elements %arg0, %arg1, %arg2 : tensor<3x!TFHE.glwe<sk?>>
+    return %0 : tensor<3x!TFHE.glwe<sk?>>
+  }
+)";
+  std::string expected = R"(module {
+  func.func @main(%arg0: !TFHE.glwe<sk<0,1,1024>>, %arg1: !TFHE.glwe<sk<0,1,1024>>, %arg2: !TFHE.glwe<sk<0,1,1024>>) -> tensor<3x!TFHE.glwe<sk<0,1,1024>>> {
+    %from_elements = tensor.from_elements %arg0, %arg1, %arg2 : tensor<3x!TFHE.glwe<sk<0,1,1024>>>
+    return %from_elements : tensor<3x!TFHE.glwe<sk<0,1,1024>>>
+  }
+}
+)";
+  concrete_optimizer::dag::CircuitSolution solution;
+  auto keyId = addSecretKey(solution, 1, 1024);
+  // %arg0
+  addInstructionKey(solution, keyId, keyId);
+  std::string output = transform(source, solution);
+  ASSERT_EQ(output, expected);
+}
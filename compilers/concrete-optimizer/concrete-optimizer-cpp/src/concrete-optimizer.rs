@@ -1,14 +1,18 @@
-use concrete_optimizer::computing_cost::cpu::CpuComplexity;
+use std::sync::Arc;
+
+use concrete_optimizer::computing_cost::complexity_model::ComplexityModel;
+use concrete_optimizer::computing_cost::cpu::{self, CalibratedCpuComplexity, LinearCost};
 use concrete_optimizer::config;
 use concrete_optimizer::config::ProcessingUnit;
 use concrete_optimizer::dag::operator::{
     self, FunctionTable, LevelledComplexity, OperatorIndex, Precision, Shape,
 };
 use concrete_optimizer::dag::unparametrized;
-use concrete_optimizer::optimization::config::{Config, SearchSpace};
+use concrete_optimizer::optimization::config::{Config, Objective, SearchSpace};
 use concrete_optimizer::optimization::dag::multi_parameters::keys_spec;
 use concrete_optimizer::optimization::dag::multi_parameters::keys_spec::CircuitSolution;
 use concrete_optimizer::optimization::dag::multi_parameters::partition_cut::PartitionCut;
+use concrete_optimizer::optimization::dag::multi_parameters::solution_cache;
 use concrete_optimizer::optimization::dag::solo_key::optimize_generic::{
     Encoding, Solution as DagSolution,
 };
@@ -37,19 +41,41 @@ fn caches_from(options: ffi::Options) -> decomposition::PersistDecompCaches {
         println!("optimizer: To clear the cache, remove directory {cache_dir}");
     }
     let processing_unit = processing_unit(options);
+    // The caches on disk are shared by all the hosts and contain the pareto
+    // fronts of the analytic model, they are not used with a calibrated model
+    let calibrated = options.cpu_calibration.calibrated;
     decomposition::cache(
         options.security_level,
         processing_unit,
-        Some(ProcessingUnit::Cpu.complexity_model()),
-        options.cache_on_disk,
+        Some(complexity_model(options)),
+        options.cache_on_disk && !calibrated,
         options.ciphertext_modulus_log,
         options.fft_precision,
     )
 }
 
+fn complexity_model(options: ffi::Options) -> Arc<dyn ComplexityModel> {
+    let calibration = options.cpu_calibration;
+    if !calibration.calibrated {
+        return ProcessingUnit::Cpu.complexity_model();
+    }
+    Arc::new(CalibratedCpuComplexity::new(cpu::CpuCalibration {
+        ks: LinearCost {
+            constant_ns: calibration.ks_constant_ns,
+            ns_per_op: calibration.ks_ns_per_op,
+        },
+        pbs: LinearCost {
+            constant_ns: calibration.pbs_constant_ns,
+            ns_per_op: calibration.pbs_ns_per_op,
+        },
+        levelled_ns_per_op: calibration.levelled_ns_per_op,
+    }))
+}
+
 fn optimize_bootstrap(precision: u64, noise_factor: f64, options: ffi::Options) -> ffi::Solution {
     // Support composable since there is no dag
     let processing_unit = processing_unit(options);
+    let complexity_model = complexity_model(options);
 
     let config = Config {
         security_level: options.security_level,
@@ -57,8 +83,9 @@ fn optimize_bootstrap(precision: u64, noise_factor: f64, options: ffi::Options)
         key_sharing: options.key_sharing,
         ciphertext_modulus_log: options.ciphertext_modulus_log,
         fft_precision: options.fft_precision,
-        complexity_model: &CpuComplexity::default(),
+        complexity_model: complexity_model.as_ref(),
         composable: options.composable,
+        objective: options.objective.into(),
     };
 
     let sum_size = 1;
@@ -314,6 +341,7 @@ fn convert_to_circuit_solution(sol: &ffi::DagSolution, dag: &OperationDag) -> ff
         instructions_keys,
         crt_decomposition: sol.crt_decomposition.clone(),
         complexity: sol.complexity,
+        critical_path_complexity: 0.0,
         p_error: sol.p_error,
         global_p_error: sol.global_p_error,
         is_feasible,
@@ -328,6 +356,7 @@ impl From<CircuitSolution> for ffi::CircuitSolution {
             instructions_keys: vec_into(v.instructions_keys),
             crt_decomposition: v.crt_decomposition,
             complexity: v.complexity,
+            critical_path_complexity: v.critical_path_complexity,
             p_error: v.p_error,
             global_p_error: v.global_p_error,
             is_feasible: v.is_feasible,
@@ -555,14 +584,16 @@ impl OperationDag {
 
     fn optimize(&self, options: ffi::Options) -> ffi::DagSolution {
         let processing_unit = processing_unit(options);
+        let complexity_model = complexity_model(options);
         let config = Config {
             security_level: options.security_level,
             maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
             key_sharing: options.key_sharing,
             ciphertext_modulus_log: options.ciphertext_modulus_log,
             fft_precision: options.fft_precision,
-            complexity_model: &CpuComplexity::default(),
+            complexity_model: complexity_model.as_ref(),
             composable: options.composable,
+            objective: options.objective.into(),
         };
 
         let search_space = SearchSpace::default(processing_unit);
@@ -609,14 +640,16 @@ impl OperationDag {
 
     fn optimize_multi(&self, options: ffi::Options) -> ffi::CircuitSolution {
         let processing_unit = processing_unit(options);
+        let complexity_model = complexity_model(options);
         let config = Config {
             security_level: options.security_level,
             maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
             key_sharing: options.key_sharing,
             ciphertext_modulus_log: options.ciphertext_modulus_log,
             fft_precision: options.fft_precision,
-            complexity_model: &CpuComplexity::default(),
+            complexity_model: complexity_model.as_ref(),
             composable: options.composable,
+            objective: options.objective.into(),
         };
         let search_space = SearchSpace::default(processing_unit);
 
@@ -628,16 +661,32 @@ impl OperationDag {
             }
             ffi::MultiParamStrategy::ByPrecision | _ => PartitionCut::for_each_precision(&self.0),
         };
-        let circuit_sol =
-            concrete_optimizer::optimization::dag::multi_parameters::optimize_generic::optimize(
-                &self.0,
-                config,
-                &search_space,
-                encoding,
-                options.default_log_norm2_woppbs,
-                &caches_from(options),
-                &Some(p_cut),
-            );
+        let p_cut = Some(p_cut);
+        // The solutions on disk assume the analytic model, like the decomposition caches
+        if !options.cache_on_disk || options.cpu_calibration.calibrated {
+            let circuit_sol =
+                concrete_optimizer::optimization::dag::multi_parameters::optimize_generic::optimize(
+                    &self.0,
+                    config,
+                    &search_space,
+                    encoding,
+                    options.default_log_norm2_woppbs,
+                    &caches_from(options),
+                    &p_cut,
+                );
+            return circuit_sol.into();
+        }
+        let circuit_sol = solution_cache::optimize(
+            solution_cache::cache(),
+            &self.0,
+            config,
+            processing_unit.br_to_string(),
+            &search_space,
+            encoding,
+            options.default_log_norm2_woppbs,
+            || caches_from(options),
+            &p_cut,
+        );
         circuit_sol.into()
     }
 }
@@ -677,6 +726,17 @@ impl Into<Encoding> for ffi::Encoding {
     }
 }
 
+#[allow(clippy::from_over_into)]
+impl Into<Objective> for ffi::Objective {
+    fn into(self) -> Objective {
+        match self {
+            Self::Complexity => Objective::Complexity,
+            Self::CriticalPath => Objective::CriticalPath,
+            _ => unreachable!("Internal error: Invalid objective"),
+        }
+    }
+}
+
 #[allow(unused_must_use)]
 #[cxx::bridge]
 mod ffi {
@@ -828,6 +888,24 @@ mod ffi {
         ByPrecisionAndNorm2,
     }
 
+    #[derive(Debug, Clone, Copy)]
+    #[namespace = "concrete_optimizer"]
+    pub enum Objective {
+        Complexity,
+        CriticalPath,
+    }
+
+    #[namespace = "concrete_optimizer"]
+    #[derive(Debug, Clone, Copy)]
+    pub struct CpuCalibration {
+        pub calibrated: bool,
+        pub ks_constant_ns: f64,
+        pub ks_ns_per_op: f64,
+        pub pbs_constant_ns: f64,
+        pub pbs_ns_per_op: f64,
+        pub levelled_ns_per_op: f64,
+    }
+
     #[namespace = "concrete_optimizer"]
     #[derive(Debug, Clone, Copy)]
     pub struct Options {
@@ -842,6 +920,8 @@ mod ffi {
         pub ciphertext_modulus_log: u32,
         pub fft_precision: u32,
         pub composable: bool,
+        pub cpu_calibration: CpuCalibration,
+        pub objective: Objective,
     }
 
     #[namespace = "concrete_optimizer::dag"]
@@ -946,6 +1026,7 @@ mod ffi {
         pub instructions_keys: Vec<InstructionKeys>,
         pub crt_decomposition: Vec<u64>,
         pub complexity: f64,
+        pub critical_path_complexity: f64,
         pub p_error: f64,
         pub global_p_error: f64,
         pub is_feasible: bool,
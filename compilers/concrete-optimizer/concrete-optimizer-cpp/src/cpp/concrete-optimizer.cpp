@@ -945,6 +945,8 @@ namespace concrete_optimizer {
   struct Weights;
   enum class Encoding : ::std::uint8_t;
   enum class MultiParamStrategy : ::std::uint8_t;
+  enum class Objective : ::std::uint8_t;
+  struct CpuCalibration;
   struct Options;
   namespace dag {
     struct OperatorIndex;
@@ -1081,6 +1083,28 @@ enum class MultiParamStrategy : ::std::uint8_t {
 };
 #endif // CXXBRIDGE1_ENUM_concrete_optimizer$MultiParamStrategy
 
+#ifndef CXXBRIDGE1_ENUM_concrete_optimizer$Objective
+#define CXXBRIDGE1_ENUM_concrete_optimizer$Objective
+enum class Objective : ::std::uint8_t {
+  Complexity = 0,
+  CriticalPath = 1,
+};
+#endif // CXXBRIDGE1_ENUM_concrete_optimizer$Objective
+
+#ifndef CXXBRIDGE1_STRUCT_concrete_optimizer$CpuCalibration
+#define CXXBRIDGE1_STRUCT_concrete_optimizer$CpuCalibration
+struct CpuCalibration final {
+  bool calibrated;
+  double ks_constant_ns;
+  double ks_ns_per_op;
+  double pbs_constant_ns;
+  double pbs_ns_per_op;
+  double levelled_ns_per_op;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_concrete_optimizer$CpuCalibration
+
 #ifndef CXXBRIDGE1_STRUCT_concrete_optimizer$Options
 #define CXXBRIDGE1_STRUCT_concrete_optimizer$Options
 struct Options final {
@@ -1095,6 +1119,8 @@ struct Options final {
   ::std::uint32_t ciphertext_modulus_log;
   ::std::uint32_t fft_precision;
   bool composable;
+  ::concrete_optimizer::CpuCalibration cpu_calibration;
+  ::concrete_optimizer::Objective objective;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -1237,6 +1263,7 @@ struct CircuitSolution final {
   ::rust::Vec<::concrete_optimizer::dag::InstructionKeys> instructions_keys;
   ::rust::Vec<::std::uint64_t> crt_decomposition;
   double complexity;
+  double critical_path_complexity;
   double p_error;
   double global_p_error;
   bool is_feasible;
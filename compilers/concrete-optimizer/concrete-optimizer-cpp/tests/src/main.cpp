@@ -30,7 +30,9 @@ concrete_optimizer::Options default_options() {
       .cache_on_disk = true,
       .ciphertext_modulus_log = CIPHERTEXT_MODULUS_LOG,
       .fft_precision = 53,
-      .composable = false
+      .composable = false,
+      .cpu_calibration = concrete_optimizer::CpuCalibration{},
+      .objective = concrete_optimizer::Objective::Complexity
   };
 }
 
@@ -0,0 +1,69 @@
+use concrete_optimizer::computing_cost::cpu::CpuComplexity;
+use concrete_optimizer::config::ProcessingUnit;
+use concrete_optimizer::dag::operator::{FunctionTable, Precision, Shape};
+use concrete_optimizer::dag::unparametrized::OperationDag;
+use concrete_optimizer::optimization::config::{Config, Objective, SearchSpace};
+use concrete_optimizer::optimization::dag::multi_parameters::optimize::optimize_to_circuit_solution;
+use concrete_optimizer::optimization::dag::multi_parameters::partition_cut::PartitionCut;
+use concrete_optimizer::optimization::decomposition;
+use criterion::{black_box, criterion_group, criterion_main, Criterion};
+
+const _4_SIGMA: f64 = 0.000_063_342_483_999_973;
+
+// Layers of lookup tables of each precision, with a dot product between them
+fn multi_partition_dag(precisions: &[Precision], size: u64, layers: usize) -> OperationDag {
+    let mut dag = OperationDag::new();
+    let mut previous = dag.add_input(precisions[0], Shape::vector(size));
+    for _ in 0..layers {
+        for &precision in precisions {
+            let lut = dag.add_lut(previous, FunctionTable::UNKWOWN, precision);
+            previous = dag.add_dot([lut, previous], [2, 1]);
+        }
+    }
+    dag
+}
+
+fn bench_multi_partition(c: &mut Criterion, name: &str, precisions: &[Precision]) {
+    let complexity_model = CpuComplexity::default();
+    let config = Config {
+        security_level: 128,
+        maximum_acceptable_error_probability: _4_SIGMA,
+        key_sharing: true,
+        ciphertext_modulus_log: 64,
+        fft_precision: 53,
+        complexity_model: &complexity_model,
+        composable: false,
+        objective: Objective::Complexity,
+    };
+    let search_space = SearchSpace::default_cpu();
+    let caches = decomposition::cache(128, ProcessingUnit::Cpu, None, true, 64, 53);
+    let dag = multi_partition_dag(precisions, 1024, 4);
+    let p_cut = Some(PartitionCut::for_each_precision(&dag));
+
+    c.bench_function(name, |b| {
+        b.iter(|| {
+            black_box(optimize_to_circuit_solution(
+                &dag,
+                config,
+                &search_space,
+                &caches,
+                &p_cut,
+            ))
+        });
+    });
+}
+
+fn multi_parameters_4_partitions(c: &mut Criterion) {
+    bench_multi_partition(c, "multi parameters 4 partitions", &[2, 4, 6, 8]);
+}
+
+fn multi_parameters_6_partitions(c: &mut Criterion) {
+    bench_multi_partition(c, "multi parameters 6 partitions", &[3, 4, 5, 6, 7, 8]);
+}
+
+criterion_group!(
+    benches,
+    multi_parameters_4_partitions,
+    multi_parameters_6_partitions
+);
+criterion_main!(benches);
@@ -4,6 +4,7 @@ use super::operators::keyswitch_lwe::KsComplexity;
 use super::operators::{keyswitch_lwe, multi_bit_pbs, pbs};
 use crate::computing_cost::operators::multi_bit_pbs::MultiBitPbsComplexity;
 use crate::parameters::{CmuxParameters, KeyswitchParameters, LweDimension, PbsParameters};
+use crate::utils::square;
 
 #[derive(Clone)]
 pub struct CpuComplexity {
@@ -64,3 +65,160 @@ impl Default for CpuComplexity {
         }
     }
 }
+
+/// Cost `constant_ns + ns_per_op * complexity`, in nanoseconds, of an operator
+/// of a given analytic complexity, fitted on measurements of the host.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct LinearCost {
+    pub constant_ns: f64,
+    pub ns_per_op: f64,
+}
+
+impl LinearCost {
+    pub fn cost(&self, complexity: Complexity) -> Complexity {
+        self.constant_ns + self.ns_per_op * complexity
+    }
+
+    /// Least squares fit of `(complexity, time_ns)` samples. Falls back to a
+    /// fit without constant when the samples do not give a positive slope and
+    /// constant, e.g. with a single sample or noisy measurements.
+    pub fn fit(samples: &[(Complexity, f64)]) -> Self {
+        assert!(!samples.is_empty());
+        let n = samples.len() as f64;
+        let mean_x = samples.iter().map(|(x, _)| x).sum::<f64>() / n;
+        let mean_y = samples.iter().map(|(_, y)| y).sum::<f64>() / n;
+        let var_x: f64 = samples.iter().map(|(x, _)| square(x - mean_x)).sum();
+        let cov_xy: f64 = samples
+            .iter()
+            .map(|(x, y)| (x - mean_x) * (y - mean_y))
+            .sum();
+
+        if var_x > 0.0 {
+            let ns_per_op = cov_xy / var_x;
+            let constant_ns = mean_y - ns_per_op * mean_x;
+            if ns_per_op > 0.0 && constant_ns >= 0.0 {
+                return Self {
+                    constant_ns,
+                    ns_per_op,
+                };
+            }
+        }
+
+        let sum_xy: f64 = samples.iter().map(|(x, y)| x * y).sum();
+        let sum_xx: f64 = samples.iter().map(|(x, _)| x * x).sum();
+        Self {
+            constant_ns: 0.0,
+            ns_per_op: sum_xy / sum_xx,
+        }
+    }
+}
+
+/// Measured costs of the cpu operators on a given host, as produced by the
+/// `cpu-calibration` tool.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct CpuCalibration {
+    pub ks: LinearCost,
+    pub pbs: LinearCost,
+    pub levelled_ns_per_op: f64,
+}
+
+/// Cpu complexity model scaled by the costs measured on the host, so that the
+/// optimizer minimizes the expected execution time in nanoseconds instead of
+/// the number of operations. The keyswitch to bootstrap cost ratio, which
+/// depends on the vector units and the memory bandwidth of the host, is then
+/// the measured one.
+#[derive(Clone)]
+pub struct CalibratedCpuComplexity {
+    pub model: CpuComplexity,
+    pub calibration: CpuCalibration,
+}
+
+impl CalibratedCpuComplexity {
+    pub fn new(calibration: CpuCalibration) -> Self {
+        Self {
+            model: CpuComplexity::default(),
+            calibration,
+        }
+    }
+}
+
+impl ComplexityModel for CalibratedCpuComplexity {
+    fn pbs_complexity(&self, params: PbsParameters, ciphertext_modulus_log: u32) -> Complexity {
+        self.calibration
+            .pbs
+            .cost(self.model.pbs_complexity(params, ciphertext_modulus_log))
+    }
+
+    fn multi_bit_pbs_complexity(
+        &self,
+        params: PbsParameters,
+        ciphertext_modulus_log: u32,
+        grouping_factor: u32,
+        jit_fft: bool,
+    ) -> Complexity {
+        self.calibration
+            .pbs
+            .cost(self.model.multi_bit_pbs_complexity(
+                params,
+                ciphertext_modulus_log,
+                grouping_factor,
+                jit_fft,
+            ))
+    }
+
+    fn cmux_complexity(&self, params: CmuxParameters, ciphertext_modulus_log: u32) -> Complexity {
+        // A cmux is a fraction of a bootstrap, without its fixed cost
+        self.calibration.pbs.ns_per_op * self.model.cmux_complexity(params, ciphertext_modulus_log)
+    }
+
+    fn ks_complexity(
+        &self,
+        params: KeyswitchParameters,
+        ciphertext_modulus_log: u32,
+    ) -> Complexity {
+        self.calibration
+            .ks
+            .cost(self.model.ks_complexity(params, ciphertext_modulus_log))
+    }
+
+    fn fft_complexity(&self, glwe_polynomial_size: f64, ciphertext_modulus_log: u32) -> Complexity {
+        self.calibration.pbs.ns_per_op
+            * self
+                .model
+                .fft_complexity(glwe_polynomial_size, ciphertext_modulus_log)
+    }
+
+    fn levelled_complexity(
+        &self,
+        sum_size: u64,
+        lwe_dimension: LweDimension,
+        ciphertext_modulus_log: u32,
+    ) -> Complexity {
+        self.calibration.levelled_ns_per_op
+            * self
+                .model
+                .levelled_complexity(sum_size, lwe_dimension, ciphertext_modulus_log)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn fit_linear_cost() {
+        let samples = [(1.0, 12.0), (2.0, 14.0), (4.0, 18.0)];
+        let cost = LinearCost::fit(&samples);
+        approx::assert_relative_eq!(cost.constant_ns, 10.0, epsilon = 1e-9);
+        approx::assert_relative_eq!(cost.ns_per_op, 2.0, epsilon = 1e-9);
+    }
+
+    #[test]
+    fn fit_linear_cost_without_constant() {
+        // A negative constant is not physical, the fit goes through zero
+        let samples = [(1.0, 1.0), (2.0, 4.0), (3.0, 7.0)];
+        let cost = LinearCost::fit(&samples);
+        approx::assert_relative_eq!(cost.constant_ns, 0.0);
+        approx::assert_relative_eq!(cost.ns_per_op, 30.0 / 14.0, epsilon = 1e-9);
+    }
+}
@@ -10,6 +10,19 @@ pub struct NoiseBoundConfig {
     pub ciphertext_modulus_log: u32,
 }
 
+/// What the optimizer minimizes among the parameters meeting the error
+/// probability.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum Objective {
+    /// The cost of all the operations of the circuit, i.e. its throughput on
+    /// a single core.
+    #[default]
+    Complexity,
+    /// The cost of the longest chain of dependent lookup tables, i.e. the
+    /// latency of the circuit when independent operations run in parallel.
+    CriticalPath,
+}
+
 #[derive(Clone, Copy)]
 pub struct Config<'a> {
     pub security_level: u64,
@@ -19,6 +32,7 @@ pub struct Config<'a> {
     pub fft_precision: u32,
     pub complexity_model: &'a dyn ComplexityModel,
     pub composable: bool,
+    pub objective: Objective,
 }
 
 #[derive(Clone, Debug)]
@@ -41,6 +41,8 @@ pub struct AnalyzedDag {
     pub undominated_variance_constraints: Vec<VarianceConstraint>,
     pub operations_count_per_instrs: Vec<OperationsCount>,
     pub operations_count: OperationsCount,
+    // Operations of the longest chain of dependent luts
+    pub critical_path_operations_count: OperationsCount,
     pub instruction_rewrite_index: Vec<Vec<OperatorIndex>>,
     pub p_cut: PartitionCut,
 }
@@ -94,6 +96,8 @@ pub fn analyze(
     let operations_count_per_instrs =
         collect_operations_count(&dag, nb_partitions, &instrs_partition);
     let operations_count = sum_operations_count(&operations_count_per_instrs);
+    let critical_path_operations_count =
+        critical_path_operations_count(&dag, nb_partitions, &operations_count_per_instrs);
     Ok(AnalyzedDag {
         operators: dag.operators,
         instruction_rewrite_index,
@@ -105,6 +109,7 @@ pub fn analyze(
         undominated_variance_constraints,
         operations_count_per_instrs,
         operations_count,
+        critical_path_operations_count,
         p_cut,
     })
 }
@@ -436,6 +441,39 @@ fn sum_operations_count(all_counts: &[OperationsCount]) -> OperationsCount {
     OperationsCount { counts: sum_counts }
 }
 
+// Operations of the longest chain of dependent luts. The elements of a tensor
+// are computed in parallel, so each lut of the chain counts once whatever its
+// shape. Chains are compared by their number of luts.
+fn critical_path_operations_count(
+    dag: &unparametrized::OperationDag,
+    nb_partitions: usize,
+    operations_count_per_instrs: &[OperationsCount],
+) -> OperationsCount {
+    let mut depths: Vec<usize> = Vec::with_capacity(dag.operators.len());
+    let mut paths: Vec<OperationsValue> = Vec::with_capacity(dag.operators.len());
+    for (i, op) in dag.operators.iter().enumerate() {
+        let deepest_input = op.get_inputs_iter().max_by_key(|input| depths[input.i]);
+        let (mut depth, mut path) = match deepest_input {
+            Some(input) => (depths[input.i], paths[input.i].clone()),
+            None => (0, OperationsValue::zero(nb_partitions)),
+        };
+        if let Op::Lut { input, .. } = op {
+            let nb_lut = dag.out_shapes[input.i].flat_size() as f64;
+            depth += 1;
+            path += operations_count_per_instrs[i].counts.clone() * (1.0 / nb_lut);
+        }
+        depths.push(depth);
+        paths.push(path);
+    }
+    let deepest = (0..depths.len()).max_by_key(|&i| depths[i]);
+    OperationsCount {
+        counts: deepest.map_or_else(
+            || OperationsValue::zero(nb_partitions),
+            |deepest| paths.swap_remove(deepest),
+        ),
+    }
+}
+
 #[cfg(test)]
 pub mod tests {
     use super::*;
@@ -695,6 +733,39 @@ pub mod tests {
         assert!(dag.nb_partitions == 1);
     }
 
+    #[allow(clippy::float_cmp)]
+    #[test]
+    fn test_critical_path() {
+        let mut dag = unparametrized::OperationDag::new();
+        let input1 = dag.add_input(8, Shape::vector(10));
+        let lut1 = dag.add_lut(input1, FunctionTable::UNKWOWN, 8);
+        let _lut2 = dag.add_lut(lut1, FunctionTable::UNKWOWN, 8);
+        let input2 = dag.add_input(8, Shape::number());
+        let _lut3 = dag.add_lut(input2, FunctionTable::UNKWOWN, 8);
+        dag.detect_outputs();
+        let dag = analyze(&dag);
+        assert!(dag.nb_partitions == 1);
+        let index = &dag.operations_count.counts.index;
+        let total = &dag.operations_count.counts;
+        let critical_path = &dag.critical_path_operations_count.counts;
+        assert_eq!(total[index.pbs(0)], 21.0);
+        assert_eq!(total[index.keyswitch_to_small(0, 0)], 21.0);
+        assert_eq!(critical_path[index.pbs(0)], 2.0);
+        assert_eq!(critical_path[index.keyswitch_to_small(0, 0)], 2.0);
+    }
+
+    #[allow(clippy::float_cmp)]
+    #[test]
+    fn test_critical_path_of_empty_dag() {
+        let dag = unparametrized::OperationDag::new();
+        let critical_path = critical_path_operations_count(&dag, 1, &[]);
+        assert!(critical_path
+            .counts
+            .values
+            .iter()
+            .all(|&count| count == 0.0));
+    }
+
     fn nan_symbolic_variance(sb: &SymbolicVariance) -> bool {
         sb.coeffs[0].is_nan()
     }
@@ -1,3 +1,4 @@
+use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 
 use crate::optimization::{atomic_pattern, wop_atomic_pattern};
@@ -15,7 +16,7 @@ pub type CircuitBoostrapKeyId = Id;
 pub type PrivateFunctionalPackingBoostrapKeyId = Id;
 pub const NO_KEY_ID: Id = Id::MAX;
 
-#[derive(Debug, Clone, PartialEq, Eq)]
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
 pub struct SecretLweKey {
     /* Big and small secret keys */
     pub identifier: SecretLweKeyId,
@@ -24,7 +25,7 @@ pub struct SecretLweKey {
     pub description: String,
 }
 
-#[derive(Debug, Clone, PartialEq, Eq)]
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
 pub struct BootstrapKey {
     /* Public TLU bootstrap keys */
     pub identifier: BootstrapKeyId,
@@ -34,7 +35,7 @@ pub struct BootstrapKey {
     pub description: String,
 }
 
-#[derive(Debug, Clone, PartialEq, Eq)]
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
 pub struct KeySwitchKey {
     /* Public TLU keyswitch keys */
     pub identifier: KeySwitchKeyId,
@@ -44,7 +45,7 @@ pub struct KeySwitchKey {
     pub description: String,
 }
 
-#[derive(Debug, Clone, PartialEq, Eq)]
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
 pub struct ConversionKeySwitchKey {
     /* Public conversion to make compatible ciphertext with incompatible keys.
     It's currently only between two big secret keys. */
@@ -56,7 +57,7 @@ pub struct ConversionKeySwitchKey {
     pub description: String,
 }
 
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct CircuitBoostrapKey {
     pub identifier: ConversionKeySwitchKeyId,
     pub representation_key: SecretLweKey,
@@ -64,7 +65,7 @@ pub struct CircuitBoostrapKey {
     pub description: String,
 }
 
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct PrivateFunctionalPackingBoostrapKey {
     pub identifier: PrivateFunctionalPackingBoostrapKeyId,
     pub representation_key: SecretLweKey,
@@ -72,7 +73,7 @@ pub struct PrivateFunctionalPackingBoostrapKey {
     pub description: String,
 }
 
-#[derive(Debug, Default, Clone)]
+#[derive(Debug, Default, Clone, Serialize, Deserialize)]
 pub struct CircuitKeys {
     /* All keys used in a circuit, sorted by Id for each key type */
     pub secret_keys: Vec<SecretLweKey>,
@@ -83,7 +84,7 @@ pub struct CircuitKeys {
     pub private_functional_packing_keys: Vec<PrivateFunctionalPackingBoostrapKey>,
 }
 
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct InstructionKeys {
     /* Describe for each instructions what is the key of inputs/outputs.
        For tlus, it gives the internal keyswitch/pbs keys.
@@ -98,7 +99,7 @@ pub struct InstructionKeys {
     pub extra_conversion_keys: Vec<ConversionKeySwitchKeyId>,
 }
 
-#[derive(Debug, Default, Clone)]
+#[derive(Debug, Default, Clone, Serialize, Deserialize)]
 pub struct CircuitSolution {
     pub circuit_keys: CircuitKeys,
     /* instructions keys ordered by instructions index of the original dag original (i.e. in same order):
@@ -110,6 +111,8 @@ pub struct CircuitSolution {
     pub instructions_keys: Vec<InstructionKeys>,
     /* complexity of the full circuit */
     pub complexity: f64,
+    /* complexity of the longest chain of dependent luts, 0 if not estimated */
+    pub critical_path_complexity: f64,
     /* highest p_error attained in a TLU */
     pub p_error: f64,
     /* result error rate, assuming any error will propagate to the result */
@@ -211,6 +214,7 @@ impl CircuitSolution {
             circuit_keys,
             instructions_keys,
             complexity: sol.complexity,
+            critical_path_complexity: 0.0,
             p_error: sol.p_error,
             global_p_error: sol.p_error,
             crt_decomposition: sol.crt_decomposition,
@@ -256,6 +260,7 @@ impl CircuitSolution {
                 instructions_keys: vec![instruction_keys; nb_instr],
                 crt_decomposition: vec![],
                 complexity: sol.complexity,
+                critical_path_complexity: 0.0,
                 p_error: sol.p_error,
                 global_p_error: sol.global_p_error,
                 is_feasible,
@@ -311,6 +316,7 @@ impl CircuitSolution {
             instructions_keys,
             crt_decomposition: vec![],
             complexity: sol.complexity,
+            critical_path_complexity: 0.0,
             p_error: sol.p_error,
             global_p_error: sol.global_p_error,
             is_feasible,
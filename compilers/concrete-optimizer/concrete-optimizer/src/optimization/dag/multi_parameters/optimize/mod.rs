@@ -4,7 +4,7 @@ use concrete_cpu_noise_model::gaussian_noise::noise::modulus_switching::estimate
 use crate::dag::unparametrized;
 use crate::noise_estimator::error;
 use crate::optimization;
-use crate::optimization::config::{Config, NoiseBoundConfig, SearchSpace};
+use crate::optimization::config::{Config, NoiseBoundConfig, Objective, SearchSpace};
 use crate::optimization::dag::multi_parameters::analyze::{analyze, AnalyzedDag};
 use crate::optimization::dag::multi_parameters::fast_keyswitch;
 use crate::optimization::dag::multi_parameters::fast_keyswitch::FksComplexityNoise;
@@ -16,7 +16,7 @@ use crate::optimization::decomposition::keyswitch::KsComplexityNoise;
 use crate::optimization::decomposition::{cmux, keyswitch, DecompCaches, PersistDecompCaches};
 use crate::parameters::GlweParameters;
 
-use crate::optimization::dag::multi_parameters::complexity::Complexity;
+use crate::optimization::dag::multi_parameters::complexity::{Complexity, OperationsCount};
 use crate::optimization::dag::multi_parameters::feasible::Feasible;
 use crate::optimization::dag::multi_parameters::partition_cut::PartitionCut;
 use crate::optimization::dag::multi_parameters::partitions::PartitionIndex;
@@ -25,8 +25,16 @@ use crate::optimization::Err::{NoParametersFound, NotComposable};
 
 use super::keys_spec::InstructionKeys;
 
+use rayon::prelude::*;
+use std::sync::Mutex;
+
 const DEBUG: bool = false;
 
+// Weight of the whole dag complexity in the critical path objective. The
+// operations off the critical path would otherwise cost nothing, and their
+// parameters would only be chosen by the error probability.
+const CRITICAL_PATH_TOTAL_WEIGHT: f64 = 1e-6;
+
 #[derive(Debug, Clone)]
 pub struct MicroParameters {
     pub pbs: Vec<Option<CmuxComplexityNoise>>,
@@ -614,8 +622,316 @@ fn fks_to_optimize(
 // In case fast ks are not used
 pub const REAL_FAST_KS: bool = false;
 
-#[allow(clippy::cognitive_complexity)]
-#[allow(clippy::too_many_lines)]
+// Ephemeral caches of the workers evaluating macro parameters concurrently,
+// each cache being used by a single worker at a time
+struct CachesPool<'a> {
+    persistent_caches: &'a PersistDecompCaches,
+    caches: Mutex<Vec<DecompCaches>>,
+}
+
+impl<'a> CachesPool<'a> {
+    fn new(persistent_caches: &'a PersistDecompCaches) -> Self {
+        Self {
+            persistent_caches,
+            caches: Mutex::new(vec![]),
+        }
+    }
+
+    fn with<R>(&self, f: impl FnOnce(&mut DecompCaches) -> R) -> R {
+        let caches = self.caches.lock().unwrap().pop();
+        let mut caches = caches.unwrap_or_else(|| self.persistent_caches.caches());
+        let result = f(&mut caches);
+        self.caches.lock().unwrap().push(caches);
+        result
+    }
+
+    fn backport(self) {
+        for caches in self.caches.into_inner().unwrap() {
+            self.persistent_caches.backport(caches);
+        }
+    }
+}
+
+#[derive(Clone, Copy)]
+struct MacroCandidate {
+    glwe_index: usize,
+    glwe_params: GlweParameters,
+    input_variance: f64,
+    internal_dim: u64,
+}
+
+// The state of the macro parameters search deciding the outcome of a candidate
+#[derive(Clone, Copy)]
+struct MacroSearchBounds {
+    is_feasible: bool,
+    best_complexity: f64,
+    best_p_error: f64,
+    best_partition_p_error: f64,
+}
+
+enum MacroOutcome {
+    // The next internal dimensions of the same glwe parameters are cut
+    Break,
+    Skip,
+    LowerBound {
+        parameters: Parameters,
+        partition_p_error: f64,
+    },
+    Best {
+        parameters: Parameters,
+        lb_message: Option<&'static str>,
+    },
+}
+
+struct MacroSearch<'a> {
+    security_level: u64,
+    ciphertext_modulus_log: u32,
+    fft_precision: u32,
+    partition: PartitionIndex,
+    used_tlu_keyswitch: &'a [Vec<bool>],
+    used_conversion_keyswitch: &'a [Vec<bool>],
+    feasible: &'a Feasible,
+    partition_feasible: Feasible,
+    complexity: &'a Complexity,
+    init_parameters: &'a Parameters,
+    fks_to_optimize: Vec<Option<FksSrc>>,
+    operations: OperationsCV,
+}
+
+impl MacroSearch<'_> {
+    #[allow(clippy::too_many_lines)]
+    fn evaluate(
+        &self,
+        bounds: &MacroSearchBounds,
+        caches: &mut DecompCaches,
+        candidate: &MacroCandidate,
+    ) -> MacroOutcome {
+        let ciphertext_modulus_log = self.ciphertext_modulus_log;
+        let fft_precision = self.fft_precision;
+        let partition = self.partition;
+        let feasible = self.feasible;
+        let complexity = self.complexity;
+        let init_parameters = self.init_parameters;
+        let used_conversion_keyswitch = self.used_conversion_keyswitch;
+        let nb_partitions = init_parameters.macro_params.len();
+        let glwe_params = candidate.glwe_params;
+        let internal_dim = candidate.internal_dim;
+
+        let mut operations = self.operations.clone();
+        // OPT: fast linear noise_modulus_switching
+        let variance_modulus_switching = estimate_modulus_switching_noise_with_binary_key(
+            internal_dim,
+            glwe_params.log2_polynomial_size,
+            ciphertext_modulus_log,
+        );
+
+        let macro_param_partition = MacroParameters {
+            glwe_params,
+            internal_dim,
+        };
+
+        // Heuristic to fill missing macro parameters
+        let macros: Vec<_> = (0..nb_partitions)
+            .map(|i| {
+                if i == partition {
+                    macro_param_partition
+                } else {
+                    init_parameters.macro_params[i].unwrap_or(macro_param_partition)
+                }
+            })
+            .collect();
+
+        // OPT: could be done once and than partially updated
+        apply_partitions_input_and_modulus_variance_and_cost(
+            ciphertext_modulus_log,
+            self.security_level,
+            nb_partitions,
+            &macros,
+            partition,
+            candidate.input_variance,
+            variance_modulus_switching,
+            &mut operations,
+        );
+
+        if bounds.is_feasible && !feasible.feasible(&operations.variance) {
+            // noise_modulus_switching is increasing with internal_dim so we can cut
+            // but as long as nothing feasible as been found we don't break to improve feasibility
+            return MacroOutcome::Break;
+        }
+
+        if complexity.complexity(&operations.cost) > bounds.best_complexity {
+            return MacroOutcome::Skip;
+        }
+
+        // setting already chosen pbs and lower bounds
+        // OPT: could be done once and than partially updated
+        apply_pbs_variance_and_cost_or_lower_bounds(
+            &mut caches.cmux,
+            &macros,
+            &init_parameters.micro_params.pbs,
+            partition,
+            &mut operations,
+        );
+
+        // OPT: could be done once and than partially updated
+        apply_all_ks_lower_bound(
+            &mut caches.keyswitch,
+            nb_partitions,
+            &macros,
+            self.used_tlu_keyswitch,
+            &mut operations,
+        );
+        // OPT: could be done once and than partially updated
+        apply_fks_variance_and_cost_or_lower_bound(
+            &mut caches.keyswitch,
+            nb_partitions,
+            &macros,
+            &init_parameters.micro_params.fks,
+            &self.fks_to_optimize,
+            used_conversion_keyswitch,
+            &mut operations,
+            ciphertext_modulus_log,
+            fft_precision,
+        );
+
+        let non_feasible = !feasible.feasible(&operations.variance);
+        if bounds.is_feasible && non_feasible {
+            return MacroOutcome::Skip;
+        }
+
+        if complexity.complexity(&operations.cost) > bounds.best_complexity {
+            return MacroOutcome::Skip;
+        }
+
+        let cmux_pareto = caches.cmux.pareto_quantities(glwe_params);
+
+        if non_feasible {
+            // here we optimize for feasibility only
+            // if nothing is feasible, it will give improves feasability for later iterations
+            let mut macro_params = init_parameters.macro_params.clone();
+            macro_params[partition] = Some(MacroParameters {
+                glwe_params,
+                internal_dim,
+            });
+            // optimize the feasibility only, takes all lower bounds on variance
+            // this selects both macro parameters and pbs (lowest variance) for this partition
+            let complexity = f64::INFINITY;
+            let cmux_params = cmux::lowest_noise(cmux_pareto);
+            let partition_p_error = self.partition_feasible.p_error(&operations.variance);
+            if partition_p_error >= bounds.best_partition_p_error {
+                return MacroOutcome::Skip;
+            }
+            let p_error = feasible.p_error(&operations.variance);
+            let global_p_error = feasible.global_p_error(&operations.variance);
+            let mut pbs = init_parameters.micro_params.pbs.clone();
+            pbs[partition] = Some(cmux_params);
+            let micro_params = MicroParameters {
+                pbs,
+                ks: vec![vec![None; nb_partitions]; nb_partitions],
+                fks: vec![vec![None; nb_partitions]; nb_partitions],
+            };
+            return MacroOutcome::LowerBound {
+                parameters: Parameters {
+                    p_error,
+                    global_p_error,
+                    complexity,
+                    micro_params,
+                    macro_params,
+                    is_lower_bound: true,
+                    is_feasible: false,
+                },
+                partition_p_error,
+            };
+        }
+
+        let micro_opt = optimize_1_cmux_and_dst_exclusive_fks_subset_and_all_ks(
+            partition,
+            &macros,
+            internal_dim,
+            cmux_pareto,
+            &self.fks_to_optimize,
+            self.used_tlu_keyswitch,
+            &operations,
+            feasible,
+            complexity,
+            &mut caches.keyswitch,
+            bounds.best_complexity,
+            bounds.best_p_error,
+            ciphertext_modulus_log,
+            fft_precision,
+        );
+        if micro_opt.is_none() {
+            // the macro parameters are feasible
+            // but the complexity is not good enough due to previous feasible solution
+            assert!(bounds.is_feasible);
+            return MacroOutcome::Skip;
+        }
+        let some_micro_params = micro_opt.unwrap();
+        // erase macros and all fks that can't be real
+        // set global is_lower_bound here, if any parameter is missing this is lower bound
+        // optimize_micro has already checked for best-ness
+        let mut lb_message = None;
+        let mut macro_params = init_parameters.macro_params.clone();
+        macro_params[partition] = Some(macro_param_partition);
+        let mut is_lower_bound = macro_params.iter().any(Option::is_none);
+        if is_lower_bound {
+            lb_message = Some("is_lower_bound due to missing macro parameter");
+        }
+        // copy back pbs from other partition
+        let mut all_pbs = init_parameters.micro_params.pbs.clone();
+        all_pbs[partition] = Some(some_micro_params.pbs);
+        let mut all_fks = init_parameters.micro_params.fks.clone();
+        for (dst_partition, maybe_fks) in self.fks_to_optimize.iter().enumerate() {
+            if let &Some(src_partition) = maybe_fks {
+                all_fks[src_partition][dst_partition] =
+                    some_micro_params.fks[src_partition][dst_partition];
+                assert!(used_conversion_keyswitch[src_partition][dst_partition]);
+                assert!(all_fks[src_partition][dst_partition].is_some());
+            }
+        }
+        // As all fks cannot be re-optimized in some case, we need to check previous ones are still valid.
+        for (src_partition, dst_partition) in cross_partition(nb_partitions) {
+            if !used_conversion_keyswitch[src_partition][dst_partition] {
+                continue;
+            }
+            let fks = &all_fks[src_partition][dst_partition];
+            if !is_lower_bound && fks.is_none() {
+                lb_message = Some("is_lower_bound due to missing fast keyswitch parameter");
+                is_lower_bound = true;
+            }
+            let src_glwe_param = macro_params[src_partition].map(|p| p.glwe_params);
+            let dst_glwe_param = macro_params[dst_partition].map(|p| p.glwe_params);
+            let src_glwe_param_stable = src_glwe_param == fks.map(|p| p.src_glwe_param);
+            let dst_glwe_param_stable = dst_glwe_param == fks.map(|p| p.dst_glwe_param);
+            if src_glwe_param_stable && dst_glwe_param_stable {
+                continue;
+            }
+            if !is_lower_bound {
+                lb_message = Some("is_lower_bound due to changing others fks macro param");
+            }
+            all_fks[src_partition][dst_partition] = None;
+            is_lower_bound = true;
+        }
+        let micro_params = MicroParameters {
+            pbs: all_pbs,
+            ks: some_micro_params.ks,
+            fks: all_fks,
+        };
+        MacroOutcome::Best {
+            parameters: Parameters {
+                p_error: some_micro_params.p_error,
+                global_p_error: some_micro_params.global_p_error,
+                complexity: some_micro_params.complexity,
+                micro_params,
+                macro_params,
+                is_lower_bound,
+                is_feasible: true,
+            },
+            lb_message,
+        }
+    }
+}
+
 fn optimize_macro(
     security_level: u64,
     ciphertext_modulus_log: u32,
@@ -626,7 +942,7 @@ fn optimize_macro(
     used_conversion_keyswitch: &[Vec<bool>],
     feasible: &Feasible,
     complexity: &Complexity,
-    caches: &mut DecompCaches,
+    caches: &CachesPool,
     init_parameters: &Parameters,
     best_complexity: f64,
     best_p_error: f64,
@@ -634,25 +950,23 @@ fn optimize_macro(
     let nb_partitions = init_parameters.macro_params.len();
     assert!(partition < nb_partitions);
 
-    let variance_modulus_switching_of = |glwe_log2_poly_size, internal_lwe_dimensions| {
-        estimate_modulus_switching_noise_with_binary_key(
-            internal_lwe_dimensions,
-            glwe_log2_poly_size,
-            ciphertext_modulus_log,
-        )
-    };
-
-    let mut best_parameters = init_parameters.clone();
-    let mut best_complexity = best_complexity;
-    let mut best_p_error = best_p_error;
-    let mut best_partition_p_error = f64::INFINITY;
-
-    let fks_to_optimize = fks_to_optimize(nb_partitions, used_conversion_keyswitch, partition);
-    let operations = OperationsCV {
-        variance: feasible.zero_variance(),
-        cost: complexity.zero_cost(),
+    let search = MacroSearch {
+        security_level,
+        ciphertext_modulus_log,
+        fft_precision,
+        partition,
+        used_tlu_keyswitch,
+        used_conversion_keyswitch,
+        feasible,
+        partition_feasible: feasible.filter_constraints(partition),
+        complexity,
+        init_parameters,
+        fks_to_optimize: fks_to_optimize(nb_partitions, used_conversion_keyswitch, partition),
+        operations: OperationsCV {
+            variance: feasible.zero_variance(),
+            cost: complexity.zero_cost(),
+        },
     };
-    let partition_feasible = feasible.filter_constraints(partition);
 
     let glwe_params_domain = search_space.glwe_dimensions.iter().flat_map(|a| {
         search_space
@@ -660,8 +974,8 @@ fn optimize_macro(
             .iter()
             .map(|b| (*a, *b))
     });
-    let mut lb_message = None;
-    for (glwe_dimension, log2_polynomial_size) in glwe_params_domain {
+    let mut candidates = vec![];
+    for (glwe_index, (glwe_dimension, log2_polynomial_size)) in glwe_params_domain.enumerate() {
         let glwe_params = GlweParameters {
             log2_polynomial_size,
             glwe_dimension,
@@ -675,216 +989,71 @@ fn optimize_macro(
         }
 
         for &internal_dim in &search_space.internal_lwe_dimensions {
-            let mut operations = operations.clone();
-            // OPT: fast linear noise_modulus_switching
-            let variance_modulus_switching =
-                variance_modulus_switching_of(log2_polynomial_size, internal_dim);
-
-            let macro_param_partition = MacroParameters {
+            candidates.push(MacroCandidate {
+                glwe_index,
                 glwe_params,
-                internal_dim,
-            };
-
-            // Heuristic to fill missing macro parameters
-            let macros: Vec<_> = (0..nb_partitions)
-                .map(|i| {
-                    if i == partition {
-                        macro_param_partition
-                    } else {
-                        init_parameters.macro_params[i].unwrap_or(macro_param_partition)
-                    }
-                })
-                .collect();
-
-            // OPT: could be done once and than partially updated
-            apply_partitions_input_and_modulus_variance_and_cost(
-                ciphertext_modulus_log,
-                security_level,
-                nb_partitions,
-                &macros,
-                partition,
                 input_variance,
-                variance_modulus_switching,
-                &mut operations,
-            );
-
-            if best_parameters.is_feasible && !feasible.feasible(&operations.variance) {
-                // noise_modulus_switching is increasing with internal_dim so we can cut
-                // but as long as nothing feasible as been found we don't break to improve feasibility
-                break;
-            }
-
-            if complexity.complexity(&operations.cost) > best_complexity {
-                continue;
-            }
-
-            // setting already chosen pbs and lower bounds
-            // OPT: could be done once and than partially updated
-            apply_pbs_variance_and_cost_or_lower_bounds(
-                &mut caches.cmux,
-                &macros,
-                &init_parameters.micro_params.pbs,
-                partition,
-                &mut operations,
-            );
-
-            // OPT: could be done once and than partially updated
-            apply_all_ks_lower_bound(
-                &mut caches.keyswitch,
-                nb_partitions,
-                &macros,
-                used_tlu_keyswitch,
-                &mut operations,
-            );
-            // OPT: could be done once and than partially updated
-            apply_fks_variance_and_cost_or_lower_bound(
-                &mut caches.keyswitch,
-                nb_partitions,
-                &macros,
-                &init_parameters.micro_params.fks,
-                &fks_to_optimize,
-                used_conversion_keyswitch,
-                &mut operations,
-                ciphertext_modulus_log,
-                fft_precision,
-            );
-
-            let non_feasible = !feasible.feasible(&operations.variance);
-            if best_parameters.is_feasible && non_feasible {
-                continue;
-            }
+                internal_dim,
+            });
+        }
+    }
 
-            if complexity.complexity(&operations.cost) > best_complexity {
-                continue;
-            }
+    let mut best_parameters = init_parameters.clone();
+    let mut bounds = MacroSearchBounds {
+        is_feasible: best_parameters.is_feasible,
+        best_complexity,
+        best_p_error,
+        best_partition_p_error: f64::INFINITY,
+    };
+    let mut lb_message = None;
 
-            let cmux_pareto = caches.cmux.pareto_quantities(glwe_params);
-
-            if non_feasible {
-                lb_message = Some("Non feasible");
-                // here we optimize for feasibility only
-                // if nothing is feasible, it will give improves feasability for later iterations
-                let mut macro_params = init_parameters.macro_params.clone();
-                macro_params[partition] = Some(MacroParameters {
-                    glwe_params,
-                    internal_dim,
-                });
-                // optimize the feasibility only, takes all lower bounds on variance
-                // this selects both macro parameters and pbs (lowest variance) for this partition
-                let complexity = f64::INFINITY;
-                let cmux_params = cmux::lowest_noise(cmux_pareto);
-                let partition_p_error = partition_feasible.p_error(&operations.variance);
-                if partition_p_error >= best_partition_p_error {
-                    continue;
+    // The candidates are evaluated in parallel by batches, with the bounds known
+    // at the start of the batch, and their outcomes are applied in the order of the
+    // sequential search. The candidates following a change of the bounds are
+    // evaluated again in the next batch, so that the result is the one of the
+    // sequential search whatever the number of threads.
+    let batch_size = 2 * rayon::current_num_threads();
+    let mut broken_glwe_index = None;
+    let mut next = 0;
+    while next < candidates.len() {
+        let batch = &candidates[next..candidates.len().min(next + batch_size)];
+        let outcomes: Vec<_> = batch
+            .par_iter()
+            .map(|candidate| {
+                if broken_glwe_index == Some(candidate.glwe_index) {
+                    return MacroOutcome::Skip;
                 }
-                best_partition_p_error = partition_p_error;
-                let p_error = feasible.p_error(&operations.variance);
-                let global_p_error = feasible.global_p_error(&operations.variance);
-                let mut pbs = init_parameters.micro_params.pbs.clone();
-                pbs[partition] = Some(cmux_params);
-                let micro_params = MicroParameters {
-                    pbs,
-                    ks: vec![vec![None; nb_partitions]; nb_partitions],
-                    fks: vec![vec![None; nb_partitions]; nb_partitions],
-                };
-                best_parameters = Parameters {
-                    p_error,
-                    global_p_error,
-                    complexity,
-                    micro_params,
-                    macro_params,
-                    is_lower_bound: true,
-                    is_feasible: false,
-                };
-                continue;
-            }
-
-            if complexity.complexity(&operations.cost) > best_complexity {
+                caches.with(|caches| search.evaluate(&bounds, caches, candidate))
+            })
+            .collect();
+        for (candidate, outcome) in batch.iter().zip(outcomes) {
+            next += 1;
+            if broken_glwe_index == Some(candidate.glwe_index) {
                 continue;
             }
-
-            let micro_opt = optimize_1_cmux_and_dst_exclusive_fks_subset_and_all_ks(
-                partition,
-                &macros,
-                internal_dim,
-                cmux_pareto,
-                &fks_to_optimize,
-                used_tlu_keyswitch,
-                &operations,
-                feasible,
-                complexity,
-                &mut caches.keyswitch,
-                best_complexity,
-                best_p_error,
-                ciphertext_modulus_log,
-                fft_precision,
-            );
-            if let Some(some_micro_params) = micro_opt {
-                // erase macros and all fks that can't be real
-                // set global is_lower_bound here, if any parameter is missing this is lower bound
-                // optimize_micro has already checked for best-ness
-                lb_message = None;
-                let mut macro_params = init_parameters.macro_params.clone();
-                macro_params[partition] = Some(macro_param_partition);
-                let mut is_lower_bound = macro_params.iter().any(Option::is_none);
-                if is_lower_bound {
-                    lb_message = Some("is_lower_bound due to missing macro parameter");
-                }
-                // copy back pbs from other partition
-                let mut all_pbs = init_parameters.micro_params.pbs.clone();
-                all_pbs[partition] = Some(some_micro_params.pbs);
-                let mut all_fks = init_parameters.micro_params.fks.clone();
-                for (dst_partition, maybe_fks) in fks_to_optimize.iter().enumerate() {
-                    if let &Some(src_partition) = maybe_fks {
-                        all_fks[src_partition][dst_partition] =
-                            some_micro_params.fks[src_partition][dst_partition];
-                        assert!(used_conversion_keyswitch[src_partition][dst_partition]);
-                        assert!(all_fks[src_partition][dst_partition].is_some());
-                    }
+            match outcome {
+                MacroOutcome::Break => broken_glwe_index = Some(candidate.glwe_index),
+                MacroOutcome::Skip => (),
+                MacroOutcome::LowerBound {
+                    parameters,
+                    partition_p_error,
+                } => {
+                    lb_message = Some("Non feasible");
+                    bounds.best_partition_p_error = partition_p_error;
+                    best_parameters = parameters;
+                    break;
                 }
-                // As all fks cannot be re-optimized in some case, we need to check previous ones are still valid.
-                for (src_partition, dst_partition) in cross_partition(nb_partitions) {
-                    if !used_conversion_keyswitch[src_partition][dst_partition] {
-                        continue;
-                    }
-                    let fks = &all_fks[src_partition][dst_partition];
-                    if !is_lower_bound && fks.is_none() {
-                        lb_message = Some("is_lower_bound due to missing fast keyswitch parameter");
-                        is_lower_bound = true;
-                    }
-                    let src_glwe_param = macro_params[src_partition].map(|p| p.glwe_params);
-                    let dst_glwe_param = macro_params[dst_partition].map(|p| p.glwe_params);
-                    let src_glwe_param_stable = src_glwe_param == fks.map(|p| p.src_glwe_param);
-                    let dst_glwe_param_stable = dst_glwe_param == fks.map(|p| p.dst_glwe_param);
-                    if src_glwe_param_stable && dst_glwe_param_stable {
-                        continue;
-                    }
-                    if !is_lower_bound {
-                        lb_message = Some("is_lower_bound due to changing others fks macro param");
-                    }
-                    all_fks[src_partition][dst_partition] = None;
-                    is_lower_bound = true;
+                MacroOutcome::Best {
+                    parameters,
+                    lb_message: message,
+                } => {
+                    lb_message = message;
+                    bounds.is_feasible = true;
+                    bounds.best_complexity = parameters.complexity;
+                    bounds.best_p_error = parameters.p_error;
+                    best_parameters = parameters;
+                    break;
                 }
-                let micro_params = MicroParameters {
-                    pbs: all_pbs,
-                    ks: some_micro_params.ks,
-                    fks: all_fks,
-                };
-                best_complexity = some_micro_params.complexity;
-                best_p_error = some_micro_params.p_error;
-                best_parameters = Parameters {
-                    p_error: best_p_error,
-                    global_p_error: some_micro_params.global_p_error,
-                    complexity: best_complexity,
-                    micro_params,
-                    macro_params,
-                    is_lower_bound,
-                    is_feasible: true,
-                };
-            } else {
-                // the macro parameters are feasible
-                // but the complexity is not good enough due to previous feasible solution
-                assert!(best_parameters.is_feasible);
             }
         }
     }
@@ -921,10 +1090,18 @@ pub fn optimize(
     let kappa =
         error::sigma_scale_of_error_probability(config.maximum_acceptable_error_probability);
 
-    let mut caches = persistent_caches.caches();
+    let caches = CachesPool::new(persistent_caches);
 
     let feasible = Feasible::of(&dag.variance_constraints, kappa, None).compressed();
-    let complexity = Complexity::of(&dag.operations_count).compressed();
+    let objective_count = match config.objective {
+        Objective::Complexity => dag.operations_count.clone(),
+        Objective::CriticalPath => {
+            let mut counts = dag.critical_path_operations_count.counts.clone();
+            counts += dag.operations_count.counts.clone() * CRITICAL_PATH_TOTAL_WEIGHT;
+            OperationsCount { counts }
+        }
+    };
+    let complexity = Complexity::of(&objective_count).compressed();
     let used_tlu_keyswitch = used_tlu_keyswitch(&dag);
     let used_conversion_keyswitch = used_conversion_keyswitch(&dag);
 
@@ -961,7 +1138,7 @@ pub fn optimize(
                 &used_conversion_keyswitch,
                 &feasible,
                 &complexity,
-                &mut caches,
+                &caches,
                 &params,
                 best_complexity,
                 best_p_error,
@@ -1023,6 +1200,7 @@ pub fn optimize(
     if best_params.is_none() {
         return Err(NoParametersFound);
     }
+    caches.backport();
     let best_params = best_params.unwrap();
     sanity_check(
         &best_params,
@@ -1155,6 +1333,30 @@ fn sanity_check(
     }
 }
 
+// The cost of each operation with the given parameters
+fn operations_cost(params: &Parameters) -> OperationsValue {
+    let nb_partitions = params.macro_params.len();
+    let micro_params = &params.micro_params;
+    let mut cost = OperationsValue::zero(nb_partitions);
+    for partition in 0..nb_partitions {
+        let internal_dim = params.macro_params[partition].unwrap().internal_dim;
+        if let Some(pbs) = micro_params.pbs[partition] {
+            *cost.pbs(partition) = pbs.complexity_br(internal_dim);
+        }
+        for src_partition in 0..nb_partitions {
+            let src_glwe_param = params.macro_params[src_partition].unwrap().glwe_params;
+            let src_lwe_dim = src_glwe_param.sample_extract_lwe_dimension();
+            if let Some(ks) = micro_params.ks[src_partition][partition] {
+                *cost.ks(src_partition, partition) = ks.complexity(src_lwe_dim);
+            }
+            if let Some(fks) = micro_params.fks[src_partition][partition] {
+                *cost.fks(src_partition, partition) = fks.complexity;
+            }
+        }
+    }
+    cost
+}
+
 pub fn optimize_to_circuit_solution(
     dag: &unparametrized::OperationDag,
     config: Config,
@@ -1200,11 +1402,15 @@ pub fn optimize_to_circuit_solution(
                 (ext_keys, instructions_keys)
             };
             let circuit_keys = ext_keys.compacted();
+            // Both costs are reported whatever the objective
+            let cost = operations_cost(&params);
             keys_spec::CircuitSolution {
                 circuit_keys,
                 instructions_keys,
                 crt_decomposition: vec![],
-                complexity: params.complexity,
+                complexity: Complexity::of(&dag.operations_count).complexity(&cost),
+                critical_path_complexity: Complexity::of(&dag.critical_path_operations_count)
+                    .complexity(&cost),
                 p_error: params.p_error,
                 global_p_error: params.global_p_error,
                 is_feasible: true,
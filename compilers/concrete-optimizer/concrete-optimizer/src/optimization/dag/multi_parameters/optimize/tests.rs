@@ -42,6 +42,7 @@ fn default_config() -> Config<'static> {
         fft_precision: 53,
         complexity_model,
         composable: false,
+        objective: Objective::Complexity,
     }
 }
 
@@ -50,7 +51,19 @@ fn optimize(
     p_cut: &Option<PartitionCut>,
     default_partition: usize,
 ) -> Option<Parameters> {
-    let config = default_config();
+    optimize_with_objective(dag, p_cut, default_partition, Objective::Complexity)
+}
+
+fn optimize_with_objective(
+    dag: &unparametrized::OperationDag,
+    p_cut: &Option<PartitionCut>,
+    default_partition: usize,
+    objective: Objective,
+) -> Option<Parameters> {
+    let config = Config {
+        objective,
+        ..default_config()
+    };
     let search_space = SearchSpace::default_cpu();
     super::optimize(
         dag,
@@ -664,6 +677,7 @@ fn test_big_secret_key_sharing() {
         fft_precision: 53,
         complexity_model: &CpuComplexity::default(),
         composable: false,
+        objective: Objective::Complexity,
     };
     let config_no_sharing = Config {
         key_sharing: false,
@@ -715,6 +729,7 @@ fn test_big_and_small_secret_key() {
         fft_precision: 53,
         complexity_model: &CpuComplexity::default(),
         composable: false,
+        objective: Objective::Complexity,
     };
     let config_no_sharing = Config {
         key_sharing: false,
@@ -859,3 +874,57 @@ fn test_bug_with_zero_noise() {
     let sol = optimize(&dag, &None, 0);
     assert!(sol.is_some());
 }
+
+#[test]
+fn test_parallel_search_is_deterministic() {
+    let mut dag = unparametrized::OperationDag::new();
+    let mut previous = dag.add_input(2, Shape::vector(16));
+    for precision in [2, 4, 6, 8] {
+        let lut = dag.add_lut(previous, FunctionTable::UNKWOWN, precision);
+        previous = dag.add_dot([lut, previous], [2, 1]);
+    }
+    let p_cut = Some(PartitionCut::for_each_precision(&dag));
+    let sol = optimize(&dag, &p_cut, 0).unwrap();
+    assert!(sol.macro_params.len() == 4);
+    let sequential_pool = rayon::ThreadPoolBuilder::new()
+        .num_threads(1)
+        .build()
+        .unwrap();
+    let sol_sequential = sequential_pool.install(|| optimize(&dag, &p_cut, 0).unwrap());
+    assert!(sol.complexity == sol_sequential.complexity);
+    assert!(sol.p_error == sol_sequential.p_error);
+    assert!(sol.macro_params == sol_sequential.macro_params);
+    assert_eq!(
+        format!("{:?}", sol.micro_params),
+        format!("{:?}", sol_sequential.micro_params)
+    );
+}
+
+#[test]
+fn optimize_critical_path_does_not_overprovision_off_path_partitions() {
+    // A chain of 4-bit luts on the critical path, and a single 8-bit lut off it
+    let mut dag = unparametrized::OperationDag::new();
+    let mut chain = dag.add_input(4, Shape::number());
+    for _ in 0..4 {
+        chain = dag.add_lut(chain, FunctionTable::UNKWOWN, 4);
+    }
+    let off_path = dag.add_input(8, Shape::number());
+    _ = dag.add_lut(off_path, FunctionTable::UNKWOWN, 8);
+    dag.detect_outputs();
+    let p_cut = Some(PartitionCut::from_precisions(&[4, 8]));
+    let off_path_partition = 1;
+    let sol_total =
+        optimize_with_objective(&dag, &p_cut, LOW_PARTITION, Objective::Complexity).unwrap();
+    let sol_critical =
+        optimize_with_objective(&dag, &p_cut, LOW_PARTITION, Objective::CriticalPath).unwrap();
+    let on_path_pbs = |sol: &Parameters| sol.micro_params.pbs[LOW_PARTITION].unwrap().complexity;
+    let off_path_pbs =
+        |sol: &Parameters| sol.micro_params.pbs[off_path_partition].unwrap().complexity;
+    assert!(on_path_pbs(&sol_critical) <= on_path_pbs(&sol_total));
+    assert!(
+        off_path_pbs(&sol_critical) <= off_path_pbs(&sol_total),
+        "{} <= {}",
+        off_path_pbs(&sol_critical),
+        off_path_pbs(&sol_total)
+    );
+}
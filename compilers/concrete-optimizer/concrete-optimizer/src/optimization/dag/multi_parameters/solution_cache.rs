@@ -0,0 +1,252 @@
+use std::fmt::Write;
+use std::hash::Hasher;
+use std::sync::OnceLock;
+
+use concrete_security_curves::gaussian::curves_gen::SECURITY_WEIGHTS_ARRAY;
+use rustc_hash::FxHasher;
+use serde::{Deserialize, Serialize};
+
+use crate::dag::unparametrized::OperationDag;
+use crate::optimization::config::{Config, SearchSpace};
+use crate::optimization::dag::multi_parameters::keys_spec::CircuitSolution;
+use crate::optimization::dag::multi_parameters::optimize_generic;
+use crate::optimization::dag::multi_parameters::partition_cut::PartitionCut;
+use crate::optimization::dag::solo_key::optimize_generic::Encoding;
+use crate::optimization::decomposition::PersistDecompCaches;
+use crate::utils::cache::persistent::{default_cache_dir, PersistentCacheHashMap};
+
+// To bump whenever a change of the optimizer changes the solutions it finds
+const SOLVER_VERSION: u64 = 2;
+
+// Beyond this number of solutions, new solutions are not cached
+const MAX_SOLUTIONS: usize = 1024;
+
+/* The solutions are invalidated by a new optimizer or new security curves */
+fn version() -> u64 {
+    hash(&format!(
+        "{SOLVER_VERSION} {} {SECURITY_WEIGHTS_ARRAY:?}",
+        env!("CARGO_PKG_VERSION")
+    ))
+}
+
+#[derive(Clone, Serialize, Deserialize)]
+pub struct CachedSolution {
+    // the full problem, to discard the hash collisions
+    problem: String,
+    solution: CircuitSolution,
+}
+
+pub type PersistSolutionCache = PersistentCacheHashMap<u64, CachedSolution>;
+
+/* Solutions of whole circuits, shared by all the processes like the decomposition caches.
+ * The file is read once per process, and written whenever a solution is added. */
+pub fn cache() -> &'static PersistSolutionCache {
+    static CACHE: OnceLock<PersistSolutionCache> = OnceLock::new();
+    CACHE.get_or_init(|| {
+        let cache_dir: String = default_cache_dir();
+        let path = format!("{cache_dir}/multi-parameters-solutions");
+        // the entries are only inserted by optimize, never computed from their key
+        let function = |_key: u64| -> CachedSolution {
+            unreachable!("PersistSolutionCache: missing solutions are not computed")
+        };
+        PersistentCacheHashMap::new(&path, version(), function)
+    })
+}
+
+/* Canonical description of everything the solution depends on, the dag included with its output tags.
+ * The complexity model is not printable, `model` must identify it. */
+pub fn problem(
+    dag: &OperationDag,
+    config: Config,
+    model: &str,
+    search_space: &SearchSpace,
+    encoding: Encoding,
+    default_log_norm2_woppbs: f64,
+    p_cut: &Option<PartitionCut>,
+) -> String {
+    // destructured so that a new field of Config cannot be forgotten here
+    let Config {
+        security_level,
+        maximum_acceptable_error_probability,
+        key_sharing,
+        ciphertext_modulus_log,
+        fft_precision,
+        complexity_model: _,
+        composable,
+        objective,
+    } = config;
+    let mut acc = String::new();
+    let err_msg = "Optimizer: Can't describe the problem";
+    writeln!(acc, "Dag: {dag:?}").expect(err_msg);
+    writeln!(
+        acc,
+        "Config: {security_level} {maximum_acceptable_error_probability:?} {key_sharing} \
+         {ciphertext_modulus_log} {fft_precision} {composable} {objective:?} {model}"
+    )
+    .expect(err_msg);
+    writeln!(acc, "Search space: {search_space:?}").expect(err_msg);
+    writeln!(
+        acc,
+        "Encoding: {encoding:?} {default_log_norm2_woppbs:?} {p_cut:?}"
+    )
+    .expect(err_msg);
+    acc
+}
+
+fn hash(problem: &str) -> u64 {
+    let mut hasher = FxHasher::default();
+    hasher.write(problem.as_bytes());
+    hasher.finish()
+}
+
+/* optimize_generic::optimize, skipped when the same problem has already been solved.
+ * The decomposition caches are only built on a miss. */
+#[allow(clippy::too_many_arguments)]
+pub fn optimize(
+    solutions: &PersistSolutionCache,
+    dag: &OperationDag,
+    config: Config,
+    model: &str,
+    search_space: &SearchSpace,
+    encoding: Encoding,
+    default_log_norm2_woppbs: f64,
+    caches: impl FnOnce() -> PersistDecompCaches,
+    p_cut: &Option<PartitionCut>,
+) -> CircuitSolution {
+    let problem = problem(
+        dag,
+        config,
+        model,
+        search_space,
+        encoding,
+        default_log_norm2_woppbs,
+        p_cut,
+    );
+    let key = hash(&problem);
+    if let Some(cached) = solutions.get(key) {
+        if cached.problem == problem {
+            return cached.solution;
+        }
+    }
+    let solution = optimize_generic::optimize(
+        dag,
+        config,
+        search_space,
+        encoding,
+        default_log_norm2_woppbs,
+        &caches(),
+        p_cut,
+    );
+    // unfeasible problems are cheap to detect again, they are not worth the space
+    if solution.is_feasible && solutions.len() < MAX_SOLUTIONS {
+        solutions.insert(
+            key,
+            CachedSolution {
+                problem,
+                solution: solution.clone(),
+            },
+        );
+        solutions.sync_to_disk();
+    }
+    solution
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::config;
+    use crate::dag::operator::{FunctionTable, Shape};
+    use crate::optimization::config::Objective;
+    use crate::optimization::decomposition;
+
+    #[test]
+    fn test_cached_solution_is_reused() {
+        let processing_unit = config::ProcessingUnit::Cpu;
+        let complexity_model = processing_unit.complexity_model();
+        let config = Config {
+            security_level: 128,
+            maximum_acceptable_error_probability: 1.0 / 1_000_000.0,
+            key_sharing: true,
+            ciphertext_modulus_log: 64,
+            fft_precision: 53,
+            complexity_model: complexity_model.as_ref(),
+            composable: false,
+            objective: Objective::Complexity,
+        };
+        let search_space = SearchSpace::default(processing_unit);
+        let mut dag = OperationDag::new();
+        let input = dag.add_input(3, Shape::number());
+        let _lut = dag.add_lut(input, FunctionTable::UNKWOWN, 3);
+        let p_cut = Some(PartitionCut::for_each_precision(&dag));
+
+        let path = "/tmp/optimizer/tests/test_cached_solution_is_reused";
+        PersistSolutionCache::clear_file(path);
+        let solutions = PersistSolutionCache::new(path, version(), |_key| unreachable!());
+        let caches = || {
+            decomposition::cache(
+                config.security_level,
+                processing_unit,
+                Some(complexity_model.clone()),
+                true,
+                config.ciphertext_modulus_log,
+                config.fft_precision,
+            )
+        };
+        let solve = |caches: &dyn Fn() -> PersistDecompCaches| {
+            optimize(
+                &solutions,
+                &dag,
+                config,
+                processing_unit.br_to_string(),
+                &search_space,
+                Encoding::Native,
+                8.0,
+                caches,
+                &p_cut,
+            )
+        };
+        let first = solve(&caches);
+        assert!(first.is_feasible);
+        let second = solve(&|| unreachable!("the solution should be cached"));
+        assert_eq!(first.complexity, second.complexity);
+        assert_eq!(
+            first.circuit_keys.secret_keys,
+            second.circuit_keys.secret_keys
+        );
+    }
+
+    #[test]
+    fn test_problem_depends_on_output_tags() {
+        let processing_unit = config::ProcessingUnit::Cpu;
+        let complexity_model = processing_unit.complexity_model();
+        let config = Config {
+            security_level: 128,
+            maximum_acceptable_error_probability: 1.0 / 1_000_000.0,
+            key_sharing: true,
+            ciphertext_modulus_log: 64,
+            fft_precision: 53,
+            complexity_model: complexity_model.as_ref(),
+            composable: false,
+            objective: Objective::Complexity,
+        };
+        let search_space = SearchSpace::default(processing_unit);
+        let mut dag = OperationDag::new();
+        let input = dag.add_input(3, Shape::number());
+        let lut = dag.add_lut(input, FunctionTable::UNKWOWN, 3);
+        let _lut = dag.add_lut(lut, FunctionTable::UNKWOWN, 3);
+        let mut tagged_dag = dag.clone();
+        tagged_dag.tag_operator_as_output(lut);
+        let describe = |dag: &OperationDag| {
+            problem(
+                dag,
+                config,
+                processing_unit.br_to_string(),
+                &search_space,
+                Encoding::Native,
+                8.0,
+                &Some(PartitionCut::for_each_precision(dag)),
+            )
+        };
+        assert_ne!(describe(&dag), describe(&tagged_dag));
+    }
+}
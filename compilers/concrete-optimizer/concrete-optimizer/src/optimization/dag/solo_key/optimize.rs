@@ -431,7 +431,7 @@ pub(crate) mod tests {
     use crate::config;
     use crate::dag::operator::{FunctionTable, Shape, Weights};
     use crate::noise_estimator::p_error::repeat_p_error;
-    use crate::optimization::config::SearchSpace;
+    use crate::optimization::config::{Objective, SearchSpace};
     use crate::optimization::dag::solo_key::symbolic_variance::VarianceOrigin;
     use crate::optimization::{atomic_pattern, decomposition};
     use crate::utils::square;
@@ -481,6 +481,7 @@ pub(crate) mod tests {
             fft_precision: 53,
             complexity_model: &CpuComplexity::default(),
             composable: false,
+            objective: Objective::Complexity,
         };
 
         let search_space = SearchSpace::default_cpu();
@@ -527,6 +528,7 @@ pub(crate) mod tests {
             fft_precision: 53,
             complexity_model: &CpuComplexity::default(),
             composable: false,
+            objective: Objective::Complexity,
         };
 
         _ = optimize_v0(
@@ -627,6 +629,7 @@ pub(crate) mod tests {
             fft_precision: 53,
             complexity_model: &CpuComplexity::default(),
             composable: false,
+            objective: Objective::Complexity,
         };
 
         let state = optimize(&dag);
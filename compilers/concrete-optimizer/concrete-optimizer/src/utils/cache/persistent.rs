@@ -103,6 +103,25 @@ where
         self.update_with(|content| ROC::extend(content, new_entries));
     }
 
+    /* Direct access for values that are not computed from the key alone */
+    pub fn get(&self, key: ROC::K) -> Option<ROC::V> {
+        self.content.read().unwrap().get(key).cloned()
+    }
+
+    #[allow(clippy::len_without_is_empty)]
+    pub fn len(&self) -> usize {
+        self.content.read().unwrap().len()
+    }
+
+    pub fn insert(&self, key: ROC::K, value: ROC::V) {
+        if DISABLE_CACHE {
+            return;
+        }
+        let mut new_entries = Map::default();
+        let _unused = new_entries.insert(key, value);
+        self.update_with(|content| ROC::extend(content, new_entries));
+    }
+
     #[allow(clippy::nursery)]
     fn update_with<F>(&self, update: F)
     where
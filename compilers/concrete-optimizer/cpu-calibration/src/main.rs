@@ -0,0 +1,324 @@
+#![warn(clippy::nursery)]
+#![warn(clippy::pedantic)]
+#![warn(clippy::style)]
+#![allow(clippy::cast_precision_loss)]
+#![allow(clippy::cast_possible_truncation)]
+
+//! Measures the cost of the cpu keyswitch, bootstrap and levelled operators
+//! of concrete-cpu on the host, over a grid of parameters, and fits it
+//! against the analytic complexity model of the optimizer.
+//!
+//! The resulting calibration file is given to the compiler with
+//! `--optimizer-cpu-calibration=<file>`, so that the optimizer minimizes the
+//! measured execution time of the circuit on this host.
+
+use std::alloc::{alloc_zeroed, dealloc, Layout};
+use std::fmt::Write as _;
+use std::time::Instant;
+
+use clap::Parser;
+use concrete_cpu::c_api::bootstrap::{
+    concrete_cpu_bootstrap_lwe_ciphertext_u64, concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch,
+    concrete_cpu_fourier_bootstrap_key_size_u64,
+};
+use concrete_cpu::c_api::fft::{
+    concrete_cpu_construct_concrete_fft, concrete_cpu_destroy_concrete_fft, Fft,
+    CONCRETE_FFT_ALIGN, CONCRETE_FFT_SIZE,
+};
+use concrete_cpu::c_api::keyswitch::{
+    concrete_cpu_keyswitch_key_size_u64, concrete_cpu_keyswitch_lwe_ciphertext_u64,
+};
+use concrete_cpu::c_api::linear_op::concrete_cpu_add_lwe_ciphertext_u64;
+use concrete_cpu::c_api::types::ScratchStatus;
+use concrete_optimizer::computing_cost::complexity_model::ComplexityModel;
+use concrete_optimizer::computing_cost::cpu::{CpuComplexity, LinearCost};
+use concrete_optimizer::parameters::{
+    BrDecompositionParameters, GlweParameters, KeyswitchParameters, KsDecompositionParameters,
+    LweDimension, PbsParameters,
+};
+
+const CALIBRATION_VERSION: u64 = 1;
+const CIPHERTEXT_MODULUS_LOG: u32 = 64;
+
+#[derive(Parser, Debug)]
+#[clap(about = "Calibrate the optimizer cpu cost model on this host")]
+struct Args {
+    #[clap(long, default_value = "cpu-calibration.json")]
+    output: String,
+
+    #[clap(long, default_value_t = 5, help = "Measures per parameter set")]
+    repetitions: usize,
+
+    #[clap(long, default_value_t = 12, help = "10..16")]
+    max_log_poly_size: u64,
+}
+
+/// A measure of an operator on a parameter set
+struct Measure {
+    operator: &'static str,
+    parameters: String,
+    complexity: f64,
+    time_ns: f64,
+}
+
+/// Returns the median time, in nanoseconds, of `iterations` calls of `f`
+fn median_time_ns(repetitions: usize, iterations: usize, mut f: impl FnMut()) -> f64 {
+    // Warm up the caches and the lazily initialized tables
+    f();
+
+    let mut times: Vec<f64> = (0..repetitions.max(1))
+        .map(|_| {
+            let start = Instant::now();
+            for _ in 0..iterations {
+                f();
+            }
+            start.elapsed().as_nanos() as f64 / iterations as f64
+        })
+        .collect();
+    times.sort_by(f64::total_cmp);
+    times[times.len() / 2]
+}
+
+/// Zeroed buffer with the given alignment, for the fft plans and the scratch
+/// memory of concrete-cpu
+struct AlignedBuffer {
+    ptr: *mut u8,
+    layout: Layout,
+}
+
+impl AlignedBuffer {
+    fn new(size: usize, align: usize) -> Self {
+        let layout = Layout::from_size_align(size.max(1), align).unwrap();
+        let ptr = unsafe { alloc_zeroed(layout) };
+        assert!(!ptr.is_null());
+        Self { ptr, layout }
+    }
+}
+
+impl Drop for AlignedBuffer {
+    fn drop(&mut self) {
+        unsafe { dealloc(self.ptr, self.layout) };
+    }
+}
+
+/// The time of a bootstrap does not depend on the values of the key and of
+/// the ciphertext, so the measures use zeroed keys.
+fn measure_pbs(args: &Args, model: &CpuComplexity, measures: &mut Vec<Measure>) {
+    for log2_polynomial_size in 10..=args.max_log_poly_size {
+        let polynomial_size = 1_usize << log2_polynomial_size;
+        let glwe_dimension = 1;
+
+        let fft_buffer = AlignedBuffer::new(CONCRETE_FFT_SIZE, CONCRETE_FFT_ALIGN);
+        let fft = fft_buffer.ptr.cast::<Fft>();
+        unsafe { concrete_cpu_construct_concrete_fft(fft, polynomial_size) };
+
+        let mut stack_size = 0;
+        let mut stack_align = 0;
+        let status = unsafe {
+            concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+                &mut stack_size,
+                &mut stack_align,
+                glwe_dimension,
+                polynomial_size,
+                fft,
+            )
+        };
+        assert!(matches!(status, ScratchStatus::Valid));
+        let stack = AlignedBuffer::new(stack_size, stack_align);
+
+        for internal_lwe_dimension in [256_usize, 512] {
+            for level in [1_usize, 2, 3] {
+                let base_log = 64 / (level + 1);
+                let fourier_bsk_size = unsafe {
+                    concrete_cpu_fourier_bootstrap_key_size_u64(
+                        level,
+                        glwe_dimension,
+                        polynomial_size,
+                        internal_lwe_dimension,
+                    )
+                };
+                // c64 coefficients, as pairs of f64
+                let fourier_bsk = vec![0.0_f64; 2 * fourier_bsk_size];
+                let accumulator = vec![0_u64; (glwe_dimension + 1) * polynomial_size];
+                let ct_in = vec![0_u64; internal_lwe_dimension + 1];
+                let mut ct_out = vec![0_u64; glwe_dimension * polynomial_size + 1];
+
+                let time_ns = median_time_ns(args.repetitions, 1, || unsafe {
+                    concrete_cpu_bootstrap_lwe_ciphertext_u64(
+                        ct_out.as_mut_ptr(),
+                        ct_in.as_ptr(),
+                        accumulator.as_ptr(),
+                        fourier_bsk.as_ptr().cast(),
+                        level,
+                        base_log,
+                        glwe_dimension,
+                        polynomial_size,
+                        internal_lwe_dimension,
+                        fft,
+                        stack.ptr,
+                        stack_size,
+                    );
+                });
+
+                let params = PbsParameters {
+                    internal_lwe_dimension: LweDimension(internal_lwe_dimension as u64),
+                    br_decomposition_parameter: BrDecompositionParameters {
+                        level: level as u64,
+                        log2_base: base_log as u64,
+                    },
+                    output_glwe_params: GlweParameters {
+                        log2_polynomial_size,
+                        glwe_dimension: glwe_dimension as u64,
+                    },
+                };
+                measures.push(Measure {
+                    operator: "pbs",
+                    parameters: format!(
+                        "n={internal_lwe_dimension} N=2**{log2_polynomial_size} \
+                         k={glwe_dimension} l={level}"
+                    ),
+                    complexity: model.pbs_complexity(params, CIPHERTEXT_MODULUS_LOG),
+                    time_ns,
+                });
+            }
+        }
+
+        unsafe { concrete_cpu_destroy_concrete_fft(fft) };
+    }
+}
+
+/// The time of a keyswitch does not depend on the values of the key and of
+/// the ciphertext, so the measures use zeroed keys.
+fn measure_ks(args: &Args, model: &CpuComplexity, measures: &mut Vec<Measure>) {
+    for input_dimension in [1024_usize, 2048] {
+        for output_dimension in [512_usize, 768, 1024] {
+            for level in [2_usize, 4, 6] {
+                let base_log = 64 / (level + 1);
+                let ksk_size = unsafe {
+                    concrete_cpu_keyswitch_key_size_u64(level, input_dimension, output_dimension)
+                };
+                let ksk = vec![0_u64; ksk_size];
+                let ct_in = vec![0_u64; input_dimension + 1];
+                let mut ct_out = vec![0_u64; output_dimension + 1];
+
+                let time_ns = median_time_ns(args.repetitions, 4, || unsafe {
+                    concrete_cpu_keyswitch_lwe_ciphertext_u64(
+                        ct_out.as_mut_ptr(),
+                        ct_in.as_ptr(),
+                        ksk.as_ptr(),
+                        level,
+                        base_log,
+                        input_dimension,
+                        output_dimension,
+                    );
+                });
+
+                let params = KeyswitchParameters {
+                    input_lwe_dimension: LweDimension(input_dimension as u64),
+                    output_lwe_dimension: LweDimension(output_dimension as u64),
+                    ks_decomposition_parameter: KsDecompositionParameters {
+                        level: level as u64,
+                        log2_base: base_log as u64,
+                    },
+                };
+                measures.push(Measure {
+                    operator: "ks",
+                    parameters: format!(
+                        "n_in={input_dimension} n_out={output_dimension} l={level}"
+                    ),
+                    complexity: model.ks_complexity(params, CIPHERTEXT_MODULUS_LOG),
+                    time_ns,
+                });
+            }
+        }
+    }
+}
+
+fn measure_levelled(args: &Args, model: &CpuComplexity, measures: &mut Vec<Measure>) {
+    for log2_lwe_dimension in 9..=14 {
+        let lwe_dimension = 1_usize << log2_lwe_dimension;
+        let ct_in0 = vec![0_u64; lwe_dimension + 1];
+        let ct_in1 = vec![0_u64; lwe_dimension + 1];
+        let mut ct_out = vec![0_u64; lwe_dimension + 1];
+
+        let time_ns = median_time_ns(args.repetitions, 1000, || unsafe {
+            concrete_cpu_add_lwe_ciphertext_u64(
+                ct_out.as_mut_ptr(),
+                ct_in0.as_ptr(),
+                ct_in1.as_ptr(),
+                lwe_dimension,
+            );
+        });
+
+        measures.push(Measure {
+            operator: "levelled",
+            parameters: format!("n={lwe_dimension}"),
+            complexity: model.levelled_complexity(
+                1,
+                LweDimension(lwe_dimension as u64),
+                CIPHERTEXT_MODULUS_LOG,
+            ),
+            time_ns,
+        });
+    }
+}
+
+fn fit(measures: &[Measure], operator: &str) -> LinearCost {
+    let samples: Vec<(f64, f64)> = measures
+        .iter()
+        .filter(|m| m.operator == operator)
+        .map(|m| (m.complexity, m.time_ns))
+        .collect();
+    LinearCost::fit(&samples)
+}
+
+fn to_json(measures: &[Measure], ks: LinearCost, pbs: LinearCost, levelled: LinearCost) -> String {
+    let mut json = String::new();
+    let cost = |cost: LinearCost| {
+        format!(
+            "{{\"constant_ns\": {:e}, \"ns_per_op\": {:e}}}",
+            cost.constant_ns, cost.ns_per_op
+        )
+    };
+    writeln!(json, "{{").unwrap();
+    writeln!(json, "  \"version\": {CALIBRATION_VERSION},").unwrap();
+    writeln!(json, "  \"ks\": {},", cost(ks)).unwrap();
+    writeln!(json, "  \"pbs\": {},", cost(pbs)).unwrap();
+    writeln!(json, "  \"levelled_ns_per_op\": {:e},", levelled.ns_per_op).unwrap();
+    writeln!(json, "  \"measures\": [").unwrap();
+    for (i, m) in measures.iter().enumerate() {
+        let separator = if i + 1 == measures.len() { "" } else { "," };
+        writeln!(
+            json,
+            "    {{\"operator\": \"{}\", \"parameters\": \"{}\", \"complexity\": {:e}, \
+             \"time_ns\": {:e}}}{separator}",
+            m.operator, m.parameters, m.complexity, m.time_ns
+        )
+        .unwrap();
+    }
+    writeln!(json, "  ]").unwrap();
+    writeln!(json, "}}").unwrap();
+    json
+}
+
+fn main() {
+    let args = Args::parse();
+    let model = CpuComplexity::default();
+    let mut measures = vec![];
+
+    measure_ks(&args, &model, &mut measures);
+    measure_pbs(&args, &model, &mut measures);
+    measure_levelled(&args, &model, &mut measures);
+
+    let ks = fit(&measures, "ks");
+    let pbs = fit(&measures, "pbs");
+    let levelled = fit(&measures, "levelled");
+
+    println!(
+        "ks: {:.1} ns + {:.3e} ns/op, pbs: {:.1} ns + {:.3e} ns/op, levelled: {:.3e} ns/op",
+        ks.constant_ns, ks.ns_per_op, pbs.constant_ns, pbs.ns_per_op, levelled.ns_per_op
+    );
+
+    std::fs::write(&args.output, to_json(&measures, ks, pbs, levelled)).unwrap();
+    println!("Calibration written to {}", args.output);
+}
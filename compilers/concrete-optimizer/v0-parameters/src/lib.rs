@@ -12,7 +12,7 @@ use clap::Parser;
 use concrete_optimizer::computing_cost::cpu::CpuComplexity;
 use concrete_optimizer::config;
 use concrete_optimizer::global_parameters::DEFAUT_DOMAINS;
-use concrete_optimizer::optimization::config::{Config, SearchSpace};
+use concrete_optimizer::optimization::config::{Config, Objective, SearchSpace};
 use concrete_optimizer::optimization::dag::solo_key::optimize::{self as optimize_dag};
 use concrete_optimizer::optimization::dag::solo_key::optimize_generic::Solution;
 use concrete_optimizer::optimization::dag::solo_key::optimize_generic::Solution::{
@@ -127,6 +127,7 @@ pub fn all_results(args: &Args) -> Vec<Vec<Option<Solution>>> {
         fft_precision: args.fft_precision,
         complexity_model: &CpuComplexity::default(),
         composable,
+        objective: Objective::Complexity,
     };
 
     let cache = decomposition::cache(
@@ -548,6 +548,15 @@ class Compiler:
 
                 print()
 
+                strategy_decisions = self.graph.format_strategy_decisions()
+                if strategy_decisions != "":
+                    print("Strategy Decisions")
+                    print("-" * columns)
+                    print(strategy_decisions)
+                    print("-" * columns)
+
+                    print()
+
             if show_assigned_graph:
                 if is_first:  # pragma: no cover
                     print()
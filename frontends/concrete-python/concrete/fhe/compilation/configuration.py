@@ -246,6 +246,12 @@ class ComparisonStrategy(str, Enum):
     # - at most 13 TLUs
     # - it's complicated...
 
+    AUTO = "auto"
+    # ---------
+    # execution:
+    # - each strategy that can be used is applied to the operation and its operands alone
+    # - the one with the lowest complexity according to the optimizer is selected
+
     @classmethod
     def parse(cls, string: str) -> "ComparisonStrategy":
         """
@@ -563,6 +569,12 @@ class BitwiseStrategy(str, Enum):
     # - at most 9 TLUs
     # - it's complicated...
 
+    AUTO = "auto"
+    # ---------
+    # execution:
+    # - each strategy that can be used is applied to the operation and its operands alone
+    # - the one with the lowest complexity according to the optimizer is selected
+
     @classmethod
     def parse(cls, string: str) -> "BitwiseStrategy":
         """
@@ -727,6 +739,12 @@ class MultivariateStrategy(str, Enum):
     # - z = tlu(z) :: 2-bits -> 13-bits
     # - tlu(pack(x, y, z)) :: 13-bits -> 8-bits
 
+    AUTO = "auto"
+    # ---------
+    # execution:
+    # - each strategy that can be used is applied to the operation and its operands alone
+    # - the one with the lowest complexity according to the optimizer is selected
+
     @classmethod
     def parse(cls, string: str) -> "MultivariateStrategy":
         """
@@ -847,6 +865,12 @@ class MinMaxStrategy(str, Enum):
     # - at most 21 TLUs
     # - it's complicated...
 
+    AUTO = "auto"
+    # ---------
+    # execution:
+    # - each strategy that can be used is applied to the operation and its operands alone
+    # - the one with the lowest complexity according to the optimizer is selected
+
     @classmethod
     def parse(cls, string: str) -> "MinMaxStrategy":
         """
@@ -398,6 +398,16 @@ class DebugManager:
             with self.debug_table(f"Bit-Width Assignments for {name}"):
                 print(function_graph.format_bit_width_assignments())
 
+    def debug_strategy_decisions(self, name, function_graph):
+        """
+        Print automatically selected strategies if configuration tells so.
+        """
+
+        strategy_decisions = function_graph.format_strategy_decisions()
+        if self.show_bit_width_assignments() and strategy_decisions != "":
+            with self.debug_table(f"Strategy Decisions for {name}"):
+                print(strategy_decisions)
+
     def debug_assigned_graph(self, name, function_graph):
         """
         Print assigned graphs if configuration tells so.
@@ -530,6 +540,7 @@ class ModuleCompiler:
             for name, function in self.functions.items():
                 dbg.debug_bit_width_constaints(name, function.graph)
                 dbg.debug_bit_width_assignments(name, function.graph)
+                dbg.debug_strategy_decisions(name, function.graph)
                 dbg.debug_assigned_graph(name, function.graph)
 
             # Compile to a module!
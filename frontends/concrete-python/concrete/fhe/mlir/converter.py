@@ -23,6 +23,7 @@ from ..representation import Graph, GraphProcessor, MultiGraphProcessor, Node, O
 from .context import Context
 from .conversion import Conversion
 from .processors import *  # pylint: disable=wildcard-import
+from .strategy_costs import StrategyCosts
 from .utils import MAXIMUM_TLU_BIT_WIDTH, construct_deduplicated_tables
 
 # pylint: enable=import-error,no-name-in-module
@@ -226,6 +227,7 @@ class Converter:
                     shifts_with_promotion=configuration.shifts_with_promotion,
                     multivariate_strategy_preference=configuration.multivariate_strategy_preference,
                     min_max_strategy_preference=configuration.min_max_strategy_preference,
+                    strategy_costs=StrategyCosts(configuration),
                 ),
                 ProcessRounding(
                     rounding_exactness=configuration.rounding_exactness,
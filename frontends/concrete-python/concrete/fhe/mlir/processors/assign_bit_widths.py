@@ -3,7 +3,7 @@ Declaration of `AssignBitWidths` graph processor.
 """
 
 from itertools import chain
-from typing import Dict, List
+from typing import Dict, List, Optional
 
 import z3
 
@@ -15,6 +15,7 @@ from ...compilation.configuration import (
 )
 from ...dtypes import Integer
 from ...representation import Graph, MultiGraphProcessor, Node, Operation
+from ..strategy_costs import Strategy, StrategyCosts
 
 
 class AssignBitWidths(MultiGraphProcessor):
@@ -28,6 +29,8 @@ class AssignBitWidths(MultiGraphProcessor):
     There is preference list for comparison strategies.
     - Strategies will be traversed in order and bit-widths
       will be assigned according to the first available strategy.
+    - The auto strategy is replaced by the available strategy
+      with the lowest cost according to `strategy_costs`.
     """
 
     single_precision: bool
@@ -37,6 +40,7 @@ class AssignBitWidths(MultiGraphProcessor):
     shifts_with_promotion: bool
     multivariate_strategy_preference: List[MultivariateStrategy]
     min_max_strategy_preference: List[MinMaxStrategy]
+    strategy_costs: Optional[StrategyCosts]
 
     def __init__(
         self,
@@ -47,6 +51,7 @@ class AssignBitWidths(MultiGraphProcessor):
         shifts_with_promotion: bool,
         multivariate_strategy_preference: List[MultivariateStrategy],
         min_max_strategy_preference: List[MinMaxStrategy],
+        strategy_costs: Optional[StrategyCosts] = None,
     ):
         self.single_precision = single_precision
         self.composable = composable
@@ -55,6 +60,7 @@ class AssignBitWidths(MultiGraphProcessor):
         self.shifts_with_promotion = shifts_with_promotion
         self.multivariate_strategy_preference = multivariate_strategy_preference
         self.min_max_strategy_preference = min_max_strategy_preference
+        self.strategy_costs = strategy_costs
 
     def apply_many(self, graphs: Dict[str, Graph]):
         optimizer = z3.Optimize()
@@ -73,6 +79,7 @@ class AssignBitWidths(MultiGraphProcessor):
                 self.shifts_with_promotion,
                 self.multivariate_strategy_preference,
                 self.min_max_strategy_preference,
+                self.strategy_costs,
             )
 
             nodes = graph.query_nodes(ordered=True)
@@ -142,6 +149,7 @@ class AdditionalConstraints:
     shifts_with_promotion: bool
     multivariate_strategy_preference: List[MultivariateStrategy]
     min_max_strategy_preference: List[MinMaxStrategy]
+    strategy_costs: Optional[StrategyCosts]
 
     node: Node
     bit_width: z3.Int
@@ -158,6 +166,7 @@ class AdditionalConstraints:
         shifts_with_promotion: bool,
         multivariate_strategy_preference: List[MultivariateStrategy],
         min_max_strategy_preference: List[MinMaxStrategy],
+        strategy_costs: Optional[StrategyCosts] = None,
     ):
         self.optimizer = optimizer
         self.graph = graph
@@ -168,6 +177,7 @@ class AdditionalConstraints:
         self.shifts_with_promotion = shifts_with_promotion
         self.multivariate_strategy_preference = multivariate_strategy_preference
         self.min_max_strategy_preference = min_max_strategy_preference
+        self.strategy_costs = strategy_costs
 
     def generate_for(self, node: Node, bit_width: z3.Int):
         """
@@ -225,6 +235,42 @@ class AdditionalConstraints:
         node.bit_width_constraints.append(constraint)
         self.optimizer.add(constraint)
 
+    def cheapest_strategy(
+        self,
+        node: Node,
+        preds: List[Node],
+        candidates: List[Strategy],
+    ) -> Optional[Strategy]:
+        """
+        Select the candidate strategy with the lowest cost for a node.
+
+        Args:
+            node (Node):
+                node to select the strategy of
+
+            preds (List[Node]):
+                ordered predecessors of the node
+
+            candidates (List[Strategy]):
+                strategies that can be used for the node
+
+        Returns:
+            Optional[Strategy]:
+                cheapest candidate, or None if there are no candidates
+        """
+
+        if len(candidates) == 0:
+            return None
+
+        if self.strategy_costs is None or len(candidates) == 1:
+            return candidates[0]
+
+        costs = {
+            candidate: self.strategy_costs.of(node, preds, candidate) for candidate in candidates
+        }
+        node.properties["strategy_costs"] = costs
+        return min(candidates, key=lambda candidate: costs[candidate])
+
     # ==========
     # Conditions
     # ==========
@@ -276,6 +322,20 @@ class AdditionalConstraints:
         ]
 
         for strategy in strategies + fallback:
+            if strategy == ComparisonStrategy.AUTO:
+                strategy = self.cheapest_strategy(
+                    node,
+                    preds,
+                    [
+                        candidate
+                        for candidate in ComparisonStrategy
+                        if candidate != ComparisonStrategy.AUTO
+                        and candidate.can_be_used(x.output, y.output)
+                    ],
+                )
+                if strategy is None:
+                    continue
+
             if strategy.can_be_used(x.output, y.output):
                 new_x_bit_width, new_y_bit_width = strategy.promotions(x.output, y.output)
                 self.constraint(node, self.bit_widths[x] >= new_x_bit_width)
@@ -302,6 +362,20 @@ class AdditionalConstraints:
         ]
 
         for strategy in strategies + fallback:
+            if strategy == BitwiseStrategy.AUTO:
+                strategy = self.cheapest_strategy(
+                    node,
+                    preds,
+                    [
+                        candidate
+                        for candidate in BitwiseStrategy
+                        if candidate != BitwiseStrategy.AUTO
+                        and candidate.can_be_used(x.output, y.output)
+                    ],
+                )
+                if strategy is None:
+                    continue
+
             if strategy.can_be_used(x.output, y.output):
                 new_x_bit_width, new_y_bit_width = strategy.promotions(x.output, y.output)
                 self.constraint(node, self.bit_widths[x] >= new_x_bit_width)
@@ -332,6 +406,20 @@ class AdditionalConstraints:
         ]
 
         for strategy in strategies + fallback:
+            if strategy == MultivariateStrategy.AUTO:
+                strategy = self.cheapest_strategy(
+                    node,
+                    preds,
+                    [
+                        candidate
+                        for candidate in MultivariateStrategy
+                        if candidate != MultivariateStrategy.AUTO
+                        and candidate.can_be_used(*(pred.output for pred in preds))
+                    ],
+                )
+                if strategy is None:
+                    continue
+
             if strategy.can_be_used(*(pred.output for pred in preds)):
                 promotions = strategy.promotions(*(pred.output for pred in preds))
                 for pred, promotion in zip(preds, promotions):
@@ -376,6 +464,20 @@ class AdditionalConstraints:
         ]
 
         for strategy in strategies + fallback:
+            if strategy == MinMaxStrategy.AUTO:
+                strategy = self.cheapest_strategy(
+                    node,
+                    preds,
+                    [
+                        candidate
+                        for candidate in MinMaxStrategy
+                        if candidate != MinMaxStrategy.AUTO
+                        and candidate.can_be_used(x.output, y.output)
+                    ],
+                )
+                if strategy is None:
+                    continue
+
             if strategy.can_be_used(x.output, y.output):
                 new_x_bit_width, new_y_bit_width = strategy.promotions(x.output, y.output)
                 self.constraint(node, self.bit_widths[x] >= new_x_bit_width)
@@ -0,0 +1,213 @@
+"""
+Declaration of `StrategyCosts` class.
+"""
+
+# pylint: disable=import-error,no-name-in-module
+
+from collections import OrderedDict
+from copy import deepcopy
+from typing import List, Tuple, Union
+
+import networkx as nx
+import numpy as np
+from concrete.compiler import CompilationContext
+
+from ..compilation.configuration import (
+    BitwiseStrategy,
+    ComparisonStrategy,
+    Configuration,
+    MinMaxStrategy,
+    MultivariateStrategy,
+)
+from ..dtypes import Integer
+from ..representation import Graph, Node
+from ..values import ValueDescription
+
+# pylint: enable=import-error,no-name-in-module
+
+Strategy = Union[ComparisonStrategy, BitwiseStrategy, MultivariateStrategy, MinMaxStrategy]
+
+
+class StrategyCosts:
+    """
+    StrategyCosts class, to estimate the cost of the strategies of an operation.
+
+    The cost of a strategy is the complexity found by the optimizer for a circuit made of the
+    operation alone, applied with the strategy. Each operand of the operation is computed by
+    a table lookup in this circuit, so promoting the operands is accounted for.
+
+    Costs only depend on the operation and on the configuration, so they are shared by all
+    compilations. The least recently used costs are evicted beyond `MAX_CACHED_COSTS` entries,
+    and `StrategyCosts.clear()` evicts them all.
+    """
+
+    configuration: Configuration
+    configuration_key: Tuple
+
+    # maximum number of costs kept between compilations
+    MAX_CACHED_COSTS = 1024
+
+    costs: "OrderedDict[Tuple, float]" = OrderedDict()
+
+    # messages of the compiler when the optimizer cannot find parameters, for mono and multi
+    NO_PARAMETERS_FOUND = ("NoParametersFound", "No crypto parameters could be found")
+
+    def __init__(self, configuration: Configuration):
+        self.configuration = configuration.fork(
+            verbose=False,
+            show_graph=False,
+            show_bit_width_constraints=False,
+            show_bit_width_assignments=False,
+            show_assigned_graph=False,
+            show_mlir=False,
+            show_optimizer=False,
+            show_statistics=False,
+            show_progress=False,
+            dataflow_parallelize=False,
+            auto_parallelize=False,
+            composable=False,
+            additional_pre_processors=[],
+            additional_post_processors=[],
+        )
+        self.configuration_key = tuple(
+            (name, repr(value)) for name, value in sorted(vars(self.configuration).items())
+        )
+
+    def of(self, node: Node, preds: List[Node], strategy: Strategy) -> float:
+        """
+        Get the cost of a strategy for an operation.
+
+        Args:
+            node (Node):
+                operation to apply the strategy to
+
+            preds (List[Node]):
+                ordered predecessors of the operation
+
+            strategy (Strategy):
+                strategy to apply
+
+        Returns:
+            float:
+                complexity of the operation with the strategy,
+                or infinity if no parameters can be found for it
+        """
+
+        key = (
+            self.configuration_key,
+            node.properties["name"],
+            tuple(str(pred.output) for pred in preds),
+            str(node.output),
+            strategy,
+        )
+        costs = StrategyCosts.costs
+        if key in costs:
+            costs.move_to_end(key)
+            return costs[key]
+
+        cost = self._compile(self._circuit(node, preds), strategy)
+
+        costs[key] = cost
+        while len(costs) > StrategyCosts.MAX_CACHED_COSTS:
+            costs.popitem(last=False)
+
+        return cost
+
+    @staticmethod
+    def clear():
+        """
+        Clear the costs shared by all compilations.
+        """
+
+        StrategyCosts.costs.clear()
+
+    @staticmethod
+    def _circuit(node: Node, preds: List[Node]) -> Graph:
+        # pylint: disable=cyclic-import,import-outside-toplevel
+
+        from ..extensions.table import LookupTable
+
+        # pylint: enable=cyclic-import,import-outside-toplevel
+
+        nx_graph = nx.MultiDiGraph()
+        input_nodes = {}
+
+        operands = []
+        for index, pred in enumerate(preds):
+            dtype = pred.output.dtype
+            assert isinstance(dtype, Integer)
+
+            value = ValueDescription(deepcopy(dtype), pred.output.shape, is_encrypted=True)
+            input_node = Node.input(f"x{index}", value)
+            input_node.bounds = (dtype.min(), dtype.max())
+            input_nodes[index] = input_node
+
+            table = np.arange(dtype.min(), dtype.max() + 1)[::-1]
+            operand = Node.generic(
+                "tlu",
+                [deepcopy(value)],
+                deepcopy(value),
+                LookupTable.apply,
+                kwargs={"table": table},
+            )
+            operand.bounds = (dtype.min(), dtype.max())
+            nx_graph.add_edge(input_node, operand, input_idx=0)
+            operands.append(operand)
+
+        output_dtype = node.output.dtype
+        assert isinstance(output_dtype, Integer)
+
+        properties = dict(node.properties)
+        properties.pop("strategy", None)
+        properties.pop("strategy_costs", None)
+
+        operation = Node(
+            [deepcopy(operand.output) for operand in operands],
+            ValueDescription(deepcopy(output_dtype), node.output.shape, is_encrypted=True),
+            node.operation,
+            node.evaluator,
+            properties,
+        )
+        operation.bounds = (output_dtype.min(), output_dtype.max())
+        for index, operand in enumerate(operands):
+            nx_graph.add_edge(operand, operation, input_idx=index)
+
+        return Graph(nx_graph, input_nodes, {0: operation})
+
+    def _compile(self, graph: Graph, strategy: Strategy) -> float:
+        # pylint: disable=cyclic-import,import-outside-toplevel
+
+        from ..compilation.server import Server
+        from .converter import Converter
+
+        # pylint: enable=cyclic-import,import-outside-toplevel
+
+        preference = {
+            ComparisonStrategy: "comparison_strategy_preference",
+            BitwiseStrategy: "bitwise_strategy_preference",
+            MultivariateStrategy: "multivariate_strategy_preference",
+            MinMaxStrategy: "min_max_strategy_preference",
+        }[type(strategy)]
+
+        configuration = self.configuration.fork(**{preference: [strategy]})
+
+        compilation_context = CompilationContext.new()
+        mlir = Converter(configuration).convert_many(
+            {"main": graph},
+            compilation_context.mlir_context(),
+        )
+        try:
+            server = Server.create(
+                mlir,
+                configuration,
+                is_simulated=True,
+                compilation_context=compilation_context,
+            )
+        except RuntimeError as error:
+            if any(message in str(error) for message in StrategyCosts.NO_PARAMETERS_FOUND):
+                return float("inf")
+            raise
+
+        complexity = server.complexity
+        server.cleanup()
+        return complexity
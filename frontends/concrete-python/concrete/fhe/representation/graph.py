@@ -618,6 +618,24 @@ class Graph:
 
         return result[:-1]
 
+    def format_strategy_decisions(self) -> str:
+        """
+        Get the textual representation of the strategies selected automatically in the graph.
+
+        Returns:
+            str:
+                textual representation of the selected strategies and of their candidates
+        """
+
+        result = ""
+        for i, node in enumerate(nx.lexicographical_topological_sort(self.graph)):
+            costs = node.properties.get("strategy_costs")
+            if costs is not None:
+                result += f"%{i}: {node.properties['strategy'].value}\n"
+                for strategy, cost in costs.items():
+                    result += f"    {strategy.value} = {cost}\n"
+        return result[:-1]
+
     def measure_bounds(
         self,
         inputset: Union[Iterable[Any], Iterable[Tuple[Any, ...]]],
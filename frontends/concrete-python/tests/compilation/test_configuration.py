@@ -138,7 +138,8 @@ FORK_NAME = "fork" if sys.version_info < (3, 10) else "Configuration.fork"
             "two-tlu-bigger-casted-smaller-promoted, "
             "three-tlu-bigger-clipped-smaller-casted, "
             "two-tlu-bigger-clipped-smaller-promoted, "
-            "chunked"
+            "chunked, "
+            "auto"
             ")",
         ),
         pytest.param(
@@ -154,7 +155,8 @@ FORK_NAME = "fork" if sys.version_info < (3, 10) else "Configuration.fork"
             "three-tlu-casted, "
             "two-tlu-bigger-promoted-smaller-casted, "
             "two-tlu-bigger-casted-smaller-promoted, "
-            "chunked"
+            "chunked, "
+            "auto"
             ")",
         ),
         pytest.param(
@@ -165,7 +167,7 @@ FORK_NAME = "fork" if sys.version_info < (3, 10) else "Configuration.fork"
         pytest.param(
             {"multivariate_strategy_preference": "bad"},
             ValueError,
-            "'bad' is not a valid 'MultivariateStrategy' (promoted, casted)",
+            "'bad' is not a valid 'MultivariateStrategy' (promoted, casted, auto)",
         ),
         pytest.param(
             {"min_max_strategy_preference": 42},
@@ -175,7 +177,12 @@ FORK_NAME = "fork" if sys.version_info < (3, 10) else "Configuration.fork"
         pytest.param(
             {"min_max_strategy_preference": "bad"},
             ValueError,
-            "'bad' is not a valid 'MinMaxStrategy' (one-tlu-promoted, three-tlu-casted, chunked)",
+            "'bad' is not a valid 'MinMaxStrategy' ("
+            "one-tlu-promoted, "
+            "three-tlu-casted, "
+            "chunked, "
+            "auto"
+            ")",
         ),
         pytest.param(
             {"additional_pre_processors": "bad"},
@@ -15,6 +15,7 @@ import pytest
 
 import tests
 from concrete import fhe
+from concrete.fhe.mlir.strategy_costs import StrategyCosts
 
 tests_directory = os.path.dirname(tests.__file__)
 
@@ -461,6 +462,17 @@ Actual Output
             """
 
 
+@pytest.fixture(autouse=True)
+def clear_strategy_costs():
+    """
+    Fixture that clears the strategy costs cached by a test, so tests don't depend on each other.
+    """
+
+    StrategyCosts.clear()
+    yield
+    StrategyCosts.clear()
+
+
 @pytest.fixture
 def helpers():
     """
@@ -9,6 +9,7 @@ import pytest
 
 from concrete import fhe
 from concrete.fhe.dtypes import Integer
+from concrete.fhe.mlir.strategy_costs import StrategyCosts
 from concrete.fhe.values import ValueDescription
 
 cases = [
@@ -85,6 +86,7 @@ for _ in range(35):
                     fhe.ComparisonStrategy.THREE_TLU_BIGGER_CLIPPED_SMALLER_CASTED,
                     fhe.ComparisonStrategy.TWO_TLU_BIGGER_CLIPPED_SMALLER_PROMOTED,
                     fhe.ComparisonStrategy.CHUNKED,
+                    fhe.ComparisonStrategy.AUTO,
                 ]
             ),
         ]
@@ -180,3 +182,55 @@ def test_comparison(
             retries=5,
             only_simulation=(max(lhs_bit_width, rhs_bit_width) > 7),
         )
+
+
+def test_comparison_auto_strategy(helpers, monkeypatch):
+    """
+    Test that the auto comparison strategy selects the cheapest strategy.
+    """
+
+    configuration = helpers.configuration().fork(
+        comparison_strategy_preference=[fhe.ComparisonStrategy.AUTO],
+    )
+
+    @fhe.compiler({"x": "encrypted", "y": "encrypted"})
+    def function(x, y):
+        return x < y
+
+    inputset = [(np.random.randint(0, 2**3), np.random.randint(0, 2**5)) for _ in range(100)]
+    circuit = function.compile(inputset, configuration)
+
+    comparisons = circuit.graph.query_nodes(
+        custom_filter=lambda node: "strategy_costs" in node.properties
+    )
+    assert len(comparisons) == 1
+
+    comparison = comparisons[0]
+    costs = comparison.properties["strategy_costs"]
+
+    assert fhe.ComparisonStrategy.AUTO not in costs
+    assert comparison.properties["strategy"] == min(costs, key=costs.get)
+
+    for x, y in [(0, 0), (7, 31), (5, 3), (3, 5)]:
+        helpers.check_execution(circuit, function, [x, y], retries=5)
+
+    # the costs are reused by the next compilations with the same configuration
+    def not_compiled(*_args):
+        raise AssertionError("the costs should be cached")
+
+    monkeypatch.setattr(StrategyCosts, "_compile", not_compiled)
+    recompiled = function.compile(inputset, configuration)
+    recompiled_comparison = recompiled.graph.query_nodes(
+        custom_filter=lambda node: "strategy_costs" in node.properties
+    )[0]
+    assert recompiled_comparison.properties["strategy"] == comparison.properties["strategy"]
+
+    # the costs are evicted beyond the bound, and cleared on demand
+    monkeypatch.undo()
+    monkeypatch.setattr(StrategyCosts, "MAX_CACHED_COSTS", 1)
+
+    StrategyCosts.clear()
+    assert len(StrategyCosts.costs) == 0
+
+    function.compile(inputset, configuration)
+    assert len(StrategyCosts.costs) == 1
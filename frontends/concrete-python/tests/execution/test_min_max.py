@@ -122,6 +122,8 @@ for lhs_bit_width in range(1, 5):
             strategies += [
                 fhe.MinMaxStrategy.CHUNKED,
             ]
+        if lhs_bit_width == rhs_bit_width:
+            strategies.append(fhe.MinMaxStrategy.AUTO)
 
         for lhs_is_signed in [False, True]:
             for rhs_is_signed in [False, True]:
@@ -137,6 +137,22 @@ cases = [
         ],
         fhe.MultivariateStrategy.PROMOTED,
     ],
+    [
+        ("x_if_y_else_zero", lambda x, y: fhe.multivariate(x_if_y_else_zero)(x, y)),
+        [
+            ValueDescription(
+                Integer(is_signed=True, bit_width=3),
+                shape=(2,),
+                is_encrypted=True,
+            ),
+            ValueDescription(
+                Integer(is_signed=False, bit_width=1),
+                shape=(),
+                is_encrypted=True,
+            ),
+        ],
+        fhe.MultivariateStrategy.AUTO,
+    ],
 ]
 
 
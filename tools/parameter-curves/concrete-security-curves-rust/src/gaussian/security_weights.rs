@@ -1,4 +1,4 @@
-#[derive(Clone, Copy)]
+#[derive(Clone, Copy, Debug)]
 pub struct SecurityWeights {
     pub(crate) slope: f64,
     pub(crate) bias: f64,